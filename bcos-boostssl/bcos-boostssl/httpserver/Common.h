@@ -24,6 +24,7 @@
 #include <boost/beast/core.hpp>
 #include <boost/beast/http.hpp>
 #include <boost/beast/http/vector_body.hpp>
+#include <map>
 
 
 #define HTTP_LISTEN(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[HTTP][LISTEN]"
@@ -45,6 +46,9 @@ using HttpRequestPtr = std::shared_ptr<HttpRequest>;
 using HttpResponsePtr = std::shared_ptr<HttpResponse>;
 using HttpReqHandler =
     std::function<void(const std::string_view req, std::function<void(bcos::bytes)>)>;
+// serve the GET request of a target, return the content type and the body of the response
+using HttpGetHandler = std::function<std::pair<std::string, std::string>()>;
+using HttpGetHandlers = std::map<std::string, HttpGetHandler>;
 using WsUpgradeHandler =
     std::function<void(std::shared_ptr<HttpStream>, HttpRequest&&, std::shared_ptr<std::string>)>;
 
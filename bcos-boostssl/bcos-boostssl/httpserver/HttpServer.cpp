@@ -193,6 +193,7 @@ HttpSession::Ptr HttpServer::buildHttpSession(
     session->setQueue(queue);
     session->setHttpStream(_httpStream);
     session->setRequestHandler(m_httpReqHandler);
+    session->setGetHandlers(m_getHandlers);
     session->setWsUpgradeHandler(m_wsUpgradeHandler);
     session->setThreadPool(threadPool());
     session->setNodeId(_nodeId);
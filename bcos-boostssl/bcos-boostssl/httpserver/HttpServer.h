@@ -60,6 +60,12 @@ public:
     HttpReqHandler httpReqHandler() const { return m_httpReqHandler; }
     void setHttpReqHandler(HttpReqHandler _httpReqHandler) { m_httpReqHandler = _httpReqHandler; }
 
+    // register the handler of the GET requests to _target, e.g. /metrics
+    void registerGetHandler(std::string const& _target, HttpGetHandler _handler)
+    {
+        m_getHandlers[_target] = std::move(_handler);
+    }
+
     std::shared_ptr<boost::asio::ip::tcp::acceptor> acceptor() const { return m_acceptor; }
     void setAcceptor(std::shared_ptr<boost::asio::ip::tcp::acceptor> _acceptor)
     {
@@ -104,6 +110,7 @@ private:
     std::string m_moduleName;
 
     HttpReqHandler m_httpReqHandler;
+    HttpGetHandlers m_getHandlers;
     WsUpgradeHandler m_wsUpgradeHandler;
 
     std::shared_ptr<boost::asio::ip::tcp::acceptor> m_acceptor;
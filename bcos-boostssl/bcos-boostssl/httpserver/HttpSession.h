@@ -189,6 +189,11 @@ public:
 
         auto startT = utcTime();
         unsigned version = _httpRequest.version();
+        if (_httpRequest.method() == boost::beast::http::verb::get &&
+            handleGetRequest(_httpRequest))
+        {
+            return;
+        }
         auto self = std::weak_ptr<HttpSession>(shared_from_this());
         if (m_httpReqHandler)
         {
@@ -232,6 +237,28 @@ public:
         }
     }
 
+    /**
+     * @brief: serve the GET request by the handler registered for its target
+     * @param _httpRequest: http request object
+     * @return bool: false if no handler is registered for the target
+     */
+    bool handleGetRequest(HttpRequest const& _httpRequest)
+    {
+        auto target = _httpRequest.target();
+        target = target.substr(0, target.find('?'));
+        auto it = m_getHandlers.find(std::string(target.data(), target.size()));
+        if (it == m_getHandlers.end())
+        {
+            return false;
+        }
+        auto [contentType, body] = it->second();
+        auto resp = buildHttpResp(boost::beast::http::status::ok, _httpRequest.version(),
+            bcos::bytes(body.begin(), body.end()));
+        resp->set(boost::beast::http::field::content_type, contentType);
+        m_queue->enqueue(resp);
+        return true;
+    }
+
     /**
      * @brief: build http response object
      * @param status: http response status
@@ -253,6 +280,9 @@ public:
     HttpReqHandler httpReqHandler() const { return m_httpReqHandler; }
     void setRequestHandler(HttpReqHandler _httpReqHandler) { m_httpReqHandler = _httpReqHandler; }
 
+    HttpGetHandlers const& getHandlers() const { return m_getHandlers; }
+    void setGetHandlers(HttpGetHandlers _getHandlers) { m_getHandlers = std::move(_getHandlers); }
+
     WsUpgradeHandler wsUpgradeHandler() const { return m_wsUpgradeHandler; }
     void setWsUpgradeHandler(WsUpgradeHandler _wsUpgradeHandler)
     {
@@ -286,6 +316,7 @@ private:
     std::shared_ptr<bcos::ThreadPool> m_threadPool;
 
     HttpReqHandler m_httpReqHandler;
+    HttpGetHandlers m_getHandlers;
     WsUpgradeHandler m_wsUpgradeHandler;
     // the parser is stored in an optional container so we can
     // construct it from scratch it at the beginning of each new message.
@@ -0,0 +1,224 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the pre-sized callback table of the websocket session
+ * @file WsCallbackSlab.cpp
+ */
+
+#include <bcos-boostssl/websocket/WsCallbackSlab.h>
+#include <algorithm>
+#include <chrono>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+
+WsCallbackSlab::WsCallbackSlab(uint32_t _capacity)
+  : m_slots(_capacity), m_wheel(WHEEL_SIZE), m_currentTick(nowTick())
+{
+    m_freeSlots.reserve(_capacity);
+    // the slots with small index are used first
+    for (uint32_t i = _capacity; i > 0; --i)
+    {
+        m_freeSlots.push_back(i - 1);
+    }
+}
+
+std::optional<std::string> WsCallbackSlab::add(RespCallBack&& _respCallBack, int32_t _timeout)
+{
+    Guard l(x_slots);
+    if (m_freeSlots.empty())
+    {
+        return std::nullopt;
+    }
+    auto index = m_freeSlots.back();
+    m_freeSlots.pop_back();
+
+    auto& slot = m_slots[index];
+    slot.respCallBack = std::move(_respCallBack);
+    slot.used = true;
+    if (_timeout > 0)
+    {
+        // never put the slot into the buckets expire has passed
+        slot.deadline = std::max(nowTick() + (_timeout + TICK_MS - 1) / TICK_MS, m_currentTick + 1);
+        m_wheel[slot.deadline % WHEEL_SIZE].push_back(WheelEntry{index, slot.generation});
+        m_timedSize++;
+    }
+    return encodeSeq(index, slot.generation);
+}
+
+RespCallBack WsCallbackSlab::remove(std::string_view _seq)
+{
+    auto position = decodeSeq(_seq);
+    if (!position || position->first >= m_slots.size())
+    {
+        return nullptr;
+    }
+
+    Guard l(x_slots);
+    auto& slot = m_slots[position->first];
+    if (!slot.used || slot.generation != position->second)
+    {
+        return nullptr;
+    }
+    return release(slot, position->first);
+}
+
+std::vector<std::pair<std::string, RespCallBack>> WsCallbackSlab::expire()
+{
+    std::vector<std::pair<std::string, RespCallBack>> expired;
+    auto now = nowTick();
+
+    Guard l(x_slots);
+    if (now <= m_currentTick)
+    {
+        return expired;
+    }
+    // all the buckets are visited once if the wheel has not been driven for a round
+    auto steps = std::min<uint64_t>(now - m_currentTick, WHEEL_SIZE);
+    for (uint64_t i = 1; i <= steps; ++i)
+    {
+        auto& bucket = m_wheel[(m_currentTick + i) % WHEEL_SIZE];
+        size_t kept = 0;
+        for (auto const& entry : bucket)
+        {
+            auto& slot = m_slots[entry.index];
+            // the response has arrived, or the slot has been reused
+            if (!slot.used || slot.generation != entry.generation)
+            {
+                continue;
+            }
+            // not timed out in this round of the wheel
+            if (slot.deadline > now)
+            {
+                bucket[kept++] = entry;
+                continue;
+            }
+            auto seq = encodeSeq(entry.index, entry.generation);
+            expired.emplace_back(std::move(seq), release(slot, entry.index));
+        }
+        bucket.resize(kept);
+    }
+    m_currentTick = now;
+    return expired;
+}
+
+std::vector<std::pair<std::string, RespCallBack>> WsCallbackSlab::clear()
+{
+    std::vector<std::pair<std::string, RespCallBack>> callbacks;
+
+    Guard l(x_slots);
+    for (uint32_t i = 0; i < m_slots.size(); ++i)
+    {
+        auto& slot = m_slots[i];
+        if (slot.used)
+        {
+            auto seq = encodeSeq(i, slot.generation);
+            callbacks.emplace_back(std::move(seq), release(slot, i));
+        }
+    }
+    for (auto& bucket : m_wheel)
+    {
+        bucket.clear();
+    }
+    return callbacks;
+}
+
+size_t WsCallbackSlab::size() const
+{
+    Guard l(x_slots);
+    return m_slots.size() - m_freeSlots.size();
+}
+
+size_t WsCallbackSlab::timedSize() const
+{
+    Guard l(x_slots);
+    return m_timedSize;
+}
+
+bool WsCallbackSlab::isSlabSeq(std::string_view _seq)
+{
+    return decodeSeq(_seq).has_value();
+}
+
+RespCallBack WsCallbackSlab::release(Slot& _slot, uint32_t _index)
+{
+    auto respCallBack = std::move(_slot.respCallBack);
+    _slot.respCallBack = nullptr;
+    _slot.used = false;
+    // the seq issued before is invalid from now on
+    _slot.generation++;
+    if (_slot.deadline > 0)
+    {
+        _slot.deadline = 0;
+        m_timedSize--;
+    }
+    m_freeSlots.push_back(_index);
+    return respCallBack;
+}
+
+std::string WsCallbackSlab::encodeSeq(uint32_t _index, uint32_t _generation)
+{
+    constexpr static char hexDigits[] = "0123456789abcdef";
+    auto value = ((uint64_t)_generation << 32) | _index;
+    std::string seq(SEQ_LENGTH, '0');
+    for (size_t i = SEQ_LENGTH; i > SEQ_LENGTH - 16; --i)
+    {
+        seq[i - 1] = hexDigits[value & 0xf];
+        value >>= 4;
+    }
+    return seq;
+}
+
+std::optional<std::pair<uint32_t, uint32_t>> WsCallbackSlab::decodeSeq(std::string_view _seq)
+{
+    if (_seq.size() != SEQ_LENGTH)
+    {
+        return std::nullopt;
+    }
+    uint64_t value = 0;
+    for (size_t i = 0; i < SEQ_LENGTH; ++i)
+    {
+        auto c = _seq[i];
+        uint64_t digit;
+        if (c >= '0' && c <= '9')
+        {
+            digit = c - '0';
+        }
+        else if (c >= 'a' && c <= 'f')
+        {
+            digit = c - 'a' + 10;
+        }
+        else
+        {
+            return std::nullopt;
+        }
+        // the high 16 digits are always '0'
+        if (i < SEQ_LENGTH - 16 && digit != 0)
+        {
+            return std::nullopt;
+        }
+        value = (value << 4) | digit;
+    }
+    return std::make_pair((uint32_t)(value & 0xffffffff), (uint32_t)(value >> 32));
+}
+
+uint64_t WsCallbackSlab::nowTick()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+               .count() /
+           TICK_MS;
+}
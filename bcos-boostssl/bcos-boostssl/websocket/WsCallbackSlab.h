@@ -0,0 +1,106 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the pre-sized callback table of the websocket session
+ * @file WsCallbackSlab.h
+ */
+#pragma once
+#include <bcos-boostssl/websocket/Common.h>
+#include <bcos-utilities/Common.h>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace bcos
+{
+namespace boostssl
+{
+namespace ws
+{
+/**
+ * @brief WsCallbackSlab keeps the response callbacks of a session in a fixed number of slots, the
+ * seq of the request is the slot index and the generation of the slot, so the response finds its
+ * callback without hashing, and the table never allocates after construction.
+ *
+ * The seq is still the string the peer echoes: 16 '0' followed by the 16 hex digits of
+ * generation(4B) | index(4B), the same length as the uuid seq of WsMessageFactory.
+ *
+ * The timeouts are kept in a timing wheel of WHEEL_SIZE buckets of TICK_MS, which is driven by
+ * one timer of the session instead of one deadline_timer per request.
+ */
+class WsCallbackSlab
+{
+public:
+    using Ptr = std::shared_ptr<WsCallbackSlab>;
+    constexpr static size_t SEQ_LENGTH = 32;
+    constexpr static uint32_t TICK_MS = 10;
+    constexpr static uint32_t WHEEL_SIZE = 1024;
+
+    WsCallbackSlab(uint32_t _capacity);
+
+    // return the seq of the slot, nullopt if all the slots are in use, the callback is moved only
+    // if the slot is taken
+    std::optional<std::string> add(RespCallBack&& _respCallBack, int32_t _timeout);
+    // return the callback and free the slot, nullptr if the seq is not issued by this slab or has
+    // been removed
+    RespCallBack remove(std::string_view _seq);
+
+    // advance the wheel to now, free the slots timed out and return their callbacks
+    std::vector<std::pair<std::string, RespCallBack>> expire();
+    // free all the slots and return their callbacks
+    std::vector<std::pair<std::string, RespCallBack>> clear();
+
+    size_t size() const;
+    // the number of the slots waiting for timeout
+    size_t timedSize() const;
+    uint32_t capacity() const { return m_slots.size(); }
+
+    static bool isSlabSeq(std::string_view _seq);
+
+private:
+    struct Slot
+    {
+        RespCallBack respCallBack;
+        uint32_t generation = 0;
+        bool used = false;
+        // 0 means no timeout
+        uint64_t deadline = 0;
+    };
+    struct WheelEntry
+    {
+        uint32_t index;
+        uint32_t generation;
+    };
+
+    static std::string encodeSeq(uint32_t _index, uint32_t _generation);
+    static std::optional<std::pair<uint32_t, uint32_t>> decodeSeq(std::string_view _seq);
+    static uint64_t nowTick();
+
+    RespCallBack release(Slot& _slot, uint32_t _index);
+
+    mutable bcos::Mutex x_slots;
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_freeSlots;
+    size_t m_timedSize = 0;
+
+    std::vector<std::vector<WheelEntry>> m_wheel;
+    // the last tick processed by expire
+    uint64_t m_currentTick;
+};
+}  // namespace ws
+}  // namespace boostssl
+}  // namespace bcos
@@ -92,6 +92,10 @@ private:
     // the max message to be send or read
     uint32_t m_maxMsgSize{DEFAULT_MAX_MESSAGE_SIZE};
 
+    // the slots of the callback slab of every session, 0 means the callbacks are keyed by the seq
+    // of the message
+    uint32_t m_callbackSlabSize{0};
+
     std::string m_moduleName = "DEFAULT";
 
 public:
@@ -113,6 +117,9 @@ public:
     void setMaxMsgSize(uint32_t _maxMsgSize) { m_maxMsgSize = _maxMsgSize; }
     uint32_t maxMsgSize() const { return m_maxMsgSize; }
 
+    void setCallbackSlabSize(uint32_t _callbackSlabSize) { m_callbackSlabSize = _callbackSlabSize; }
+    uint32_t callbackSlabSize() const { return m_callbackSlabSize; }
+
     uint32_t reconnectPeriod() const
     {
         return m_reconnectPeriod > MIN_RECONNECT_PERIOD_MS ? m_reconnectPeriod :
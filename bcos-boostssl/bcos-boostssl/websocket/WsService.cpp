@@ -386,6 +386,10 @@ std::shared_ptr<WsSession> WsService::newSession(
     session->setConnectedEndPoint(endPoint);
     session->setMaxWriteMsgSize(m_config->maxMsgSize());
     session->setSendMsgTimeout(m_config->sendMsgTimeout());
+    if (m_config->callbackSlabSize() > 0)
+    {
+        session->setCallbackSlab(std::make_shared<WsCallbackSlab>(m_config->callbackSlabSize()));
+    }
     session->setNodeId(_nodeId);
 
     auto self = std::weak_ptr<WsService>(shared_from_this());
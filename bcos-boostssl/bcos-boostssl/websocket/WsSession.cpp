@@ -84,6 +84,19 @@ void WsSession::drop(uint32_t _reason)
             m_threadPool->enqueue(
                 [callback, error]() { callback->respCallBack(error, nullptr, nullptr); });
         }
+
+        if (m_callbackSlab)
+        {
+            for (auto& [seq, respCallBack] : m_callbackSlab->clear())
+            {
+                WEBSOCKET_SESSION(TRACE)
+                    << LOG_DESC("the session has been disconnected") << LOG_KV("seq", seq);
+
+                m_threadPool->enqueue([respCallBack = std::move(respCallBack), error]() {
+                    respCallBack(error, nullptr, nullptr);
+                });
+            }
+        }
     }
 
     // clear callbacks
@@ -187,6 +200,12 @@ void WsSession::onMessage(bcos::boostssl::MessageFace::Ptr _message)
         {
             return;
         }
+        auto respCallBack = session->getAndRemoveSlabCallback(_message);
+        if (respCallBack)
+        {
+            respCallBack(nullptr, _message, session);
+            return;
+        }
         auto callback = session->getAndRemoveRespCallback(_message->seq(), true, _message);
         if (callback)
         {
@@ -366,10 +385,29 @@ void WsSession::asyncSendMessage(
         return;
     }
 
+    auto timeout = _options.timeout > 0 ? _options.timeout : m_sendMsgTimeout;
+    bool slabCallback = false;
+    if (_respFunc && m_callbackSlab)
+    {
+        auto slabSeq = m_callbackSlab->add(std::move(_respFunc), timeout);
+        if (slabSeq)
+        {
+            // the peer echoes the seq of the slab in the response
+            _msg->setSeq(*slabSeq);
+            seq = std::move(*slabSeq);
+            slabCallback = true;
+        }
+        // the slab is full, fall back to m_callbacks with the seq of the message
+    }
+
     auto buffer = std::make_shared<bytes>();
     auto r = _msg->encode(*buffer);
     if (!r)
     {
+        if (slabCallback)
+        {
+            _respFunc = m_callbackSlab->remove(seq);
+        }
         if (_respFunc)
         {
             auto error =
@@ -385,11 +423,17 @@ void WsSession::asyncSendMessage(
         return;
     }
 
-    if (_respFunc)
+    if (slabCallback)
+    {
+        if (timeout > 0)
+        {
+            startWheelTimer();
+        }
+    }
+    else if (_respFunc)
     {  // callback
         auto callback = std::make_shared<CallBack>();
         callback->respCallBack = _respFunc;
-        auto timeout = _options.timeout > 0 ? _options.timeout : m_sendMsgTimeout;
         if (timeout > 0)
         {
             // create new timer to handle timeout
@@ -469,3 +513,64 @@ void WsSession::onRespTimeout(const boost::system::error_code& _error, const std
         std::make_shared<Error>(WsError::TimeOut, "waiting for message response timed out");
     m_threadPool->enqueue([callback, error]() { callback->respCallBack(error, nullptr, nullptr); });
 }
+
+RespCallBack WsSession::getAndRemoveSlabCallback(std::shared_ptr<MessageFace> const& _message)
+{
+    if (!m_callbackSlab || (needCheckRspPacket() && !_message->isRespPacket()))
+    {
+        return nullptr;
+    }
+    return m_callbackSlab->remove(_message->seq());
+}
+
+void WsSession::startWheelTimer()
+{
+    bool expected = false;
+    if (!m_wheelTimerRunning.compare_exchange_strong(expected, true))
+    {
+        return;
+    }
+
+    if (!m_wheelTimer)
+    {
+        m_wheelTimer = std::make_shared<boost::asio::deadline_timer>(*m_ioc);
+    }
+    m_wheelTimer->expires_from_now(boost::posix_time::milliseconds(WsCallbackSlab::TICK_MS));
+    auto self = std::weak_ptr<WsSession>(shared_from_this());
+    m_wheelTimer->async_wait([self](const boost::system::error_code& _error) {
+        auto session = self.lock();
+        if (session)
+        {
+            session->onWheelTimer(_error);
+        }
+    });
+}
+
+void WsSession::onWheelTimer(const boost::system::error_code& _error)
+{
+    m_wheelTimerRunning = false;
+    if (_error)
+    {
+        return;
+    }
+
+    auto expired = m_callbackSlab->expire();
+    if (!expired.empty())
+    {
+        auto error =
+            std::make_shared<Error>(WsError::TimeOut, "waiting for message response timed out");
+        for (auto& [seq, respCallBack] : expired)
+        {
+            WEBSOCKET_SESSION(WARNING) << LOG_BADGE("onRespTimeout") << LOG_KV("seq", seq);
+            m_threadPool->enqueue([respCallBack = std::move(respCallBack), error]() {
+                respCallBack(error, nullptr, nullptr);
+            });
+        }
+    }
+
+    // the requests added after the flag is reset start the timer by themselves
+    if (!m_isDrop && m_callbackSlab->timedSize() > 0)
+    {
+        startWheelTimer();
+    }
+}
@@ -20,6 +20,7 @@
 #pragma once
 #include <bcos-boostssl/httpserver/Common.h>
 #include <bcos-boostssl/websocket/Common.h>
+#include <bcos-boostssl/websocket/WsCallbackSlab.h>
 #include <bcos-boostssl/websocket/WsMessage.h>
 #include <bcos-boostssl/websocket/WsStream.h>
 #include <bcos-utilities/Common.h>
@@ -156,6 +157,11 @@ public:
         m_needCheckRspPacket = _needCheckRespPacket;
     }
 
+    // the requests with callback use the seq of the slab instead of their own seq if the slab is
+    // set, the requests fall back to m_callbacks when the slab is full
+    WsCallbackSlab::Ptr callbackSlab() const { return m_callbackSlab; }
+    void setCallbackSlab(WsCallbackSlab::Ptr _callbackSlab) { m_callbackSlab = _callbackSlab; }
+
 protected:
     struct CallBack
     {
@@ -168,6 +174,11 @@ protected:
         std::shared_ptr<MessageFace> _message = nullptr);
     virtual void onRespTimeout(const boost::system::error_code& _error, const std::string& _seq);
 
+    RespCallBack getAndRemoveSlabCallback(std::shared_ptr<MessageFace> const& _message);
+    // one timer drives the timeout wheel of the slab while there are requests waiting for timeout
+    void startWheelTimer();
+    void onWheelTimer(const boost::system::error_code& _error);
+
     virtual void onWsAccept(boost::beast::error_code _ec);
 
     virtual void asyncRead();
@@ -206,6 +217,9 @@ protected:
     // callbacks
     mutable bcos::SharedMutex x_callback;
     std::unordered_map<std::string, CallBack::Ptr> m_callbacks;
+    WsCallbackSlab::Ptr m_callbackSlab;
+    std::shared_ptr<boost::asio::deadline_timer> m_wheelTimer;
+    std::atomic_bool m_wheelTimerRunning = {false};
 
     // callback handler
     WsConnectHandler m_connectHandler;
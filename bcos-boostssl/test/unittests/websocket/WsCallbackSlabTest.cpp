@@ -0,0 +1,117 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for WsCallbackSlab
+ * @file WsCallbackSlabTest.cpp
+ */
+
+#include <bcos-boostssl/websocket/WsCallbackSlab.h>
+#include <bcos-boostssl/websocket/WsMessage.h>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <thread>
+
+using namespace bcos;
+
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+
+BOOST_AUTO_TEST_SUITE(WsCallbackSlabTest)
+
+BOOST_AUTO_TEST_CASE(test_addAndRemove)
+{
+    WsCallbackSlab slab(2);
+    int called = 0;
+    auto seq1 = slab.add([&called](Error::Ptr, std::shared_ptr<MessageFace>,
+                             std::shared_ptr<WsSession>) { called += 1; },
+        -1);
+    auto seq2 = slab.add([&called](Error::Ptr, std::shared_ptr<MessageFace>,
+                             std::shared_ptr<WsSession>) { called += 10; },
+        -1);
+    BOOST_REQUIRE(seq1 && seq2);
+    BOOST_CHECK_NE(*seq1, *seq2);
+    // the same length as the uuid seq
+    BOOST_CHECK_EQUAL(seq1->size(), WsMessageFactory().newSeq().size());
+    BOOST_CHECK(WsCallbackSlab::isSlabSeq(*seq1));
+    BOOST_CHECK_EQUAL(slab.size(), 2);
+
+    // full
+    RespCallBack respCallBack = [](Error::Ptr, std::shared_ptr<MessageFace>,
+                                    std::shared_ptr<WsSession>) {};
+    BOOST_CHECK(!slab.add(std::move(respCallBack), -1));
+    BOOST_CHECK(respCallBack);
+
+    auto callback = slab.remove(*seq2);
+    BOOST_REQUIRE(callback);
+    callback(nullptr, nullptr, nullptr);
+    BOOST_CHECK_EQUAL(called, 10);
+    // removed once only
+    BOOST_CHECK(!slab.remove(*seq2));
+
+    // the slot is reused by another generation, the old seq does not match
+    auto seq3 = slab.add(std::move(respCallBack), -1);
+    BOOST_REQUIRE(seq3);
+    BOOST_CHECK_NE(*seq3, *seq2);
+    BOOST_CHECK(!slab.remove(*seq2));
+    BOOST_CHECK(slab.remove(*seq3));
+
+    // the seq not issued by the slab
+    BOOST_CHECK(!WsCallbackSlab::isSlabSeq(WsMessageFactory().newSeq()));
+    BOOST_CHECK(!slab.remove(WsMessageFactory().newSeq()));
+    BOOST_CHECK(!slab.remove("1"));
+
+    auto callbacks = slab.clear();
+    BOOST_REQUIRE_EQUAL(callbacks.size(), 1);
+    BOOST_CHECK_EQUAL(callbacks[0].first, *seq1);
+    callbacks[0].second(nullptr, nullptr, nullptr);
+    BOOST_CHECK_EQUAL(called, 11);
+    BOOST_CHECK_EQUAL(slab.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_timeoutWheel)
+{
+    WsCallbackSlab slab(16);
+    auto emptyCallback = []() -> RespCallBack {
+        return [](Error::Ptr, std::shared_ptr<MessageFace>, std::shared_ptr<WsSession>) {};
+    };
+    auto shortSeq = slab.add(emptyCallback(), WsCallbackSlab::TICK_MS);
+    auto answeredSeq = slab.add(emptyCallback(), WsCallbackSlab::TICK_MS);
+    auto longSeq = slab.add(emptyCallback(), 60 * 1000);
+    // never times out
+    auto noTimeoutSeq = slab.add(emptyCallback(), -1);
+    BOOST_REQUIRE(shortSeq && answeredSeq && longSeq && noTimeoutSeq);
+    BOOST_CHECK_EQUAL(slab.timedSize(), 3);
+
+    BOOST_CHECK(slab.remove(*answeredSeq));
+    BOOST_CHECK_EQUAL(slab.timedSize(), 2);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(WsCallbackSlab::TICK_MS * 5));
+    auto expired = slab.expire();
+    BOOST_REQUIRE_EQUAL(expired.size(), 1);
+    BOOST_CHECK_EQUAL(expired[0].first, *shortSeq);
+    BOOST_CHECK(expired[0].second);
+    BOOST_CHECK(!slab.remove(*shortSeq));
+    BOOST_CHECK_EQUAL(slab.timedSize(), 1);
+    BOOST_CHECK_EQUAL(slab.size(), 2);
+
+    // the wheel has been driven to now
+    BOOST_CHECK(slab.expire().empty());
+    BOOST_CHECK(slab.remove(*longSeq));
+    BOOST_CHECK(slab.remove(*noTimeoutSeq));
+    BOOST_CHECK_EQUAL(slab.timedSize(), 0);
+    BOOST_CHECK_EQUAL(slab.size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -30,6 +30,7 @@
 #include "bcos-framework/protocol/BlockHeader.h"
 #include "bcos-protocol/TransactionStatus.h"
 #include <bcos-framework/protocol/LogEntry.h>
+#include <bcos-utilities/AsyncLog.h>
 #include <bcos-utilities/Exceptions.h>
 #include <evmc/instructions.h>
 #include <boost/algorithm/string/case_conv.hpp>
@@ -49,6 +50,9 @@ namespace executor
 #define EXECUTOR_BLK_LOG(LEVEL, number) EXECUTOR_LOG(LEVEL) << BLOCK_NUMBER(number)
 #define EXECUTOR_NAME_LOG(LEVEL) \
     BCOS_LOG(LEVEL) << LOG_BADGE("EXECUTOR:" + std::to_string(m_schedulerTermId))
+// for the logs of every transaction, formatted on the background thread
+#define EXECUTOR_NAME_ASYNC_LOG(LEVEL, FORMAT, ...) \
+    BCOS_ASYNC_LOG(LEVEL, "[EXECUTOR:{}]" FORMAT, m_schedulerTermId __VA_OPT__(, ) __VA_ARGS__)
 #define COROUTINE_TRACE_LOG(LEVEL, contextID, seq) \
     BCOS_LOG(LEVEL) << LOG_BADGE("EXECUTOR") << "[" << (contextID) << "," << (seq) << "]"
 #define PARA_LOG(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE("PARA") << LOG_BADGE(utcTime())
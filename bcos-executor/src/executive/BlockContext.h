@@ -81,6 +81,10 @@ public:
 
     VMSchedule const& vmSchedule() const { return m_schedule; }
 
+    // the context is created for the read-only call against the last committed state
+    bool isCall() const { return m_isCall; }
+    void setIsCall(bool _isCall) { m_isCall = _isCall; }
+
     ExecutiveFlowInterface::Ptr getExecutiveFlow(std::string codeAddress);
     void setExecutiveFlow(std::string codeAddress, ExecutiveFlowInterface::Ptr executiveFlow);
 
@@ -111,6 +115,7 @@ private:
     u256 m_gasLimit;
     bool m_isWasm = false;
     bool m_isAuthCheck = false;
+    bool m_isCall = false;
 
     uint64_t m_txGasLimit = 3000000000;
     std::shared_ptr<storage::StateStorageInterface> m_storage;
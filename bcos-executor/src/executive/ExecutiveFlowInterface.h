@@ -75,7 +75,7 @@ private:
             if (!m_pool)
             {
                 m_pool = std::make_shared<bcos::ThreadPool>(
-                    "ExecutiveFlow", std::thread::hardware_concurrency());
+                    "ExecutiveFlow", bcos::TaskClass::EXECUTIVE_FLOW);
             }
         }
         return m_pool;
@@ -68,6 +68,7 @@
 #include <bcos-framework/protocol/Protocol.h>
 #include <bcos-utilities/Error.h>
 #include <bcos-utilities/ThreadPool.h>
+#include <bcos-utilities/Tracer.h>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
 #include <tbb/spin_mutex.h>
@@ -131,7 +132,7 @@ TransactionExecutor::TransactionExecutor(bcos::ledger::LedgerInterface::Ptr ledg
     m_abiCache = make_shared<ClockCache<bcos::bytes, FunctionAbi>>(32);
     m_gasInjector = std::make_shared<wasm::GasInjector>(wasm::GetInstructionTable());
 
-    m_threadPool = std::make_shared<bcos::ThreadPool>(name, std::thread::hardware_concurrency());
+    m_threadPool = std::make_shared<bcos::ThreadPool>(name, bcos::TaskClass::EXECUTION);
     if (m_isWasm)
     {
         initWasmEnvironment();
@@ -479,6 +480,7 @@ void TransactionExecutor::dmcCall(bcos::protocol::ExecutionMessage::UniquePtr in
         // TODO: pass blockHash, version here
         blockContext = createBlockContext(
             number, h256(), 0, 0, std::move(storage));  // TODO: complete the block info
+        blockContext->setIsCall(true);
 
         auto inserted = m_calledContext->emplace(
             std::tuple{input->contextID(), input->seq()}, CallState{blockContext});
@@ -648,6 +650,7 @@ void TransactionExecutor::call(bcos::protocol::ExecutionMessage::UniquePtr input
         // TODO: pass blockHash, version here
         blockContext = createBlockContext(
             number, h256(), 0, 0, std::move(storage));  // TODO: complete the block info
+        blockContext->setIsCall(true);
 
         auto inserted = m_calledContext->emplace(
             std::tuple{input->contextID(), input->seq()}, CallState{blockContext});
@@ -758,8 +761,10 @@ void TransactionExecutor::executeTransactionsInternal(std::string contractAddres
                             << LOG_KV("requestTimestamp", requestTimestamp);
 
     auto callback = [this, useCoroutine, _callback = _callback, requestTimestamp, blockNumber,
-                        txNum, contractAddress](bcos::Error::UniquePtr error,
+                        txNum, contractAddress, spanStart = trace::spanStart()](
+                        bcos::Error::UniquePtr error,
                         std::vector<bcos::protocol::ExecutionMessage::UniquePtr> outputs) {
+        trace::spanEnd(trace::c_executor, "executeTransactions", blockNumber, spanStart, txNum);
         EXECUTOR_NAME_LOG(DEBUG) << BLOCK_NUMBER(blockNumber)
                                  << "executeTransactionsInternal response"
                                  << LOG_KV("useCoroutine", useCoroutine) << LOG_KV("txNum", txNum)
@@ -850,9 +855,11 @@ void TransactionExecutor::executeTransactionsInternal(std::string contractAddres
             [this, startT, useCoroutine, contractAddress, indexes = std::move(indexes),
                 fillInputs = std::move(fillInputs),
                 callParametersList = std::move(callParametersList), callback = std::move(callback),
-                txHashes,
-                blockNumber](Error::Ptr error, protocol::TransactionsPtr transactions) mutable {
+                txHashes, blockNumber, spanStart = trace::spanStart()](
+                Error::Ptr error, protocol::TransactionsPtr transactions) mutable {
                 auto fillTxsT = (utcTime() - startT);
+                trace::spanEnd(
+                    trace::c_txpool, "fillBlock", blockNumber, spanStart, txHashes->size());
 
                 if (!m_isRunning)
                 {
@@ -1492,10 +1499,10 @@ void TransactionExecutor::dagExecuteTransactionsInternal(
                         }
                         else
                         {
-                            EXECUTOR_NAME_LOG(DEBUG)
-                                << LOG_BADGE("dagExecuteTransactionsInternal")
-                                << LOG_DESC("Found ABI in cache") << LOG_KV("address", to)
-                                << LOG_KV("abiKey", toHexStringWithPrefix(abiKey));
+                            EXECUTOR_NAME_ASYNC_LOG(DEBUG,
+                                "[dagExecuteTransactionsInternal]Found ABI in cache,address={},"
+                                "abiKey={}",
+                                to, toHexStringWithPrefix(abiKey));
                             auto& functionAbi = cacheHandle.value();
                             conflictFields =
                                 extractConflictFields(functionAbi, *params, m_blockContext);
@@ -1503,11 +1510,10 @@ void TransactionExecutor::dagExecuteTransactionsInternal(
                     }
                     if (conflictFields == nullptr)
                     {
-                        EXECUTOR_NAME_LOG(DEBUG)
-                            << LOG_BADGE("dagExecuteTransactionsInternal")
-                            << LOG_DESC("The transaction can't be executed concurrently")
-                            << LOG_KV("address", to)
-                            << LOG_KV("abiKey", toHexStringWithPrefix(abiKey));
+                        EXECUTOR_NAME_ASYNC_LOG(DEBUG,
+                            "[dagExecuteTransactionsInternal]The transaction can't be executed "
+                            "concurrently,address={},abiKey={}",
+                            to, toHexStringWithPrefix(abiKey));
                         executionResults[i] = toExecutionResult(std::move(inputs[i]));
                         executionResults[i]->setType(ExecutionMessage::SEND_BACK);
                         continue;
@@ -1590,8 +1596,9 @@ void TransactionExecutor::prepare(
         params.number, params.primaryTableName, params.primaryTableKey, params.timestamp};
 
     m_backendStorage->asyncPrepare(storageParams, *(first->storage),
-        [this, callback = std::move(callback), blockNumber = params.number](
-            auto&& error, uint64_t) {
+        [this, callback = std::move(callback), blockNumber = params.number,
+            spanStart = trace::spanStart()](auto&& error, uint64_t) {
+            trace::spanEnd(trace::c_storage, "executorPrepare", blockNumber, spanStart);
             if (!m_isRunning)
             {
                 callback(BCOS_ERROR_UNIQUE_PTR(
@@ -1653,8 +1660,10 @@ void TransactionExecutor::commit(
     bcos::protocol::TwoPCParams storageParams{
         params.number, params.primaryTableName, params.primaryTableKey, params.timestamp};
     m_backendStorage->asyncCommit(storageParams, [this, callback = std::move(callback),
-                                                     blockNumber = params.number](
+                                                     blockNumber = params.number,
+                                                     spanStart = trace::spanStart()](
                                                      Error::Ptr&& error, uint64_t) {
+        trace::spanEnd(trace::c_storage, "executorCommit", blockNumber, spanStart);
         if (!m_isRunning)
         {
             callback(
@@ -1877,16 +1886,19 @@ ExecutiveFlowInterface::Ptr TransactionExecutor::getExecutiveFlow(
     {
         auto executiveFactory = std::make_shared<ExecutiveFactory>(blockContext,
             m_precompiledContract, m_constantPrecompiled, m_builtInPrecompiled, m_gasInjector);
+        // the calls run on the dedicated pool (if any) to avoid delaying the block execution
+        auto threadPool =
+            (blockContext->isCall() && m_callThreadPool) ? m_callThreadPool : m_threadPool;
         if (!useCoroutine)
         {
             executiveFlow = std::make_shared<ExecutiveSerialFlow>(executiveFactory);
-            executiveFlow->setThreadPool(m_threadPool);
+            executiveFlow->setThreadPool(threadPool);
             blockContext->setExecutiveFlow(codeAddress, executiveFlow);
         }
         else
         {
             executiveFlow = std::make_shared<ExecutiveStackFlow>(executiveFactory);
-            executiveFlow->setThreadPool(m_threadPool);
+            executiveFlow->setThreadPool(threadPool);
             blockContext->setExecutiveFlow(codeAddress, executiveFlow);
         }
     }
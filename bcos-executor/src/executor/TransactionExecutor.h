@@ -168,6 +168,12 @@ public:
     void start() override { m_isRunning = true; }
     void stop() override;
 
+    // run the read-only calls on the given pool instead of the block execution pool
+    void setCallThreadPool(bcos::ThreadPool::Ptr _callThreadPool)
+    {
+        m_callThreadPool = std::move(_callThreadPool);
+    }
+
 protected:
     void executeTransactionsInternal(std::string contractAddress,
         gsl::span<bcos::protocol::ExecutionMessage::UniquePtr> inputs, bool useCoroutine,
@@ -312,6 +318,8 @@ protected:
     int64_t m_schedulerTermId = -1;
 
     bcos::ThreadPool::Ptr m_threadPool;
+    // the pool dedicated to the read-only calls, shared by the executors of all the terms
+    bcos::ThreadPool::Ptr m_callThreadPool;
     void initEvmEnvironment();
     void initWasmEnvironment();
 };
@@ -78,9 +78,22 @@ public:
 
     TransactionExecutor::Ptr build()
     {
-        return std::make_shared<TransactionExecutor>(m_ledger, m_txpool, m_cache, m_storage,
-            m_executionMessageFactory, m_hashImpl, m_isWasm, m_isAuthCheck, m_keyPageSize,
-            m_keyPageIgnoreTables, m_name + "-" + std::to_string(utcTime()));
+        auto executor = std::make_shared<TransactionExecutor>(m_ledger, m_txpool, m_cache,
+            m_storage, m_executionMessageFactory, m_hashImpl, m_isWasm, m_isAuthCheck,
+            m_keyPageSize, m_keyPageIgnoreTables, m_name + "-" + std::to_string(utcTime()));
+        executor->setCallThreadPool(m_callThreadPool);
+        return executor;
+    }
+
+    // 0 means the calls share the block execution threads
+    void setCallThreadCount(size_t _callThreadCount)
+    {
+        if (_callThreadCount == 0)
+        {
+            m_callThreadPool = nullptr;
+            return;
+        }
+        m_callThreadPool = std::make_shared<bcos::ThreadPool>("callExecutor", _callThreadCount);
     }
 
 private:
@@ -95,6 +108,7 @@ private:
     bcos::crypto::Hash::Ptr m_hashImpl;
     bool m_isWasm;
     bool m_isAuthCheck;
+    bcos::ThreadPool::Ptr m_callThreadPool;
 };
 
 }  // namespace executor
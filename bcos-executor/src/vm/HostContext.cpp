@@ -27,6 +27,7 @@
 #include "bcos-table/src/StateStorage.h"
 #include "evmc/evmc.hpp"
 #include <bcos-utilities/Common.h>
+#include <bcos-utilities/Tracer.h>
 #include <evmc/evmc.h>
 #include <evmc/helpers.h>
 #include <boost/algorithm/hex.hpp>
@@ -101,6 +102,7 @@ HostContext::HostContext(CallParameters::UniquePtr callParameters,
 
 std::string HostContext::get(const std::string_view& _key)
 {
+    BCOS_TRACE_SPAN(trace::c_storage, "getRow", blockNumber());
     auto start = utcTimeUs();
     auto entry = m_executive->storage().getRow(m_tableName, _key);
     if (entry)
@@ -318,6 +320,7 @@ VMSchedule const& HostContext::vmSchedule() const
 
 u256 HostContext::store(const u256& _n)
 {
+    BCOS_TRACE_SPAN(trace::c_storage, "store", blockNumber());
     auto start = utcTimeUs();
 
     auto key = toEvmC(_n);
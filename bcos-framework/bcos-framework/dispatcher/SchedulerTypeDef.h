@@ -45,6 +45,7 @@ enum SchedulerError
     Stopped,
     InvalidBlockVersion,
     BlockIsCommitting,
+    CallRateLimited,
 };
 }  // namespace scheduler
 }  // namespace bcos
\ No newline at end of file
@@ -130,6 +130,21 @@ public:
     virtual void getABI(
         std::string_view contract, std::function<void(bcos::Error::Ptr, std::string)> callback) = 0;
 
+    // Batch holds the requests to a remote executor issued by one caller, e.g. a DMC round of a
+    // block, the requests are sent together by flush
+    class Batch
+    {
+    public:
+        using Ptr = std::shared_ptr<Batch>;
+        virtual ~Batch() = default;
+        // the requests issued by the calling thread are held in the batch until leave
+        virtual void enter() = 0;
+        virtual void leave() = 0;
+        virtual void flush() = 0;
+    };
+    // nullptr if the executor sends every request at once
+    virtual Batch::Ptr createBatch() { return nullptr; }
+
     virtual void start(){};
 
     virtual void stop(){};
@@ -79,6 +79,21 @@ public:
     virtual void onReceiveMessage(const std::string& _groupID, bcos::crypto::NodeIDPtr _nodeID,
         bytesConstRef _data, ReceiveMsgFunc _receiveMsgCallback) = 0;
 
+    /**
+     * @brief: receive message from the gateway in the same process, call by gateway
+     * @param _groupID: groupID
+     * @param _nodeID: the node send this message
+     * @param _message: received message data, shared with the modules instead of being copied
+     * @return void
+     */
+    virtual void onReceiveSharedMessage(const std::string& _groupID,
+        bcos::crypto::NodeIDPtr _nodeID, bytesConstPtr _message,
+        ReceiveMsgFunc _receiveMsgCallback)
+    {
+        onReceiveMessage(_groupID, _nodeID, bytesConstRef(_message->data(), _message->size()),
+            _receiveMsgCallback);
+    }
+
     /**
      * @brief: receive broadcast message from gateway, call by gateway
      * @param _groupID: groupID
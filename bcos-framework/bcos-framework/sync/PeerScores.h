@@ -0,0 +1,223 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the network quality of the peers measured by the sync modules
+ * @file PeerScores.h
+ */
+#pragma once
+#include <bcos-crypto/interfaces/crypto/KeyInterface.h>
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <random>
+
+namespace bcos
+{
+namespace sync
+{
+// PeerScores keeps the round-trip time, the throughput and the failure rate of the peers, measured
+// on the request/response pairs of the block sync and the txs sync. Both of them send to the peers
+// with the lower cost first, and share the process-wide instance by default.
+class PeerScores
+{
+public:
+    using Ptr = std::shared_ptr<PeerScores>;
+    struct Score
+    {
+        // the moving averages, rtt in ms and throughput in bytes per ms
+        double rtt = 0;
+        double throughput = 0;
+        double failureRate = 0;
+        uint64_t responses = 0;
+        uint64_t failures = 0;
+    };
+    // the weight of the latest sample in the moving averages
+    constexpr static double c_sampleWeight = 0.2;
+    // the time lost by a failed request, about the time before the request is sent again
+    constexpr static double c_failureCost = 1000;
+    constexpr static double c_maxFailureRate = 0.9;
+    // the peers whose costs differ less than c_costBucket ms are regarded as the same
+    constexpr static double c_costBucket = 10;
+
+    static Ptr const& instance()
+    {
+        static Ptr peerScores = std::make_shared<PeerScores>();
+        return peerScores;
+    }
+
+    // the response of a request is received _rtt ms after the request is sent
+    void onResponse(bcos::crypto::NodeIDPtr const& _peer, uint64_t _rtt)
+    {
+        std::lock_guard<std::mutex> l(x_scores);
+        auto& score = m_scores[_peer->data()];
+        score.rtt = (score.responses == 0) ? _rtt : average(score.rtt, _rtt);
+        score.failureRate = average(score.failureRate, 0);
+        score.responses++;
+    }
+
+    // _bytes of the responses are received in _elapsed ms
+    void onTransfer(bcos::crypto::NodeIDPtr const& _peer, uint64_t _bytes, uint64_t _elapsed)
+    {
+        auto throughput = (double)_bytes / std::max<uint64_t>(_elapsed, 1);
+        std::lock_guard<std::mutex> l(x_scores);
+        auto& score = m_scores[_peer->data()];
+        score.throughput =
+            (score.throughput == 0) ? throughput : average(score.throughput, throughput);
+    }
+
+    // the request is timeout or responded with error
+    void onFailure(bcos::crypto::NodeIDPtr const& _peer)
+    {
+        std::lock_guard<std::mutex> l(x_scores);
+        auto& score = m_scores[_peer->data()];
+        score.failureRate = average(score.failureRate, 1);
+        score.failures++;
+    }
+
+    std::optional<Score> score(bcos::crypto::NodeIDPtr const& _peer) const
+    {
+        std::lock_guard<std::mutex> l(x_scores);
+        auto it = m_scores.find(_peer->data());
+        if (it == m_scores.end())
+        {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    std::map<bcos::bytes, Score> scores() const
+    {
+        std::lock_guard<std::mutex> l(x_scores);
+        return m_scores;
+    }
+
+    // the expected time in ms to receive _bytes from the peer, the peers never measured cost the
+    // median of the measured peers, so that they are tried before the slow peers but don't take
+    // all the requests from the fast ones
+    double cost(bcos::crypto::NodeIDPtr const& _peer, uint64_t _bytes = 0) const
+    {
+        std::lock_guard<std::mutex> l(x_scores);
+        auto it = m_scores.find(_peer->data());
+        if (it == m_scores.end())
+        {
+            return medianCost(_bytes);
+        }
+        return costOf(it->second, _bytes);
+    }
+
+    // order _items by the cost bucket of the peers, the items of the same bucket are shuffled to
+    // spread the load over them, return the end of every bucket
+    template <class T, class NodeIDOf>
+    std::vector<size_t> sortByCost(
+        std::vector<T>& _items, NodeIDOf const& _nodeIDOf, uint64_t _bytes = 0) const
+    {
+        std::vector<std::pair<int64_t, T>> items;
+        items.reserve(_items.size());
+        {
+            std::lock_guard<std::mutex> l(x_scores);
+            std::optional<double> unmeasuredCost;
+            for (auto& item : _items)
+            {
+                auto it = m_scores.find(_nodeIDOf(item)->data());
+                if (it == m_scores.end() && !unmeasuredCost)
+                {
+                    unmeasuredCost = medianCost(_bytes);
+                }
+                auto cost = (it == m_scores.end()) ? *unmeasuredCost : costOf(it->second, _bytes);
+                items.emplace_back((int64_t)(cost / c_costBucket), std::move(item));
+            }
+        }
+        std::stable_sort(items.begin(), items.end(),
+            [](auto const& _lhs, auto const& _rhs) { return _lhs.first < _rhs.first; });
+        std::vector<size_t> bucketEnds;
+        for (size_t i = 0; i < items.size(); i++)
+        {
+            _items[i] = std::move(items[i].second);
+            if (i + 1 == items.size() || items[i + 1].first != items[i].first)
+            {
+                bucketEnds.emplace_back(i + 1);
+            }
+        }
+        shuffleBuckets(_items, bucketEnds);
+        return bucketEnds;
+    }
+
+    // shuffle the items sorted by sortByCost again inside every bucket
+    template <class T>
+    static void shuffleBuckets(std::vector<T>& _items, std::vector<size_t> const& _bucketEnds)
+    {
+        thread_local std::mt19937 random(std::random_device{}());
+        size_t begin = 0;
+        for (auto end : _bucketEnds)
+        {
+            std::shuffle(_items.begin() + begin, _items.begin() + end, random);
+            begin = end;
+        }
+    }
+
+    void sortPeersByCost(bcos::crypto::NodeIDs& _peers, uint64_t _bytes = 0) const
+    {
+        sortByCost(
+            _peers, [](bcos::crypto::NodeIDPtr const& _peer) { return _peer; }, _bytes);
+    }
+
+private:
+    static double average(double _average, double _sample)
+    {
+        return _average + c_sampleWeight * (_sample - _average);
+    }
+
+    static double costOf(Score const& _score, uint64_t _bytes)
+    {
+        auto cost = _score.rtt;
+        if (_bytes > 0 && _score.throughput > 0)
+        {
+            cost += _bytes / _score.throughput;
+        }
+        // every try fails with failureRate, the expected failures before the success are
+        // failureRate / (1 - failureRate)
+        auto failureRate = std::min(_score.failureRate, c_maxFailureRate);
+        return cost + c_failureCost * failureRate / (1 - failureRate);
+    }
+
+    // the median cost of the measured peers, 0 if none is measured, x_scores must be held
+    double medianCost(uint64_t _bytes) const
+    {
+        if (m_scores.empty())
+        {
+            return 0;
+        }
+        std::vector<double> costs;
+        costs.reserve(m_scores.size());
+        for (auto const& it : m_scores)
+        {
+            costs.emplace_back(costOf(it.second, _bytes));
+        }
+        auto middle = costs.begin() + costs.size() / 2;
+        std::nth_element(costs.begin(), middle, costs.end());
+        if (costs.size() % 2 == 1)
+        {
+            return *middle;
+        }
+        // the lower middle one is the largest of the lower half
+        return (*std::max_element(costs.begin(), middle) + *middle) / 2;
+    }
+
+    std::map<bcos::bytes, Score> m_scores;
+    mutable std::mutex x_scores;
+};
+}  // namespace sync
+}  // namespace bcos
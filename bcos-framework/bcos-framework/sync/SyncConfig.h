@@ -22,6 +22,7 @@
 #include <bcos-crypto/interfaces/crypto/KeyInterface.h>
 #include <bcos-framework/consensus/ConsensusNodeInterface.h>
 #include <bcos-framework/protocol/ProtocolTypeDef.h>
+#include <bcos-framework/sync/PeerScores.h>
 namespace bcos
 {
 namespace sync
@@ -123,6 +124,10 @@ public:
         return m_connectedNodeList->count(_nodeId);
     }
 
+    // the network quality of the peers, shared by the block sync and the txs sync
+    PeerScores::Ptr const& peerScores() const { return m_peerScores; }
+    void setPeerScores(PeerScores::Ptr _peerScores) { m_peerScores = std::move(_peerScores); }
+
     bcos::crypto::NodeIDSet groupNodeList()
     {
         ReadGuard l(x_nodeList);
@@ -165,6 +170,8 @@ protected:
 
     bcos::crypto::NodeIDSetPtr m_connectedNodeList;
     mutable SharedMutex x_connectedNodeList;
+
+    PeerScores::Ptr m_peerScores = PeerScores::instance();
 };
 }  // namespace sync
 }  // namespace bcos
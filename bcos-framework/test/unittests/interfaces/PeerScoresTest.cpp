@@ -0,0 +1,145 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief Unit tests for the PeerScores
+ * @file PeerScoresTest.cpp
+ */
+#include "bcos-framework/sync/PeerScores.h"
+#include <bcos-crypto/signature/key/KeyImpl.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+#include <set>
+using namespace bcos;
+using namespace bcos::sync;
+using namespace bcos::crypto;
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(PeerScoresTest, TestPromptFixture)
+BOOST_AUTO_TEST_CASE(testScore)
+{
+    PeerScores peerScores;
+    auto peer = std::make_shared<KeyImpl>(bytes{'a'});
+    BOOST_CHECK(!peerScores.score(peer));
+    BOOST_CHECK_EQUAL(peerScores.cost(peer), 0);
+
+    peerScores.onResponse(peer, 100);
+    BOOST_CHECK_CLOSE(peerScores.score(peer)->rtt, 100, 0.01);
+    peerScores.onResponse(peer, 200);
+    BOOST_CHECK_CLOSE(peerScores.score(peer)->rtt, 120, 0.01);
+    BOOST_CHECK_CLOSE(peerScores.cost(peer), 120, 0.01);
+
+    // 1000 bytes per ms
+    peerScores.onTransfer(peer, 1000000, 1000);
+    BOOST_CHECK_CLOSE(peerScores.score(peer)->throughput, 1000, 0.01);
+    BOOST_CHECK_CLOSE(peerScores.cost(peer, 1000000), 1120, 0.01);
+
+    peerScores.onFailure(peer);
+    auto score = peerScores.score(peer);
+    BOOST_CHECK_EQUAL(score->responses, 2);
+    BOOST_CHECK_EQUAL(score->failures, 1);
+    BOOST_CHECK_CLOSE(score->failureRate, 0.2, 0.01);
+    BOOST_CHECK_CLOSE(peerScores.cost(peer), 120 + PeerScores::c_failureCost * 0.25, 0.01);
+
+    // the peer never responds
+    auto deadPeer = std::make_shared<KeyImpl>(bytes{'b'});
+    for (int i = 0; i < 100; i++)
+    {
+        peerScores.onFailure(deadPeer);
+    }
+    BOOST_CHECK_CLOSE(
+        peerScores.cost(deadPeer), PeerScores::c_failureCost * PeerScores::c_maxFailureRate /
+                                       (1 - PeerScores::c_maxFailureRate),
+        0.01);
+    BOOST_CHECK_EQUAL(peerScores.scores().size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(testSortByCost)
+{
+    PeerScores peerScores;
+    NodeIDs peers;
+    for (char c : std::string("abcde"))
+    {
+        peers.emplace_back(std::make_shared<KeyImpl>(bytes{(byte)c}));
+    }
+    peerScores.onResponse(peers[0], 300);
+    peerScores.onResponse(peers[1], 10);
+    peerScores.onResponse(peers[2], 100);
+    peerScores.onFailure(peers[3]);
+
+    // the peer never measured costs the median of 10, 100, 250 and 300
+    BOOST_CHECK_CLOSE(peerScores.cost(peers[4]), 175, 0.01);
+    auto sorted = peers;
+    peerScores.sortPeersByCost(sorted);
+    BOOST_CHECK(sorted[0] == peers[1]);
+    BOOST_CHECK(sorted[1] == peers[2]);
+    BOOST_CHECK(sorted[2] == peers[4]);
+    BOOST_CHECK(sorted[3] == peers[3]);
+    BOOST_CHECK(sorted[4] == peers[0]);
+
+    // the slow link costs more for the large responses
+    peerScores.onTransfer(peers[1], 1000, 1000);
+    peerScores.onTransfer(peers[2], 100000, 1000);
+    sorted = {peers[1], peers[2]};
+    peerScores.sortPeersByCost(sorted, 100000);
+    BOOST_CHECK(sorted[0] == peers[2]);
+    BOOST_CHECK(sorted[1] == peers[1]);
+}
+
+BOOST_AUTO_TEST_CASE(testSortByCostShuffleTies)
+{
+    PeerScores peerScores;
+    NodeIDs peers;
+    for (char c : std::string("abcdef"))
+    {
+        peers.emplace_back(std::make_shared<KeyImpl>(bytes{(byte)c}));
+    }
+    // peers 0-1 are never measured and cost the median 102.5, 2-3 and 4-5 are in the same cost
+    // bucket
+    peerScores.onResponse(peers[2], 1);
+    peerScores.onResponse(peers[3], 5);
+    peerScores.onResponse(peers[4], 200);
+    peerScores.onResponse(peers[5], 205);
+
+    std::set<NodeIDPtr> firstPeers;
+    std::set<NodeIDPtr> thirdPeers;
+    for (int i = 0; i < 100; i++)
+    {
+        auto sorted = peers;
+        auto bucketEnds = peerScores.sortByCost(
+            sorted, [](NodeIDPtr const& _peer) { return _peer; });
+        BOOST_CHECK(bucketEnds == std::vector<size_t>({2, 4, 6}));
+        BOOST_CHECK(std::set<NodeIDPtr>(sorted.begin(), sorted.begin() + 2) ==
+                    std::set<NodeIDPtr>(peers.begin() + 2, peers.begin() + 4));
+        BOOST_CHECK(std::set<NodeIDPtr>(sorted.begin() + 2, sorted.begin() + 4) ==
+                    std::set<NodeIDPtr>(peers.begin(), peers.begin() + 2));
+        BOOST_CHECK(std::set<NodeIDPtr>(sorted.begin() + 4, sorted.end()) ==
+                    std::set<NodeIDPtr>(peers.begin() + 4, peers.end()));
+        firstPeers.insert(sorted[0]);
+        thirdPeers.insert(sorted[2]);
+
+        // shuffled again inside the buckets
+        PeerScores::shuffleBuckets(sorted, bucketEnds);
+        BOOST_CHECK(std::set<NodeIDPtr>(sorted.begin() + 2, sorted.begin() + 4) ==
+                    std::set<NodeIDPtr>(peers.begin(), peers.begin() + 2));
+    }
+    // the peers of the same cost take turns to go first
+    BOOST_CHECK_EQUAL(firstPeers.size(), 2);
+    BOOST_CHECK_EQUAL(thirdPeers.size(), 2);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -44,6 +44,8 @@ bool FrontMessage::encode(bytes& _buffer)
         return false;
     }
 
+    // encode the large payloads without reallocation
+    _buffer.reserve(HEADER_MIN_LENGTH + uuidLength + m_payload.size());
     _buffer.insert(_buffer.end(), (byte*)&moduleID, (byte*)&moduleID + 2);
     _buffer.insert(_buffer.end(), (byte*)&uuidLength, (byte*)&uuidLength + 1);
     if (uuidLength > 0)
@@ -24,8 +24,6 @@
 #include <bcos-front/FrontService.h>
 #include <bcos-utilities/Common.h>
 #include <bcos-utilities/Exceptions.h>
-#include <boost/uuid/random_generator.hpp>
-#include <boost/uuid/uuid_io.hpp>
 #include <random>
 #include <thread>
 
@@ -35,6 +33,8 @@ using namespace protocol;
 
 FrontService::FrontService()
 {
+    std::random_device randomDevice;
+    m_requestID = ((uint64_t)randomDevice() << 32) | randomDevice();
     m_localProtocol = g_BCOSConfig.protocolInfo(ProtocolModuleID::NodeService);
     FRONT_LOG(INFO) << LOG_DESC("FrontService") << LOG_KV("this", this)
                     << LOG_KV("minVersion", m_localProtocol->minVersion())
@@ -144,11 +144,12 @@ void FrontService::start()
     FRONT_LOG(INFO) << LOG_DESC("start") << LOG_KV("nodeID", m_nodeID->hex())
                     << LOG_KV("groupID", m_groupID);
 
-    FRONT_LOG(INFO) << LOG_DESC("register module")
-                    << LOG_KV("count", m_moduleID2MessageDispatcher.size());
-    for (const auto& module : m_moduleID2MessageDispatcher)
+    for (size_t moduleID = 0; moduleID < m_moduleDispatchers.size(); moduleID++)
     {
-        FRONT_LOG(INFO) << LOG_DESC("register module") << LOG_KV("moduleID", module.first);
+        if (m_moduleDispatchers[moduleID])
+        {
+            FRONT_LOG(INFO) << LOG_DESC("register module") << LOG_KV("moduleID", moduleID);
+        }
     }
 
     return;
@@ -169,7 +170,7 @@ void FrontService::stop()
             for (auto& callback : m_callback)
             {
                 FRONT_LOG(INFO) << LOG_DESC("FrontService stopped, erase the callback")
-                                << LOG_KV("uuid", callback.first);
+                                << LOG_KV("requestID", callback.first);
                 // cancel the timer
                 if (callback.second->timeoutHandler)
                 {
@@ -256,12 +257,12 @@ void FrontService::asyncSendMessageByNodeID(int _moduleID, bcos::crypto::NodeIDP
 {
     try
     {
-        static thread_local auto uuid_gen =
-            boost::uuids::basic_random_generator<std::random_device>();
-        std::string uuid = boost::uuids::to_string(uuid_gen());
+        auto requestID = m_requestID++;
+        auto uuid = requestIDToString(requestID);
         if (_callbackFunc)
         {
             auto callback = std::make_shared<Callback>();
+            callback->nodeID = _nodeID;
             callback->callbackFunc = _callbackFunc;
 
             if (_timeout > 0)
@@ -274,16 +275,16 @@ void FrontService::asyncSendMessageByNodeID(int _moduleID, bcos::crypto::NodeIDP
                 auto frontServiceWeakPtr = std::weak_ptr<FrontService>(shared_from_this());
                 // callback->startTime = utcSteadyTime();
                 timeoutHandler->async_wait(
-                    [frontServiceWeakPtr, _nodeID, uuid](const boost::system::error_code& e) {
+                    [frontServiceWeakPtr, _nodeID, requestID](const boost::system::error_code& e) {
                         auto frontService = frontServiceWeakPtr.lock();
                         if (frontService)
                         {
-                            frontService->onMessageTimeout(e, _nodeID, uuid);
+                            frontService->onMessageTimeout(e, _nodeID, requestID);
                         }
                     });
             }
 
-            addCallback(uuid, callback);
+            addCallback(requestID, callback);
 
             FRONT_LOG(DEBUG) << LOG_DESC("asyncSendMessageByNodeID") << LOG_KV("groupID", m_groupID)
                              << LOG_KV("moduleID", _moduleID) << LOG_KV("uuid", uuid)
@@ -300,7 +301,7 @@ void FrontService::asyncSendMessageByNodeID(int _moduleID, bcos::crypto::NodeIDP
                                      << LOG_KV("errorCode", _error->errorCode())
                                      << LOG_KV("errorMessage", _error->errorMessage());
                 */
-                    handleCallback(_error, bytesConstRef(), uuid, _moduleID, _nodeID);
+                    handleCallback(_error, nullptr, bytesConstRef(), uuid, _moduleID, _nodeID);
                 }
             });
     }
@@ -456,13 +457,61 @@ void FrontService::notifyGroupNodeInfo(
     }
 }
 
-void FrontService::handleCallback(bcos::Error::Ptr _error, bytesConstRef _payLoad,
-    std::string const& _uuid, int _moduleID, bcos::crypto::NodeIDPtr _nodeID)
+std::string FrontService::requestIDToString(uint64_t _requestID)
+{
+    std::string uuid(sizeof(_requestID) * 2, '0');
+    static const char* c_hexChars = "0123456789abcdef";
+    for (size_t i = uuid.size(); i > 0; --i)
+    {
+        uuid[i - 1] = c_hexChars[_requestID & 0xf];
+        _requestID >>= 4;
+    }
+    return uuid;
+}
+
+std::optional<uint64_t> FrontService::requestIDFromString(std::string_view _uuid)
+{
+    if (_uuid.size() != sizeof(uint64_t) * 2)
+    {
+        return std::nullopt;
+    }
+    uint64_t requestID = 0;
+    for (auto c : _uuid)
+    {
+        uint64_t value = 0;
+        if (c >= '0' && c <= '9')
+        {
+            value = c - '0';
+        }
+        else if (c >= 'a' && c <= 'f')
+        {
+            value = c - 'a' + 10;
+        }
+        else
+        {
+            return std::nullopt;
+        }
+        requestID = (requestID << 4) | value;
+    }
+    return requestID;
+}
+
+void FrontService::handleCallback(bcos::Error::Ptr _error, bytesConstPtr _message,
+    bytesConstRef _payLoad, std::string const& _uuid, int _moduleID,
+    bcos::crypto::NodeIDPtr _nodeID)
 {
-    // callback message
-    auto callback = getAndRemoveCallback(_uuid);
+    auto requestID = requestIDFromString(_uuid);
+    if (!requestID)
+    {
+        return;
+    }
+    // callback message, the request ids are predictable, so the responses from the nodes other
+    // than the one requested are dropped
+    auto callback = getAndRemoveCallback(*requestID, _nodeID);
     if (!callback)
     {
+        FRONT_LOG(DEBUG) << LOG_DESC("handleCallback: no request matches the response")
+                         << LOG_KV("uuid", _uuid);
         return;
     }
     auto frontServiceWeakPtr = std::weak_ptr<FrontService>(shared_from_this());
@@ -490,12 +539,9 @@ void FrontService::handleCallback(bcos::Error::Ptr _error, bytesConstRef _payLoa
 
     if (m_threadPool)
     {
-        // construct shared_ptr<bytes> from message->payload() first for
-        // thead safe
-        std::shared_ptr<bytes> buffer = std::make_shared<bytes>(_payLoad.begin(), _payLoad.end());
-        m_threadPool->enqueue([_uuid, _error, callback, buffer, _nodeID, respFunc] {
-            callback->callbackFunc(
-                _error, _nodeID, bytesConstRef(buffer->data(), buffer->size()), _uuid, respFunc);
+        // the payload is kept alive by _message
+        m_threadPool->enqueue([_uuid, _error, callback, _message, _payLoad, _nodeID, respFunc] {
+            callback->callbackFunc(_error, _nodeID, _payLoad, _uuid, respFunc);
         });
     }
     else
@@ -513,6 +559,49 @@ void FrontService::handleCallback(bcos::Error::Ptr _error, bytesConstRef _payLoa
  */
 void FrontService::onReceiveMessage(const std::string& _groupID, bcos::crypto::NodeIDPtr _nodeID,
     bytesConstRef _data, ReceiveMsgFunc _receiveMsgCallback)
+{
+    FRONT_LOG(TRACE) << LOG_BADGE("onReceiveMessage") << LOG_KV("groupID", _groupID)
+                     << LOG_KV("nodeID", _nodeID->hex()) << LOG_KV("length", _data.size());
+    if (m_threadPool)
+    {
+        // _data is only valid in this call, copy it for the thread pool
+        auto message = std::make_shared<bytes const>(_data.begin(), _data.end());
+        dispatchMessage(_nodeID, message, bytesConstRef(message->data(), message->size()));
+    }
+    else
+    {
+        dispatchMessage(_nodeID, nullptr, _data);
+    }
+    onMessageDispatched(_receiveMsgCallback);
+}
+
+void FrontService::onReceiveSharedMessage(const std::string& _groupID,
+    bcos::crypto::NodeIDPtr _nodeID, bytesConstPtr _message, ReceiveMsgFunc _receiveMsgCallback)
+{
+    FRONT_LOG(TRACE) << LOG_BADGE("onReceiveSharedMessage") << LOG_KV("groupID", _groupID)
+                     << LOG_KV("nodeID", _nodeID->hex()) << LOG_KV("length", _message->size());
+    dispatchMessage(_nodeID, _message, bytesConstRef(_message->data(), _message->size()));
+    onMessageDispatched(_receiveMsgCallback);
+}
+
+void FrontService::onMessageDispatched(ReceiveMsgFunc _receiveMsgCallback)
+{
+    if (!_receiveMsgCallback)
+    {
+        return;
+    }
+    if (m_threadPool)
+    {
+        m_threadPool->enqueue([_receiveMsgCallback]() { _receiveMsgCallback(nullptr); });
+    }
+    else
+    {
+        _receiveMsgCallback(nullptr);
+    }
+}
+
+void FrontService::dispatchMessage(
+    bcos::crypto::NodeIDPtr _nodeID, bytesConstPtr _message, bytesConstRef _data)
 {
     try
     {
@@ -531,57 +620,36 @@ void FrontService::onReceiveMessage(const std::string& _groupID, bcos::crypto::N
 
         FRONT_LOG(TRACE) << LOG_BADGE("onReceiveMessage") << LOG_KV("moduleID", moduleID)
                          << LOG_KV("uuid", uuid) << LOG_KV("ext", ext)
-                         << LOG_KV("groupID", _groupID) << LOG_KV("nodeID", _nodeID->hex())
-                         << LOG_KV("length", _data.size());
+                         << LOG_KV("nodeID", _nodeID->hex()) << LOG_KV("length", _data.size());
 
         if (message->isResponse())
         {
-            handleCallback(nullptr, message->payload(), uuid, moduleID, _nodeID);
+            handleCallback(nullptr, _message, message->payload(), uuid, moduleID, _nodeID);
+            return;
         }
-        else
+        if ((size_t)moduleID >= m_moduleDispatchers.size() || !m_moduleDispatchers[moduleID])
         {
-            auto it = m_moduleID2MessageDispatcher.find(moduleID);
-            if (it != m_moduleID2MessageDispatcher.end())
-            {
-                if (m_threadPool)
-                {
-                    auto callback = it->second;
-                    // construct shared_ptr<bytes> from message->payload() first for
-                    // thead safe
-                    std::shared_ptr<bytes> buffer = std::make_shared<bytes>(
-                        message->payload().begin(), message->payload().end());
-                    m_threadPool->enqueue([uuid, callback, buffer, message, _nodeID] {
-                        callback(_nodeID, uuid, bytesConstRef(buffer->data(), buffer->size()));
-                    });
-                }
-                else
-                {
-                    it->second(_nodeID, uuid, message->payload());
-                }
-            }
-            else
-            {
-                FRONT_LOG(WARNING) << LOG_DESC("unable find the register module message dispather")
-                                   << LOG_KV("moduleID", moduleID) << LOG_KV("uuid", uuid);
-            }
+            FRONT_LOG(WARNING) << LOG_DESC("unable find the register module message dispather")
+                               << LOG_KV("moduleID", moduleID) << LOG_KV("uuid", uuid);
+            return;
         }
-    }
-    catch (const std::exception& e)
-    {
-        FRONT_LOG(ERROR) << "onReceiveMessage" << LOG_KV("error", boost::diagnostic_information(e));
-    }
-
-    if (_receiveMsgCallback)
-    {
+        auto const& dispatcher = m_moduleDispatchers[moduleID];
         if (m_threadPool)
         {
-            m_threadPool->enqueue([_receiveMsgCallback]() { _receiveMsgCallback(nullptr); });
+            // the payload is kept alive by _message
+            m_threadPool->enqueue([uuid = std::move(uuid), dispatcher, _message,
+                                      payload = message->payload(),
+                                      _nodeID] { (*dispatcher)(_nodeID, uuid, payload); });
         }
         else
         {
-            _receiveMsgCallback(nullptr);
+            (*dispatcher)(_nodeID, uuid, message->payload());
         }
     }
+    catch (const std::exception& e)
+    {
+        FRONT_LOG(ERROR) << "onReceiveMessage" << LOG_KV("error", boost::diagnostic_information(e));
+    }
 }
 
 /**
@@ -637,42 +705,43 @@ void FrontService::sendMessage(int _moduleID, bcos::crypto::NodeIDPtr _nodeID,
 /**
  * @brief: handle message timeout
  * @param _error: boost error code
- * @param _uuid: message uuid
+ * @param _requestID: the id of the request
  * @return void
  */
 void FrontService::onMessageTimeout(const boost::system::error_code& _error,
-    bcos::crypto::NodeIDPtr _nodeID, const std::string& _uuid)
+    bcos::crypto::NodeIDPtr _nodeID, uint64_t _requestID)
 {
     if (_error)
     {
         return;
     }
 
+    auto uuid = requestIDToString(_requestID);
     try
     {
-        Callback::Ptr callback = getAndRemoveCallback(_uuid);
+        Callback::Ptr callback = getAndRemoveCallback(_requestID);
         if (callback)
         {
             auto errorPtr = std::make_shared<Error>(CommonError::TIMEOUT, "timeout");
             if (m_threadPool)
             {
-                m_threadPool->enqueue([_uuid, _nodeID, callback, errorPtr]() {
-                    callback->callbackFunc(errorPtr, _nodeID, bytesConstRef(), _uuid,
+                m_threadPool->enqueue([uuid, _nodeID, callback, errorPtr]() {
+                    callback->callbackFunc(errorPtr, _nodeID, bytesConstRef(), uuid,
                         std::function<void(bytesConstRef)>());
                 });
             }
             else
             {
-                callback->callbackFunc(errorPtr, _nodeID, bytesConstRef(), _uuid,
+                callback->callbackFunc(errorPtr, _nodeID, bytesConstRef(), uuid,
                     std::function<void(bytesConstRef)>());
             }
         }
 
-        FRONT_LOG(WARNING) << LOG_BADGE("onMessageTimeout") << LOG_KV("uuid", _uuid);
+        FRONT_LOG(WARNING) << LOG_BADGE("onMessageTimeout") << LOG_KV("uuid", uuid);
     }
     catch (std::exception& e)
     {
-        FRONT_LOG(ERROR) << "onMessageTimeout" << LOG_KV("uuid", _uuid)
+        FRONT_LOG(ERROR) << "onMessageTimeout" << LOG_KV("uuid", uuid)
                          << LOG_KV("error", boost::diagnostic_information(e));
     }
 }
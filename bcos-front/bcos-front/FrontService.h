@@ -24,8 +24,11 @@
 #include <bcos-framework/gateway/GatewayInterface.h>
 #include <bcos-framework/gateway/GroupNodeInfo.h>
 #include <bcos-utilities/Common.h>
+#include <bcos-utilities/Exceptions.h>
 #include <bcos-utilities/ThreadPool.h>
 #include <boost/asio.hpp>
+#include <atomic>
+#include <optional>
 
 namespace bcos
 {
@@ -35,6 +38,8 @@ class FrontService : public FrontServiceInterface, public std::enable_shared_fro
 {
 public:
     using Ptr = std::shared_ptr<FrontService>;
+    using MessageDispatcher = std::function<void(
+        bcos::crypto::NodeIDPtr _nodeID, const std::string& _id, bytesConstRef _data)>;
 
     FrontService();
     FrontService(const FrontService&) = delete;
@@ -122,6 +127,18 @@ public:
     void onReceiveMessage(const std::string& _groupID, bcos::crypto::NodeIDPtr _nodeID,
         bytesConstRef _data, ReceiveMsgFunc _receiveMsgCallback) override;
 
+    /**
+     * @brief: receive message from the gateway in the same process, the message is decoded in
+     * place and its payload is passed to the module without copy
+     * @param _groupID: groupID
+     * @param _nodeID: the node send the message
+     * @param _message: received message data
+     * @param _receiveMsgCallback: response callback
+     * @return void
+     */
+    void onReceiveSharedMessage(const std::string& _groupID, bcos::crypto::NodeIDPtr _nodeID,
+        bytesConstPtr _message, ReceiveMsgFunc _receiveMsgCallback) override;
+
     /**
      * @brief: receive broadcast message from gateway
      * @param _groupID: groupID
@@ -149,11 +166,11 @@ public:
     /**
      * @brief: handle message timeout
      * @param _error: boost error code
-     * @param _uuid: message uuid
+     * @param _requestID: the id of the request
      * @return void
      */
     void onMessageTimeout(const boost::system::error_code& _error, bcos::crypto::NodeIDPtr _nodeID,
-        const std::string& _uuid);
+        uint64_t _requestID);
 
 public:
     FrontMessageFactory::Ptr messageFactory() const { return m_messageFactory; }
@@ -184,21 +201,33 @@ public:
     bcos::ThreadPool::Ptr threadPool() const { return m_threadPool; }
     void setThreadPool(bcos::ThreadPool::Ptr _threadPool) { m_threadPool = _threadPool; }
 
-    // register message _dispatcher for module
-    void registerModuleMessageDispatcher(int _moduleID,
-        std::function<void(
-            bcos::crypto::NodeIDPtr _nodeID, const std::string& _id, bytesConstRef _data)>
-            _dispatcher)
+    // register message _dispatcher for module, all the modules should be registered before start
+    void registerModuleMessageDispatcher(int _moduleID, MessageDispatcher _dispatcher)
     {
-        m_moduleID2MessageDispatcher[_moduleID] = _dispatcher;
+        if (_moduleID < 0 || _moduleID > UINT16_MAX)
+        {
+            BOOST_THROW_EXCEPTION(InvalidParameter() << errinfo_comment(
+                                      "invalid moduleID " + std::to_string(_moduleID)));
+        }
+        if ((size_t)_moduleID >= m_moduleDispatchers.size())
+        {
+            m_moduleDispatchers.resize(_moduleID + 1);
+        }
+        m_moduleDispatchers[_moduleID] = std::make_shared<MessageDispatcher>(std::move(_dispatcher));
     }
 
     // only for ut
-    std::unordered_map<int,
-        std::function<void(bcos::crypto::NodeIDPtr, const std::string&, bytesConstRef)>>
-    moduleID2MessageDispatcher() const
+    std::unordered_map<int, MessageDispatcher> moduleID2MessageDispatcher() const
     {
-        return m_moduleID2MessageDispatcher;
+        std::unordered_map<int, MessageDispatcher> moduleID2MessageDispatcher;
+        for (size_t moduleID = 0; moduleID < m_moduleDispatchers.size(); moduleID++)
+        {
+            if (m_moduleDispatchers[moduleID])
+            {
+                moduleID2MessageDispatcher[moduleID] = *m_moduleDispatchers[moduleID];
+            }
+        }
+        return moduleID2MessageDispatcher;
     }
 
     // only for ut
@@ -221,24 +250,35 @@ public:
     {
         using Ptr = std::shared_ptr<Callback>;
         uint64_t startTime = utcSteadyTime();
+        // the node the request is sent to, only its response is accepted
+        bcos::crypto::NodeIDPtr nodeID;
         CallbackFunc callbackFunc;
         std::shared_ptr<boost::asio::deadline_timer> timeoutHandler;
     };
     // lock m_callback
     mutable bcos::RecursiveMutex x_callback;
-    // uuid to callback
-    std::unordered_map<std::string, Callback::Ptr> m_callback;
+    // request id to callback
+    std::unordered_map<uint64_t, Callback::Ptr> m_callback;
 
     // only for ut
-    std::unordered_map<std::string, Callback::Ptr> callback() const { return m_callback; }
+    std::unordered_map<std::string, Callback::Ptr> callback() const
+    {
+        RecursiveGuard l(x_callback);
+        std::unordered_map<std::string, Callback::Ptr> callbacks;
+        for (auto const& it : m_callback)
+        {
+            callbacks[requestIDToString(it.first)] = it.second;
+        }
+        return callbacks;
+    }
 
-    Callback::Ptr getAndRemoveCallback(const std::string& _uuid)
+    Callback::Ptr getAndRemoveCallback(uint64_t _requestID)
     {
         Callback::Ptr callback = nullptr;
 
         {
             RecursiveGuard l(x_callback);
-            auto it = m_callback.find(_uuid);
+            auto it = m_callback.find(_requestID);
             if (it != m_callback.end())
             {
                 callback = it->second;
@@ -249,15 +289,41 @@ public:
         return callback;
     }
 
-    void addCallback(const std::string& _uuid, Callback::Ptr _callback)
+    // remove the callback only if the response is from the node the request is sent to
+    Callback::Ptr getAndRemoveCallback(uint64_t _requestID, bcos::crypto::NodeIDPtr const& _nodeID)
     {
         RecursiveGuard l(x_callback);
-        m_callback[_uuid] = _callback;
+        auto it = m_callback.find(_requestID);
+        if (it == m_callback.end() || !_nodeID || !it->second->nodeID ||
+            it->second->nodeID->data() != _nodeID->data())
+        {
+            return nullptr;
+        }
+        auto callback = it->second;
+        m_callback.erase(it);
+        return callback;
     }
 
+    void addCallback(uint64_t _requestID, Callback::Ptr _callback)
+    {
+        RecursiveGuard l(x_callback);
+        m_callback[_requestID] = _callback;
+    }
+
+    // the request id is sent as the uuid of the message, in the fixed length hex
+    static std::string requestIDToString(uint64_t _requestID);
+    // the uuids not issued by requestIDToString, such as the uuids of the old nodes, are not
+    // request ids
+    static std::optional<uint64_t> requestIDFromString(std::string_view _uuid);
+
 protected:
-    virtual void handleCallback(bcos::Error::Ptr _error, bytesConstRef _payLoad,
-        std::string const& _uuid, int _moduleID, bcos::crypto::NodeIDPtr _nodeID);
+    virtual void handleCallback(bcos::Error::Ptr _error, bytesConstPtr _message,
+        bytesConstRef _payLoad, std::string const& _uuid, int _moduleID,
+        bcos::crypto::NodeIDPtr _nodeID);
+    // decode the message in place, _message owns _data if not null
+    void dispatchMessage(bcos::crypto::NodeIDPtr _nodeID, bytesConstPtr _message,
+        bytesConstRef _data);
+    void onMessageDispatched(ReceiveMsgFunc _receiveMsgCallback);
     void notifyGroupNodeInfo(
         const std::string& _groupID, bcos::gateway::GroupNodeInfo::Ptr _groupNodeInfo);
 
@@ -273,9 +339,11 @@ private:
 
     FrontMessageFactory::Ptr m_messageFactory;
 
-    std::unordered_map<int, std::function<void(bcos::crypto::NodeIDPtr _nodeID,
-                                const std::string& _id, bytesConstRef _data)>>
-        m_moduleID2MessageDispatcher;
+    // the message dispatchers indexed by the moduleID
+    std::vector<std::shared_ptr<MessageDispatcher>> m_moduleDispatchers;
+    // the id of the next request, starts from a random number so that the responses to the
+    // requests sent before restart are not taken as the responses to the new requests
+    std::atomic<uint64_t> m_requestID;
 
     std::unordered_map<int, std::function<void(bcos::gateway::GroupNodeInfo::Ptr _groupNodeInfo,
                                 ReceiveMsgFunc _receiveMsgCallback)>>
@@ -320,4 +320,105 @@ BOOST_AUTO_TEST_CASE(testFrontService_loopTimeout)
     BOOST_CHECK(frontService->callback().empty());
 }
 
+BOOST_AUTO_TEST_CASE(testFrontService_onReceiveSharedMessage)
+{
+    auto frontService = buildFrontService();
+    auto srcNodeID = createKey(g_dstNodeID_0);
+    std::string data(1000, 'x');
+    int moduleID = 2000;
+
+    auto message = frontService->messageFactory()->buildMessage();
+    message->setModuleID(moduleID);
+    message->setUuid(std::make_shared<bytes>(36, 'u'));
+    message->setPayload(bytesConstRef((unsigned char*)data.data(), data.size()));
+    auto buffer = std::make_shared<bytes>();
+    message->encode(*buffer);
+
+    std::promise<bool> p;
+    auto f = p.get_future();
+    bytesConstPtr sharedBuffer = buffer;
+    frontService->registerModuleMessageDispatcher(moduleID,
+        [&p, sharedBuffer, data](bcos::crypto::NodeIDPtr, const std::string& _id,
+            bytesConstRef _data) {
+            BOOST_CHECK_EQUAL(_id, std::string(36, 'u'));
+            BOOST_CHECK_EQUAL(std::string(_data.begin(), _data.end()), data);
+            // the payload is not copied
+            BOOST_CHECK(_data.data() >= sharedBuffer->data() &&
+                        _data.data() + _data.size() == sharedBuffer->data() + sharedBuffer->size());
+            p.set_value(true);
+        });
+    frontService->onReceiveSharedMessage(g_groupID, srcNodeID, buffer, nullptr);
+    f.get();
+}
+
+BOOST_AUTO_TEST_CASE(testFrontService_requestID)
+{
+    for (uint64_t requestID : {(uint64_t)0, (uint64_t)0x1234abcd, UINT64_MAX})
+    {
+        auto uuid = FrontService::requestIDToString(requestID);
+        BOOST_CHECK_EQUAL(uuid.size(), 16);
+        BOOST_CHECK_EQUAL(FrontService::requestIDFromString(uuid).value(), requestID);
+    }
+    // the uuids of the old nodes
+    BOOST_CHECK(!FrontService::requestIDFromString("6ba7b810-9dad-11d1-80b4-00c04fd430c8"));
+    BOOST_CHECK(!FrontService::requestIDFromString("000000000000000g"));
+
+    // the responses to the requests not sent are ignored
+    auto frontService = buildFrontService();
+    auto dstNodeID = createKey(g_dstNodeID_0);
+    std::string data(100, '#');
+    int moduleID = 12345;
+    std::promise<bool> p;
+    auto f = p.get_future();
+    frontService->asyncSendMessageByNodeID(moduleID, dstNodeID,
+        bytesConstRef((unsigned char*)data.data(), data.size()), 0,
+        [&p](Error::Ptr _error, bcos::crypto::NodeIDPtr, bytesConstRef, const std::string&,
+            std::function<void(bytesConstRef)>) {
+            BOOST_CHECK(_error == nullptr);
+            p.set_value(true);
+        });
+    BOOST_REQUIRE_EQUAL(frontService->callback().size(), 1);
+    auto uuid = frontService->callback().begin()->first;
+    auto otherUuid = FrontService::requestIDToString(
+        FrontService::requestIDFromString(uuid).value() + 1);
+    frontService->asyncSendResponse(otherUuid, moduleID, dstNodeID,
+        bytesConstRef((unsigned char*)data.data(), data.size()), nullptr);
+    BOOST_CHECK_EQUAL(frontService->callback().size(), 1);
+    frontService->asyncSendResponse(uuid, moduleID, dstNodeID,
+        bytesConstRef((unsigned char*)data.data(), data.size()), nullptr);
+    f.get();
+    BOOST_CHECK(frontService->callback().empty());
+}
+
+BOOST_AUTO_TEST_CASE(testFrontService_responseFromOtherNode)
+{
+    auto frontService = buildFrontService();
+    auto dstNodeID = createKey(g_dstNodeID_0);
+    auto otherNodeID = createKey(g_dstNodeID_1);
+    std::string data(100, '#');
+    std::string forgedData(100, '!');
+    int moduleID = 12345;
+    std::promise<std::string> p;
+    auto f = p.get_future();
+    frontService->asyncSendMessageByNodeID(moduleID, dstNodeID,
+        bytesConstRef((unsigned char*)data.data(), data.size()), 0,
+        [&p](Error::Ptr _error, bcos::crypto::NodeIDPtr, bytesConstRef _data, const std::string&,
+            std::function<void(bytesConstRef)>) {
+            BOOST_CHECK(_error == nullptr);
+            p.set_value(std::string(_data.begin(), _data.end()));
+        });
+    BOOST_REQUIRE_EQUAL(frontService->callback().size(), 1);
+    auto uuid = frontService->callback().begin()->first;
+    // the response with the right id but from another node is ignored
+    frontService->asyncSendResponse(uuid, moduleID, otherNodeID,
+        bytesConstRef((unsigned char*)forgedData.data(), forgedData.size()), nullptr);
+    BOOST_CHECK_EQUAL(frontService->callback().size(), 1);
+    BOOST_CHECK(f.wait_for(std::chrono::milliseconds(100)) == std::future_status::timeout);
+
+    frontService->asyncSendResponse(uuid, moduleID, dstNodeID,
+        bytesConstRef((unsigned char*)data.data(), data.size()), nullptr);
+    BOOST_CHECK_EQUAL(f.get(), data);
+    BOOST_CHECK(frontService->callback().empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -373,12 +373,12 @@ void Gateway::asyncSendBroadcastMessage(uint16_t _type, const std::string& _grou
  * @param _groupID: groupID
  * @param _srcNodeID: the sender nodeID
  * @param _dstNodeID: the receiver nodeID
- * @param _payload: message content
+ * @param _payload: message content, shared with the front service without copy
  * @param _callback: callback
  * @return void
  */
 void Gateway::onReceiveP2PMessage(const std::string& _groupID, NodeIDPtr _srcNodeID,
-    NodeIDPtr _dstNodeID, bytesConstRef _payload, ErrorRespFunc _errorRespFunc)
+    NodeIDPtr _dstNodeID, bytesConstPtr _payload, ErrorRespFunc _errorRespFunc)
 {
     auto frontService =
         m_gatewayNodeManager->localRouterTable()->getFrontService(_groupID, _dstNodeID);
@@ -402,7 +402,7 @@ void Gateway::onReceiveP2PMessage(const std::string& _groupID, NodeIDPtr _srcNod
         return;
     }
 
-    frontService->frontService()->onReceiveMessage(_groupID, _srcNodeID, _payload,
+    frontService->frontService()->onReceiveSharedMessage(_groupID, _srcNodeID, _payload,
         [_groupID, _srcNodeID, _dstNodeID, _errorRespFunc](Error::Ptr _error) {
             if (_errorRespFunc)
             {
@@ -453,98 +453,35 @@ bool Gateway::checkBWRateLimit(ratelimit::RateLimiterManager::Ptr _rateLimiterMa
     std::string errorMsg;
     do
     {
-        // total outgoing bandwidth
-        ratelimit::BWRateLimiterInterface::Ptr totalOutGoingBWLimit =
-            _rateLimiterManager->getRateLimiter(ratelimit::RateLimiterManager::TOTAL_OUTGOING_KEY);
-
-        // connection outgoing bandwidth
-        ratelimit::BWRateLimiterInterface::Ptr connOutGoingBWLimit =
-            _rateLimiterManager->getConnRateLimiter(endPoint);
-
-        // group outgoing bandwidth
-        ratelimit::BWRateLimiterInterface::Ptr groupOutGoingBWLimit = nullptr;
-        if (!groupID.empty())
+        // acquire the permits from total -> group -> connection -> module in one pass
+        // Note: the p2p network itself's message (moduleID is zero) and the message of the modules
+        // without bandwidth limit are not limited, the permits are acquired just for statistic
+        auto overflowLevel =
+            _rateLimiterManager->tryAcquire(endPoint, groupID, moduleID, (int64_t)msgLength);
+        if (overflowLevel == ratelimit::RateLimitLevel::Total)
         {
-            groupOutGoingBWLimit = _rateLimiterManager->getGroupRateLimiter(groupID);
+            // total outgoing bandwidth overflow
+            errorMsg = "the network total outgoing bandwidth overflow";
+            break;
         }
-
-        auto modulesWithNoBwLimit = _rateLimiterManager->modulesWithNoBwLimit();
-
-        // if moduleID is zero, the P2P network itself's message, the ratelimiter does not limit
-        // P2P own's messages
-        if (moduleID == 0)
+        if (overflowLevel == ratelimit::RateLimitLevel::Group)
         {
-            if (totalOutGoingBWLimit)
-            {
-                totalOutGoingBWLimit->tryAcquire(msgLength);
-            }
-
-            if (connOutGoingBWLimit)
-            {
-                connOutGoingBWLimit->tryAcquire(msgLength);
-            }
+            // group outgoing bandwidth overflow
+            errorMsg = "the group outgoing bandwidth overflow, groupID: " + groupID;
+            break;
         }
-        // if moduleID is not zero, the message comes from the front
-        // There are two scenarios:
-        //  1. ulimit module message rate or
-        //  2. limit module message rate
-        else if (modulesWithNoBwLimit.count(moduleID))
-        {  // case 1: ulimit module message rate or, just for statistic
-
-            if (totalOutGoingBWLimit)
-            {
-                totalOutGoingBWLimit->tryAcquire(msgLength);
-            }
-
-            if (connOutGoingBWLimit)
-            {
-                connOutGoingBWLimit->tryAcquire(msgLength);
-            }
-
-            if (groupOutGoingBWLimit)
-            {
-                groupOutGoingBWLimit->tryAcquire(msgLength);
-            }
+        if (overflowLevel == ratelimit::RateLimitLevel::Conn)
+        {
+            // connection outgoing bandwidth overflow
+            errorMsg = "the network connection outgoing bandwidth overflow, endpoint: " + endPoint;
+            break;
         }
-        else
-        {  // case 2: limit module message rate
-
-            if (totalOutGoingBWLimit && !totalOutGoingBWLimit->tryAcquire(msgLength))
-            {
-                // total outgoing bandwidth overflow
-                errorMsg = "the network total outgoing bandwidth overflow";
-                break;
-            }
-
-            if (connOutGoingBWLimit && !connOutGoingBWLimit->tryAcquire(msgLength))
-            {
-                // connection outgoing bandwidth overflow
-                errorMsg =
-                    "the network connection outgoing bandwidth overflow, endpoint: " + endPoint;
-                if (totalOutGoingBWLimit)
-                {
-                    totalOutGoingBWLimit->rollback(msgLength);
-                }
-
-                break;
-            }
-
-            if (groupOutGoingBWLimit && !groupOutGoingBWLimit->tryAcquire(msgLength))
-            {
-                // group outgoing bandwidth overflow
-                errorMsg = "the group outgoing bandwidth overflow, groupID: " + groupID;
-                if (totalOutGoingBWLimit)
-                {
-                    totalOutGoingBWLimit->rollback(msgLength);
-                }
-
-                if (connOutGoingBWLimit)
-                {
-                    connOutGoingBWLimit->rollback(msgLength);
-                }
-
-                break;
-            }
+        if (overflowLevel == ratelimit::RateLimitLevel::Module)
+        {
+            // module outgoing bandwidth overflow
+            errorMsg = "the module outgoing bandwidth overflow, moduleID: " +
+                       std::to_string(moduleID);
+            break;
         }
 
         m_rateStatistics->updateOutGoing(endPoint, msgLength, true);
@@ -615,7 +552,6 @@ void Gateway::onReceiveP2PMessage(
 
     auto options = _msg->options();
     auto msgPayload = _msg->payload();
-    auto payload = bytesConstRef(msgPayload->data(), msgPayload->size());
     // groupID
     auto groupID = options->groupID();
     // moduleID
@@ -647,7 +583,7 @@ void Gateway::onReceiveP2PMessage(
     auto srcNodeIDPtr = m_gatewayNodeManager->keyFactory()->createKey(*srcNodeID.get());
     auto dstNodeIDPtr = m_gatewayNodeManager->keyFactory()->createKey(*dstNodeIDs[0].get());
     auto gateway = std::weak_ptr<Gateway>(shared_from_this());
-    onReceiveP2PMessage(groupID, srcNodeIDPtr, dstNodeIDPtr, payload,
+    onReceiveP2PMessage(groupID, srcNodeIDPtr, dstNodeIDPtr, msgPayload,
         [groupID, srcNodeIDPtr, dstNodeIDPtr, _session, _msg, gateway](Error::Ptr _error) {
             auto gatewayPtr = gateway.lock();
             if (!gatewayPtr)
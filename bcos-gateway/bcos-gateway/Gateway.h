@@ -133,13 +133,13 @@ public:
      * @param _groupID: groupID
      * @param _srcNodeID: the sender nodeID
      * @param _dstNodeID: the receiver nodeID
-     * @param _payload: message content
+     * @param _payload: message content, shared with the front service without copy
      * @param _errorRespFunc: error func
      * @return void
      */
     virtual void onReceiveP2PMessage(const std::string& _groupID,
         bcos::crypto::NodeIDPtr _srcNodeID, bcos::crypto::NodeIDPtr _dstNodeID,
-        bytesConstRef _payload, ErrorRespFunc _errorRespFunc = ErrorRespFunc());
+        bytesConstPtr _payload, ErrorRespFunc _errorRespFunc = ErrorRespFunc());
 
 
     P2PInterface::Ptr p2pInterface() const { return m_p2pInterface; }
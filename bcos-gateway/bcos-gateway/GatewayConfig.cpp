@@ -384,6 +384,10 @@ void GatewayConfig::initRatelimitConfig(const boost::property_tree::ptree& _pt)
     ;   group_group0=2
     ;   group_group1=2
     ;   group_group2=2
+    ;
+    ; specify module to limit bandwidth, module_moduleName=n
+    ;   module_amop=2
+    ;   module_block_sync=5
     */
 
     // modules_without_bw_limit=raft,pbft
@@ -504,6 +508,26 @@ void GatewayConfig::initRatelimitConfig(const boost::property_tree::ptree& _pt)
                     << LOG_BADGE("initRateLimitConfig") << LOG_DESC("add group bandwidth limit")
                     << LOG_KV("group", group) << LOG_KV("bandwidth", bw);
             }
+            else if (boost::starts_with(key, "module_"))
+            {
+                // module_xxxx =
+                std::string module = key.substr(7);
+                boost::algorithm::to_lower(module);
+                auto optModuleID = protocol::stringToModuleID(module);
+                if (!optModuleID.has_value())
+                {
+                    BOOST_THROW_EXCEPTION(InvalidParameter() << errinfo_comment(
+                                              "flow_control.module_xxx config, unrecognized "
+                                              "module: " +
+                                              module));
+                }
+                double bw = boost::lexical_cast<double>(value);
+                m_rateLimitConfig.module2BwLimit[optModuleID.value()] = doubleMBToBit(bw);
+
+                GATEWAY_CONFIG_LOG(INFO)
+                    << LOG_BADGE("initRateLimitConfig") << LOG_DESC("add module bandwidth limit")
+                    << LOG_KV("module", module) << LOG_KV("bandwidth", bw);
+            }
         }
     }
 
@@ -535,7 +559,8 @@ void GatewayConfig::initRatelimitConfig(const boost::property_tree::ptree& _pt)
                              << LOG_KV("groupOutgoingBwLimit", groupOutgoingBwLimit)
                              << LOG_KV("moduleIDs", boost::join(modules, ","))
                              << LOG_KV("ips size", m_rateLimitConfig.ip2BwLimit.size())
-                             << LOG_KV("groups size", m_rateLimitConfig.group2BwLimit.size());
+                             << LOG_KV("groups size", m_rateLimitConfig.group2BwLimit.size())
+                             << LOG_KV("modules size", m_rateLimitConfig.module2BwLimit.size());
 }
 
 void GatewayConfig::checkFileExist(const std::string& _path)
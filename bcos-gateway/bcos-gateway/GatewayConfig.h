@@ -59,6 +59,9 @@ public:
         // specify group bandwidth limiting
         std::unordered_map<std::string, int64_t> group2BwLimit;
 
+        // specify module bandwidth limiting
+        std::unordered_map<uint16_t, int64_t> module2BwLimit;
+
         // the message of modules that do not limit bandwidth
         std::set<uint16_t> modulesWithNoBwLimit;
 
@@ -70,7 +73,7 @@ public:
                 return true;
             }
 
-            if (!group2BwLimit.empty() || !ip2BwLimit.empty())
+            if (!group2BwLimit.empty() || !ip2BwLimit.empty() || !module2BwLimit.empty())
             {
                 return true;
             }
@@ -388,6 +388,13 @@ std::shared_ptr<ratelimit::RateLimiterManager> GatewayFactory::buildRateLimitMan
         }
     }
 
+    // module => rate limit
+    for (const auto& [moduleID, bandWidth] : _rateLimitConfig.module2BwLimit)
+    {
+        auto rateLimiterInterface = rateLimiterFactory->buildRateLimiter(bandWidth);
+        rateLimiterManager->registerModuleRateLimiter(moduleID, rateLimiterInterface);
+    }
+
     // modules without bandwidth limit
     rateLimiterManager->setModulesWithNoBwLimit(_rateLimitConfig.modulesWithNoBwLimit);
     rateLimiterManager->setRateLimiterFactory(rateLimiterFactory);
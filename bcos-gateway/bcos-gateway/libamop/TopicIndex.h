@@ -0,0 +1,112 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file TopicIndex.h
+ * @brief the inverted index from topic to the subscribers
+ */
+#pragma once
+#include <bcos-gateway/libamop/Common.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace bcos
+{
+namespace amop
+{
+// TopicIndex maps the topic to its subscribers (the clients or the nodeIDs).
+// The readers load an immutable snapshot without any lock, the writers copy the snapshot, replace
+// the subscribers of the changed topics and publish the new snapshot. The subscriptions change far
+// less often than the messages are routed, so copying the topic table on update is cheap.
+// Note: the writers must be serialized by the caller
+class TopicIndex
+{
+public:
+    using Subscribers = std::vector<std::string>;
+    using Snapshot = std::unordered_map<std::string, std::shared_ptr<const Subscribers>>;
+
+    TopicIndex() : m_snapshot(std::make_shared<const Snapshot>()) {}
+
+    // the subscribers of the topic, nullptr if no one subscribes the topic
+    std::shared_ptr<const Subscribers> subscribers(std::string const& _topic) const
+    {
+        auto snapshot = std::atomic_load(&m_snapshot);
+        auto it = snapshot->find(_topic);
+        if (it == snapshot->end())
+        {
+            return nullptr;
+        }
+        return it->second;
+    }
+
+    size_t topicsSize() const { return std::atomic_load(&m_snapshot)->size(); }
+
+    // the subscriber subscribes _newTopics instead of _oldTopics
+    void update(std::string const& _subscriber, TopicItems const& _oldTopics,
+        TopicItems const& _newTopics)
+    {
+        auto snapshot = std::make_shared<Snapshot>(*std::atomic_load(&m_snapshot));
+        for (auto const& topicItem : _oldTopics)
+        {
+            if (_newTopics.count(topicItem))
+            {
+                continue;
+            }
+            auto it = snapshot->find(topicItem.topicName());
+            if (it == snapshot->end())
+            {
+                continue;
+            }
+            auto subscribers = std::make_shared<Subscribers>(*it->second);
+            subscribers->erase(std::remove(subscribers->begin(), subscribers->end(), _subscriber),
+                subscribers->end());
+            if (subscribers->empty())
+            {
+                snapshot->erase(it);
+                continue;
+            }
+            it->second = std::move(subscribers);
+        }
+        for (auto const& topicItem : _newTopics)
+        {
+            if (_oldTopics.count(topicItem))
+            {
+                continue;
+            }
+            auto& topicSubscribers = (*snapshot)[topicItem.topicName()];
+            auto subscribers = topicSubscribers ? std::make_shared<Subscribers>(*topicSubscribers) :
+                                                  std::make_shared<Subscribers>();
+            if (std::find(subscribers->begin(), subscribers->end(), _subscriber) ==
+                subscribers->end())
+            {
+                subscribers->emplace_back(_subscriber);
+            }
+            topicSubscribers = std::move(subscribers);
+        }
+        std::atomic_store(&m_snapshot, std::shared_ptr<const Snapshot>(std::move(snapshot)));
+    }
+
+    void remove(std::string const& _subscriber, TopicItems const& _oldTopics)
+    {
+        update(_subscriber, _oldTopics, TopicItems());
+    }
+
+private:
+    std::shared_ptr<const Snapshot> m_snapshot;
+};
+}  // namespace amop
+}  // namespace bcos
@@ -103,7 +103,9 @@ void TopicManager::subTopic(const std::string& _client, const TopicItems& _topic
 {
     {
         std::unique_lock lock(x_clientTopics);
-        m_client2TopicItems[_client] = _topicItems;  // Override the previous value
+        auto& topicItems = m_client2TopicItems[_client];
+        m_clientTopicIndex.update(_client, topicItems, _topicItems);
+        topicItems = _topicItems;  // Override the previous value
         incTopicSeq();
     }
     createAndGetServiceByClient(_client);
@@ -150,19 +152,23 @@ void TopicManager::removeTopics(
     }
     {
         std::unique_lock lock(x_clientTopics);
-        if (!m_client2TopicItems.count(_client))
+        auto it = m_client2TopicItems.find(_client);
+        if (it == m_client2TopicItems.end())
         {
             return;
         }
+        auto& topicItems = it->second;
+        TopicItems removedTopics;
         for (auto const& topic : _topicList)
         {
-            if (m_client2TopicItems[_client].count(topic))
+            if (topicItems.erase(topic))
             {
-                m_client2TopicItems[_client].erase(topic);
+                removedTopics.insert(TopicItem(topic));
             }
             TOPIC_LOG(INFO) << LOG_BADGE("removeTopics") << LOG_KV("client", _client)
                             << LOG_KV("topicSeq", topicSeq()) << LOG_KV("topic", topic);
         }
+        m_clientTopicIndex.remove(_client, removedTopics);
         incTopicSeq();
     }
 }
@@ -172,8 +178,13 @@ void TopicManager::removeTopicsByClient(const std::string& _client)
     std::size_t result = 0;
     {
         std::unique_lock lock(x_clientTopics);
-
-        result = m_client2TopicItems.erase(_client);
+        auto it = m_client2TopicItems.find(_client);
+        if (it != m_client2TopicItems.end())
+        {
+            m_clientTopicIndex.remove(_client, it->second);
+            m_client2TopicItems.erase(it);
+            result = 1;
+        }
     }
 
     incTopicSeq();
@@ -309,7 +320,12 @@ void TopicManager::notifyNodeIDs(const std::vector<P2pID>& _nodeIDs)
                     return it->first == _nodeID;
                 }) == _nodeIDs.end())
             {  // nodeID is offline, remove the nodeID's state
-                m_nodeID2TopicItems.erase(it->first);
+                auto topicsIt = m_nodeID2TopicItems.find(it->first);
+                if (topicsIt != m_nodeID2TopicItems.end())
+                {
+                    m_nodeTopicIndex.remove(it->first, topicsIt->second);
+                    m_nodeID2TopicItems.erase(topicsIt);
+                }
                 it = m_nodeID2TopicSeq.erase(it);
                 removeCount++;
             }
@@ -336,7 +352,9 @@ void TopicManager::updateSeqAndTopicsByNodeID(
     {
         std::unique_lock lock(x_topics);
         m_nodeID2TopicSeq[_nodeID] = _topicSeq;
-        m_nodeID2TopicItems[_nodeID] = _topicItems;
+        auto& topicItems = m_nodeID2TopicItems[_nodeID];
+        m_nodeTopicIndex.update(_nodeID, topicItems, _topicItems);
+        topicItems = _topicItems;
     }
 
     TOPIC_LOG(INFO) << LOG_BADGE("updateSeqAndTopicsByNodeID") << LOG_KV("nodeID", _nodeID)
@@ -353,18 +371,20 @@ void TopicManager::updateSeqAndTopicsByNodeID(
 void TopicManager::queryNodeIDsByTopic(
     const std::string& _topic, std::vector<std::string>& _nodeIDs)
 {
-    std::shared_lock lock(x_topics);
-    for (auto it = m_nodeID2TopicItems.begin(); it != m_nodeID2TopicItems.end(); ++it)
+    // lock-free, the index snapshot is immutable
+    auto nodeIDs = m_nodeTopicIndex.subscribers(_topic);
+    if (!nodeIDs)
+    {
+        return;
+    }
+    for (auto const& nodeID : *nodeIDs)
     {
-        auto findIt = std::find_if(it->second.begin(), it->second.end(),
-            [_topic](const TopicItem& _topicItem) { return _topic == _topicItem.topicName(); });
         // only return the connected nodes
-        if (findIt != it->second.end() && m_network->isReachable(it->first))
+        if (m_network->isReachable(nodeID))
         {
-            _nodeIDs.push_back(it->first);
+            _nodeIDs.push_back(nodeID);
         }
     }
-    return;
 }
 
 /**
@@ -376,17 +396,11 @@ void TopicManager::queryNodeIDsByTopic(
 void TopicManager::queryClientsByTopic(
     const std::string& _topic, std::vector<std::string>& _clients)
 {
+    // lock-free, the index snapshot is immutable
+    auto clients = m_clientTopicIndex.subscribers(_topic);
+    if (clients)
     {
-        std::shared_lock lock(x_clientTopics);
-        for (const auto& items : m_client2TopicItems)
-        {
-            auto it = std::find_if(items.second.begin(), items.second.end(),
-                [_topic](const TopicItem& _topicItem) { return _topic == _topicItem.topicName(); });
-            if (it != items.second.end())
-            {
-                _clients.push_back(items.first);
-            }
-        }
+        _clients.insert(_clients.end(), clients->begin(), clients->end());
     }
 
     TOPIC_LOG(INFO) << LOG_BADGE("queryClientsByTopic") << LOG_KV("topic", _topic)
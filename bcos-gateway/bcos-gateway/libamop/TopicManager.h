@@ -23,6 +23,7 @@
 #include <bcos-crypto/interfaces/crypto/KeyInterface.h>
 #include <bcos-framework/rpc/RPCInterface.h>
 #include <bcos-gateway/libamop/Common.h>
+#include <bcos-gateway/libamop/TopicIndex.h>
 #include <bcos-gateway/libp2p/P2PInterface.h>
 #include <bcos-tars-protocol/client/RpcServiceClient.h>
 #include <bcos-utilities/Common.h>
@@ -165,6 +166,11 @@ protected:
     // nodeID => topicItems
     std::unordered_map<std::string, TopicItems> m_nodeID2TopicItems;
 
+    // topic => clients, updated with m_client2TopicItems under x_clientTopics
+    TopicIndex m_clientTopicIndex;
+    // topic => nodeIDs, updated with m_nodeID2TopicItems under x_topics
+    TopicIndex m_nodeTopicIndex;
+
     std::map<std::string, bcos::rpc::RPCInterface::Ptr> m_clientInfo;
     mutable SharedMutex x_clientInfo;
 
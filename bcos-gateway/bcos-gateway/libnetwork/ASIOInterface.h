@@ -122,6 +122,33 @@ public:
         });
     }
 
+    // write the buffers in order with a single gather write, the buffers must be alive until the
+    // handler is called
+    virtual void asyncWrite(std::shared_ptr<SocketFace> socket,
+        std::vector<boost::asio::const_buffer> buffers, ReadWriteHandler handler)
+    {
+        auto type = m_type;
+        auto ioService = socket->ioService();
+        ioService->post([type, socket, buffers = std::move(buffers), handler]() {
+            if (socket->isConnected())
+            {
+                switch (type)
+                {
+                case TCP_ONLY:
+                {
+                    ba::async_write(socket->ref(), buffers, handler);
+                    break;
+                }
+                case SSL:
+                {
+                    ba::async_write(socket->sslref(), buffers, handler);
+                    break;
+                }
+                }
+            }
+        });
+    }
+
     virtual void asyncRead(std::shared_ptr<SocketFace> socket,
         boost::asio::mutable_buffers_1 buffers, ReadWriteHandler handler)
     {
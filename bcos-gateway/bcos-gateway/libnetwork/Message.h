@@ -40,6 +40,18 @@ public:
     virtual ~MessageExtAttributes() = default;
 };
 
+// the message encoded for a session: the header is encoded for every destination, the payload is
+// encoded once and shared by all the sessions the message is written to, it must not be modified
+struct EncodedMessage
+{
+    using Ptr = std::shared_ptr<EncodedMessage>;
+
+    bytes header;
+    std::shared_ptr<const bytes> payload;
+
+    size_t size() const { return header.size() + (payload ? payload->size() : 0); }
+};
+
 class Message
 {
 public:
@@ -56,6 +68,18 @@ public:
     virtual bool isRespPacket() const = 0;
     virtual bool encode(bcos::bytes& _buffer) = 0;
     virtual ssize_t decode(bytesConstRef _buffer) = 0;
+    // decode the fields ahead of the payload from the beginning of a message larger than _buffer,
+    // _payload is set to the payload buffer of the message for the rest of the message to be read
+    // into, return the offset of the payload, MESSAGE_INCOMPLETE if _buffer does not hold all the
+    // fields ahead of the payload
+    virtual ssize_t decodeHead(bytesConstRef _buffer, bytesRef& _payload) = 0;
+    // encode the message for a session, the messages without a shared payload encode all the
+    // fields into the header
+    virtual bool encode(EncodedMessage& _encodedMsg)
+    {
+        _encodedMsg.payload.reset();
+        return encode(_encodedMsg.header);
+    }
 
     virtual std::string const& srcP2PNodeID() const = 0;
     virtual std::string const& dstP2PNodeID() const = 0;
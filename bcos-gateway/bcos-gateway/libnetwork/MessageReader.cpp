@@ -0,0 +1,157 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief decode the messages from the bytes read by the session
+ * @file MessageReader.cpp
+ */
+
+#include <bcos-gateway/libnetwork/MessageReader.h>
+#include <boost/asio/detail/socket_ops.hpp>
+#include <algorithm>
+#include <cstring>
+
+using namespace bcos;
+using namespace bcos::gateway;
+
+MessageReader::MessageReader(MessageFactory::Ptr _messageFactory, size_t _bufferSize)
+  : m_messageFactory(std::move(_messageFactory)),
+    c_bufferSize(std::max(_bufferSize, LENGTH_FIELD_SIZE)),
+    m_buffer(c_bufferSize)
+{}
+
+bytesRef MessageReader::readBuffer()
+{
+    if (m_message)
+    {
+        return m_payload.getCroppedData(m_payloadReceived);
+    }
+    // the unread bytes are moved only when less than half of the buffer is free at the tail
+    if (m_end == m_begin || (m_begin > 0 && m_buffer.size() - m_end < m_buffer.size() / 2))
+    {
+        compact();
+    }
+    return bytesRef(m_buffer.data() + m_end, m_buffer.size() - m_end);
+}
+
+size_t MessageReader::pendingSize() const
+{
+    return (m_end - m_begin) + (m_message ? m_payloadReceived : 0);
+}
+
+void MessageReader::compact()
+{
+    auto size = m_end - m_begin;
+    if (size > 0 && m_begin > 0)
+    {
+        std::memmove(m_buffer.data(), m_buffer.data() + m_begin, size);
+    }
+    m_begin = 0;
+    m_end = size;
+    // the buffer grown for a message without decodeHead is given back
+    if (size <= c_bufferSize && m_buffer.size() > c_bufferSize)
+    {
+        m_buffer.resize(c_bufferSize);
+        m_buffer.shrink_to_fit();
+    }
+}
+
+bool MessageReader::onRead(size_t _size, MessageHandler const& _handler)
+{
+    if (m_message)
+    {
+        m_payloadReceived += _size;
+        if (m_payloadReceived < m_payload.size())
+        {
+            return true;
+        }
+        auto message = std::move(m_message);
+        m_message.reset();
+        m_payload = bytesRef();
+        m_payloadReceived = 0;
+        _handler(NetworkException(P2PExceptionType::Success, "Success"), message);
+        return true;
+    }
+    m_end += _size;
+    return decodeMessages(_handler);
+}
+
+bool MessageReader::decodeMessages(MessageHandler const& _handler)
+{
+    while (m_end - m_begin >= LENGTH_FIELD_SIZE)
+    {
+        auto data = unread();
+        uint32_t length = 0;
+        std::memcpy(&length, data.data(), LENGTH_FIELD_SIZE);
+        length = boost::asio::detail::socket_ops::network_to_host_long(length);
+
+        auto message = m_messageFactory->buildMessage();
+        try
+        {
+            if (length <= data.size())
+            {
+                // Note: the decode function may throw exception
+                auto result = message->decode(data.getCroppedData(0, length));
+                if (result <= 0)
+                {
+                    SESSION_LOG(ERROR) << LOG_DESC("Decode message error")
+                                       << LOG_KV("result", result) << LOG_KV("length", length);
+                    _handler(NetworkException(P2PExceptionType::ProtocolError, "ProtocolError"),
+                        message);
+                    return false;
+                }
+                m_begin += result;
+                _handler(NetworkException(P2PExceptionType::Success, "Success"), message);
+                continue;
+            }
+            // wait until the buffer is full of the message
+            if (length <= m_buffer.size() || data.size() < m_buffer.size())
+            {
+                return true;
+            }
+
+            bytesRef payload;
+            auto offset = message->decodeHead(data, payload);
+            if (offset == MessageDecodeStatus::MESSAGE_INCOMPLETE)
+            {
+                // the fields ahead of the payload exceed the buffer, read the whole message
+                m_buffer.resize(length);
+                return true;
+            }
+            if (offset < 0)
+            {
+                SESSION_LOG(ERROR) << LOG_DESC("Decode message head error")
+                                   << LOG_KV("result", offset) << LOG_KV("length", length);
+                _handler(
+                    NetworkException(P2PExceptionType::ProtocolError, "ProtocolError"), message);
+                return false;
+            }
+            auto received = data.getCroppedData(offset);
+            std::memcpy(payload.data(), received.data(), received.size());
+            m_message = std::move(message);
+            m_payload = payload;
+            m_payloadReceived = received.size();
+            m_begin = m_end = 0;
+            return true;
+        }
+        catch (std::exception const& e)
+        {
+            SESSION_LOG(ERROR) << LOG_DESC("Decode message exception")
+                               << LOG_KV("error", boost::diagnostic_information(e));
+            _handler(NetworkException(P2PExceptionType::ProtocolError, "ProtocolError"), message);
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,82 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief decode the messages from the bytes read by the session
+ * @file MessageReader.h
+ */
+
+#pragma once
+
+#include <bcos-gateway/libnetwork/Common.h>
+#include <bcos-gateway/libnetwork/Message.h>
+#include <bcos-utilities/Common.h>
+#include <functional>
+
+namespace bcos
+{
+namespace gateway
+{
+/**
+ * @brief MessageReader frames the messages by the 4 bytes length at the front of each message.
+ *
+ * The socket reads into the free tail of a pre-allocated buffer, the complete messages are decoded
+ * in place, and the unread bytes (less than one message) are moved to the front only when the free
+ * tail runs short, rather than erasing every decoded message from the front of the buffer.
+ *
+ * A message larger than the buffer is read header first: once the buffer is full, the fields ahead
+ * of the payload are decoded by Message::decodeHead, and the rest of the payload is read straight
+ * into the payload of the message, so the large payloads are neither buffered nor copied again.
+ */
+class MessageReader
+{
+public:
+    using MessageHandler = std::function<void(NetworkException const&, Message::Ptr)>;
+    constexpr static size_t LENGTH_FIELD_SIZE = 4;
+
+    MessageReader(MessageFactory::Ptr _messageFactory, size_t _bufferSize);
+
+    // where the next read of the socket goes
+    bytesRef readBuffer();
+    // _size bytes have been read into readBuffer(), every message completed is passed to _handler,
+    // return false if the stream can not be decoded, the reading should stop then
+    bool onRead(size_t _size, MessageHandler const& _handler);
+
+    // the bytes read but not decoded yet
+    size_t pendingSize() const;
+    size_t bufferSize() const { return m_buffer.size(); }
+
+private:
+    bytesConstRef unread() const
+    {
+        return bytesConstRef(m_buffer.data() + m_begin, m_end - m_begin);
+    }
+    void compact();
+    // decode the messages in the buffer, false on error
+    bool decodeMessages(MessageHandler const& _handler);
+
+    MessageFactory::Ptr m_messageFactory;
+    const size_t c_bufferSize;
+
+    bytes m_buffer;
+    size_t m_begin = 0;
+    size_t m_end = 0;
+
+    // the large message whose payload is being read
+    Message::Ptr m_message;
+    bytesRef m_payload;
+    size_t m_payloadReceived = 0;
+};
+}  // namespace gateway
+}  // namespace bcos
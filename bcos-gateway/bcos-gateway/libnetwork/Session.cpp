@@ -13,6 +13,7 @@
 #include <bcos-gateway/libnetwork/Session.h>
 #include <bcos-gateway/libnetwork/SessionFace.h>  // for Respon...
 #include <bcos-gateway/libnetwork/SocketFace.h>   // for Socket...
+#include <bcos-utilities/Metrics.h>
 #include <chrono>
 #include <cstddef>
 #include <fstream>
@@ -21,10 +22,29 @@
 using namespace bcos;
 using namespace bcos::gateway;
 
+namespace
+{
+struct SessionMetrics
+{
+    metrics::Counter& sentMsgs = metrics::MetricsRegistry::instance().counter(
+        "bcos_gateway_sent_msgs_total", "The p2p messages sent");
+    metrics::Counter& sentBytes = metrics::MetricsRegistry::instance().counter(
+        "bcos_gateway_sent_bytes_total", "The p2p bytes sent");
+    metrics::Counter& receivedMsgs = metrics::MetricsRegistry::instance().counter(
+        "bcos_gateway_received_msgs_total", "The p2p messages received");
+    metrics::Counter& receivedBytes = metrics::MetricsRegistry::instance().counter(
+        "bcos_gateway_received_bytes_total", "The p2p bytes received");
+};
+SessionMetrics& sessionMetrics()
+{
+    static SessionMetrics sessionMetrics;
+    return sessionMetrics;
+}
+}  // namespace
+
 Session::Session(size_t _bufferSize) : bufferSize(_bufferSize)
 {
     SESSION_LOG(INFO) << "[Session::Session] this=" << this;
-    m_recvBuffer.resize(bufferSize);
     m_seq2Callback = std::make_shared<std::unordered_map<uint32_t, ResponseCallback::Ptr>>();
     m_idleCheckTimer = std::make_shared<bcos::Timer>(m_idleTimeInterval, "idleChecker");
     m_idleCheckTimer->registerTimeoutHandler([this]() { checkNetworkStatus(); });
@@ -87,6 +107,24 @@ void Session::asyncSendMessage(Message::Ptr message, Options options, SessionCal
         return;
     }
 
+    // encode before registering the callback, the header is encoded for this session and the
+    // payload encoded by the first session is shared
+    auto encodedMsg = std::make_shared<EncodedMessage>();
+    if (!message->encode(*encodedMsg))
+    {
+        SESSION_LOG(WARNING) << LOG_DESC("Session asyncSendMessage: encode message failed")
+                             << LOG_KV("endpoint", nodeIPEndpoint())
+                             << LOG_KV("packetType", message->packetType())
+                             << LOG_KV("seq", message->seq());
+        if (callback)
+        {
+            server->threadPool()->enqueue([callback] {
+                callback(NetworkException(-1, "encode message failed"), Message::Ptr());
+            });
+        }
+        return;
+    }
+
     if (callback)
     {
         auto handler = std::make_shared<ResponseCallback>();
@@ -122,13 +160,10 @@ void Session::asyncSendMessage(Message::Ptr message, Options options, SessionCal
     SESSION_LOG(TRACE) << LOG_DESC("Session asyncSendMessage")
                        << LOG_KV("endpoint", nodeIPEndpoint());
 
-    std::shared_ptr<bytes> p_buffer = std::make_shared<bytes>();
-    message->encode(*p_buffer);
-
-    send(p_buffer);
+    send(encodedMsg);
 }
 
-void Session::send(std::shared_ptr<bytes> _msg)
+void Session::send(EncodedMessage::Ptr _encodedMsg)
 {
     if (!actived())
     {
@@ -142,13 +177,15 @@ void Session::send(std::shared_ptr<bytes> _msg)
     {
         Guard l(x_writeQueue);
 
-        m_writeQueue.push(make_pair(_msg, u256(utcTime())));
+        m_writeQueue.push(make_pair(_encodedMsg, u256(utcTime())));
     }
+    sessionMetrics().sentMsgs.inc();
 
     write();
 }
 
-void Session::onWrite(boost::system::error_code ec, std::size_t, std::shared_ptr<bytes>)
+void Session::onWrite(
+    boost::system::error_code ec, std::size_t bytesTransferred, EncodedMessage::Ptr)
 {
     if (!actived())
     {
@@ -166,6 +203,7 @@ void Session::onWrite(boost::system::error_code ec, std::size_t, std::shared_ptr
             drop(TCPError);
             return;
         }
+        sessionMetrics().sentBytes.inc(bytesTransferred);
         {
             if (m_writing)
             {
@@ -202,7 +240,7 @@ void Session::write()
 
         m_writing = true;
 
-        std::pair<std::shared_ptr<bytes>, u256> task;
+        std::pair<EncodedMessage::Ptr, u256> task;
         u256 enter_time = u256(0);
 
         if (m_writeQueue.empty())
@@ -215,7 +253,7 @@ void Session::write()
         m_writeQueue.pop();
 
         enter_time = task.second;
-        auto buffer = task.first;
+        auto encodedMsg = task.first;
 
         auto server = m_server.lock();
         if (server && server->haveNetwork())
@@ -224,15 +262,21 @@ void Session::write()
             {
                 // asio::buffer referecne buffer, so buffer need alive before
                 // asio::buffer be used
+                std::vector<boost::asio::const_buffer> buffers;
+                buffers.emplace_back(boost::asio::buffer(encodedMsg->header));
+                if (encodedMsg->payload && !encodedMsg->payload->empty())
+                {
+                    buffers.emplace_back(boost::asio::buffer(*encodedMsg->payload));
+                }
                 auto self = std::weak_ptr<Session>(shared_from_this());
-                server->asioInterface()->asyncWrite(m_socket, boost::asio::buffer(*buffer),
-                    [self, buffer](const boost::system::error_code _error, std::size_t _size) {
+                server->asioInterface()->asyncWrite(m_socket, std::move(buffers),
+                    [self, encodedMsg](const boost::system::error_code _error, std::size_t _size) {
                         auto session = self.lock();
                         if (!session)
                         {
                             return;
                         }
-                        session->onWrite(_error, _size, buffer);
+                        session->onWrite(_error, _size, encodedMsg);
                     });
             }
             else
@@ -432,56 +476,27 @@ void Session::doRead()
                     return;
                 }
                 s->m_lastReadTime.store(utcSteadyTime());
-                s->m_data.insert(s->m_data.end(), s->m_recvBuffer.begin(),
-                    s->m_recvBuffer.begin() + bytesTransferred);
-
-                while (true)
-                {
-                    Message::Ptr message = s->m_messageFactory->buildMessage();
-                    try
-                    {
-                        // Note: the decode function may throw exception
-                        ssize_t result =
-                            message->decode(bytesConstRef(s->m_data.data(), s->m_data.size()));
-                        if (result > 0)
-                        {
-                            /// SESSION_LOG(TRACE) << "Decode success: " << result;
-                            NetworkException e(P2PExceptionType::Success, "Success");
-                            s->onMessage(e, message);
-                            s->m_data.erase(s->m_data.begin(), s->m_data.begin() + result);
-                        }
-                        else if (result == 0)
+                sessionMetrics().receivedBytes.inc(bytesTransferred);
+                auto decoded = s->m_messageReader->onRead(bytesTransferred,
+                    [&s](NetworkException const& e, Message::Ptr message) {
+                        if (e.errorCode() == P2PExceptionType::Success)
                         {
-                            s->doRead();
-                            break;
+                            sessionMetrics().receivedMsgs.inc();
                         }
-                        else
-                        {
-                            SESSION_LOG(ERROR)
-                                << LOG_DESC("Decode message error") << LOG_KV("result", result);
-                            s->onMessage(
-                                NetworkException(P2PExceptionType::ProtocolError, "ProtocolError"),
-                                message);
-                            break;
-                        }
-                    }
-                    catch (std::exception const& e)
-                    {
-                        SESSION_LOG(ERROR) << LOG_DESC("Decode message exception")
-                                           << LOG_KV("error", boost::diagnostic_information(e));
-                        s->onMessage(
-                            NetworkException(P2PExceptionType::ProtocolError, "ProtocolError"),
-                            message);
-                        break;
-                    }
+                        s->onMessage(e, message);
+                    });
+                if (decoded)
+                {
+                    s->doRead();
                 }
             }
         };
 
         if (m_socket->isConnected())
         {
+            auto buffer = m_messageReader->readBuffer();
             server->asioInterface()->asyncReadSome(
-                m_socket, boost::asio::buffer(m_recvBuffer, m_recvBuffer.size()), asyncRead);
+                m_socket, boost::asio::buffer(buffer.data(), buffer.size()), asyncRead);
         }
         else
         {
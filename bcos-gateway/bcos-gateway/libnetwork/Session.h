@@ -7,6 +7,7 @@
 #pragma once
 
 #include <bcos-gateway/libnetwork/Common.h>
+#include <bcos-gateway/libnetwork/MessageReader.h>
 #include <bcos-gateway/libnetwork/SessionFace.h>
 #include <bcos-utilities/Common.h>
 #include <bcos-utilities/Timer.h>
@@ -53,6 +54,7 @@ public:
     virtual void setMessageFactory(MessageFactory::Ptr _messageFactory)
     {
         m_messageFactory = _messageFactory;
+        m_messageReader = std::make_unique<MessageReader>(_messageFactory, bufferSize);
     }
 
     virtual std::function<void(NetworkException, SessionFace::Ptr, Message::Ptr)> messageHandler()
@@ -110,11 +112,11 @@ protected:
     virtual void checkNetworkStatus();
 
 private:
-    void send(std::shared_ptr<bytes> _msg);
+    void send(EncodedMessage::Ptr _encodedMsg);
 
     void doRead();
-    std::vector<byte> m_data;  ///< Buffer for ingress packet data.
-    std::vector<byte> m_recvBuffer;
+    ///< Decode the ingress packet data in place from the pre-allocated buffer
+    std::unique_ptr<MessageReader> m_messageReader;
     const size_t bufferSize;
 
     /// Drop the connection for the reason @a _r.
@@ -127,7 +129,8 @@ private:
 
     /// Perform a single round of the write operation. This could end up calling
     /// itself asynchronously.
-    void onWrite(boost::system::error_code ec, std::size_t length, std::shared_ptr<bytes> buffer);
+    void onWrite(
+        boost::system::error_code ec, std::size_t length, EncodedMessage::Ptr _encodedMsg);
     void write();
 
     /// call by doRead() to deal with message
@@ -141,14 +144,15 @@ private:
     class QueueCompare
     {
     public:
-        bool operator()(const std::pair<std::shared_ptr<bytes>, u256>&,
-            const std::pair<std::shared_ptr<bytes>, u256>&) const
+        bool operator()(const std::pair<EncodedMessage::Ptr, u256>&,
+            const std::pair<EncodedMessage::Ptr, u256>&) const
         {
             return false;
         }
     };
 
-    boost::heap::priority_queue<std::pair<std::shared_ptr<bytes>, u256>,
+    // the broadcast messages share the encoded payload among the write queues of the sessions
+    boost::heap::priority_queue<std::pair<EncodedMessage::Ptr, u256>,
         boost::heap::compare<QueueCompare>, boost::heap::stable<true>>
         m_writeQueue;
     std::atomic_bool m_writing = {false};
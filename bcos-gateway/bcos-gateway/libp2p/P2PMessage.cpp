@@ -183,6 +183,19 @@ bool P2PMessage::encodeHeader(bytes& _buffer)
     return true;
 }
 
+bool P2PMessage::encodeBody(bytes& _buffer)
+{
+    // encode options
+    if (hasOptions() && !m_options->encode(_buffer))
+    {
+        return false;
+    }
+
+    // encode payload
+    _buffer.insert(_buffer.end(), m_payload->begin(), m_payload->end());
+    return true;
+}
+
 bool P2PMessage::encode(bytes& _buffer)
 {
     bytes emptyBuffer;
@@ -191,15 +204,11 @@ bool P2PMessage::encode(bytes& _buffer)
     {
         return false;
     }
-    // encode options
-    if (hasOptions() && !m_options->encode(_buffer))
+    if (!encodeBody(_buffer))
     {
         return false;
     }
 
-    // encode payload
-    _buffer.insert(_buffer.end(), m_payload->begin(), m_payload->end());
-
     // calc total length and modify the length value in the buffer
     auto length = boost::asio::detail::socket_ops::host_to_network_long((uint32_t)_buffer.size());
 
@@ -210,6 +219,49 @@ bool P2PMessage::encode(bytes& _buffer)
     return true;
 }
 
+std::shared_ptr<const bytes> P2PMessage::encodedBody()
+{
+    auto encodedBody = std::atomic_load(&m_encodedBody);
+    if (encodedBody)
+    {
+        return encodedBody;
+    }
+    auto body = std::make_shared<bytes>();
+    body->reserve(m_payload->size() + P2PMessageOptions::OPTIONS_MIN_LENGTH);
+    if (!encodeBody(*body))
+    {
+        return nullptr;
+    }
+    // the messages broadcast concurrently may encode the body more than once, any of the results
+    // can be shared
+    encodedBody = body;
+    std::atomic_store(&m_encodedBody, encodedBody);
+    return encodedBody;
+}
+
+bool P2PMessage::encode(EncodedMessage& _encodedMsg)
+{
+    auto body = encodedBody();
+    if (!body)
+    {
+        return false;
+    }
+    bytes emptyBuffer;
+    _encodedMsg.header.swap(emptyBuffer);
+    if (!encodeHeader(_encodedMsg.header))
+    {
+        return false;
+    }
+    _encodedMsg.payload = body;
+
+    // the length field covers the header and the shared body
+    auto length = boost::asio::detail::socket_ops::host_to_network_long(
+        (uint32_t)(_encodedMsg.header.size() + body->size()));
+    std::copy((byte*)&length, (byte*)&length + 4, _encodedMsg.header.data());
+    m_length = _encodedMsg.header.size() + body->size();
+    return true;
+}
+
 ssize_t P2PMessage::decodeHeader(bytesConstRef _buffer)
 {
     int32_t offset = 0;
@@ -280,3 +332,48 @@ ssize_t P2PMessage::decode(bytesConstRef _buffer)
 
     return m_length;
 }
+
+ssize_t P2PMessage::decodeHead(bytesConstRef _buffer, bytesRef& _payload)
+{
+    if (_buffer.size() < P2PMessage::MESSAGE_HEADER_LENGTH)
+    {
+        return MessageDecodeStatus::MESSAGE_INCOMPLETE;
+    }
+    // check the length before the header of any version is decoded
+    auto length =
+        boost::asio::detail::socket_ops::network_to_host_long(*((uint32_t*)&_buffer[0]));
+    if (length > P2PMessage::MAX_MESSAGE_LENGTH)
+    {
+        P2PMSG_LOG(WARNING) << LOG_DESC("Illegal p2p message packet") << LOG_KV("length", length)
+                            << LOG_KV("maxLen", P2PMessage::MAX_MESSAGE_LENGTH);
+        return MessageDecodeStatus::MESSAGE_ERROR;
+    }
+
+    ssize_t offset = 0;
+    try
+    {
+        offset = decodeHeader(_buffer);
+    }
+    catch (std::out_of_range const&)
+    {
+        return MessageDecodeStatus::MESSAGE_INCOMPLETE;
+    }
+    if (hasOptions())
+    {
+        auto optionsOffset = m_options->decode(_buffer.getCroppedData(offset));
+        if (optionsOffset < 0)
+        {
+            return MessageDecodeStatus::MESSAGE_INCOMPLETE;
+        }
+        offset += optionsOffset;
+    }
+    if ((size_t)offset > m_length)
+    {
+        return MessageDecodeStatus::MESSAGE_ERROR;
+    }
+
+    // payload, the bytes are filled by the caller
+    m_payload = std::make_shared<bytes>(m_length - offset);
+    _payload = bytesRef(m_payload->data(), m_payload->size());
+    return offset;
+}
@@ -24,6 +24,7 @@
 #include <bcos-gateway/libnetwork/Common.h>
 #include <bcos-gateway/libnetwork/Message.h>
 #include <bcos-utilities/Common.h>
+#include <memory>
 #include <vector>
 
 #define CHECK_OFFSET_WITH_THROW_EXCEPTION(offset, length)                                    \
@@ -154,7 +155,12 @@ public:
     virtual void setVersion(uint16_t version) { m_version = version; }
 
     uint16_t packetType() const override { return m_packetType; }
-    virtual void setPacketType(uint16_t packetType) { m_packetType = packetType; }
+    virtual void setPacketType(uint16_t packetType)
+    {
+        m_packetType = packetType;
+        // whether the body contains the options depends on the packet type
+        resetEncodedBody();
+    }
 
     uint32_t seq() const override { return m_seq; }
     virtual void setSeq(uint32_t seq) { m_seq = seq; }
@@ -163,14 +169,29 @@ public:
     virtual void setExt(uint16_t _ext) { m_ext = _ext; }
 
     P2PMessageOptions::Ptr options() const { return m_options; }
-    void setOptions(P2PMessageOptions::Ptr _options) { m_options = _options; }
+    void setOptions(P2PMessageOptions::Ptr _options)
+    {
+        m_options = _options;
+        resetEncodedBody();
+    }
 
     std::shared_ptr<bytes> payload() const { return m_payload; }
-    void setPayload(std::shared_ptr<bytes> _payload) { m_payload = _payload; }
+    void setPayload(std::shared_ptr<bytes> _payload)
+    {
+        m_payload = _payload;
+        resetEncodedBody();
+    }
 
     void setRespPacket() { m_ext |= bcos::protocol::MessageExtFieldFlag::Response; }
     bool encode(bytes& _buffer) override;
+    // encode the header for the current destination, and share the body (options and payload)
+    // encoded by the first call among all the destinations
+    // Note: the options and the payload must not be modified after the message has been sent
+    bool encode(EncodedMessage& _encodedMsg) override;
+    // the options and the payload encoded once, nullptr if the options are invalid
+    virtual std::shared_ptr<const bytes> encodedBody();
     ssize_t decode(bytesConstRef _buffer) override;
+    ssize_t decodeHead(bytesConstRef _buffer, bytesRef& _payload) override;
     bool isRespPacket() const override
     {
         return (m_ext & bcos::protocol::MessageExtFieldFlag::Response) != 0;
@@ -200,6 +221,9 @@ public:
 protected:
     virtual ssize_t decodeHeader(bytesConstRef _buffer);
     virtual bool encodeHeader(bytes& _buffer);
+    virtual bool encodeBody(bytes& _buffer);
+
+    void resetEncodedBody() { std::atomic_store(&m_encodedBody, std::shared_ptr<const bytes>()); }
 
 protected:
     uint32_t m_length = 0;
@@ -218,6 +242,9 @@ protected:
     std::shared_ptr<bytes> m_payload;  ///< payload data
 
     MessageExtAttributes::Ptr m_extAttr = nullptr;  ///< message additional attributes
+
+    // the options and payload encoded by the first session the message is written to
+    std::shared_ptr<const bytes> m_encodedBody;
 };
 
 class P2PMessageFactory : public MessageFactory
@@ -86,6 +86,7 @@ ssize_t P2PMessageV2::decodeHeader(bytesConstRef _buffer)
         m_srcP2PNodeID.assign(&_buffer[offset], &_buffer[offset] + srcP2PNodeIDLen);
     }
     offset += srcP2PNodeIDLen;
+    CHECK_OFFSET_WITH_THROW_EXCEPTION(offset + 2, length);
     // decode dstP2PNodeID, the length of dstP2PNodeID is 2-bytes
     uint16_t dstP2PNodeIDLen =
         boost::asio::detail::socket_ops::network_to_host_short(*((uint16_t*)&_buffer[offset]));
@@ -504,15 +504,47 @@ void Service::asyncBroadcastMessage(P2PMessage::Ptr message, Options options)
 {
     try
     {
-        std::unordered_map<P2pID, P2PSession::Ptr> sessions;
+        std::vector<P2PSession::Ptr> sessions;
         {
             RecursiveGuard l(x_sessions);
-            sessions = m_sessions;
+            sessions.reserve(m_sessions.size());
+            for (auto const& it : m_sessions)
+            {
+                if (it.second->actived())
+                {
+                    sessions.emplace_back(it.second);
+                }
+            }
         }
-
-        for (auto s : sessions)
+        if (sessions.empty())
         {
-            asyncSendMessageByNodeID(s.first, message, CallbackFuncWithSession(), options);
+            return;
+        }
+        if (message->seq() == 0)
+        {
+            message->setSeq(m_messageFactory->newSeq());
+        }
+        // encode the options and payload once, every session encodes its own header and shares
+        // the body in its write queue
+        if (!message->encodedBody())
+        {
+            SERVICE_LOG(WARNING) << LOG_DESC("asyncBroadcastMessage: encode message failed")
+                                 << LOG_KV("packetType", message->packetType())
+                                 << LOG_KV("seq", message->seq());
+            return;
+        }
+        for (auto const& session : sessions)
+        {
+            try
+            {
+                sendMessageToSession(session, message, options, CallbackFuncWithSession());
+            }
+            catch (std::exception& e)
+            {
+                SERVICE_LOG(WARNING) << LOG_DESC("asyncBroadcastMessage")
+                                     << LOG_KV("nodeid", session->p2pID())
+                                     << LOG_KV("what", boost::diagnostic_information(e));
+            }
         }
     }
     catch (std::exception& e)
@@ -28,24 +28,36 @@ using namespace bcos;
 using namespace bcos::gateway;
 using namespace bcos::gateway::ratelimit;
 
+namespace
+{
+// at most one second of permits can be acquired in advance, same as m_maxQPS permits
+constexpr int64_t c_maxAdvanceTime = 1000000000;
+}  // namespace
+
 BWRateLimiter::BWRateLimiter(int64_t _maxQPS)
   : m_maxQPS(_maxQPS),
-    m_permitsUpdateInterval((double)1000000 / (double)m_maxQPS),
-    m_lastPermitsUpdateTime(utcSteadyTimeUs()),
+    m_permitsUpdateInterval((double)1000000000 / (double)m_maxQPS),
     m_maxPermits(m_maxQPS),
-    m_futureBurstResetTime(m_lastPermitsUpdateTime + m_burstTimeInterval)
+    m_permitsTime(now())
 {
     RATELIMIT_LOG(INFO) << LOG_BADGE("[NEWOBJ][BWRateLimiter]")
                         << LOG_KV("permitsUpdateInterval", m_permitsUpdateInterval)
                         << LOG_KV("maxPermits", m_maxPermits);
 }
 
+int64_t BWRateLimiter::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
 void BWRateLimiter::setMaxPermitsSize(int64_t const& _maxPermitsSize)
 {
     m_maxPermits = _maxPermitsSize;
 
     RATELIMIT_LOG(INFO) << LOG_BADGE("setMaxPermitsSize") << LOG_DESC("setMaxPermitsSize")
-                        << LOG_KV("maxPermitsSize", m_maxPermits);
+                        << LOG_KV("maxPermitsSize", _maxPermitsSize);
 }
 
 void BWRateLimiter::setBurstTimeInterval(int64_t const& _burstInterval)
@@ -64,105 +76,50 @@ void BWRateLimiter::setMaxBurstReqNum(int64_t const& _maxBurstReqNum)
                         << LOG_KV("maxBurstReqNum", m_maxBurstReqNum);
 }
 
+// the permits are acquired when no permits acquired in advance are waiting to be refilled, and
+// the permits acquired in advance don't exceed m_maxQPS
 bool BWRateLimiter::tryAcquire(int64_t _requiredPermits)
 {
-    int64_t waitTime = fetchPermitsAndGetWaitTime(_requiredPermits, false, utcSteadyTimeUs());
-    return (waitTime == 0);
-}
-
-void BWRateLimiter::acquire(int64_t _requiredPermits)
-{
-    int64_t waitTime = fetchPermitsAndGetWaitTime(_requiredPermits, false, utcSteadyTimeUs());
-    if (waitTime > 0)
-    {
-        std::this_thread::sleep_for(std::chrono::microseconds(waitTime));
-    }
-    return;
-}
-
-void BWRateLimiter::rollback(int64_t _requiredPermits)
-{
-    Guard l(m_mutex);
-    m_currentStoredPermits += _requiredPermits;
-    if (m_currentStoredPermits > m_maxPermits)
-    {
-        m_currentStoredPermits = m_maxPermits;
-    }
-    return;
-}
-
-int64_t BWRateLimiter::fetchPermitsAndGetWaitTime(
-    int64_t _requiredPermits, bool _fetchPermitsWhenRequireWait, int64_t _now)
-{
-    Guard l(m_mutex);
-    // has remaining permits, handle the request directly
-    if (m_currentStoredPermits > _requiredPermits)
+    auto currentTime = now();
+    auto requiredTime = permitsTime(_requiredPermits);
+    auto permitsTime = m_permitsTime.load(std::memory_order_relaxed);
+    while (true)
     {
-        m_currentStoredPermits -= _requiredPermits;
-        return 0;
-    }
-
-    // update the permits
-    updatePermits(_now);
-    int64_t waitAvailableTime = m_lastPermitsUpdateTime - _now;
-    // _fetchPermitsWhenRequireWait is false: don't fetch permits after timeout
-    // _fetchPermitsWhenRequireWait is true: fetch permits after timeout
-    if (!_fetchPermitsWhenRequireWait)
-    {
-        if (waitAvailableTime > 0)
+        // the stored permits never exceed m_maxPermits
+        auto fromTime = std::max(permitsTime, currentTime - this->permitsTime(m_maxPermits));
+        if (fromTime > currentTime || fromTime + requiredTime - currentTime >= c_maxAdvanceTime)
         {
-            return waitAvailableTime;
+            return false;
         }
-        // Only permits of m_maxQPS can be used in advance
-        if ((_requiredPermits - m_currentStoredPermits) >= m_maxQPS)
+        if (m_permitsTime.compare_exchange_weak(permitsTime, fromTime + requiredTime,
+                std::memory_order_acq_rel, std::memory_order_relaxed))
         {
-            // Indicates that the permits was not obtained
-            return 1;
+            return true;
         }
     }
-    if ((waitAvailableTime > 0 || (_requiredPermits - m_currentStoredPermits) >= m_maxQPS) &&
-        !_fetchPermitsWhenRequireWait)
-    {
-        return waitAvailableTime;
-    }
-    updateCurrentStoredPermits(_requiredPermits);
-    return std::max(waitAvailableTime, (int64_t)0);
 }
 
-void BWRateLimiter::updateCurrentStoredPermits(int64_t _requiredPermits)
+// acquire the permits in any case, and wait for the permits acquired in advance before
+void BWRateLimiter::acquire(int64_t _requiredPermits)
 {
-    double waitTime = 0;
-
-    if (_requiredPermits > m_currentStoredPermits)
-    {
-        waitTime = (_requiredPermits - m_currentStoredPermits) * m_permitsUpdateInterval;
-        m_currentStoredPermits = 0;
-    }
-    else
+    auto currentTime = now();
+    auto requiredTime = permitsTime(_requiredPermits);
+    auto permitsTime = m_permitsTime.load(std::memory_order_relaxed);
+    int64_t fromTime = 0;
+    do
     {
-        m_currentStoredPermits -= _requiredPermits;
-    }
-    if (waitTime > 0)
+        fromTime = std::max(permitsTime, currentTime - this->permitsTime(m_maxPermits));
+    } while (!m_permitsTime.compare_exchange_weak(permitsTime, fromTime + requiredTime,
+        std::memory_order_acq_rel, std::memory_order_relaxed));
+
+    if (fromTime > currentTime)
     {
-        m_lastPermitsUpdateTime += (int64_t)(waitTime);
+        std::this_thread::sleep_for(std::chrono::nanoseconds(fromTime - currentTime));
     }
 }
 
-void BWRateLimiter::updatePermits(int64_t _now)
+void BWRateLimiter::rollback(int64_t _requiredPermits)
 {
-    if (_now <= m_lastPermitsUpdateTime)
-    {
-        return;
-    }
-    int64_t increasedPermits = (double)(_now - m_lastPermitsUpdateTime) / m_permitsUpdateInterval;
-    m_currentStoredPermits = std::min(m_maxPermits, m_currentStoredPermits + increasedPermits);
-    // update last permits update time
-    if (m_currentStoredPermits == m_maxPermits)
-    {
-        m_lastPermitsUpdateTime = _now;
-    }
-    else
-    {
-        m_lastPermitsUpdateTime += increasedPermits * m_permitsUpdateInterval;
-    }
+    // the permits over m_maxPermits are dropped by the next acquisition
+    m_permitsTime.fetch_sub(permitsTime(_requiredPermits), std::memory_order_acq_rel);
 }
@@ -24,6 +24,7 @@
 
 #include <bcos-gateway/libratelimit/BWRateLimiterInterface.h>
 #include <bcos-utilities/Common.h>
+#include <atomic>
 
 namespace bcos
 {
@@ -81,30 +82,27 @@ public:
     void setMaxBurstReqNum(int64_t const& _maxBurstReqNum);
 
 protected:
-    int64_t fetchPermitsAndGetWaitTime(
-        int64_t _requiredPermits, bool _fetchPermitsWhenRequireWait, int64_t _now);
-
-    void updatePermits(int64_t _now);
-
-    void updateCurrentStoredPermits(int64_t _requiredPermits);
+    // the steady time in nanoseconds
+    static int64_t now();
+    // the time in nanoseconds to refill the permits
+    int64_t permitsTime(int64_t _permits) const
+    {
+        return (int64_t)((double)_permits * m_permitsUpdateInterval);
+    }
 
 private:
-    mutable bcos::Mutex m_mutex;
-
     // the max QPS
     int64_t m_maxQPS;
-
-    // stored permits
-    std::atomic<int64_t> m_currentStoredPermits = 0;
-
-    // the interval time to update storedPermits
+    // the interval time in nanoseconds to refill a permit
     double m_permitsUpdateInterval;
-    int64_t m_lastPermitsUpdateTime;
-    int64_t m_maxPermits = 0;
+    std::atomic<int64_t> m_maxPermits = {0};
+
+    // the token bucket is a single atomic, updated with CAS without any lock:
+    // the bucket is full when m_permitsTime <= now - permitsTime(m_maxPermits), the stored permits
+    // are (now - m_permitsTime) / m_permitsUpdateInterval, and m_permitsTime > now means the
+    // permits acquired in advance that are not refilled yet
+    std::atomic<int64_t> m_permitsTime = {0};
 
-    std::atomic<int64_t> m_futureBurstResetTime;
-    // the current burstReqNum, every m_burstTimeInterval is refreshed to 0
-    std::atomic<int64_t> m_burstReqNum = {0};
     // the max burst num during m_burstTimeInterval
     int64_t m_maxBurstReqNum = 0;
     // default burst interval is 1s
@@ -20,6 +20,7 @@
 
 #include "bcos-gateway/Common.h"
 #include <bcos-gateway/libratelimit/RateLimiterManager.h>
+#include <array>
 
 using namespace bcos;
 using namespace bcos::gateway;
@@ -29,9 +30,9 @@ const std::string RateLimiterManager::TOTAL_OUTGOING_KEY = "total-outgoing-key";
 
 BWRateLimiterInterface::Ptr RateLimiterManager::getRateLimiter(const std::string& _rateLimiterKey)
 {
-    std::shared_lock lock(x_rateLimiters);
-    auto it = m_rateLimiters.find(_rateLimiterKey);
-    if (it != m_rateLimiters.end())
+    auto rateLimiters = std::atomic_load(&m_rateLimiters);
+    auto it = rateLimiters->find(_rateLimiterKey);
+    if (it != rateLimiters->end())
     {
         return it->second;
     }
@@ -50,8 +51,10 @@ bool RateLimiterManager::registerRateLimiter(
     RATELIMIT_LOG(INFO) << LOG_BADGE("registerRateLimiter")
                         << LOG_KV("rateLimiterKey", _rateLimiterKey);
 
-    std::unique_lock lock(x_rateLimiters);
-    auto result = m_rateLimiters.try_emplace(_rateLimiterKey, _rateLimiter);
+    std::lock_guard lock(x_rateLimiters);
+    auto rateLimiters = std::make_shared<RateLimiters>(*m_rateLimiters);
+    auto result = rateLimiters->try_emplace(_rateLimiterKey, _rateLimiter);
+    std::atomic_store(&m_rateLimiters, std::shared_ptr<const RateLimiters>(rateLimiters));
     return result.second;
 }
 
@@ -60,8 +63,15 @@ bool RateLimiterManager::removeRateLimiter(const std::string& _rateLimiterKey)
     RATELIMIT_LOG(INFO) << LOG_BADGE("removeRateLimiter")
                         << LOG_KV("rateLimiterKey", _rateLimiterKey);
 
-    std::unique_lock lock(x_rateLimiters);
-    return m_rateLimiters.erase(_rateLimiterKey) > 0;
+    std::lock_guard lock(x_rateLimiters);
+    if (!m_rateLimiters->count(_rateLimiterKey))
+    {
+        return false;
+    }
+    auto rateLimiters = std::make_shared<RateLimiters>(*m_rateLimiters);
+    rateLimiters->erase(_rateLimiterKey);
+    std::atomic_store(&m_rateLimiters, std::shared_ptr<const RateLimiters>(rateLimiters));
+    return true;
 }
 
 BWRateLimiterInterface::Ptr RateLimiterManager::ensureRateLimiterExist(
@@ -82,15 +92,17 @@ BWRateLimiterInterface::Ptr RateLimiterManager::ensureRateLimiterExist(
     rateLimiter = m_rateLimiterFactory->buildRateLimiter(_maxPermits);
 
     {
-        std::unique_lock lock(x_rateLimiters);
-        auto it = m_rateLimiters.find(_rateLimiterKey);
-        if (it != m_rateLimiters.end())
+        std::lock_guard lock(x_rateLimiters);
+        auto it = m_rateLimiters->find(_rateLimiterKey);
+        if (it != m_rateLimiters->end())
         {
             rateLimiter = it->second;
         }
         else
         {
-            m_rateLimiters[_rateLimiterKey] = rateLimiter;
+            auto rateLimiters = std::make_shared<RateLimiters>(*m_rateLimiters);
+            (*rateLimiters)[_rateLimiterKey] = rateLimiter;
+            std::atomic_store(&m_rateLimiters, std::shared_ptr<const RateLimiters>(rateLimiters));
         }
     }
 
@@ -175,4 +187,80 @@ BWRateLimiterInterface::Ptr RateLimiterManager::getConnRateLimiter(const std::st
     }
 
     return rateLimiter;
-}
\ No newline at end of file
+}
+bool RateLimiterManager::registerModuleRateLimiter(
+    uint16_t _moduleID, BWRateLimiterInterface::Ptr _rateLimiter)
+{
+    return registerRateLimiter("module-" + std::to_string(_moduleID), _rateLimiter);
+}
+
+bool RateLimiterManager::removeModuleRateLimiter(uint16_t _moduleID)
+{
+    return removeRateLimiter("module-" + std::to_string(_moduleID));
+}
+
+BWRateLimiterInterface::Ptr RateLimiterManager::getModuleRateLimiter(uint16_t _moduleID)
+{
+    std::string rateLimiterKey = "module-" + std::to_string(_moduleID);
+
+    auto rateLimiter = getRateLimiter(rateLimiterKey);
+
+    if (rateLimiter == nullptr)
+    {
+        auto it = m_rateLimitConfig.module2BwLimit.find(_moduleID);
+        if (it != m_rateLimitConfig.module2BwLimit.end() && it->second > 0)
+        {
+            rateLimiter = ensureRateLimiterExist(rateLimiterKey, it->second);
+        }
+    }
+
+    return rateLimiter;
+}
+
+RateLimitLevel RateLimiterManager::tryAcquire(const std::string& _connIP,
+    const std::string& _groupID, uint16_t _moduleID, int64_t _requiredPermits)
+{
+    std::array<std::pair<RateLimitLevel, BWRateLimiterInterface::Ptr>, 4> rateLimiters;
+    size_t rateLimitersSize = 0;
+    auto addRateLimiter = [&](RateLimitLevel _level, BWRateLimiterInterface::Ptr _rateLimiter) {
+        if (_rateLimiter)
+        {
+            rateLimiters[rateLimitersSize++] = {_level, std::move(_rateLimiter)};
+        }
+    };
+    addRateLimiter(RateLimitLevel::Total, getRateLimiter(TOTAL_OUTGOING_KEY));
+    // the p2p's own message is not limited by the group and the module
+    if (_moduleID != 0 && !_groupID.empty())
+    {
+        addRateLimiter(RateLimitLevel::Group, getGroupRateLimiter(_groupID));
+    }
+    addRateLimiter(RateLimitLevel::Conn, getConnRateLimiter(_connIP));
+    if (_moduleID != 0)
+    {
+        addRateLimiter(RateLimitLevel::Module, getModuleRateLimiter(_moduleID));
+    }
+
+    // the p2p's own message and the message of the modules without limit only consume the permits
+    if (_moduleID == 0 || m_modulesWithNoBwLimit.count(_moduleID))
+    {
+        for (size_t i = 0; i < rateLimitersSize; ++i)
+        {
+            rateLimiters[i].second->tryAcquire(_requiredPermits);
+        }
+        return RateLimitLevel::None;
+    }
+
+    for (size_t i = 0; i < rateLimitersSize; ++i)
+    {
+        if (rateLimiters[i].second->tryAcquire(_requiredPermits))
+        {
+            continue;
+        }
+        for (size_t j = 0; j < i; ++j)
+        {
+            rateLimiters[j].second->rollback(_requiredPermits);
+        }
+        return rateLimiters[i].first;
+    }
+    return RateLimitLevel::None;
+}
@@ -24,7 +24,7 @@
 #include "bcos-gateway/libratelimit/ModuleWhiteList.h"
 #include <bcos-gateway/GatewayConfig.h>
 #include <bcos-utilities/Common.h>
-#include <shared_mutex>
+#include <mutex>
 #include <unordered_map>
 
 namespace bcos
@@ -34,6 +34,16 @@ namespace gateway
 namespace ratelimit
 {
 
+// the levels of the outgoing bandwidth limit, a message acquires the permits from every level
+enum class RateLimitLevel : int
+{
+    None = 0,
+    Total,
+    Group,
+    Conn,
+    Module,
+};
+
 class RateLimiterManager
 {
 public:
@@ -74,6 +84,26 @@ public:
 
     BWRateLimiterInterface::Ptr getConnRateLimiter(const std::string& _connIP);
 
+    bool registerModuleRateLimiter(uint16_t _moduleID, BWRateLimiterInterface::Ptr _rateLimiter);
+
+    bool removeModuleRateLimiter(uint16_t _moduleID);
+
+    BWRateLimiterInterface::Ptr getModuleRateLimiter(uint16_t _moduleID);
+
+    /**
+     * @brief acquire the permits of the message from the limiters of all the levels in one pass:
+     * total -> group -> connection -> module, the permits acquired are rolled back when any level
+     * overflows
+     *
+     * @param _connIP: the ip of the connection
+     * @param _groupID: the group of the message, empty means the p2p's own message
+     * @param _moduleID: the module of the message, zero means the p2p's own message
+     * @param _requiredPermits: the length of the message
+     * @return the level overflows, RateLimitLevel::None if the permits are acquired
+     */
+    RateLimitLevel tryAcquire(const std::string& _connIP, const std::string& _groupID,
+        uint16_t _moduleID, int64_t _requiredPermits);
+
 public:
     ratelimit::BWRateLimiterFactory::Ptr rateLimiterFactory() const { return m_rateLimiterFactory; }
     void setRateLimiterFactory(ratelimit::BWRateLimiterFactory::Ptr _rateLimiterFactory)
@@ -97,10 +127,12 @@ private:
     //   factory for BWRateLimiterInterface
     ratelimit::BWRateLimiterFactory::Ptr m_rateLimiterFactory;
 
-    // lock for m_group2RateLimiter
-    mutable std::shared_mutex x_rateLimiters;
-    // group/ip => ratelimiter
-    std::unordered_map<std::string, BWRateLimiterInterface::Ptr> m_rateLimiters;
+    using RateLimiters = std::unordered_map<std::string, BWRateLimiterInterface::Ptr>;
+    // serialize the writers of m_rateLimiters
+    mutable std::mutex x_rateLimiters;
+    // group/ip/module => ratelimiter, the readers load the immutable snapshot without any lock,
+    // the writers copy the snapshot and publish the new one, the limiters are rarely registered
+    std::shared_ptr<const RateLimiters> m_rateLimiters = std::make_shared<const RateLimiters>();
 
     // the message of modules that do not limit bandwidth
     std::set<uint16_t> m_modulesWithNoBwLimit;
@@ -0,0 +1,74 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the local stand-in of the distributed rate limiter
+ * @file FakeDistributedRateLimiter.h
+ */
+#pragma once
+
+#include <bcos-gateway/libratelimit/BWRateLimiter.h>
+#include <atomic>
+
+namespace bcos
+{
+namespace test
+{
+// FakeDistributedRateLimiter stands in for the limiter shared by the gateways of a cluster: all
+// the gateways built with the same FakeDistributedRateLimiter::Ptr acquire the permits from the
+// same in-process bucket, and the requests are counted to check the traffic of every gateway
+class FakeDistributedRateLimiter : public bcos::gateway::ratelimit::BWRateLimiterInterface
+{
+public:
+    using Ptr = std::shared_ptr<FakeDistributedRateLimiter>;
+    FakeDistributedRateLimiter(int64_t _maxQPS)
+      : m_bucket(std::make_shared<bcos::gateway::ratelimit::BWRateLimiter>(_maxQPS))
+    {}
+    ~FakeDistributedRateLimiter() override {}
+
+    void acquire(int64_t _requiredPermits) override
+    {
+        m_requests++;
+        m_bucket->acquire(_requiredPermits);
+    }
+
+    bool tryAcquire(int64_t _requiredPermits) override
+    {
+        m_requests++;
+        auto ret = m_bucket->tryAcquire(_requiredPermits);
+        if (ret)
+        {
+            m_acquiredPermits += _requiredPermits;
+        }
+        return ret;
+    }
+
+    void rollback(int64_t _requiredPermits) override
+    {
+        m_rollbackPermits += _requiredPermits;
+        m_bucket->rollback(_requiredPermits);
+    }
+
+    int64_t requests() const { return m_requests; }
+    int64_t acquiredPermits() const { return m_acquiredPermits; }
+    int64_t rollbackPermits() const { return m_rollbackPermits; }
+
+private:
+    std::shared_ptr<bcos::gateway::ratelimit::BWRateLimiter> m_bucket;
+    std::atomic<int64_t> m_requests = {0};
+    std::atomic<int64_t> m_acquiredPermits = {0};
+    std::atomic<int64_t> m_rollbackPermits = {0};
+};
+}  // namespace test
+}  // namespace bcos
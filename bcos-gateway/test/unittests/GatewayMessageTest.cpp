@@ -421,6 +421,72 @@ BOOST_AUTO_TEST_CASE(test_P2PMessageV2_codec)
     testP2PMessageCodec(factory, 1);
 }
 
+void testP2PMessageSharedBody(std::shared_ptr<MessageFactory> factory, uint32_t _version = 0)
+{
+    auto encodeMsg = std::static_pointer_cast<P2PMessage>(factory->buildMessage());
+    encodeMsg->setVersion(_version);
+    encodeMsg->setSeq(0x12345678);
+    encodeMsg->setPacketType(GatewayMessageType::BroadcastMessage);
+    encodeMsg->setPayload(std::make_shared<bytes>(10000, 'a'));
+    std::string srcNodeID = "nodeID";
+    encodeMsg->options()->setGroupID("group");
+    encodeMsg->options()->setSrcNodeID(std::make_shared<bytes>(srcNodeID.begin(), srcNodeID.end()));
+
+    // every destination encodes its own header and shares the body
+    std::vector<std::string> dstP2PNodeIDs = {"node1", "node2", "node3"};
+    std::vector<EncodedMessage> encodedMsgs(dstP2PNodeIDs.size());
+    for (size_t i = 0; i < dstP2PNodeIDs.size(); ++i)
+    {
+        encodeMsg->setDstP2PNodeID(dstP2PNodeIDs[i]);
+        BOOST_CHECK(encodeMsg->encode(encodedMsgs[i]));
+        BOOST_CHECK(encodedMsgs[i].payload);
+        BOOST_CHECK_EQUAL(encodedMsgs[i].payload.get(), encodedMsgs[0].payload.get());
+
+        // the shared frame is the same as the message encoded into a single buffer
+        bytes buffer;
+        BOOST_CHECK(encodeMsg->encode(buffer));
+        bytes frame = encodedMsgs[i].header;
+        frame.insert(frame.end(), encodedMsgs[i].payload->begin(), encodedMsgs[i].payload->end());
+        BOOST_CHECK(frame == buffer);
+        BOOST_CHECK_EQUAL(encodedMsgs[i].size(), buffer.size());
+
+        auto decodeMsg = std::static_pointer_cast<P2PMessage>(factory->buildMessage());
+        BOOST_CHECK_EQUAL(decodeMsg->decode(ref(frame)), frame.size());
+        BOOST_CHECK_EQUAL(decodeMsg->seq(), 0x12345678);
+        BOOST_CHECK_EQUAL(decodeMsg->payload()->size(), 10000);
+        BOOST_CHECK_EQUAL(decodeMsg->options()->groupID(), "group");
+        if (_version > 0)
+        {
+            BOOST_CHECK_EQUAL(decodeMsg->dstP2PNodeID(), dstP2PNodeIDs[i]);
+        }
+    }
+
+    // the body is encoded again after the payload changes
+    encodeMsg->setPayload(std::make_shared<bytes>(100, 'b'));
+    EncodedMessage encodedMsg;
+    BOOST_CHECK(encodeMsg->encode(encodedMsg));
+    BOOST_CHECK(encodedMsg.payload.get() != encodedMsgs[0].payload.get());
+    BOOST_CHECK_EQUAL(encodedMsg.payload->back(), 'b');
+
+    // the invalid options are not encoded
+    auto invalidMsg = std::static_pointer_cast<P2PMessage>(factory->buildMessage());
+    invalidMsg->setPacketType(GatewayMessageType::PeerToPeerMessage);
+    BOOST_CHECK(!invalidMsg->encodedBody());
+    BOOST_CHECK(!invalidMsg->encode(encodedMsg));
+}
+
+BOOST_AUTO_TEST_CASE(test_P2PMessage_sharedBody)
+{
+    auto factory = std::make_shared<P2PMessageFactory>();
+    testP2PMessageSharedBody(factory);
+}
+
+BOOST_AUTO_TEST_CASE(test_P2PMessageV2_sharedBody)
+{
+    auto factory = std::make_shared<P2PMessageFactoryV2>();
+    testP2PMessageSharedBody(factory, 1);
+}
+
 BOOST_AUTO_TEST_CASE(test_P2PMessage_attr)
 {
     auto attr = std::make_shared<GatewayMessageExtAttributes>();
@@ -0,0 +1,202 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for MessageReader
+ * @file MessageReaderTest.cpp
+ */
+
+#include <bcos-gateway/Common.h>
+#include <bcos-gateway/libnetwork/MessageReader.h>
+#include <bcos-gateway/libp2p/P2PMessage.h>
+#include <bcos-gateway/libp2p/P2PMessageV2.h>
+#include <bcos-utilities/DataConvertUtility.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <cstring>
+
+using namespace bcos;
+using namespace bcos::gateway;
+using namespace bcos::test;
+
+namespace
+{
+bytes encodeMessage(MessageFactory::Ptr _factory, uint32_t _seq, size_t _payloadSize,
+    bool _withOptions, uint16_t _version = 0)
+{
+    auto msg = std::static_pointer_cast<P2PMessage>(_factory->buildMessage());
+    msg->setVersion(_version);
+    msg->setSeq(_seq);
+    msg->setPayload(std::make_shared<bytes>(_payloadSize, (byte)_seq));
+    if (_withOptions)
+    {
+        msg->setPacketType(GatewayMessageType::PeerToPeerMessage);
+        auto options = std::make_shared<P2PMessageOptions>();
+        options->setGroupID("group0");
+        options->setModuleID(1001);
+        options->setSrcNodeID(std::make_shared<bytes>(64, 's'));
+        options->setDstNodeIDs({std::make_shared<bytes>(64, 'd')});
+        msg->setOptions(options);
+    }
+    else
+    {
+        msg->setPacketType(0x4321);
+    }
+    bytes buffer;
+    BOOST_REQUIRE(msg->encode(buffer));
+    return buffer;
+}
+
+// feed the stream to the reader in reads of at most _readSize bytes
+bool feed(MessageReader& _reader, bytes const& _stream, size_t _readSize,
+    std::vector<Message::Ptr>& _messages)
+{
+    size_t offset = 0;
+    while (offset < _stream.size())
+    {
+        auto buffer = _reader.readBuffer();
+        BOOST_REQUIRE(buffer.size() > 0);
+        auto size = std::min({buffer.size(), _readSize, _stream.size() - offset});
+        std::memcpy(buffer.data(), _stream.data() + offset, size);
+        offset += size;
+        auto decoded =
+            _reader.onRead(size, [&_messages](NetworkException const& e, Message::Ptr _msg) {
+                if (e.errorCode() == P2PExceptionType::Success)
+                {
+                    _messages.push_back(_msg);
+                }
+            });
+        if (!decoded)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void testReadMessages(MessageFactory::Ptr _factory, uint16_t _version)
+{
+    bytes stream;
+    std::vector<size_t> payloadSizes;
+    for (uint32_t i = 0; i < 200; ++i)
+    {
+        // mostly small messages, with a few larger than the buffer
+        auto payloadSize = (i % 50 == 49) ? (size_t)(1024 * 1024 + i) : (size_t)(i % 7) * 30;
+        auto buffer = encodeMessage(_factory, i, payloadSize, i % 2 == 0, _version);
+        stream.insert(stream.end(), buffer.begin(), buffer.end());
+        payloadSizes.push_back(payloadSize);
+    }
+
+    for (auto readSize : {1UL, 7UL, 100UL, 4096UL, 65536UL})
+    {
+        MessageReader reader(_factory, 4096);
+        std::vector<Message::Ptr> messages;
+        BOOST_REQUIRE(feed(reader, stream, readSize, messages));
+        BOOST_REQUIRE_EQUAL(messages.size(), payloadSizes.size());
+        for (size_t i = 0; i < messages.size(); ++i)
+        {
+            auto msg = std::static_pointer_cast<P2PMessage>(messages[i]);
+            BOOST_CHECK_EQUAL(msg->seq(), i);
+            BOOST_CHECK_EQUAL(msg->version(), _version);
+            BOOST_REQUIRE_EQUAL(msg->payload()->size(), payloadSizes[i]);
+            BOOST_CHECK(std::all_of(msg->payload()->begin(), msg->payload()->end(),
+                [i](byte _b) { return _b == (byte)i; }));
+            if (i % 2 == 0)
+            {
+                BOOST_CHECK_EQUAL(msg->options()->groupID(), "group0");
+                BOOST_CHECK_EQUAL(msg->options()->moduleID(), 1001);
+                BOOST_CHECK_EQUAL(msg->options()->dstNodeIDs().size(), 1);
+            }
+        }
+        BOOST_CHECK_EQUAL(reader.pendingSize(), 0);
+        // the large messages never grow the buffer
+        BOOST_CHECK_EQUAL(reader.bufferSize(), 4096);
+    }
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(MessageReaderTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(test_readMessages)
+{
+    testReadMessages(std::make_shared<P2PMessageFactory>(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_readMessagesV2)
+{
+    testReadMessages(std::make_shared<P2PMessageFactoryV2>(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_largeMessageHeaderFirst)
+{
+    auto factory = std::make_shared<P2PMessageFactory>();
+    auto stream = encodeMessage(factory, 1, 100000, true);
+    MessageReader reader(factory, 1024);
+
+    std::vector<Message::Ptr> messages;
+    auto handler = [&messages](NetworkException const&, Message::Ptr _msg) {
+        messages.push_back(_msg);
+    };
+    auto buffer = reader.readBuffer();
+    BOOST_REQUIRE_EQUAL(buffer.size(), 1024);
+    std::memcpy(buffer.data(), stream.data(), buffer.size());
+    BOOST_CHECK(reader.onRead(buffer.size(), handler));
+    BOOST_CHECK(messages.empty());
+
+    // the rest of the message is read into the payload directly
+    buffer = reader.readBuffer();
+    BOOST_REQUIRE_EQUAL(buffer.size(), stream.size() - 1024);
+    std::memcpy(buffer.data(), stream.data() + 1024, buffer.size());
+    BOOST_CHECK(reader.onRead(buffer.size(), handler));
+    BOOST_REQUIRE_EQUAL(messages.size(), 1);
+    auto msg = std::static_pointer_cast<P2PMessage>(messages[0]);
+    BOOST_CHECK_EQUAL(msg->payload()->size(), 100000);
+    BOOST_CHECK_EQUAL(msg->options()->groupID(), "group0");
+    BOOST_CHECK_EQUAL(reader.readBuffer().size(), 1024);
+}
+
+BOOST_AUTO_TEST_CASE(test_invalidMessage)
+{
+    auto factory = std::make_shared<P2PMessageFactory>();
+    std::string invalidMessage =
+        "GET / HTTP/1.1\r\nHost: 127.0.0.1:20200\r\nUpgrade: websocket\r\nConnection: "
+        "upgrade\r\nSec-WebSocket-Key: lkBb9dFFu4tuMNJyXAWIfQ==\r\nSec-WebSocket-Version: "
+        "13\r\n\r\n";
+    auto stream = asBytes(invalidMessage);
+    stream.resize(8192, 'a');
+
+    MessageReader reader(factory, 4096);
+    int errors = 0;
+    bool decoded = true;
+    size_t offset = 0;
+    while (decoded && offset < stream.size())
+    {
+        auto buffer = reader.readBuffer();
+        auto size = std::min(buffer.size(), stream.size() - offset);
+        std::memcpy(buffer.data(), stream.data() + offset, size);
+        offset += size;
+        decoded = reader.onRead(size, [&errors](NetworkException const& e, Message::Ptr) {
+            if (e.errorCode() == P2PExceptionType::ProtocolError)
+            {
+                errors++;
+            }
+        });
+    }
+    // the length field is larger than the max message length
+    BOOST_CHECK(!decoded);
+    BOOST_CHECK_EQUAL(errors, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
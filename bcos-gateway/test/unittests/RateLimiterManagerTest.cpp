@@ -19,11 +19,13 @@
  * @date 2021-05-17
  */
 
+#include "../common/FakeDistributedRateLimiter.h"
 #include <bcos-gateway/GatewayConfig.h>
 #include <bcos-gateway/GatewayFactory.h>
 #include <bcos-utilities/testutils/TestPromptFixture.h>
 #include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
+#include <thread>
 
 using namespace bcos;
 using namespace gateway;
@@ -165,5 +167,103 @@ BOOST_AUTO_TEST_CASE(test_rateLimiterManagerConfigIPv6)
     BOOST_CHECK(!rateLimiterManager->removeRateLimiter("ip-127.0.0.1"));
 }
 
+BOOST_AUTO_TEST_CASE(test_tokenBucket)
+{
+    auto rateLimiter = std::make_shared<ratelimit::BWRateLimiter>(1000);
+    // at most maxQPS permits can be acquired in advance
+    BOOST_CHECK(!rateLimiter->tryAcquire(1000));
+    BOOST_CHECK(rateLimiter->tryAcquire(500));
+    // the permits acquired in advance must be refilled first
+    BOOST_CHECK(!rateLimiter->tryAcquire(1));
+    rateLimiter->rollback(500);
+    BOOST_CHECK(rateLimiter->tryAcquire(900));
+
+    // the permits are not over acquired by the concurrent requests
+    auto concurrentLimiter = std::make_shared<ratelimit::BWRateLimiter>(100000);
+    std::atomic<int64_t> acquiredPermits = 0;
+    auto startTime = utcSteadyTime();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 32; ++i)
+    {
+        threads.emplace_back([&concurrentLimiter, &acquiredPermits]() {
+            for (int j = 0; j < 1000; ++j)
+            {
+                acquiredPermits += concurrentLimiter->tryAcquire(10) ? 10 : 0;
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    auto refilledPermits = (int64_t)(utcSteadyTime() - startTime + 1) * 100;
+    BOOST_CHECK(acquiredPermits > 0);
+    BOOST_CHECK_LE(acquiredPermits, 100000 + refilledPermits);
+}
+
+BOOST_AUTO_TEST_CASE(test_hierarchicalRateLimit)
+{
+    bcos::gateway::GatewayConfig::RateLimitConfig rateLimitConfig;
+    rateLimitConfig.totalOutgoingBwLimit = 10000;
+    rateLimitConfig.ip2BwLimit["192.108.0.1"] = 1000;
+    rateLimitConfig.group2BwLimit["group0"] = 5000;
+    rateLimitConfig.module2BwLimit[1000] = 2000;
+    rateLimitConfig.modulesWithNoBwLimit = {1001};
+    auto gatewayFactory = std::make_shared<GatewayFactory>("", "");
+    auto rateLimiterManager = gatewayFactory->buildRateLimitManager(rateLimitConfig);
+    BOOST_CHECK(rateLimiterManager->getModuleRateLimiter(1000) != nullptr);
+    BOOST_CHECK(rateLimiterManager->getModuleRateLimiter(1002) == nullptr);
+
+    // the connection overflows, the permits of the total and the group are rolled back
+    auto level = rateLimiterManager->tryAcquire("192.108.0.1", "group0", 1000, 1500);
+    BOOST_CHECK(level == ratelimit::RateLimitLevel::Conn);
+    BOOST_CHECK(rateLimiterManager->getGroupRateLimiter("group0")->tryAcquire(4900));
+
+    // the module overflows
+    level = rateLimiterManager->tryAcquire("192.108.0.2", "group1", 1000, 2500);
+    BOOST_CHECK(level == ratelimit::RateLimitLevel::Module);
+    // the group overflows
+    level = rateLimiterManager->tryAcquire("192.108.0.2", "group0", 1002, 100);
+    BOOST_CHECK(level == ratelimit::RateLimitLevel::Group);
+    level = rateLimiterManager->tryAcquire("192.108.0.2", "group1", 1000, 1500);
+    BOOST_CHECK(level == ratelimit::RateLimitLevel::None);
+    // the total overflows
+    level = rateLimiterManager->tryAcquire("192.108.0.2", "group1", 1002, 9000);
+    BOOST_CHECK(level == ratelimit::RateLimitLevel::Total);
+
+    // the module without limit and the p2p's own message never overflow
+    level = rateLimiterManager->tryAcquire("192.108.0.2", "group0", 1001, 100);
+    BOOST_CHECK(level == ratelimit::RateLimitLevel::None);
+    level = rateLimiterManager->tryAcquire("192.108.0.2", "", 0, 100);
+    BOOST_CHECK(level == ratelimit::RateLimitLevel::None);
+}
+
+BOOST_AUTO_TEST_CASE(test_distributedRateLimit)
+{
+    // two gateways share the bandwidth of the group
+    auto groupRateLimiter = std::make_shared<FakeDistributedRateLimiter>(1000);
+    bcos::gateway::GatewayConfig::RateLimitConfig rateLimitConfig;
+    auto gatewayFactory = std::make_shared<GatewayFactory>("", "");
+    auto rateLimiterManager0 = gatewayFactory->buildRateLimitManager(rateLimitConfig);
+    auto rateLimiterManager1 = gatewayFactory->buildRateLimitManager(rateLimitConfig);
+    BOOST_CHECK(rateLimiterManager0->registerGroupRateLimiter("group0", groupRateLimiter));
+    BOOST_CHECK(rateLimiterManager1->registerGroupRateLimiter("group0", groupRateLimiter));
+    rateLimiterManager1->registerConnRateLimiter(
+        "192.108.0.1", std::make_shared<ratelimit::BWRateLimiter>(100));
+
+    auto level = rateLimiterManager0->tryAcquire("192.108.0.1", "group0", 1000, 600);
+    BOOST_CHECK(level == ratelimit::RateLimitLevel::None);
+    // the group overflows on the other gateway
+    level = rateLimiterManager1->tryAcquire("192.108.0.2", "group0", 1000, 100);
+    BOOST_CHECK(level == ratelimit::RateLimitLevel::Group);
+    BOOST_CHECK_EQUAL(groupRateLimiter->requests(), 2);
+    BOOST_CHECK_EQUAL(groupRateLimiter->acquiredPermits(), 600);
+
+    // the connection of the other gateway overflows, the group permits are rolled back
+    groupRateLimiter->rollback(600);
+    level = rateLimiterManager1->tryAcquire("192.108.0.1", "group0", 1000, 200);
+    BOOST_CHECK(level == ratelimit::RateLimitLevel::Conn);
+    BOOST_CHECK_EQUAL(groupRateLimiter->rollbackPermits(), 800);
+}
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -19,6 +19,7 @@
  * @date 2021-06-21
  */
 #include "bcos-gateway/libamop/AirTopicManager.h"
+#include <bcos-gateway/libamop/TopicIndex.h>
 #include <bcos-gateway/libamop/TopicManager.h>
 #include <bcos-utilities/testutils/TestPromptFixture.h>
 #include <boost/test/unit_test.hpp>
@@ -136,4 +137,58 @@ BOOST_AUTO_TEST_CASE(test_subTopics)
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_queryClientsByTopic)
+{
+    auto topicManager = std::make_shared<LocalTopicManager>("", nullptr);
+    auto queryClients = [&topicManager](std::string const& _topic) {
+        std::vector<std::string> clients;
+        topicManager->queryClientsByTopic(_topic, clients);
+        std::sort(clients.begin(), clients.end());
+        return clients;
+    };
+
+    topicManager->subTopic("client0", TopicItems{TopicItem("topic0"), TopicItem("topic1")});
+    topicManager->subTopic("client1", TopicItems{TopicItem("topic1"), TopicItem("topic2")});
+    BOOST_CHECK(queryClients("topic0") == std::vector<std::string>({"client0"}));
+    BOOST_CHECK(queryClients("topic1") == std::vector<std::string>({"client0", "client1"}));
+    BOOST_CHECK(queryClients("topic2") == std::vector<std::string>({"client1"}));
+    BOOST_CHECK(queryClients("topic3").empty());
+
+    // override the topics of client0
+    topicManager->subTopic("client0", TopicItems{TopicItem("topic2"), TopicItem("topic3")});
+    BOOST_CHECK(queryClients("topic0").empty());
+    BOOST_CHECK(queryClients("topic1") == std::vector<std::string>({"client1"}));
+    BOOST_CHECK(queryClients("topic2") == std::vector<std::string>({"client0", "client1"}));
+    BOOST_CHECK(queryClients("topic3") == std::vector<std::string>({"client0"}));
+
+    topicManager->removeTopics("client1", {"topic2", "topic4"});
+    BOOST_CHECK(queryClients("topic2") == std::vector<std::string>({"client0"}));
+    BOOST_CHECK(queryClients("topic1") == std::vector<std::string>({"client1"}));
+
+    topicManager->removeTopicsByClient("client0");
+    BOOST_CHECK(queryClients("topic2").empty());
+    BOOST_CHECK(queryClients("topic3").empty());
+    BOOST_CHECK(queryClients("topic1") == std::vector<std::string>({"client1"}));
+}
+
+BOOST_AUTO_TEST_CASE(test_topicIndexSnapshot)
+{
+    TopicIndex topicIndex;
+    topicIndex.update("node0", TopicItems(), TopicItems{TopicItem("topic0"), TopicItem("topic1")});
+    auto subscribers = topicIndex.subscribers("topic0");
+    BOOST_CHECK(subscribers);
+    BOOST_CHECK_EQUAL(subscribers->size(), 1);
+
+    // the snapshot loaded by the readers is never modified
+    topicIndex.update("node1", TopicItems(), TopicItems{TopicItem("topic0")});
+    BOOST_CHECK_EQUAL(subscribers->size(), 1);
+    BOOST_CHECK_EQUAL(topicIndex.subscribers("topic0")->size(), 2);
+
+    topicIndex.remove("node0", TopicItems{TopicItem("topic0"), TopicItem("topic1")});
+    BOOST_CHECK_EQUAL(subscribers->front(), "node0");
+    BOOST_CHECK_EQUAL(topicIndex.subscribers("topic0")->front(), "node1");
+    BOOST_CHECK(!topicIndex.subscribers("topic1"));
+    BOOST_CHECK_EQUAL(topicIndex.topicsSize(), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
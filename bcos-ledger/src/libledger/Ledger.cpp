@@ -129,8 +129,8 @@ void Ledger::asyncPrewriteBlock(bcos::storage::StorageInterface::Ptr storage,
 
     auto blockNumberStr = boost::lexical_cast<std::string>(header->number());
 
-    // 9 storage callbacks and write hash=>receipt
-    size_t TOTAL_CALLBACK = 9 + block->receiptsSize();
+    // 9 storage callbacks and write hash=>receipt, hash=>location
+    size_t TOTAL_CALLBACK = 9 + 2 * block->receiptsSize();
     auto setRowCallback = [total = std::make_shared<std::atomic<size_t>>(TOTAL_CALLBACK),
                               failed = std::make_shared<bool>(false),
                               callback = std::move(callback)](
@@ -231,16 +231,24 @@ void Ledger::asyncPrewriteBlock(bcos::storage::StorageInterface::Ptr storage,
     storage->asyncSetRow(SYS_NUMBER_2_TXS, blockNumberStr, std::move(number2TransactionHashesEntry),
         [setRowCallback](auto&& error) { setRowCallback(std::forward<decltype(error)>(error)); });
 
-    // hash 2 receipts
+    // hash 2 receipts and hash 2 location
     std::atomic_int64_t totalCount = 0;
     std::atomic_int64_t failedCount = 0;
     tbb::parallel_for(tbb::blocked_range<size_t>(0, block->receiptsSize()),
-        [&storage, &transactionsBlock, &block, &failedCount, &totalCount, &setRowCallback](
-            const tbb::blocked_range<size_t>& range) {
+        [&storage, &transactionsBlock, &block, &header, &failedCount, &totalCount,
+            &setRowCallback](const tbb::blocked_range<size_t>& range) {
             for (size_t i = range.begin(); i < range.end(); ++i)
             {
                 auto hash = transactionsBlock->transactionHash(i);
 
+                Entry locationEntry;
+                locationEntry.importFields(
+                    {encodeTxLocation(TxLocation{header->number(), (uint32_t)i})});
+                storage->asyncSetRow(SYS_HASH_2_LOCATION, bcos::concepts::bytebuffer::toView(hash),
+                    std::move(locationEntry), [setRowCallback](auto&& error) {
+                        setRowCallback(std::forward<decltype(error)>(error));
+                    });
+
                 auto receipt = block->receipt(i);
                 if (receipt->status() != 0)
                 {
@@ -260,6 +268,15 @@ void Ledger::asyncPrewriteBlock(bcos::storage::StorageInterface::Ptr storage,
             }
         });
 
+    // visible to the queries once this block is committed
+    std::vector<HashType> txHashes;
+    txHashes.reserve(block->receiptsSize());
+    for (size_t i = 0; i < block->receiptsSize(); ++i)
+    {
+        txHashes.emplace_back(transactionsBlock->transactionHash(i));
+    }
+    m_indexCache->stage(header->number(), header->hash(), std::move(txHashes));
+
     LEDGER_LOG(DEBUG) << LOG_DESC("Calculate tx counts in block")
                       << LOG_KV("number", blockNumberStr) << LOG_KV("totalCount", totalCount)
                       << LOG_KV("failedCount", failedCount);
@@ -562,6 +579,11 @@ void Ledger::asyncGetBlockNumberByHash(const crypto::HashType& _blockHash,
 {
     auto key = _blockHash;
     LEDGER_LOG(TRACE) << "GetBlockNumberByHash request" << LOG_KV("hash", key.hex());
+    if (auto blockNumber = m_indexCache->blockNumber(key))
+    {
+        _onGetBlock(nullptr, *blockNumber);
+        return;
+    }
 
     asyncGetSystemTableEntry(SYS_HASH_2_NUMBER, bcos::concepts::bytebuffer::toView(key),
         [callback = std::move(_onGetBlock)](
@@ -1285,59 +1307,84 @@ void Ledger::asyncGetSystemTableEntry(const std::string_view& table, const std::
     });
 }
 
+void Ledger::asyncGetTxLocation(const HashType& _txHash,
+    std::function<void(Error::Ptr&&, std::optional<TxLocation>&&)> callback)
+{
+    if (auto location = m_indexCache->txLocation(_txHash))
+    {
+        callback(nullptr, std::move(location));
+        return;
+    }
+    // point read without opening the table, which not exists in the chains built before the index
+    m_storage->asyncGetRow(SYS_HASH_2_LOCATION, bcos::concepts::bytebuffer::toView(_txHash),
+        [callback = std::move(callback)](Error::UniquePtr error, std::optional<Entry> entry) {
+            if (error)
+            {
+                callback(BCOS_ERROR_WITH_PREV_PTR(
+                             LedgerError::GetStorageError, "GetTxLocation error", *error),
+                    std::nullopt);
+                return;
+            }
+            if (!entry)
+            {
+                callback(nullptr, std::nullopt);
+                return;
+            }
+            callback(nullptr, decodeTxLocation(entry->getField(0)));
+        });
+}
+
 void Ledger::getTxProof(
     const HashType& _txHash, std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof)
 {
-    // txHash->receipt receipt->number number->txHash
-    asyncGetTransactionReceiptByHash(_txHash, false,
-        [this, _txHash, _onGetProof = std::move(_onGetProof)](
-            Error::Ptr _error, TransactionReceipt::ConstPtr _receipt, const MerkleProofPtr&) {
-            if (_error || !_receipt)
+    // txHash->location location->number number->txHashes
+    asyncGetTxLocation(_txHash, [this, _txHash, _onGetProof = std::move(_onGetProof)](
+                                    Error::Ptr&& _error, std::optional<TxLocation>&& _location) {
+        if (!_error && _location)
+        {
+            getTxProofInBlock(_txHash, _location->blockNumber, _onGetProof);
+            return;
+        }
+        // the block committed before the location index, txHash->receipt receipt->number
+        asyncGetTransactionReceiptByHash(_txHash, false,
+            [this, _txHash, _onGetProof](Error::Ptr _error, TransactionReceipt::ConstPtr _receipt,
+                const MerkleProofPtr&) {
+                if (_error || !_receipt)
+                {
+                    LEDGER_LOG(DEBUG) << LOG_BADGE("getTxProof")
+                                      << LOG_DESC("getReceiptByTxHash from storage failed")
+                                      << LOG_KV("txHash", _txHash.hex());
+                    _onGetProof(std::forward<decltype(_error)>(_error), nullptr);
+                    return;
+                }
+                getTxProofInBlock(_txHash, _receipt->blockNumber(), _onGetProof);
+            });
+    });
+}
+
+void Ledger::getTxProofInBlock(const HashType& _txHash, BlockNumber _blockNumber,
+    std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof)
+{
+    // the transaction hashes are the leaves of the merkle tree, no need to load the transactions
+    asyncGetBlockTransactionHashes(_blockNumber,
+        [cryptoSuite = m_blockFactory->cryptoSuite(), _onGetProof = std::move(_onGetProof),
+            _txHash](Error::Ptr&& _error, std::vector<std::string>&& _hashList) {
+            if (_error || _hashList.empty())
             {
                 LEDGER_LOG(DEBUG) << LOG_BADGE("getTxProof")
-                                  << LOG_DESC("getReceiptByTxHash from storage failed")
+                                  << LOG_DESC("asyncGetBlockTransactionHashes from storage failed")
                                   << LOG_KV("txHash", _txHash.hex());
                 _onGetProof(std::forward<decltype(_error)>(_error), nullptr);
                 return;
             }
-            asyncGetBlockTransactionHashes(_receipt->blockNumber(),
-                [this, _onGetProof, _txHash = std::move(_txHash)](
-                    Error::Ptr&& _error, std::vector<std::string>&& _hashList) {
-                    if (_error || _hashList.empty())
-                    {
-                        LEDGER_LOG(DEBUG)
-                            << LOG_BADGE("getTxProof")
-                            << LOG_DESC("asyncGetBlockTransactionHashes from storage failed")
-                            << LOG_KV("txHash", _txHash.hex());
-                        _onGetProof(std::forward<decltype(_error)>(_error), nullptr);
-                        return;
-                    }
-                    asyncBatchGetTransactions(std::make_shared<std::vector<std::string>>(_hashList),
-                        [cryptoSuite = m_blockFactory->cryptoSuite(), _onGetProof,
-                            _txHash = std::move(_txHash)](
-                            Error::Ptr&& _error, std::vector<Transaction::Ptr>&& _txList) {
-                            if (_error || _txList.empty())
-                            {
-                                LEDGER_LOG(DEBUG)
-                                    << LOG_BADGE("getTxProof") << LOG_DESC("getTxs callback failed")
-                                    << LOG_KV("code", _error->errorCode())
-                                    << LOG_KV("msg", _error->errorMessage());
-                                _onGetProof(std::forward<decltype(_error)>(_error), nullptr);
-                                return;
-                            }
-
-                            auto merkleProofPtr = std::make_shared<MerkleProof>();
-                            auto merkleProofUtility = std::make_shared<MerkleProofUtility>();
 
-                            merkleProofUtility->getMerkleProof(_txHash,
-                                std::forward<decltype(_txList)>(_txList), cryptoSuite,
-                                merkleProofPtr);
-                            LEDGER_LOG(TRACE)
-                                << LOG_BADGE("getTxProof") << LOG_DESC("get merkle proof success")
-                                << LOG_KV("txHash", _txHash.hex());
-                            _onGetProof(nullptr, std::move(merkleProofPtr));
-                        });
-                });
+            auto merkleProofPtr = std::make_shared<MerkleProof>();
+            auto merkleProofUtility = std::make_shared<MerkleProofUtility>();
+            merkleProofUtility->getMerkleProofByHashes(
+                _txHash, _hashList, cryptoSuite, merkleProofPtr);
+            LEDGER_LOG(TRACE) << LOG_BADGE("getTxProof") << LOG_DESC("get merkle proof success")
+                              << LOG_KV("txHash", _txHash.hex());
+            _onGetProof(nullptr, std::move(merkleProofPtr));
         });
 }
 
@@ -1419,6 +1466,7 @@ bool Ledger::buildGenesisBlock(LedgerConfig::Ptr _ledgerConfig, size_t _gasLimit
         SYS_NUMBER_2_BLOCK_HEADER, SYS_VALUE,
         SYS_NUMBER_2_TXS, SYS_VALUE,
         SYS_HASH_2_RECEIPT, SYS_VALUE,
+        SYS_HASH_2_LOCATION, SYS_VALUE,
         SYS_BLOCK_NUMBER_2_NONCES, SYS_VALUE,
     };
     // clang-format on
@@ -25,6 +25,7 @@
 #include "bcos-framework/protocol/ProtocolTypeDef.h"
 #include "bcos-framework/storage/Common.h"
 #include "bcos-framework/storage/StorageInterface.h"
+#include "utilities/BlockIndex.h"
 #include "utilities/MerkleProofUtility.h"
 #include <bcos-utilities/Common.h>
 #include <bcos-utilities/Exceptions.h>
@@ -39,8 +40,11 @@ class Ledger : public LedgerInterface, public std::enable_shared_from_this<Ledge
 {
 public:
     Ledger(bcos::protocol::BlockFactory::Ptr _blockFactory,
-        bcos::storage::StorageInterface::Ptr _storage)
-      : m_blockFactory(std::move(_blockFactory)), m_storage(std::move(_storage))
+        bcos::storage::StorageInterface::Ptr _storage,
+        size_t _indexCacheCapacity = c_defaultBlockIndexCacheCapacity)
+      : m_blockFactory(std::move(_blockFactory)),
+        m_storage(std::move(_storage)),
+        m_indexCache(std::make_shared<BlockIndexCache>(_indexCacheCapacity))
     {
         assert(m_blockFactory);
         assert(m_storage);
@@ -123,9 +127,16 @@ private:
     void asyncGetSystemTableEntry(const std::string_view& table, const std::string_view& key,
         std::function<void(Error::Ptr&&, std::optional<bcos::storage::Entry>&&)> callback);
 
+    // tx hash => (block number, index), from the hot tier or the SYS_HASH_2_LOCATION table
+    void asyncGetTxLocation(const crypto::HashType& _txHash,
+        std::function<void(Error::Ptr&&, std::optional<TxLocation>&&)> callback);
+
     void getTxProof(const crypto::HashType& _txHash,
         std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof);
 
+    void getTxProofInBlock(const crypto::HashType& _txHash, protocol::BlockNumber _blockNumber,
+        std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof);
+
     void getReceiptProof(protocol::TransactionReceipt::Ptr _receipt,
         std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof);
 
@@ -145,5 +156,6 @@ private:
 
     bcos::protocol::BlockFactory::Ptr m_blockFactory;
     bcos::storage::StorageInterface::Ptr m_storage;
+    BlockIndexCache::Ptr m_indexCache;
 };
 }  // namespace bcos::ledger
\ No newline at end of file
@@ -0,0 +1,121 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the fixed-width index of the block hash and the transaction hash
+ * @file BlockIndex.cpp
+ */
+#include "BlockIndex.h"
+#include <bcos-utilities/DataConvertUtility.h>
+
+using namespace bcos;
+using namespace bcos::ledger;
+using namespace bcos::protocol;
+using namespace bcos::crypto;
+
+std::string bcos::ledger::encodeTxLocation(TxLocation const& _location)
+{
+    std::string data(c_txLocationSize, '\0');
+    std::string number(sizeof(int64_t), '\0');
+    toBigEndian((uint64_t)_location.blockNumber, number);
+    std::string index(sizeof(uint32_t), '\0');
+    toBigEndian(_location.index, index);
+    data.replace(0, number.size(), number);
+    data.replace(number.size(), index.size(), index);
+    return data;
+}
+
+std::optional<TxLocation> bcos::ledger::decodeTxLocation(std::string_view _data)
+{
+    if (_data.size() != c_txLocationSize)
+    {
+        return std::nullopt;
+    }
+    TxLocation location;
+    location.blockNumber = (BlockNumber)fromBigEndian<uint64_t>(_data.substr(0, sizeof(int64_t)));
+    location.index = fromBigEndian<uint32_t>(_data.substr(sizeof(int64_t)));
+    return location;
+}
+
+void BlockIndexCache::stage(
+    BlockNumber _blockNumber, HashType const& _blockHash, std::vector<HashType> _txHashes)
+{
+    if (m_capacity == 0)
+    {
+        return;
+    }
+    WriteGuard l(x_index);
+    // the next block is prewritten only after the pending block committed
+    if (m_pending && m_pending->number + 1 == _blockNumber)
+    {
+        promote(std::move(*m_pending));
+    }
+    // otherwise the pending block is prewritten again or replaced, drop it
+    m_pending = BlockIndex{_blockNumber, _blockHash, std::move(_txHashes)};
+}
+
+std::optional<BlockNumber> BlockIndexCache::blockNumber(HashType const& _blockHash) const
+{
+    ReadGuard l(x_index);
+    auto it = m_blockNumbers.find(_blockHash);
+    if (it == m_blockNumbers.end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+std::optional<TxLocation> BlockIndexCache::txLocation(HashType const& _txHash) const
+{
+    ReadGuard l(x_index);
+    auto it = m_txs.find(_txHash);
+    if (it == m_txs.end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void BlockIndexCache::promote(BlockIndex&& _block)
+{
+    if (!m_blocks.empty() && m_blocks.back().number >= _block.number)
+    {
+        // the chain is rebuilt from an older block, the cached index is not reliable any more
+        m_blocks.clear();
+        m_blockNumbers.clear();
+        m_txs.clear();
+    }
+    m_blockNumbers.insert_or_assign(_block.hash, _block.number);
+    for (uint32_t i = 0; i < _block.txHashes.size(); ++i)
+    {
+        m_txs.insert_or_assign(_block.txHashes[i], TxLocation{_block.number, i});
+    }
+    m_blocks.emplace_back(std::move(_block));
+    evict();
+}
+
+void BlockIndexCache::evict()
+{
+    // keep the latest block even if it exceeds the capacity alone
+    while (m_txs.size() > m_capacity && m_blocks.size() > 1)
+    {
+        auto& oldest = m_blocks.front();
+        m_blockNumbers.erase(oldest.hash);
+        for (auto const& txHash : oldest.txHashes)
+        {
+            m_txs.erase(txHash);
+        }
+        m_blocks.pop_front();
+    }
+}
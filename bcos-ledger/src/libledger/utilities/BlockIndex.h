@@ -0,0 +1,101 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the fixed-width index of the block hash and the transaction hash
+ * @file BlockIndex.h
+ */
+#pragma once
+#include <bcos-crypto/interfaces/crypto/CommonType.h>
+#include <bcos-framework/protocol/ProtocolTypeDef.h>
+#include <bcos-utilities/Common.h>
+#include <deque>
+#include <optional>
+#include <unordered_map>
+
+namespace bcos::ledger
+{
+// the location of a transaction in the chain
+struct TxLocation
+{
+    protocol::BlockNumber blockNumber = -1;
+    uint32_t index = 0;
+
+    bool operator==(TxLocation const& _other) const
+    {
+        return blockNumber == _other.blockNumber && index == _other.index;
+    }
+};
+
+// 8 bytes big-endian block number followed by 4 bytes big-endian index
+constexpr static size_t c_txLocationSize = sizeof(int64_t) + sizeof(uint32_t);
+
+std::string encodeTxLocation(TxLocation const& _location);
+std::optional<TxLocation> decodeTxLocation(std::string_view _data);
+
+constexpr static size_t c_defaultBlockIndexCacheCapacity = 200000;
+
+// The in-memory hot tier of the block index, holds the block hash => number and the tx hash =>
+// location of the latest committed blocks, which serve most of the rpc queries.
+// The index of a block is staged when it is prewritten, and becomes visible when the next block is
+// prewritten, which means the staged block has been committed.
+class BlockIndexCache
+{
+public:
+    using Ptr = std::shared_ptr<BlockIndexCache>;
+    // _capacity: the max number of the cached transactions, 0 means disable the cache
+    explicit BlockIndexCache(size_t _capacity) : m_capacity(_capacity) {}
+    virtual ~BlockIndexCache() = default;
+
+    BlockIndexCache(const BlockIndexCache&) = delete;
+    BlockIndexCache(BlockIndexCache&&) = delete;
+    BlockIndexCache& operator=(const BlockIndexCache&) = delete;
+    BlockIndexCache& operator=(BlockIndexCache&&) = delete;
+
+    void stage(protocol::BlockNumber _blockNumber, crypto::HashType const& _blockHash,
+        std::vector<crypto::HashType> _txHashes);
+
+    std::optional<protocol::BlockNumber> blockNumber(crypto::HashType const& _blockHash) const;
+    std::optional<TxLocation> txLocation(crypto::HashType const& _txHash) const;
+
+    size_t blockSize() const
+    {
+        ReadGuard l(x_index);
+        return m_blocks.size();
+    }
+    size_t txSize() const
+    {
+        ReadGuard l(x_index);
+        return m_txs.size();
+    }
+
+private:
+    struct BlockIndex
+    {
+        protocol::BlockNumber number;
+        crypto::HashType hash;
+        std::vector<crypto::HashType> txHashes;
+    };
+    void promote(BlockIndex&& _block);
+    void evict();
+
+    size_t m_capacity;
+    std::optional<BlockIndex> m_pending;
+    // the committed blocks, in ascending order of the block number
+    std::deque<BlockIndex> m_blocks;
+    std::unordered_map<crypto::HashType, protocol::BlockNumber> m_blockNumbers;
+    std::unordered_map<crypto::HashType, TxLocation> m_txs;
+    mutable bcos::SharedMutex x_index;
+};
+}  // namespace bcos::ledger
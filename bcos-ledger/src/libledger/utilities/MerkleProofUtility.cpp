@@ -27,6 +27,22 @@ namespace bcos
 {
 namespace ledger
 {
+void MerkleProofUtility::getMerkleProofByHashes(const crypto::HashType& _txHash,
+    std::vector<std::string> const& _hashes, crypto::CryptoSuite::Ptr _crypto,
+    const std::shared_ptr<MerkleProof>& merkleProof)
+{
+    std::vector<bytes> hashList;
+    hashList.reserve(_hashes.size());
+    for (auto const& hash : _hashes)
+    {
+        hashList.emplace_back(hash.begin(), hash.end());
+    }
+    auto parent2Child = std::make_shared<Parent2ChildListMap>();
+    protocol::calculateMerkleProof(std::move(_crypto), hashList, parent2Child);
+    auto child2Parent = getChild2Parent(parent2Child);
+    makeMerkleProof(_txHash, parent2Child, child2Parent, merkleProof);
+}
+
 void MerkleProofUtility::makeMerkleProof(const crypto::HashType& _txHash,
     const std::shared_ptr<Parent2ChildListMap>& parent2ChildList,
     const std::shared_ptr<Child2ParentMap>& child2Parent, const std::shared_ptr<MerkleProof>& merkleProof)
@@ -44,6 +44,11 @@ public:
         makeMerkleProof(_txHash, std::move(parent2Child), std::move(child2Parent), merkleProof);
     }
 
+    // the leaves are the binary hashes, no need to decode the transactions or receipts
+    void getMerkleProofByHashes(const crypto::HashType& _txHash,
+        std::vector<std::string> const& _hashes, crypto::CryptoSuite::Ptr _crypto,
+        const std::shared_ptr<MerkleProof>& merkleProof);
+
     template <typename T>
     std::shared_ptr<Parent2ChildListMap> getParent2ChildList(
         crypto::CryptoSuite::Ptr _crypto, T _ts)
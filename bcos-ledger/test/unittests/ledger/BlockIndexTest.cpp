@@ -0,0 +1,83 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file BlockIndexTest.cpp
+ */
+
+#include "bcos-ledger/src/libledger/utilities/BlockIndex.h"
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::ledger;
+using namespace bcos::crypto;
+
+namespace bcos::test
+{
+BOOST_FIXTURE_TEST_SUITE(BlockIndexTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(txLocationCodec)
+{
+    TxLocation location{0x0102030405, 0x0a0b};
+    auto data = encodeTxLocation(location);
+    BOOST_CHECK_EQUAL(data.size(), c_txLocationSize);
+    // big-endian
+    BOOST_CHECK_EQUAL(data[3], 0x01);
+    BOOST_CHECK_EQUAL(data[7], 0x05);
+    BOOST_CHECK_EQUAL(data[10], 0x0a);
+    BOOST_CHECK(decodeTxLocation(data) == location);
+
+    BOOST_CHECK(!decodeTxLocation(""));
+    BOOST_CHECK(!decodeTxLocation(std::string_view(data).substr(1)));
+}
+
+BOOST_AUTO_TEST_CASE(cacheCommittedBlocks)
+{
+    BlockIndexCache cache(4);
+    HashType block1("1001");
+    HashType block2("1002");
+    HashType block3("1003");
+    cache.stage(1, block1, {HashType("01"), HashType("02")});
+    // not committed yet
+    BOOST_CHECK(!cache.blockNumber(block1));
+    BOOST_CHECK(!cache.txLocation(HashType("01")));
+
+    // prewrite block 1 again
+    cache.stage(1, block1, {HashType("01"), HashType("02")});
+    BOOST_CHECK(!cache.blockNumber(block1));
+
+    cache.stage(2, block2, {HashType("03"), HashType("04"), HashType("05")});
+    BOOST_CHECK_EQUAL(*cache.blockNumber(block1), 1);
+    BOOST_CHECK(cache.txLocation(HashType("02")) == (TxLocation{1, 1}));
+    BOOST_CHECK(!cache.blockNumber(block2));
+
+    // exceed the capacity, evict block 1
+    cache.stage(3, block3, {});
+    BOOST_CHECK(!cache.blockNumber(block1));
+    BOOST_CHECK(!cache.txLocation(HashType("01")));
+    BOOST_CHECK_EQUAL(*cache.blockNumber(block2), 2);
+    BOOST_CHECK(cache.txLocation(HashType("05")) == (TxLocation{2, 2}));
+    BOOST_CHECK_EQUAL(cache.blockSize(), 1);
+    BOOST_CHECK_EQUAL(cache.txSize(), 3);
+
+    // disabled
+    BlockIndexCache disabled(0);
+    disabled.stage(1, block1, {HashType("01")});
+    disabled.stage(2, block2, {});
+    BOOST_CHECK(!disabled.blockNumber(block1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
@@ -20,12 +20,47 @@
  */
 #include "StateMachine.h"
 #include "Common.h"
+#include <bcos-utilities/Metrics.h>
 
 using namespace bcos;
 using namespace bcos::consensus;
 using namespace bcos::protocol;
 using namespace bcos::crypto;
 
+namespace
+{
+struct SpeculationMetrics
+{
+    // the speculative result is adopted by the committed proposal
+    metrics::Counter& adopted = metrics::MetricsRegistry::instance().counter(
+        "bcos_pbft_speculative_blocks_total", "The proposals executed before commit",
+        "result=\"adopted\"");
+    // another proposal is committed, the speculative result is discarded
+    metrics::Counter& discarded = metrics::MetricsRegistry::instance().counter(
+        "bcos_pbft_speculative_blocks_total", "The proposals executed before commit",
+        "result=\"discarded\"");
+    metrics::Counter& failed = metrics::MetricsRegistry::instance().counter(
+        "bcos_pbft_speculative_blocks_total", "The proposals executed before commit",
+        "result=\"failed\"");
+    metrics::Histogram& hiddenTime = metrics::MetricsRegistry::instance().histogram(
+        "bcos_pbft_speculative_hidden_seconds",
+        "The execution time overlapped with the prepare and commit rounds");
+    metrics::Histogram& waitTime = metrics::MetricsRegistry::instance().histogram(
+        "bcos_pbft_speculative_wait_seconds",
+        "The time the committed proposal waits for its speculative execution");
+};
+SpeculationMetrics& speculationMetrics()
+{
+    static SpeculationMetrics speculationMetrics;
+    return speculationMetrics;
+}
+
+uint64_t microseconds(std::chrono::steady_clock::duration _duration)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(_duration).count();
+}
+}  // namespace
+
 void StateMachine::asyncApply(ssize_t _timeout, ProposalInterface::ConstPtr _lastAppliedProposal,
     ProposalInterface::Ptr _proposal, ProposalInterface::Ptr _executedProposal,
     std::function<void(int64_t)> _onExecuteFinished)
@@ -41,12 +76,30 @@ void StateMachine::asyncApply(ssize_t _timeout, ProposalInterface::ConstPtr _las
 void StateMachine::asyncPreApply(
     ProposalInterface::Ptr _proposal, std::function<void(bool)> _onPreApplyFinished)
 {
+    {
+        // the speculative execution has prepared the block
+        Guard l(x_speculation);
+        if (m_speculation && m_speculation->hash == _proposal->hash())
+        {
+            return;
+        }
+    }
     // Note: async here to increase performance, trigger preExecuteBlock
     m_schedulerWorker->enqueue([this, _proposal, _onPreApplyFinished]() {
         this->preApply(_proposal, _onPreApplyFinished);
     });
 }
 
+void StateMachine::asyncSpeculativeApply(
+    ProposalInterface::ConstPtr _lastAppliedProposal, ProposalInterface::Ptr _proposal)
+{
+    // Note: serialized with asyncApply in m_worker, so the committed proposal always finds the
+    // speculation started before
+    m_worker->enqueue([this, _lastAppliedProposal, _proposal]() {
+        this->speculativeApply(_lastAppliedProposal, _proposal);
+    });
+}
+
 void StateMachine::apply(ssize_t, ProposalInterface::ConstPtr _lastAppliedProposal,
     ProposalInterface::Ptr _proposal, ProposalInterface::Ptr _executedProposal,
     std::function<void(int64_t)> _onExecuteFinished)
@@ -62,10 +115,10 @@ void StateMachine::apply(ssize_t, ProposalInterface::ConstPtr _lastAppliedPropos
         }
         return;
     }
-    auto block = m_blockFactory->createBlock(_proposal->data());
+    auto commitTime = std::chrono::steady_clock::now();
+    auto block = createBlockToApply(_lastAppliedProposal, _proposal);
     // invalid block
-    auto blockHeader = block->blockHeader();
-    if (!blockHeader)
+    if (!block)
     {
         if (_onExecuteFinished)
         {
@@ -73,6 +126,25 @@ void StateMachine::apply(ssize_t, ProposalInterface::ConstPtr _lastAppliedPropos
         }
         return;
     }
+    auto speculation = takeSpeculation(_proposal->index());
+    if (speculation)
+    {
+        adoptSpeculation(
+            speculation, block, _proposal, _executedProposal, _onExecuteFinished, commitTime);
+        return;
+    }
+    executeBlock(block, _proposal, _executedProposal, _onExecuteFinished);
+}
+
+Block::Ptr StateMachine::createBlockToApply(
+    ProposalInterface::ConstPtr _lastAppliedProposal, ProposalInterface::Ptr _proposal)
+{
+    auto block = m_blockFactory->createBlock(_proposal->data());
+    auto blockHeader = block->blockHeader();
+    if (!blockHeader)
+    {
+        return nullptr;
+    }
     // set the parentHash information
     if (_proposal->index() == _lastAppliedProposal->index() + 1)
     {
@@ -91,10 +163,16 @@ void StateMachine::apply(ssize_t, ProposalInterface::ConstPtr _lastAppliedPropos
                              << LOG_KV("lastAppliedIndex", _lastAppliedProposal->index())
                              << LOG_KV("proposal", _proposal->index());
     }
+    return block;
+}
+
+void StateMachine::executeBlock(Block::Ptr _block, ProposalInterface::Ptr _proposal,
+    ProposalInterface::Ptr _executedProposal, std::function<void(int64_t)> _onExecuteFinished)
+{
     // calls dispatcher to execute the block
     auto startT = utcTime();
-    m_scheduler->executeBlock(block, false,
-        [startT, block, _onExecuteFinished, _proposal, _executedProposal](
+    m_scheduler->executeBlock(_block, false,
+        [startT, block = _block, _onExecuteFinished, _proposal, _executedProposal](
             Error::Ptr&& _error, BlockHeader::Ptr&& _blockHeader, bool _sysBlock) {
             if (!_onExecuteFinished)
             {
@@ -129,19 +207,24 @@ void StateMachine::apply(ssize_t, ProposalInterface::ConstPtr _lastAppliedPropos
                                        << LOG_KV("timeCost", (utcTime() - startT));
                 return;
             }
-            _executedProposal->setIndex(_blockHeader->number());
-            _executedProposal->setHash(_blockHeader->hash());
-
-            bcos::bytes blockHeaderBuffer;
-            _blockHeader->encode(blockHeaderBuffer);
-            _executedProposal->setData(std::move(blockHeaderBuffer));
-            // the transactions hash list
-            _executedProposal->setExtraData(_proposal->data());
+            fillExecutedProposal(_blockHeader, _proposal, _executedProposal);
             // The _onExecuteFinished callback itself does the asynchronous logic, so there is no
             // need to use m_worker to re-synchronize it here.
             _onExecuteFinished(0);
         });
-    return;
+}
+
+void StateMachine::fillExecutedProposal(BlockHeader::Ptr _blockHeader,
+    ProposalInterface::Ptr _proposal, ProposalInterface::Ptr _executedProposal)
+{
+    _executedProposal->setIndex(_blockHeader->number());
+    _executedProposal->setHash(_blockHeader->hash());
+
+    bcos::bytes blockHeaderBuffer;
+    _blockHeader->encode(blockHeaderBuffer);
+    _executedProposal->setData(std::move(blockHeaderBuffer));
+    // the transactions hash list
+    _executedProposal->setExtraData(_proposal->data());
 }
 
 void StateMachine::preApply(
@@ -174,4 +257,142 @@ void StateMachine::preApply(
                 _onPreApplyFinished(false);
             }
         });
-}
\ No newline at end of file
+}
+
+void StateMachine::speculativeApply(
+    ProposalInterface::ConstPtr _lastAppliedProposal, ProposalInterface::Ptr _proposal)
+{
+    if (_proposal->index() != _lastAppliedProposal->index() + 1)
+    {
+        return;
+    }
+    {
+        Guard l(x_speculation);
+        if (m_speculation && m_speculation->index >= _proposal->index())
+        {
+            return;
+        }
+    }
+    auto block = createBlockToApply(_lastAppliedProposal, _proposal);
+    if (!block)
+    {
+        return;
+    }
+    auto speculation = std::make_shared<Speculation>();
+    speculation->index = _proposal->index();
+    speculation->hash = _proposal->hash();
+    speculation->startTime = std::chrono::steady_clock::now();
+    {
+        Guard l(x_speculation);
+        m_speculation = speculation;
+    }
+    CONSENSUS_LOG(INFO) << LOG_DESC("speculativeApply") << LOG_KV("index", _proposal->index())
+                        << LOG_KV("hash", _proposal->hash().abridged())
+                        << LOG_KV("txsSize", block->transactionsHashSize());
+    m_scheduler->executeBlock(block, false,
+        [this, speculation](Error::Ptr&& _error, BlockHeader::Ptr&& _blockHeader, bool) {
+            std::function<void()> onFinished;
+            {
+                Guard l(x_speculation);
+                speculation->finished = true;
+                speculation->finishTime = std::chrono::steady_clock::now();
+                if (_error)
+                {
+                    speculation->errorCode = _error->errorCode();
+                }
+                else if (!_blockHeader || _blockHeader->number() != speculation->index)
+                {
+                    speculation->errorCode = -1;
+                }
+                else
+                {
+                    speculation->result = std::move(_blockHeader);
+                }
+                onFinished = std::move(speculation->onFinished);
+            }
+            CONSENSUS_LOG(INFO) << LOG_DESC("speculativeApply finished")
+                                << LOG_KV("index", speculation->index)
+                                << LOG_KV("code", speculation->errorCode)
+                                << LOG_KV("timeCost(us)", microseconds(speculation->finishTime -
+                                                                       speculation->startTime));
+            if (speculation->errorCode != 0)
+            {
+                speculationMetrics().failed.inc();
+            }
+            if (onFinished)
+            {
+                onFinished();
+            }
+        });
+}
+
+StateMachine::Speculation::Ptr StateMachine::takeSpeculation(BlockNumber _index)
+{
+    Guard l(x_speculation);
+    if (!m_speculation || m_speculation->index > _index)
+    {
+        return nullptr;
+    }
+    auto speculation = std::move(m_speculation);
+    m_speculation = nullptr;
+    if (speculation->index < _index)
+    {
+        return nullptr;
+    }
+    return speculation;
+}
+
+void StateMachine::adoptSpeculation(Speculation::Ptr _speculation, Block::Ptr _block,
+    ProposalInterface::Ptr _proposal, ProposalInterface::Ptr _executedProposal,
+    std::function<void(int64_t)> _onExecuteFinished,
+    std::chrono::steady_clock::time_point _commitTime)
+{
+    auto onSpeculationFinished = [this, _speculation, _block, _proposal, _executedProposal,
+                                     _onExecuteFinished, _commitTime]() {
+        if (_speculation->errorCode != 0)
+        {
+            // the failed block has been removed from the scheduler, execute it again
+            executeBlock(_block, _proposal, _executedProposal, _onExecuteFinished);
+            return;
+        }
+        if (_speculation->hash != _proposal->hash())
+        {
+            // the scheduler finds the executed block differs from the committed one, discards all
+            // the uncommitted blocks by switching term, and the consensus retries the proposal
+            CONSENSUS_LOG(INFO) << LOG_DESC("discard the speculative execution")
+                                << LOG_KV("index", _proposal->index())
+                                << LOG_KV("speculated", _speculation->hash.abridged())
+                                << LOG_KV("committed", _proposal->hash().abridged());
+            speculationMetrics().discarded.inc();
+            m_discardedSpeculations++;
+            executeBlock(_block, _proposal, _executedProposal, _onExecuteFinished);
+            return;
+        }
+        auto hiddenTime = std::min(_speculation->finishTime, _commitTime) - _speculation->startTime;
+        auto waitTime = std::max(_speculation->finishTime, _commitTime) - _commitTime;
+        speculationMetrics().adopted.inc();
+        m_adoptedSpeculations++;
+        speculationMetrics().hiddenTime.observe(microseconds(hiddenTime));
+        speculationMetrics().waitTime.observe(microseconds(waitTime));
+        CONSENSUS_LOG(INFO) << METRIC << LOG_DESC("adopt the speculative execution")
+                            << LOG_KV("number", _speculation->result->number())
+                            << LOG_KV("result", _speculation->result->hash().abridged())
+                            << LOG_KV("txsSize", _block->transactionsHashSize())
+                            << LOG_KV("hidden(us)", microseconds(hiddenTime))
+                            << LOG_KV("wait(us)", microseconds(waitTime));
+        fillExecutedProposal(_speculation->result, _proposal, _executedProposal);
+        if (_onExecuteFinished)
+        {
+            _onExecuteFinished(0);
+        }
+    };
+    {
+        Guard l(x_speculation);
+        if (!_speculation->finished)
+        {
+            _speculation->onFinished = std::move(onSpeculationFinished);
+            return;
+        }
+    }
+    onSpeculationFinished();
+}
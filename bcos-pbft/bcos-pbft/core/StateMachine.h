@@ -23,6 +23,7 @@
 #include <bcos-framework/dispatcher/SchedulerInterface.h>
 #include <bcos-framework/protocol/BlockFactory.h>
 #include <bcos-utilities/ThreadPool.h>
+#include <chrono>
 
 namespace bcos
 {
@@ -37,8 +38,7 @@ public:
     {
         // since execute block is serial, only use one thread to decrease the timecost
         m_worker = std::make_shared<ThreadPool>("stateMachine", 1);
-        m_schedulerWorker =
-            std::make_shared<ThreadPool>("preExec", (std::thread::hardware_concurrency() * 2));
+        m_schedulerWorker = std::make_shared<ThreadPool>("preExec", TaskClass::EXECUTION);
     }
 
     ~StateMachine() override
@@ -60,13 +60,52 @@ public:
     void asyncPreApply(
         ProposalInterface::Ptr _proposal, std::function<void(bool)> _onPreApplyFinished) override;
 
+    void asyncSpeculativeApply(ProposalInterface::ConstPtr _lastAppliedProposal,
+        ProposalInterface::Ptr _proposal) override;
+
+    // the speculative results adopted or discarded by the committed proposals
+    uint64_t adoptedSpeculations() const { return m_adoptedSpeculations; }
+    uint64_t discardedSpeculations() const { return m_discardedSpeculations; }
+
 private:
+    // the proposal executed before commit, only the proposal next to the last applied one is
+    // speculated, so the scheduler has no other uncommitted block to discard with it
+    struct Speculation
+    {
+        using Ptr = std::shared_ptr<Speculation>;
+        bcos::protocol::BlockNumber index;
+        bcos::crypto::HashType hash;
+        std::chrono::steady_clock::time_point startTime;
+
+        bool finished = false;
+        std::chrono::steady_clock::time_point finishTime;
+        int64_t errorCode = 0;
+        bcos::protocol::BlockHeader::Ptr result;
+        // the apply of the committed proposal waiting for the speculation
+        std::function<void()> onFinished;
+    };
+
     void apply(ssize_t _execTimeout, ProposalInterface::ConstPtr _lastAppliedProposal,
         ProposalInterface::Ptr _proposal, ProposalInterface::Ptr _executedProposal,
         std::function<void(int64_t)> _onExecuteFinished);
+    void executeBlock(bcos::protocol::Block::Ptr _block, ProposalInterface::Ptr _proposal,
+        ProposalInterface::Ptr _executedProposal, std::function<void(int64_t)> _onExecuteFinished);
+    bcos::protocol::Block::Ptr createBlockToApply(
+        ProposalInterface::ConstPtr _lastAppliedProposal, ProposalInterface::Ptr _proposal);
+    static void fillExecutedProposal(bcos::protocol::BlockHeader::Ptr _blockHeader,
+        ProposalInterface::Ptr _proposal, ProposalInterface::Ptr _executedProposal);
 
     void preApply(ProposalInterface::Ptr _proposal, std::function<void(bool)> _onPreApplyFinished);
 
+    void speculativeApply(
+        ProposalInterface::ConstPtr _lastAppliedProposal, ProposalInterface::Ptr _proposal);
+    // remove the speculations not later than _index, return the speculation of _index
+    Speculation::Ptr takeSpeculation(bcos::protocol::BlockNumber _index);
+    void adoptSpeculation(Speculation::Ptr _speculation, bcos::protocol::Block::Ptr _block,
+        ProposalInterface::Ptr _proposal, ProposalInterface::Ptr _executedProposal,
+        std::function<void(int64_t)> _onExecuteFinished,
+        std::chrono::steady_clock::time_point _commitTime);
+
 protected:
     bcos::scheduler::SchedulerInterface::Ptr m_scheduler;
     bcos::protocol::BlockFactory::Ptr m_blockFactory;
@@ -74,6 +113,11 @@ protected:
     // threadPool used for scheduler preExecuteBlock, since preExecuteBlock may fetch transactions
     // from the txpool, it need to use multiple thread to improve the txs-fetching-speed
     bcos::ThreadPool::Ptr m_schedulerWorker;
+
+    Speculation::Ptr m_speculation;
+    mutable Mutex x_speculation;
+    std::atomic<uint64_t> m_adoptedSpeculations = {0};
+    std::atomic<uint64_t> m_discardedSpeculations = {0};
 };
 }  // namespace consensus
 }  // namespace bcos
\ No newline at end of file
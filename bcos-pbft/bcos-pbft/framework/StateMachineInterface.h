@@ -39,6 +39,15 @@ public:
     // (Not required): Just for performance, call this before "asyncApply" in the other thread.
     virtual void asyncPreApply(
         ProposalInterface::Ptr _proposal, std::function<void(bool)> _onPreApplyFinished) = 0;
+
+    // (Not required): execute the proposal before it is committed, "asyncApply" of the same
+    // proposal adopts the result, and the result of a different proposal is discarded
+    virtual void asyncSpeculativeApply(
+        ProposalInterface::ConstPtr _lastAppliedProposal, ProposalInterface::Ptr _proposal)
+    {
+        (void)_lastAppliedProposal;
+        (void)_proposal;
+    }
 };
 }  // namespace consensus
 }  // namespace bcos
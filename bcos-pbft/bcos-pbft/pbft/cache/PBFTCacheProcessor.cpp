@@ -320,6 +320,30 @@ bool PBFTCacheProcessor::tryToPreApplyProposal(ProposalInterface::Ptr _proposal)
     return true;
 }
 
+bool PBFTCacheProcessor::tryToSpeculativeApply(PBFTProposalInterface::Ptr _proposal)
+{
+    if (!m_config->speculativeExecution())
+    {
+        return false;
+    }
+    // only speculate on the proposal next to the committed block: discarding it discards all the
+    // uncommitted blocks of the scheduler, which should not include the blocks waiting for the
+    // stable checkpoint
+    auto committedProposal = m_config->committedProposal();
+    if (_proposal->index() != committedProposal->index() + 1 ||
+        _proposal->index() != m_config->expectedCheckPoint() || !m_executingProposals.empty())
+    {
+        return false;
+    }
+    // the system proposal changes the consensus config, and the next proposals depend on it
+    if (_proposal->systemProposal() || m_config->waitSealUntil() > committedProposal->index())
+    {
+        return false;
+    }
+    m_config->stateMachine()->asyncSpeculativeApply(committedProposal, _proposal);
+    return true;
+}
+
 bool PBFTCacheProcessor::tryToApplyCommitQueue()
 {
     notifyToSealNextBlock();
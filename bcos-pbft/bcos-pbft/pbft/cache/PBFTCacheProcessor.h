@@ -136,6 +136,8 @@ public:
 
     bool tryToPreApplyProposal(ProposalInterface::Ptr _proposal);
     bool tryToApplyCommitQueue();
+    // execute the verified proposal next to the committed block before it is committed
+    virtual bool tryToSpeculativeApply(PBFTProposalInterface::Ptr _proposal);
 
     // notify the consensusing proposal index to the sync module
     void notifyCommittedProposalIndex(bcos::protocol::BlockNumber _index);
@@ -165,6 +165,13 @@ public:
         m_checkPointTimeoutInterval = _timeoutInterval;
     }
 
+    // execute the proposals once they pass the verification, before they are committed
+    bool speculativeExecution() const { return m_speculativeExecution; }
+    void setSpeculativeExecution(bool _speculativeExecution)
+    {
+        m_speculativeExecution = _speculativeExecution;
+    }
+
     void resetToView()
     {
         m_toView.store(m_view);
@@ -349,6 +356,8 @@ public:
     virtual bool startRecovered() const { return m_startRecovered; }
 
     bcos::protocol::BlockNumber waitSealUntil() { return m_waitSealUntil; }
+    bcos::protocol::BlockNumber waitResealUntil() { return m_waitResealUntil; }
+    size_t unsealedTxsSize() const { return m_unsealedTxsSize; }
 
 protected:
     void updateQuorum() override;
@@ -395,6 +404,7 @@ protected:
 
     int64_t m_waterMarkLimit = 50;
     std::atomic<int64_t> m_checkPointTimeoutInterval = {3000};
+    std::atomic_bool m_speculativeExecution = {false};
 
     std::atomic<uint64_t> m_leaderSwitchPeriod = {1};
     const unsigned c_pbftMsgDefaultVersion = 0;
@@ -421,3 +431,15 @@ protected:
 };
 }  // namespace consensus
 }  // namespace bcos
+
+// the fields of printCurrentState for PBFT_ASYNC_LOG, formatted on the background thread, the
+// storage must have been init
+#define PBFT_STATE_FORMAT                                                                          \
+    ",committedIndex={},consNum={},committedHash={},view={},toView={},changeCycle={},"             \
+    "expectedCheckPoint={},Idx={},unsealedTxs={},sealUntil={},waitResealUntil={},nodeId={}"
+#define PBFT_STATE_ARGS(_config)                                                                   \
+    (_config)->committedProposal()->index(), (_config)->progressedIndex(),                         \
+        (_config)->committedProposal()->hash().abridged(), (_config)->view(), (_config)->toView(), \
+        (_config)->timer()->changeCycle(), (_config)->expectedCheckPoint(),                        \
+        (_config)->nodeIndex(), (_config)->unsealedTxsSize(), (_config)->waitSealUntil(),          \
+        (_config)->waitResealUntil(), (_config)->nodeID()->shortHex()
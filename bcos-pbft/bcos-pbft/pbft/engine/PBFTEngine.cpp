@@ -24,7 +24,9 @@
 #include <bcos-framework/dispatcher/SchedulerTypeDef.h>
 #include <bcos-framework/ledger/LedgerConfig.h>
 #include <bcos-framework/protocol/Protocol.h>
+#include <bcos-utilities/Metrics.h>
 #include <bcos-utilities/ThreadPool.h>
+#include <bcos-utilities/Tracer.h>
 #include <boost/bind/bind.hpp>
 using namespace bcos;
 using namespace bcos::consensus;
@@ -33,6 +35,39 @@ using namespace bcos::front;
 using namespace bcos::crypto;
 using namespace bcos::protocol;
 
+namespace
+{
+constexpr std::array<char const*, PacketType::RecoverResponse + 1> c_packetTypeNames = {
+    "prePrepare", "prepare", "commit", "viewChange", "newView", "committedProposalRequest",
+    "committedProposalResponse", "preparedProposalRequest", "preparedProposalResponse",
+    "checkPoint", "recoverRequest", "recoverResponse"};
+
+struct PBFTMetrics
+{
+    PBFTMetrics()
+    {
+        for (size_t type = 0; type < c_packetTypeNames.size(); ++type)
+        {
+            handleMsgTime[type] = &metrics::MetricsRegistry::instance().histogram(
+                "bcos_pbft_handle_msg_seconds", "The time to handle the PBFT messages",
+                "type=\"" + std::string(c_packetTypeNames[type]) + "\"");
+        }
+    }
+
+    std::array<metrics::Histogram*, PacketType::RecoverResponse + 1> handleMsgTime;
+    metrics::Gauge& msgQueueSize = metrics::MetricsRegistry::instance().gauge(
+        "bcos_pbft_msg_queue_size", "The PBFT messages waiting to be handled");
+    metrics::Gauge& overflowMsgQueueSize = metrics::MetricsRegistry::instance().gauge(
+        "bcos_pbft_overflow_msg_queue_size",
+        "The PBFT messages waiting to be handled after the msg queue is full");
+};
+PBFTMetrics& pbftMetrics()
+{
+    static PBFTMetrics pbftMetrics;
+    return pbftMetrics;
+}
+}  // namespace
+
 PBFTEngine::PBFTEngine(PBFTConfig::Ptr _config)
   : ConsensusEngine("pbft", 0),
     m_config(_config),
@@ -252,9 +287,8 @@ void PBFTEngine::onProposalApplySuccess(
     m_cacheProcessor->checkAndCommitStableCheckPoint();
     m_cacheProcessor->tryToApplyCommitQueue();
     m_cacheProcessor->eraseExecutedProposal(_proposal->hash());
-    PBFT_LOG(INFO) << LOG_DESC("onProposalApplySuccess") << LOG_KV("index", checkPointMsg->index())
-                   << LOG_KV("hash", checkPointMsg->hash().abridged()) << LOG_KV("lockT", lockT)
-                   << LOG_KV("timecost", (utcTime() - recordT));
+    PBFT_ASYNC_LOG(INFO, "onProposalApplySuccess,index={},hash={},lockT={},timecost={}",
+        checkPointMsg->index(), checkPointMsg->hash().abridged(), lockT, (utcTime() - recordT));
 }
 
 // called after proposal executed successfully
@@ -358,10 +392,10 @@ void PBFTEngine::onRecvProposal(bool _containSysTxs, bytesConstRef _proposalData
     auto pbftMessage =
         m_config->pbftMessageFactory()->populateFrom(PacketType::PrePreparePacket, pbftProposal,
             m_config->pbftMsgDefaultVersion(), m_config->view(), utcTime(), m_config->nodeIndex());
-    PBFT_LOG(INFO) << LOG_DESC("++++++++++++++++ Generating seal on")
-                   << LOG_KV("index", pbftMessage->index()) << LOG_KV("Idx", m_config->nodeIndex())
-                   << LOG_KV("hash", pbftMessage->hash().abridged())
-                   << LOG_KV("sysProposal", pbftProposal->systemProposal());
+    PBFT_ASYNC_LOG(INFO,
+        "++++++++++++++++ Generating seal on,index={},Idx={},hash={},sysProposal={}",
+        pbftMessage->index(), m_config->nodeIndex(), pbftMessage->hash().abridged(),
+        pbftProposal->systemProposal());
 
     // handle the pre-prepare packet
     RecursiveGuard l(m_mutex);
@@ -496,7 +530,32 @@ void PBFTEngine::onReceivePBFTMessage(Error::Ptr _error, NodeIDPtr _fromNode, by
             });
             return;
         }
-        m_msgQueue->push(pbftMsg);
+        if (c_undroppablePacket.count(pbftMsg->packetType()))
+        {
+            if (!pushWithoutWait(pbftMsg))
+            {
+                PBFT_LOG(WARNING) << LOG_DESC(
+                                         "onReceivePBFTMessage: drop the message for overflow "
+                                         "msgQueue full")
+                                  << LOG_KV("type", pbftMsg->packetType())
+                                  << LOG_KV("index", pbftMsg->index())
+                                  << LOG_KV("fromNode", _fromNode->shortHex());
+                return;
+            }
+            m_signalled.notify_all();
+            return;
+        }
+        // apply back-pressure to the network threads, but don't wait while syncing for the engine
+        // stops consuming
+        auto pushWait = isSyncingHigher() ? 0 : c_PushWaitMilliseconds;
+        if (!m_msgQueue->tryPush(pbftMsg, pushWait))
+        {
+            PBFT_LOG(WARNING) << LOG_DESC("onReceivePBFTMessage: drop the message for msgQueue full")
+                              << LOG_KV("type", pbftMsg->packetType())
+                              << LOG_KV("index", pbftMsg->index())
+                              << LOG_KV("fromNode", _fromNode->shortHex());
+            return;
+        }
         m_signalled.notify_all();
     }
     catch (std::exception const& _e)
@@ -509,6 +568,22 @@ void PBFTEngine::onReceivePBFTMessage(Error::Ptr _error, NodeIDPtr _fromNode, by
     }
 }
 
+bool PBFTEngine::pushWithoutWait(std::shared_ptr<PBFTBaseMessageInterface> _msg)
+{
+    if (m_msgQueue->tryPush(_msg))
+    {
+        return true;
+    }
+    // the cap keeps a flood of the undroppable messages from growing the memory without bound
+    if (m_overflowMsgSize >= c_maxOverflowMsgs)
+    {
+        return false;
+    }
+    m_overflowMsgQueue.push(std::move(_msg));
+    pbftMetrics().overflowMsgQueueSize.set(++m_overflowMsgSize);
+    return true;
+}
+
 void PBFTEngine::clearAllCache()
 {
     RecursiveGuard l(m_mutex);
@@ -529,12 +604,27 @@ void PBFTEngine::executeWorker()
         waitSignal();
         return;
     }
+    // handle the overflowed undroppable messages first
+    std::optional<std::shared_ptr<PBFTBaseMessageInterface>> messageResult;
+    if (!m_overflowMsgQueue.empty())
+    {
+        auto overflowResult = m_overflowMsgQueue.tryPop(0);
+        if (overflowResult.first)
+        {
+            messageResult = std::move(overflowResult.second);
+            pbftMetrics().overflowMsgQueueSize.set(--m_overflowMsgSize);
+        }
+    }
     // handle the PBFT message(here will wait when the msgQueue is empty)
-    auto messageResult = m_msgQueue->tryPop(c_PopWaitSeconds);
+    if (!messageResult)
+    {
+        messageResult = m_msgQueue->tryPop(c_PopWaitSeconds);
+    }
     auto empty = m_msgQueue->empty();
-    if (messageResult.first)
+    pbftMetrics().msgQueueSize.set(m_msgQueue->size());
+    if (messageResult)
     {
-        auto pbftMsg = messageResult.second;
+        auto pbftMsg = std::move(*messageResult);
         auto packetType = pbftMsg->packetType();
         // can't handle the future consensus messages when handling the system
         // proposal
@@ -547,7 +637,14 @@ void PBFTEngine::executeWorker()
                             << LOG_KV("index", pbftMsg->index()) << LOG_KV("type", packetType)
                             << m_config->printCurrentState();
 #endif
-            m_msgQueue->push(pbftMsg);
+            // the worker is the only consumer, never wait for room here
+            if (!pushWithoutWait(pbftMsg))
+            {
+                PBFT_LOG(WARNING) << LOG_DESC(
+                                         "drop the future consensus message for overflow msgQueue "
+                                         "full")
+                                  << LOG_KV("type", packetType) << LOG_KV("index", pbftMsg->index());
+            }
             if (empty)
             {
                 waitSignal();
@@ -572,6 +669,13 @@ void PBFTEngine::handleMsg(std::shared_ptr<PBFTBaseMessageInterface> _msg)
                           << printPBFTMsgInfo(_msg);
         return;
     }
+    std::optional<metrics::ScopedTimer> timer;
+    std::optional<trace::ScopedSpan> span;
+    if (_msg->packetType() <= PacketType::RecoverResponse)
+    {
+        timer.emplace(*pbftMetrics().handleMsgTime[_msg->packetType()]);
+        span.emplace(trace::c_consensus, c_packetTypeNames[_msg->packetType()], _msg->index());
+    }
     RecursiveGuard l(m_mutex);
     switch (_msg->packetType())
     {
@@ -770,8 +874,8 @@ bool PBFTEngine::handlePrePrepareMsg(PBFTMessageInterface::Ptr _prePrepareMsg,
                         << m_config->printCurrentState();
         return false;
     }
-    PBFT_LOG(INFO) << LOG_DESC("handlePrePrepareMsg") << printPBFTMsgInfo(_prePrepareMsg)
-                   << m_config->printCurrentState();
+    PBFT_ASYNC_LOG(INFO, "handlePrePrepareMsg" PBFT_MSG_INFO_FORMAT PBFT_STATE_FORMAT,
+        PBFT_MSG_INFO_ARGS(_prePrepareMsg), PBFT_STATE_ARGS(m_config));
 
     auto result = checkPrePrepareMsg(_prePrepareMsg);
     if (result == CheckResult::INVALID)
@@ -814,8 +918,12 @@ bool PBFTEngine::handlePrePrepareMsg(PBFTMessageInterface::Ptr _prePrepareMsg,
         m_config->timer()->restart();
         // broadcast PrepareMsg the packet
         broadcastPrepareMsg(_prePrepareMsg);
-        PBFT_LOG(INFO) << LOG_DESC("handlePrePrepareMsg and broadcast prepare packet")
-                       << printPBFTMsgInfo(_prePrepareMsg) << m_config->printCurrentState();
+        PBFT_ASYNC_LOG(INFO,
+            "handlePrePrepareMsg and broadcast prepare packet" PBFT_MSG_INFO_FORMAT
+                PBFT_STATE_FORMAT,
+            PBFT_MSG_INFO_ARGS(_prePrepareMsg), PBFT_STATE_ARGS(m_config));
+        // execute the proposal while the prepare and commit messages are exchanged
+        m_cacheProcessor->tryToSpeculativeApply(_prePrepareMsg->consensusProposal());
         m_cacheProcessor->checkAndPreCommit();
         return true;
     }
@@ -22,6 +22,7 @@
 #include "PBFTLogSync.h"
 #include "bcos-pbft/core/ConsensusEngine.h"
 #include <bcos-tool/LedgerConfigFetcher.h>
+#include <bcos-utilities/BoundedConcurrentQueue.h>
 #include <bcos-utilities/ConcurrentQueue.h>
 #include <bcos-utilities/Error.h>
 
@@ -41,7 +42,7 @@ class PBFTConfig;
 class PBFTCacheProcessor;
 class PBFTProposalInterface;
 
-using PBFTMsgQueue = ConcurrentQueue<std::shared_ptr<PBFTBaseMessageInterface>>;
+using PBFTMsgQueue = BoundedConcurrentQueue<std::shared_ptr<PBFTBaseMessageInterface>>;
 using PBFTMsgQueuePtr = std::shared_ptr<PBFTMsgQueue>;
 
 enum CheckResult
@@ -196,6 +197,9 @@ protected:
         Error::Ptr&& _error, PBFTProposalInterface::Ptr _stableProposal);
 
 private:
+    // push the message into m_msgQueue, or m_overflowMsgQueue if m_msgQueue is full, never wait
+    // for room, return false if both of them are full
+    bool pushWithoutWait(std::shared_ptr<PBFTBaseMessageInterface> _msg);
     // utility functions
     void waitSignal()
     {
@@ -212,6 +216,10 @@ protected:
 
     // PBFT message cache queue
     PBFTMsgQueuePtr m_msgQueue;
+    // the undroppable messages received and the future consensus messages re-pushed when
+    // m_msgQueue is full, handled before m_msgQueue, at most c_maxOverflowMsgs
+    ConcurrentQueue<std::shared_ptr<PBFTBaseMessageInterface>> m_overflowMsgQueue;
+    std::atomic<size_t> m_overflowMsgSize = {0};
     std::shared_ptr<PBFTCacheProcessor> m_cacheProcessor;
     // for log syncing
     PBFTLogSync::Ptr m_logSync;
@@ -225,6 +233,9 @@ protected:
     mutable RecursiveMutex m_mutex;
 
     const unsigned c_PopWaitSeconds = 5;
+    // the network threads wait at most c_PushWaitMilliseconds when m_msgQueue is full
+    const int c_PushWaitMilliseconds = 100;
+    const size_t c_maxOverflowMsgs = 10000;
 
     // Message packets allowed to be processed in timeout mode
     const std::set<PacketType> c_timeoutAllowedPacket = {ViewChangePacket, NewViewPacket,
@@ -233,6 +244,10 @@ protected:
 
     const std::set<PacketType> c_consensusPacket = {PrePreparePacket, PreparePacket, CommitPacket};
 
+    // the viewchange, checkpoint and recover packets keep the consensus alive, never drop them
+    const std::set<PacketType> c_undroppablePacket = {
+        ViewChangePacket, NewViewPacket, CheckPoint, RecoverRequest, RecoverResponse};
+
     std::atomic_bool m_stopped = {false};
     bcos::tool::LedgerConfigFetcher::Ptr m_ledgerFetcher;
 };
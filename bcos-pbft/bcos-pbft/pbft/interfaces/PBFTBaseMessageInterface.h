@@ -80,4 +80,10 @@ inline std::string printPBFTMsgInfo(PBFTBaseMessageInterface::Ptr _pbftMsg)
     return stringstream.str();
 }
 }  // namespace consensus
-}  // namespace bcos
\ No newline at end of file
+}  // namespace bcos
+
+// the fields of printPBFTMsgInfo for PBFT_ASYNC_LOG, formatted on the background thread
+#define PBFT_MSG_INFO_FORMAT ",reqHash={},reqIndex={},reqV={},fromIdx={}"
+#define PBFT_MSG_INFO_ARGS(_pbftMsg)                                                               \
+    (_pbftMsg)->hash().abridged(), (_pbftMsg)->index(), (_pbftMsg)->view(),                        \
+        (_pbftMsg)->generatedFrom()
@@ -19,10 +19,14 @@
  */
 #pragma once
 #include <bcos-framework/Common.h>
+#include <bcos-utilities/AsyncLog.h>
 #include <bcos-utilities/Exceptions.h>
 #include <stdint.h>
 
 #define PBFT_LOG(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE("CONSENSUS") << LOG_BADGE("PBFT")
+// for the logs of every proposal, formatted on the background thread
+#define PBFT_ASYNC_LOG(LEVEL, FORMAT, ...) \
+    BCOS_ASYNC_LOG(LEVEL, "[CONSENSUS][PBFT]" FORMAT __VA_OPT__(, ) __VA_ARGS__)
 #define PBFT_STORAGE_LOG(LEVEL) \
     BCOS_LOG(LEVEL) << LOG_BADGE("CONSENSUS") << LOG_BADGE("PBFT") << LOG_BADGE("STORAGE")
 
@@ -26,6 +26,7 @@
 #include <bcos-crypto/signature/secp256k1/Secp256k1Crypto.h>
 #include <bcos-utilities/testutils/TestPromptFixture.h>
 #include <boost/test/unit_test.hpp>
+#include <future>
 
 using namespace bcos;
 using namespace bcos::consensus;
@@ -49,7 +50,8 @@ inline bool shouldExit(std::map<IndexType, PBFTFixture::Ptr>& _consensusNodes,
     return true;
 }
 
-void testPBFTEngineWithFaulty(size_t _consensusNodes, size_t _connectedNodes)
+std::map<IndexType, PBFTFixture::Ptr> testPBFTEngineWithFaulty(
+    size_t _consensusNodes, size_t _connectedNodes, bool _speculativeExecution = false)
 {
     auto hashImpl = std::make_shared<Keccak256>();
     auto signatureImpl = std::make_shared<Secp256k1Crypto>();
@@ -59,6 +61,10 @@ void testPBFTEngineWithFaulty(size_t _consensusNodes, size_t _connectedNodes)
     std::cout << "### createFakers: " << currentBlockNumber << std::endl;
     auto fakerMap = createFakers(cryptoSuite, _consensusNodes, currentBlockNumber, _connectedNodes);
     std::cout << "### createFakers: " << currentBlockNumber << " success" << std::endl;
+    for (auto const& node : fakerMap)
+    {
+        node.second->pbftConfig()->setSpeculativeExecution(_speculativeExecution);
+    }
     // check the leader notify the sealer to seal proposals
     IndexType leaderIndex = 0;
     auto leaderFaker = fakerMap[leaderIndex];
@@ -130,6 +136,7 @@ void testPBFTEngineWithFaulty(size_t _consensusNodes, size_t _connectedNodes)
         }
         std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
+    return fakerMap;
 }
 
 // TODO: Remove this test due to memory access violation
@@ -146,6 +153,71 @@ BOOST_AUTO_TEST_CASE(testPBFTEngineWithAllNonFaulty)
     std::cout << "testPBFTEngineWithFaulty with 7 non-faulty success" << std::endl;
 }
 
+BOOST_AUTO_TEST_CASE(testPBFTEngineWithSpeculativeExecution)
+{
+    // the replicas execute the proposals before commit and adopt the results
+    auto fakerMap = testPBFTEngineWithFaulty(4, 4, true);
+    uint64_t adopted = 0;
+    uint64_t discarded = 0;
+    for (auto const& node : fakerMap)
+    {
+        auto stateMachine =
+            std::dynamic_pointer_cast<StateMachine>(node.second->pbftConfig()->stateMachine());
+        adopted += stateMachine->adoptedSpeculations();
+        discarded += stateMachine->discardedSpeculations();
+    }
+    BOOST_CHECK(adopted > 0);
+    // every committed proposal is the one pre-prepared
+    BOOST_CHECK_EQUAL(discarded, 0);
+}
+
+BOOST_AUTO_TEST_CASE(testSpeculativeExecutionDiscarded)
+{
+    auto hashImpl = std::make_shared<Keccak256>();
+    auto signatureImpl = std::make_shared<Secp256k1Crypto>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+    auto fakerMap = createFakers(cryptoSuite, 1, 19, 1);
+    auto faker = fakerMap[0];
+    auto stateMachine =
+        std::dynamic_pointer_cast<StateMachine>(faker->pbftConfig()->stateMachine());
+    auto committedProposal = faker->pbftConfig()->committedProposal();
+    auto index = committedProposal->index() + 1;
+
+    auto fakeProposal = [&](size_t _txsSize) {
+        auto block = fakeBlock(cryptoSuite, faker, index, _txsSize);
+        bytes blockData;
+        block->encode(blockData);
+        auto proposal = std::make_shared<PBFTProposal>();
+        proposal->setIndex(index);
+        // the fake headers of the same index are the same, distinguish the proposals by the txs
+        proposal->setHash(hashImpl->hash(blockData));
+        proposal->setData(std::move(blockData));
+        return proposal;
+    };
+    auto apply = [&](PBFTProposal::Ptr _proposal) {
+        std::promise<int64_t> executed;
+        auto executedProposal = std::make_shared<PBFTProposal>();
+        stateMachine->asyncApply(0, committedProposal, _proposal, executedProposal,
+            [&executed](int64_t _code) { executed.set_value(_code); });
+        BOOST_CHECK_EQUAL(executed.get_future().get(), 0);
+        BOOST_CHECK_EQUAL(executedProposal->index(), index);
+    };
+
+    // another proposal of the same index is committed, the speculative result is discarded and
+    // the committed one is executed
+    stateMachine->asyncSpeculativeApply(committedProposal, fakeProposal(10));
+    apply(fakeProposal(5));
+    BOOST_CHECK_EQUAL(stateMachine->discardedSpeculations(), 1);
+    BOOST_CHECK_EQUAL(stateMachine->adoptedSpeculations(), 0);
+
+    // the speculated proposal is committed
+    auto proposal = fakeProposal(10);
+    stateMachine->asyncSpeculativeApply(committedProposal, proposal);
+    apply(proposal);
+    BOOST_CHECK_EQUAL(stateMachine->discardedSpeculations(), 1);
+    BOOST_CHECK_EQUAL(stateMachine->adoptedSpeculations(), 1);
+}
+
 BOOST_AUTO_TEST_CASE(testHandlePrePrepareMsg)
 {
     auto hashImpl = std::make_shared<Keccak256>();
@@ -37,6 +37,7 @@
 #include <bcos-utilities/DataConvertUtility.h>
 #include <bcos-utilities/Exceptions.h>
 #include <bcos-utilities/FileUtility.h>
+#include <bcos-utilities/Metrics.h>
 #include <bcos-utilities/ThreadPool.h>
 #include <boost/core/ignore_unused.hpp>
 #include <boost/property_tree/ini_parser.hpp>
@@ -328,6 +329,7 @@ bcos::rpc::JsonRpcImpl_2_0::Ptr RpcFactory::buildJsonRpc(int sendTxTimeout,
     auto jsonRpcInterface =
         std::make_shared<bcos::rpc::JsonRpcImpl_2_0>(_groupManager, m_gateway, _wsService);
     jsonRpcInterface->setSendTxTimeout(sendTxTimeout);
+    jsonRpcInterface->setMaxBatchRequestSize(m_nodeConfig->rpcMaxBatchRequestSize());
     /*/
         auto jsonRpcInterface =
             std::make_shared<bcos::rpc::DupTestTxJsonRpcImpl_2_0>(_groupManager, m_gateway,
@@ -338,6 +340,13 @@ bcos::rpc::JsonRpcImpl_2_0::Ptr RpcFactory::buildJsonRpc(int sendTxTimeout,
     {
         httpServer->setHttpReqHandler(std::bind(&bcos::rpc::JsonRpcInterface::onRPCRequest,
             jsonRpcInterface, std::placeholders::_1, std::placeholders::_2));
+        if (m_nodeConfig->rpcEnableMetrics())
+        {
+            httpServer->registerGetHandler("/metrics", []() {
+                return std::make_pair(std::string("text/plain; version=0.0.4"),
+                    bcos::metrics::MetricsRegistry::instance().prometheusText());
+            });
+        }
     }
     return jsonRpcInterface;
 }
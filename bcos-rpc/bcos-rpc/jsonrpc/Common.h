@@ -30,6 +30,9 @@ namespace bcos
 {
 namespace rpc
 {
+// the default max number of calls in one JSON-RPC batch request
+constexpr static size_t c_defaultMaxBatchRequestSize = 100;
+
 struct NodeInfo
 {
     std::string version;
@@ -78,7 +81,7 @@ struct JsonRequest
 {
     std::string jsonrpc;
     std::string method;
-    int64_t id;
+    int64_t id{0};
     Json::Value params;
 };
 
@@ -95,7 +98,7 @@ struct JsonResponse
         }
     };
     std::string jsonrpc;
-    int64_t id;
+    int64_t id{0};
     Error error;
     Json::Value result;
 };
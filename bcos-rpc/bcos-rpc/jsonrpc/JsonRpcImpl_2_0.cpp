@@ -27,10 +27,14 @@
 #include <bcos-framework/protocol/LogEntry.h>
 #include <bcos-framework/protocol/Transaction.h>
 #include <bcos-framework/protocol/TransactionReceipt.h>
+#include <bcos-framework/sync/PeerScores.h>
 #include <bcos-protocol/TransactionStatus.h>
 #include <bcos-rpc/jsonrpc/Common.h>
 #include <bcos-rpc/jsonrpc/JsonRpcImpl_2_0.h>
+#include <bcos-tars-protocol/Common.h>
+#include <bcos-tars-protocol/tars/TransactionBatch.h>
 #include <bcos-utilities/Base64.h>
+#include <bcos-utilities/Tracer.h>
 #include <json/value.h>
 #include <boost/algorithm/hex.hpp>
 #include <boost/archive/iterators/base64_from_binary.hpp>
@@ -61,6 +65,9 @@ JsonRpcImpl_2_0::JsonRpcImpl_2_0(GroupManager::Ptr _groupManager,
     m_wsService->registerMsgHandler(bcos::protocol::MessageType::RPC_REQUEST,
         boost::bind(&JsonRpcImpl_2_0::handleRpcRequest, this, boost::placeholders::_1,
             boost::placeholders::_2));
+    m_wsService->registerMsgHandler(bcos::protocol::MessageType::RPC_SUBMIT_TRANSACTIONS,
+        boost::bind(&JsonRpcImpl_2_0::handleSubmitTransactions, this, boost::placeholders::_1,
+            boost::placeholders::_2));
 }
 
 void JsonRpcImpl_2_0::handleRpcRequest(
@@ -96,6 +103,125 @@ void JsonRpcImpl_2_0::handleRpcRequest(
     });
 }
 
+void JsonRpcImpl_2_0::handleSubmitTransactions(
+    std::shared_ptr<boostssl::MessageFace> _msg, std::shared_ptr<boostssl::ws::WsSession> _session)
+{
+    struct BatchContext
+    {
+        std::shared_ptr<boostssl::MessageFace> msg;
+        std::shared_ptr<boostssl::ws::WsSession> session;
+        bcostars::TransactionBatchResponse response;
+        std::atomic<size_t> remaining = {0};
+
+        void sendResponse()
+        {
+            if (!session || !session->isConnected())
+            {
+                RPC_IMPL_LOG(WARNING)
+                    << LOG_BADGE("handleSubmitTransactions")
+                    << LOG_DESC("unable to send response for session has been inactive")
+                    << LOG_KV("seq", msg->seq()) << LOG_KV("txs", response.results.size());
+                return;
+            }
+            tars::TarsOutputStream<bcostars::protocol::BufferWriterByteVector> output;
+            response.writeTo(output);
+            auto buffer = std::make_shared<bcos::bytes>();
+            output.getByteBuffer().swap(*buffer);
+            msg->setPayload(buffer);
+            session->asyncSendMessage(msg);
+        }
+
+        void onResult(size_t _index, Error::Ptr _error, Json::Value const* _jResp)
+        {
+            auto& result = response.results[_index];
+            if (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS)
+            {
+                result.error.errorCode = _error->errorCode();
+                result.error.errorMessage = _error->errorMessage();
+            }
+            else if (_jResp)
+            {
+                auto jResp = toBytes(*_jResp);
+                result.result.assign(jResp.begin(), jResp.end());
+            }
+            if (remaining.fetch_sub(1) == 1)
+            {
+                sendResponse();
+            }
+        }
+    };
+
+    auto context = std::make_shared<BatchContext>();
+    context->msg = _msg;
+    context->session = _session;
+
+    bcostars::TransactionBatchRequest request;
+    try
+    {
+        auto payload = _msg->payload();
+        tars::TarsInputStream<tars::BufferReader> input;
+        input.setBuffer((const char*)payload->data(), payload->size());
+        request.readFrom(input);
+        if (request.transactions.size() > maxBatchRequestSize())
+        {
+            BOOST_THROW_EXCEPTION(JsonRpcException(JsonRpcError::InvalidRequest,
+                "The batch request exceeds the limit of " + std::to_string(maxBatchRequestSize()) +
+                    " transactions."));
+        }
+    }
+    catch (JsonRpcException const& e)
+    {
+        context->response.error.errorCode = e.code();
+        context->response.error.errorMessage = e.what();
+        context->sendResponse();
+        return;
+    }
+    catch (std::exception const& e)
+    {
+        context->response.error.errorCode = JsonRpcError::InvalidRequest;
+        context->response.error.errorMessage = "invalid transaction batch";
+        RPC_IMPL_LOG(WARNING) << LOG_BADGE("handleSubmitTransactions")
+                              << LOG_DESC("decode transaction batch failed")
+                              << LOG_KV("error", boost::diagnostic_information(e));
+        context->sendResponse();
+        return;
+    }
+
+    auto size = request.transactions.size();
+    RPC_IMPL_LOG(TRACE) << LOG_BADGE("handleSubmitTransactions") << LOG_KV("group", request.groupID)
+                        << LOG_KV("node", request.nodeName) << LOG_KV("txs", size);
+    if (size == 0)
+    {
+        context->sendResponse();
+        return;
+    }
+    context->response.results.resize(size);
+    context->remaining = size;
+    for (size_t i = 0; i < size; ++i)
+    {
+        auto& transaction = request.transactions[i];
+        try
+        {
+            submitTransaction(request.groupID, request.nodeName,
+                bcos::bytes(transaction.begin(), transaction.end()), request.requireProof,
+                [context, i](Error::Ptr _error, Json::Value& _jResp) {
+                    context->onResult(i, std::move(_error), &_jResp);
+                });
+        }
+        catch (JsonRpcException const& e)
+        {
+            context->onResult(i, std::make_shared<Error>(e.code(), e.what()), nullptr);
+        }
+        catch (std::exception const& e)
+        {
+            context->onResult(i,
+                std::make_shared<Error>(
+                    JsonRpcError::InternalError, boost::diagnostic_information(e)),
+                nullptr);
+        }
+    }
+}
+
 bcos::bytes JsonRpcImpl_2_0::decodeData(std::string_view _data)
 {
     auto begin = _data.begin();
@@ -363,9 +489,15 @@ void JsonRpcImpl_2_0::call(std::string_view _groupID, std::string_view _nodeName
 
 void JsonRpcImpl_2_0::sendTransaction(std::string_view _groupID, std::string_view _nodeName,
     std::string_view _data, bool _requireProof, RespFunc _respFunc)
+{
+    submitTransaction(_groupID, _nodeName, decodeData(_data), _requireProof, std::move(_respFunc));
+}
+
+void JsonRpcImpl_2_0::submitTransaction(std::string_view _groupID, std::string_view _nodeName,
+    bcos::bytes _transactionData, bool _requireProof, RespFunc _respFunc)
 {
     auto self = std::weak_ptr<JsonRpcImpl_2_0>(shared_from_this());
-    auto transactionData = decodeData(_data);
+    auto transactionData = std::move(_transactionData);
     auto nodeService = getNodeService(_groupID, _nodeName, "sendTransaction");
     auto txpool = nodeService->txpool();
     checkService(txpool, "txpool");
@@ -1140,6 +1272,28 @@ void JsonRpcImpl_2_0::getGroupBlockNumber(RespFunc _respFunc)
     _respFunc(nullptr, response);
 }
 
+void JsonRpcImpl_2_0::getBlockTrace(std::string_view _groupID, std::string_view _nodeName,
+    int64_t _blockNumber, RespFunc _respFunc)
+{
+    RPC_IMPL_LOG(TRACE) << LOG_DESC("getBlockTrace") << LOG_KV("group", _groupID)
+                        << LOG_KV("node", _nodeName) << LOG_KV("blockNumber", _blockNumber);
+    getNodeService(_groupID, _nodeName, "getBlockTrace");
+    auto& tracer = trace::Tracer::instance();
+    if (tracer.capacity() == 0)
+    {
+        BOOST_THROW_EXCEPTION(JsonRpcException(JsonRpcError::OperationNotAllowed,
+            "The trace is disabled, please set trace.enable to true"));
+    }
+    Json::Value response;
+    Json::Reader reader;
+    if (!reader.parse(tracer.chromeTrace(_blockNumber), response))
+    {
+        BOOST_THROW_EXCEPTION(
+            JsonRpcException(JsonRpcError::InternalError, "Invalid trace of the block"));
+    }
+    _respFunc(nullptr, response);
+}
+
 // get the information of a given node
 void JsonRpcImpl_2_0::getGroupNodeInfo(
     std::string_view _groupID, std::string_view _nodeName, RespFunc _respFunc)
@@ -1190,11 +1344,35 @@ void JsonRpcImpl_2_0::gatewayInfoToJson(Json::Value& _response,
     {
         return;
     }
+    // the network quality of the nodes measured by the block sync and the txs sync
+    std::map<std::string, Json::Value> nodeScores;
+    for (auto const& [nodeID, score] : bcos::sync::PeerScores::instance()->scores())
+    {
+        Json::Value item;
+        item["nodeID"] = *toHexString(nodeID);
+        item["rtt"] = score.rtt;
+        item["throughput"] = score.throughput;
+        item["failureRate"] = score.failureRate;
+        nodeScores[item["nodeID"].asString()] = item;
+    }
     Json::Value peersInfo(Json::arrayValue);
     for (auto const& it : *_peersInfo)
     {
         Json::Value peerInfo;
         gatewayInfoToJson(peerInfo, it);
+        Json::Value scores(Json::arrayValue);
+        for (auto const& groupNodeIDs : it->nodeIDInfo())
+        {
+            for (auto const& nodeID : groupNodeIDs.second)
+            {
+                auto score = nodeScores.find(nodeID);
+                if (score != nodeScores.end())
+                {
+                    scores.append(score->second);
+                }
+            }
+        }
+        peerInfo["scores"] = scores;
         peersInfo.append(peerInfo);
     }
     _response["peers"] = peersInfo;
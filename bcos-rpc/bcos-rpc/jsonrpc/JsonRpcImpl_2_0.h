@@ -116,6 +116,9 @@ public:
 
     void getGroupBlockNumber(RespFunc _respFunc) override;
 
+    void getBlockTrace(std::string_view _groupID, std::string_view _nodeName,
+        int64_t _blockNumber, RespFunc _respFunc) override;
+
 public:
     void setNodeInfo(const NodeInfo& _nodeInfo) { m_nodeInfo = _nodeInfo; }
     NodeInfo nodeInfo() const { return m_nodeInfo; }
@@ -142,6 +145,13 @@ protected:
 
     virtual void handleRpcRequest(std::shared_ptr<boostssl::MessageFace> _msg,
         std::shared_ptr<boostssl::ws::WsSession> _session);
+    // the signed transactions submitted by the sdk in one binary request, the response is sent
+    // when all the transactions have their results
+    virtual void handleSubmitTransactions(std::shared_ptr<boostssl::MessageFace> _msg,
+        std::shared_ptr<boostssl::ws::WsSession> _session);
+
+    void submitTransaction(std::string_view _groupID, std::string_view _nodeName,
+        bcos::bytes _transactionData, bool _requireProof, RespFunc _respFunc);
 
     // TODO: check perf influence
     NodeService::Ptr getNodeService(
@@ -1,10 +1,13 @@
 #include "JsonRpcInterface.h"
+#include <bcos-utilities/Common.h>
 #include <json/forwards.h>
 #include <boost/beast/core/ostream.hpp>
 #include <boost/iostreams/device/array.hpp>
 #include <boost/iostreams/device/back_inserter.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
 #include <boost/iostreams/stream.hpp>
+#include <atomic>
+#include <cctype>
 #include <iterator>
 #include <ostream>
 #include <sstream>
@@ -63,6 +66,8 @@ void JsonRpcInterface::initMethod()
         &JsonRpcInterface::getGroupInfoListI, this, std::placeholders::_1, std::placeholders::_2);
     m_methodToFunc["getGroupNodeInfo"] = std::bind(
         &JsonRpcInterface::getGroupNodeInfoI, this, std::placeholders::_1, std::placeholders::_2);
+    m_methodToFunc["getBlockTrace"] = std::bind(
+        &JsonRpcInterface::getBlockTraceI, this, std::placeholders::_1, std::placeholders::_2);
 
     for (const auto& method : m_methodToFunc)
     {
@@ -72,12 +77,137 @@ void JsonRpcInterface::initMethod()
 }
 
 void JsonRpcInterface::onRPCRequest(std::string_view _requestBody, Sender _sender)
+{
+    if (isBatchRequest(_requestBody))
+    {
+        onRPCBatchRequest(_requestBody, std::move(_sender));
+        return;
+    }
+
+    Json::Value root;
+    try
+    {
+        parseRpcRequestJson(_requestBody, root);
+    }
+    catch (const JsonRpcException& e)
+    {
+        JsonResponse response;
+        response.error.code = e.code();
+        response.error.message = std::string(e.what());
+        auto strResp = toStringResponse(std::move(response));
+        RPC_IMPL_LOG(DEBUG) << LOG_BADGE("onRPCRequest") << LOG_KV("request", _requestBody)
+                            << LOG_KV("response",
+                                   std::string_view((const char*)strResp.data(), strResp.size()));
+        _sender(std::move(strResp));
+        return;
+    }
+
+    handleRequest(root, [_requestBody, _sender](JsonResponse _response) {
+        auto failed = (_response.error.code != 0);
+        auto strResp = toStringResponse(std::move(_response));
+        if (failed)
+        {
+            RPC_IMPL_LOG(DEBUG) << LOG_BADGE("onRPCRequest") << LOG_KV("request", _requestBody)
+                                << LOG_KV("response", std::string_view((const char*)strResp.data(),
+                                                          strResp.size()));
+        }
+        else
+        {
+            RPC_IMPL_LOG(TRACE) << LOG_BADGE("onRPCRequest") << LOG_KV("request", _requestBody)
+                                << LOG_KV("response", std::string_view((const char*)strResp.data(),
+                                                          strResp.size()));
+        }
+        _sender(std::move(strResp));
+    });
+}
+
+bool JsonRpcInterface::isBatchRequest(std::string_view _requestBody)
+{
+    for (auto c : _requestBody)
+    {
+        if (!std::isspace(static_cast<unsigned char>(c)))
+        {
+            return c == '[';
+        }
+    }
+    return false;
+}
+
+void JsonRpcInterface::onRPCBatchRequest(std::string_view _requestBody, Sender _sender)
+{
+    Json::Value root;
+    JsonResponse errorResponse;
+    try
+    {
+        parseRpcRequestJson(_requestBody, root);
+        if (!root.isArray() || root.empty())
+        {
+            BOOST_THROW_EXCEPTION(JsonRpcException(
+                JsonRpcError::InvalidRequest, "The JSON sent is not a valid Request object."));
+        }
+        if (root.size() > m_maxBatchRequestSize)
+        {
+            BOOST_THROW_EXCEPTION(JsonRpcException(JsonRpcError::InvalidRequest,
+                "The batch request exceeds the limit of " + std::to_string(m_maxBatchRequestSize) +
+                    " calls."));
+        }
+    }
+    catch (const JsonRpcException& e)
+    {
+        // the batch is rejected as a whole with a single response object, as JSON-RPC 2.0 requires
+        errorResponse.error.code = e.code();
+        errorResponse.error.message = std::string(e.what());
+        auto strResp = toStringResponse(std::move(errorResponse));
+        RPC_IMPL_LOG(DEBUG) << LOG_BADGE("onRPCBatchRequest") << LOG_KV("request", _requestBody)
+                            << LOG_KV("response",
+                                   std::string_view((const char*)strResp.data(), strResp.size()));
+        _sender(std::move(strResp));
+        return;
+    }
+
+    // all the calls of the batch are dispatched at once, the responses are collected into the
+    // slot with the same index and sent back together when the last call completes
+    struct BatchContext
+    {
+        explicit BatchContext(size_t _size) : responses(_size), pending(_size) {}
+        std::vector<Json::Value> responses;
+        std::atomic<size_t> pending;
+    };
+    auto batchSize = root.size();
+    auto context = std::make_shared<BatchContext>(batchSize);
+    auto startT = utcTime();
+    for (Json::ArrayIndex i = 0; i < batchSize; i++)
+    {
+        handleRequest(
+            root[i], [i, context, _sender, startT, batchSize](JsonResponse _response) {
+                context->responses[i] = toJsonResponse(std::move(_response));
+                if (context->pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                {
+                    return;
+                }
+                Json::Value jResp(Json::arrayValue);
+                for (auto& response : context->responses)
+                {
+                    jResp.append(std::move(response));
+                }
+                auto strResp = toBytes(jResp);
+                RPC_IMPL_LOG(TRACE) << LOG_BADGE("onRPCBatchRequest")
+                                    << LOG_KV("batchSize", batchSize)
+                                    << LOG_KV("respSize", strResp.size())
+                                    << LOG_KV("timecost", (utcTime() - startT));
+                _sender(std::move(strResp));
+            });
+    }
+}
+
+void JsonRpcInterface::handleRequest(
+    Json::Value const& _request, std::function<void(JsonResponse)> _onResponse)
 {
     JsonRequest request;
     JsonResponse response;
     try
     {
-        parseRpcRequestJson(_requestBody, request);
+        parseRpcRequestJson(_request, request);
 
         response.jsonrpc = request.jsonrpc;
         response.id = request.id;
@@ -91,7 +221,7 @@ void JsonRpcInterface::onRPCRequest(std::string_view _requestBody, Sender _sende
         }
 
         it->second(request.params,
-            [_requestBody, response, _sender](Error::Ptr _error, Json::Value& _result) mutable {
+            [response, _onResponse](Error::Ptr _error, Json::Value& _result) mutable {
                 if (_error && (_error->errorCode() != bcos::protocol::CommonError::SUCCESS))
                 {
                     // error
@@ -102,12 +232,7 @@ void JsonRpcInterface::onRPCRequest(std::string_view _requestBody, Sender _sende
                 {
                     response.result.swap(_result);
                 }
-                auto strResp = toStringResponse(std::move(response));
-                RPC_IMPL_LOG(TRACE)
-                    << LOG_BADGE("onRPCRequest") << LOG_KV("request", _requestBody)
-                    << LOG_KV("response",
-                           std::string_view((const char*)strResp.data(), strResp.size()));
-                _sender(std::move(strResp));
+                _onResponse(std::move(response));
             });
 
         // success response
@@ -124,19 +249,34 @@ void JsonRpcInterface::onRPCRequest(std::string_view _requestBody, Sender _sende
         response.error.code = JsonRpcError::InvalidRequest;
         response.error.message = std::string(e.what());
     }
-
-    auto strResp = toStringResponse(response);
-
-    RPC_IMPL_LOG(DEBUG) << LOG_BADGE("onRPCRequest") << LOG_KV("request", _requestBody)
-                        << LOG_KV("response",
-                               std::string_view((const char*)strResp.data(), strResp.size()));
-    _sender(strResp);
+    _onResponse(std::move(response));
 }
 
-void JsonRpcInterface::parseRpcRequestJson(std::string_view _requestBody, JsonRequest& _jsonRequest)
+void JsonRpcInterface::parseRpcRequestJson(std::string_view _requestBody, Json::Value& _root)
 {
-    Json::Value root;
     Json::Reader jsonReader;
+    try
+    {
+        if (jsonReader.parse(_requestBody.begin(), _requestBody.end(), _root))
+        {
+            return;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        RPC_IMPL_LOG(ERROR) << LOG_BADGE("parseRpcRequestJson") << LOG_KV("request", _requestBody)
+                            << LOG_KV("error", boost::diagnostic_information(e));
+        BOOST_THROW_EXCEPTION(
+            JsonRpcException(JsonRpcError::ParseError, "Invalid JSON was received by the server."));
+    }
+    RPC_IMPL_LOG(ERROR) << LOG_BADGE("parseRpcRequestJson") << LOG_KV("request", _requestBody)
+                        << LOG_KV("errorMessage", "invalid request json object");
+    BOOST_THROW_EXCEPTION(
+        JsonRpcException(JsonRpcError::ParseError, "Invalid JSON was received by the server."));
+}
+
+void JsonRpcInterface::parseRpcRequestJson(Json::Value const& _root, JsonRequest& _jsonRequest)
+{
     std::string errorMessage;
 
     try
@@ -146,52 +286,47 @@ void JsonRpcInterface::parseRpcRequestJson(std::string_view _requestBody, JsonRe
         int64_t id = 0;
         do
         {
-            if (!jsonReader.parse(_requestBody.begin(), _requestBody.end(), root))
+            if (!_root.isObject())
             {
                 errorMessage = "invalid request json object";
                 break;
             }
 
-            if (!root.isMember("jsonrpc"))
+            if (!_root.isMember("jsonrpc"))
             {
                 errorMessage = "request has no jsonrpc field";
                 break;
             }
-            jsonrpc = root["jsonrpc"].asString();
+            jsonrpc = _root["jsonrpc"].asString();
 
-            if (!root.isMember("method"))
+            if (!_root.isMember("method"))
             {
                 errorMessage = "request has no method field";
                 break;
             }
-            method = root["method"].asString();
+            method = _root["method"].asString();
 
-            if (root.isMember("id"))
+            if (_root.isMember("id"))
             {
-                id = root["id"].asInt64();
+                id = _root["id"].asInt64();
             }
 
-            if (!root.isMember("params"))
+            if (!_root.isMember("params"))
             {
                 errorMessage = "request has no params field";
                 break;
             }
 
-            if (!root["params"].isArray())
+            if (!_root["params"].isArray())
             {
                 errorMessage = "request params is not array object";
                 break;
             }
 
-            auto jParams = root["params"];
-
             _jsonRequest.jsonrpc = jsonrpc;
             _jsonRequest.method = method;
             _jsonRequest.id = id;
-            _jsonRequest.params = jParams;
-
-            // RPC_IMPL_LOG(DEBUG) << LOG_BADGE("parseRpcRequestJson") << LOG_KV("method", method)
-            //                     << LOG_KV("requestMessage", _requestBody);
+            _jsonRequest.params = _root["params"];
 
             // success return
             return;
@@ -199,13 +334,13 @@ void JsonRpcInterface::parseRpcRequestJson(std::string_view _requestBody, JsonRe
     }
     catch (const std::exception& e)
     {
-        RPC_IMPL_LOG(ERROR) << LOG_BADGE("parseRpcRequestJson") << LOG_KV("request", _requestBody)
+        RPC_IMPL_LOG(ERROR) << LOG_BADGE("parseRpcRequestJson")
                             << LOG_KV("error", boost::diagnostic_information(e));
-        BOOST_THROW_EXCEPTION(
-            JsonRpcException(JsonRpcError::ParseError, "Invalid JSON was received by the server."));
+        BOOST_THROW_EXCEPTION(JsonRpcException(
+            JsonRpcError::InvalidRequest, "The JSON sent is not a valid Request object."));
     }
 
-    RPC_IMPL_LOG(ERROR) << LOG_BADGE("parseRpcRequestJson") << LOG_KV("request", _requestBody)
+    RPC_IMPL_LOG(ERROR) << LOG_BADGE("parseRpcRequestJson")
                         << LOG_KV("errorMessage", errorMessage);
 
     BOOST_THROW_EXCEPTION(JsonRpcException(
@@ -215,7 +350,11 @@ void JsonRpcInterface::parseRpcRequestJson(std::string_view _requestBody, JsonRe
 
 bcos::bytes JsonRpcInterface::toStringResponse(JsonResponse _jsonResponse)
 {
-    auto jResp = toJsonResponse(std::move(_jsonResponse));
+    return toBytes(toJsonResponse(std::move(_jsonResponse)));
+}
+
+bcos::bytes JsonRpcInterface::toBytes(Json::Value const& _jResp)
+{
     std::unique_ptr<Json::StreamWriter> writer(Json::StreamWriterBuilder().newStreamWriter());
     class JsonSink
     {
@@ -238,7 +377,7 @@ bcos::bytes JsonRpcInterface::toStringResponse(JsonResponse _jsonResponse)
     bcos::bytes out;
     boost::iostreams::stream<JsonSink> outputStream(out);
 
-    writer->write(jResp, &outputStream);
+    writer->write(_jResp, &outputStream);
     writer.reset();
     return out;
 }
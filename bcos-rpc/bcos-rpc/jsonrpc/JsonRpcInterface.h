@@ -113,15 +113,37 @@ public:
 
     virtual void getGroupBlockNumber(RespFunc _respFunc) = 0;
 
+    // get the execution spans of the block in the Chrome trace event format
+    virtual void getBlockTrace(std::string_view _groupID, std::string_view _nodeName,
+        int64_t _blockNumber, RespFunc _respFunc) = 0;
+
 public:
+    // handle both the single request object and the JSON-RPC 2.0 batch (array of request objects)
     void onRPCRequest(std::string_view _requestBody, Sender _sender);
 
+    void setMaxBatchRequestSize(size_t _maxBatchRequestSize)
+    {
+        m_maxBatchRequestSize = _maxBatchRequestSize;
+    }
+    size_t maxBatchRequestSize() const { return m_maxBatchRequestSize; }
+
+protected:
+    static bcos::bytes toBytes(Json::Value const& _jResp);
+
 private:
     void initMethod();
 
+    void onRPCBatchRequest(std::string_view _requestBody, Sender _sender);
+    // dispatch the parsed request object, _onResponse is called exactly once
+    void handleRequest(Json::Value const& _request, std::function<void(JsonResponse)> _onResponse);
+
     std::unordered_map<std::string, std::function<void(Json::Value, RespFunc)>> m_methodToFunc;
+    // the max number of calls accepted in one batch request
+    size_t m_maxBatchRequestSize = c_defaultMaxBatchRequestSize;
 
-    static void parseRpcRequestJson(std::string_view _requestBody, JsonRequest& _jsonRequest);
+    static bool isBatchRequest(std::string_view _requestBody);
+    static void parseRpcRequestJson(std::string_view _requestBody, Json::Value& _root);
+    static void parseRpcRequestJson(Json::Value const& _root, JsonRequest& _jsonRequest);
     static bcos::bytes toStringResponse(JsonResponse _jsonResponse);
     static Json::Value toJsonResponse(JsonResponse _jsonResponse);
 
@@ -269,6 +291,12 @@ private:
     {
         getGroupNodeInfo(toView(_req[0u]), toView(_req[1u]), std::move(_respFunc));
     }
+
+    void getBlockTraceI(const Json::Value& _req, RespFunc _respFunc)
+    {
+        getBlockTrace(
+            toView(_req[0u]), toView(_req[1u]), _req[2u].asInt64(), std::move(_respFunc));
+    }
 };
 
 }  // namespace bcos::rpc
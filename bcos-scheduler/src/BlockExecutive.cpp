@@ -10,6 +10,7 @@
 #include "bcos-table/src/StateStorage.h"
 #include <bcos-framework/executor/ExecuteError.h>
 #include <bcos-utilities/Error.h>
+#include <bcos-utilities/Tracer.h>
 #include <tbb/parallel_for_each.h>
 #include <boost/algorithm/hex.hpp>
 #include <boost/asio/defer.hpp>
@@ -27,6 +28,72 @@
 using namespace bcos::scheduler;
 using namespace bcos::ledger;
 
+namespace
+{
+// the batches of the requests a DMC round sends to the executors, flushed when the round leaves
+// the scope, with or without exception
+class ExecutorBatches
+{
+public:
+    using Executors = std::vector<bcos::executor::ParallelTransactionExecutorInterface::Ptr>;
+    explicit ExecutorBatches(Executors const& _executors)
+    {
+        for (auto const& executor : _executors)
+        {
+            if (auto batch = executor->createBatch())
+            {
+                m_batches.emplace_back(std::move(batch));
+            }
+        }
+    }
+    ~ExecutorBatches()
+    {
+        for (auto& batch : m_batches)
+        {
+            try
+            {
+                batch->flush();
+            }
+            catch (std::exception const& e)
+            {
+                DMC_LOG(WARNING) << "flush the executor batch exception: "
+                                 << boost::diagnostic_information(e);
+            }
+        }
+    }
+    ExecutorBatches(ExecutorBatches const&) = delete;
+    ExecutorBatches& operator=(ExecutorBatches const&) = delete;
+
+    // the requests issued by the calling thread go into the batches while the scope lives
+    class Scope
+    {
+    public:
+        explicit Scope(ExecutorBatches& _batches) : m_batches(_batches)
+        {
+            for (auto& batch : m_batches.m_batches)
+            {
+                batch->enter();
+            }
+        }
+        ~Scope()
+        {
+            for (auto& batch : m_batches.m_batches)
+            {
+                batch->leave();
+            }
+        }
+        Scope(Scope const&) = delete;
+        Scope& operator=(Scope const&) = delete;
+
+    private:
+        ExecutorBatches& m_batches;
+    };
+
+private:
+    std::vector<bcos::executor::ParallelTransactionExecutorInterface::Batch::Ptr> m_batches;
+};
+}  // namespace
+
 BlockExecutive::BlockExecutive(bcos::protocol::Block::Ptr block, SchedulerImpl* scheduler,
     size_t startContextID,
     bcos::protocol::TransactionSubmitResultFactory::Ptr transactionSubmitResultFactory,
@@ -56,6 +123,7 @@ void BlockExecutive::prepare()
     {
         return;
     }
+    BCOS_TRACE_SPAN(trace::c_scheduler, "prepare", number());
 
     auto startT = utcTime();
 
@@ -450,7 +518,9 @@ void BlockExecutive::asyncCommit(std::function<void(Error::UniquePtr)> callback)
     SCHEDULER_LOG(INFO) << BLOCK_NUMBER(number()) << LOG_DESC("BlockExecutive commit block");
 
     m_scheduler->m_ledger->asyncPrewriteBlock(stateStorage, m_blockTxs, m_block,
-        [this, stateStorage, callback = std::move(callback)](Error::Ptr&& error) mutable {
+        [this, stateStorage, spanStart = trace::spanStart(), callback = std::move(callback)](
+            Error::Ptr&& error) mutable {
+            trace::spanEnd(trace::c_ledger, "prewriteBlock", number(), spanStart);
             if (error)
             {
                 SCHEDULER_LOG(ERROR) << "Prewrite block error!" << error->errorMessage();
@@ -520,7 +590,9 @@ void BlockExecutive::asyncCommit(std::function<void(Error::UniquePtr)> callback)
             params.primaryTableName = SYS_CURRENT_STATE;
             params.primaryTableKey = SYS_KEY_CURRENT_NUMBER;
             m_scheduler->m_storage->asyncPrepare(params, *stateStorage,
-                [status, this, callback](Error::Ptr&& error, uint64_t startTimeStamp) {
+                [status, this, spanStart = trace::spanStart(), callback](
+                    Error::Ptr&& error, uint64_t startTimeStamp) {
+                    trace::spanEnd(trace::c_storage, "asyncPrepare", number(), spanStart);
                     if (error)
                     {
                         ++status->failed;
@@ -682,6 +754,8 @@ void BlockExecutive::DAGExecute(std::function<void(Error::UniquePtr)> callback)
     auto totalCount = std::make_shared<std::atomic_size_t>(requests.size());
     auto failed = std::make_shared<std::atomic_size_t>(0);
     auto callbackPtr = std::make_shared<decltype(callback)>(std::move(callback));
+    auto spanStart = trace::spanStart();
+    auto txsCount = requests.size();
     SCHEDULER_LOG(INFO) << LOG_BADGE("DAG") << LOG_BADGE("Stat") << BLOCK_NUMBER(number())
                         << "DAGExecute.0:\t>>> Start send to executor";
 
@@ -719,7 +793,7 @@ void BlockExecutive::DAGExecute(std::function<void(Error::UniquePtr)> callback)
         startT = utcTime();
         executor->dagExecuteTransactions(*messages,
             [this, contractAddress, messages, startT, prepareT, iterators = std::move(iterators),
-                totalCount, failed, callbackPtr](bcos::Error::UniquePtr error,
+                totalCount, failed, callbackPtr, spanStart, txsCount](bcos::Error::UniquePtr error,
                 std::vector<bcos::protocol::ExecutionMessage::UniquePtr> responseMessages) {
                 SCHEDULER_LOG(INFO)
                     << LOG_BADGE("DAG") << LOG_BADGE("Stat") << BLOCK_NUMBER(number())
@@ -758,6 +832,7 @@ void BlockExecutive::DAGExecute(std::function<void(Error::UniquePtr)> callback)
                 if (totalCount->fetch_sub(messages->size()) == messages->size())
                 {
                     // only one thread can get in this field
+                    trace::spanEnd(trace::c_scheduler, "DAGExecute", number(), spanStart, txsCount);
                     SCHEDULER_LOG(DEBUG)
                         << LOG_BADGE("DAG") << LOG_BADGE("Stat") << BLOCK_NUMBER(number())
                         << "DAGExecute.3:\t<<< Joint all contract result\t"
@@ -796,6 +871,7 @@ void BlockExecutive::DMCExecute(
         m_dmcRecorder->nextDmcRound();
 
         auto lastT = utcTime();
+        auto spanStart = trace::spanStart();
         DMC_LOG(INFO) << LOG_BADGE("Stat") << BLOCK_NUMBER(number())
                       << "DMCExecute.0:\t [+] Start\t\t\t"
                       << LOG_KV("round", m_dmcRecorder->getRound())
@@ -827,7 +903,7 @@ void BlockExecutive::DMCExecute(
             return;
         }
 
-        auto executorCallback = [this, lastT, batchStatus = std::move(batchStatus),
+        auto executorCallback = [this, lastT, spanStart, batchStatus = std::move(batchStatus),
                                     callback = std::move(callback)](
                                     bcos::Error::UniquePtr error, DmcExecutor::Status status) {
             if (error || status == DmcExecutor::Status::ERROR)
@@ -878,6 +954,8 @@ void BlockExecutive::DMCExecute(
             }
 
             // handle batch result(only one thread can get in here)
+            trace::spanEnd(trace::c_scheduler, "DMCRound", number(), spanStart,
+                m_dmcRecorder->getRound());
             DMC_LOG(INFO) << LOG_BADGE("Stat") << BLOCK_NUMBER(number())
                           << "DMCExecute.5:\t <<< Joint all executor result\t"
                           << LOG_KV("round", m_dmcRecorder->getRound())
@@ -916,10 +994,18 @@ void BlockExecutive::DMCExecute(
                       << LOG_KV("cost", utcTime() - lastT)
                       << LOG_KV("contractNum", contractAddress.size());
 
+        // the requests of the round to the same executor are sent together, the batches belong
+        // to this round only, the rounds of the other blocks send their own
+        ExecutorBatches::Executors executors;
+        m_scheduler->m_executorManager->forEachExecutor(
+            [&executors](auto, auto executor) { executors.emplace_back(std::move(executor)); });
+        ExecutorBatches batches(executors);
+
 // for each dmcExecutor
 #pragma omp parallel for
         for (size_t i = 0; i < contractAddress.size(); i++)
         {
+            ExecutorBatches::Scope scope(batches);
             auto dmcExecutor = m_dmcExecutors[contractAddress[i]];
             dmcExecutor->go(executorCallback);
         }
@@ -1033,7 +1119,9 @@ void BlockExecutive::batchNextBlock(std::function<void(Error::UniquePtr)> callba
 {
     auto status = std::make_shared<CommitStatus>();
     status->total = m_scheduler->m_executorManager->size();
-    status->checkAndCommit = [this, callback = std::move(callback)](const CommitStatus& status) {
+    status->checkAndCommit = [this, spanStart = trace::spanStart(),
+                                 callback = std::move(callback)](const CommitStatus& status) {
+        trace::spanEnd(trace::c_scheduler, "nextBlock", number(), spanStart);
         if (!m_isRunning)
         {
             callback(BCOS_ERROR_UNIQUE_PTR(SchedulerError::Stopped, "BlockExecutive is stopped"));
@@ -1097,8 +1185,9 @@ void BlockExecutive::batchGetHashes(
 
     auto status = std::make_shared<CommitStatus>();
     status->total = m_scheduler->m_executorManager->size();  // all executors
-    status->checkAndCommit = [this, totalHash, callback = std::move(callback)](
-                                 const CommitStatus& status) {
+    status->checkAndCommit = [this, totalHash, spanStart = trace::spanStart(),
+                                 callback = std::move(callback)](const CommitStatus& status) {
+        trace::spanEnd(trace::c_scheduler, "getHashes", number(), spanStart);
         if (!m_isRunning)
         {
             callback(
@@ -1180,8 +1269,10 @@ void BlockExecutive::batchBlockCommit(
     bcos::protocol::TwoPCParams params;
     params.number = number();
     params.timestamp = 0;
-    m_scheduler->m_storage->asyncCommit(
-        params, [rollbackVersion, status, this, callback](Error::Ptr&& error, uint64_t commitTS) {
+    m_scheduler->m_storage->asyncCommit(params,
+        [rollbackVersion, status, this, spanStart = trace::spanStart(), callback](
+            Error::Ptr&& error, uint64_t commitTS) {
+            trace::spanEnd(trace::c_storage, "asyncCommit", number(), spanStart);
             if (error)
             {
                 SCHEDULER_LOG(ERROR)
@@ -1444,6 +1535,7 @@ void BlockExecutive::serialPrepareExecutor()
     // For the same DMC lock priority
     // m_dmcExecutors must be prepared in contractAddress less<> serial order
 
+    BCOS_TRACE_SPAN(trace::c_scheduler, "serialPrepareExecutor", number());
     /// Handle normal message
     bool hasScheduleOutMessage;
     do
@@ -1476,26 +1568,31 @@ void BlockExecutive::serialPrepareExecutor()
     // try to unlock some locked tx
     bool needDetectDeadlock = true;
     bool allFinished = true;
-    for (auto it = m_dmcExecutors.begin(); it != m_dmcExecutors.end(); it++)
     {
-        auto& address = it->first;
-        auto dmcExecutor = m_dmcExecutors[address];
-        if (dmcExecutor->hasFinished())
+        // try to unlock the locked messages of every executor
+        BCOS_TRACE_SPAN(trace::c_scheduler, "unlockPrepare", number());
+        for (auto it = m_dmcExecutors.begin(); it != m_dmcExecutors.end(); it++)
         {
-            continue;  // must jump finished executor
+            auto& address = it->first;
+            auto dmcExecutor = m_dmcExecutors[address];
+            if (dmcExecutor->hasFinished())
+            {
+                continue;  // must jump finished executor
+            }
+            DMC_LOG(TRACE) << " 3.UnlockPrepare: \t |---------------- addr:" << address
+                           << " | number:" << std::to_string(m_block->blockHeaderConst()->number())
+                           << " ----------------|";
+
+            allFinished = false;
+            bool need = dmcExecutor->unlockPrepare();
+            needDetectDeadlock &= need;
+            // if there is an executor need detect deadlock, noNeedDetectDeadlock = false
         }
-        DMC_LOG(TRACE) << " 3.UnlockPrepare: \t |---------------- addr:" << address
-                       << " | number:" << std::to_string(m_block->blockHeaderConst()->number())
-                       << " ----------------|";
-
-        allFinished = false;
-        bool need = dmcExecutor->unlockPrepare();
-        needDetectDeadlock &= need;
-        // if there is an executor need detect deadlock, noNeedDetectDeadlock = false
     }
 
     if (needDetectDeadlock && !allFinished)
     {
+        BCOS_TRACE_SPAN(trace::c_scheduler, "detectDeadLock", number());
         bool needRevert = false;
         // detect deadlock and revert the first tx TODO: revert many tx in one DMC round
         for (auto it = m_dmcExecutors.begin(); it != m_dmcExecutors.end(); it++)
@@ -0,0 +1,146 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief dispatch the read-only calls apart from the block execution
+ * @file CallEngine.cpp
+ */
+#include "CallEngine.h"
+#include <bcos-framework/dispatcher/SchedulerTypeDef.h>
+
+using namespace bcos;
+using namespace bcos::scheduler;
+
+CallEngine::CallEngine(uint64_t _maxCallsPerSecond, size_t _cacheCapacity)
+  : m_maxCallsPerSecond(_maxCallsPerSecond), m_cacheCapacity(_cacheCapacity)
+{
+    SCHEDULER_LOG(INFO) << LOG_DESC("create CallEngine")
+                        << LOG_KV("maxCallsPerSecond", _maxCallsPerSecond)
+                        << LOG_KV("cacheCapacity", _cacheCapacity);
+}
+
+void CallEngine::asyncCall(
+    protocol::Transaction::Ptr _tx, ExecuteCallFunc _executeCall, Callback _callback)
+{
+    if (!tryAcquire())
+    {
+        m_rejectedCalls++;
+        _callback(BCOS_ERROR_PTR(SchedulerError::CallRateLimited,
+                      "Call rejected for exceeding the limit of " +
+                          std::to_string(m_maxCallsPerSecond) + " calls per second"),
+            nullptr);
+        return;
+    }
+
+    std::string key;
+    if (m_cacheCapacity > 0)
+    {
+        key = cacheKey(*_tx);
+        auto receipt = getCachedReceipt(key);
+        if (receipt)
+        {
+            m_cacheHits++;
+            _callback(nullptr, std::move(receipt));
+            return;
+        }
+        m_cacheMisses++;
+    }
+
+    auto generation = m_generation.load();
+    _executeCall(std::move(_tx),
+        [this, key = std::move(key), generation, callback = std::move(_callback)](
+            Error::Ptr&& _error, protocol::TransactionReceipt::Ptr&& _receipt) {
+            if (!_error && _receipt && m_cacheCapacity > 0)
+            {
+                cacheReceipt(std::move(key), _receipt, generation);
+            }
+            callback(std::move(_error), std::move(_receipt));
+        });
+}
+
+void CallEngine::onBlockCommitted(protocol::BlockNumber _blockNumber)
+{
+    size_t cachedCalls = 0;
+    {
+        WriteGuard l(x_cache);
+        m_generation++;
+        cachedCalls = m_cache.size();
+        m_cache.clear();
+    }
+    SCHEDULER_LOG(DEBUG) << BLOCK_NUMBER(_blockNumber) << LOG_DESC("CallEngine: reset call cache")
+                         << LOG_KV("cachedCalls", cachedCalls) << LOG_KV("hits", m_cacheHits)
+                         << LOG_KV("misses", m_cacheMisses)
+                         << LOG_KV("rejected", m_rejectedCalls);
+}
+
+bool CallEngine::tryAcquire()
+{
+    if (m_maxCallsPerSecond == 0)
+    {
+        return true;
+    }
+    auto now = utcSteadyTime();
+    Guard l(x_limiter);
+    if (now - m_windowStart >= 1000)
+    {
+        m_windowStart = now;
+        m_windowCalls = 0;
+    }
+    if (m_windowCalls >= m_maxCallsPerSecond)
+    {
+        return false;
+    }
+    m_windowCalls++;
+    return true;
+}
+
+std::string CallEngine::cacheKey(protocol::Transaction const& _tx)
+{
+    auto to = _tx.to();
+    auto input = _tx.input();
+    std::string key;
+    key.reserve(to.size() + input.size() + 1);
+    key.append(to);
+    // the address is hex, the separator can not appear in it
+    key.push_back('/');
+    key.append((const char*)input.data(), input.size());
+    return key;
+}
+
+protocol::TransactionReceipt::Ptr CallEngine::getCachedReceipt(std::string const& _key)
+{
+    ReadGuard l(x_cache);
+    auto it = m_cache.find(_key);
+    if (it == m_cache.end())
+    {
+        return nullptr;
+    }
+    return it->second;
+}
+
+void CallEngine::cacheReceipt(
+    std::string _key, protocol::TransactionReceipt::Ptr _receipt, uint64_t _generation)
+{
+    WriteGuard l(x_cache);
+    // the call was executed on the state before the latest commit
+    if (_generation != m_generation)
+    {
+        return;
+    }
+    if (m_cache.size() >= m_cacheCapacity)
+    {
+        return;
+    }
+    m_cache.emplace(std::move(_key), std::move(_receipt));
+}
@@ -0,0 +1,90 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief dispatch the read-only calls apart from the block execution
+ * @file CallEngine.h
+ */
+#pragma once
+#include "Common.h"
+#include <bcos-framework/protocol/Transaction.h>
+#include <bcos-framework/protocol/TransactionReceipt.h>
+#include <bcos-utilities/Common.h>
+#include <bcos-utilities/Error.h>
+#include <atomic>
+#include <unordered_map>
+
+namespace bcos::scheduler
+{
+// The CallEngine limits the read-only calls per second and memoises the receipts of the identical
+// (to, input) calls until the next block is committed. All the calls are executed against the last
+// committed state (on the dedicated call pool of the executor), so the cache is only valid within
+// one committed block and is dropped by onBlockCommitted.
+class CallEngine
+{
+public:
+    using Ptr = std::shared_ptr<CallEngine>;
+    using Callback = std::function<void(Error::Ptr&&, protocol::TransactionReceipt::Ptr&&)>;
+    using ExecuteCallFunc = std::function<void(protocol::Transaction::Ptr, Callback)>;
+
+    // _maxCallsPerSecond: 0 means no limit
+    // _cacheCapacity: 0 means disable the call result cache
+    CallEngine(uint64_t _maxCallsPerSecond, size_t _cacheCapacity);
+    virtual ~CallEngine() = default;
+
+    CallEngine(const CallEngine&) = delete;
+    CallEngine(CallEngine&&) = delete;
+    CallEngine& operator=(const CallEngine&) = delete;
+    CallEngine& operator=(CallEngine&&) = delete;
+
+    virtual void asyncCall(
+        protocol::Transaction::Ptr _tx, ExecuteCallFunc _executeCall, Callback _callback);
+
+    // the state changed, the cached call results are stale
+    virtual void onBlockCommitted(protocol::BlockNumber _blockNumber);
+
+    uint64_t cacheHits() const { return m_cacheHits; }
+    uint64_t cacheMisses() const { return m_cacheMisses; }
+    uint64_t rejectedCalls() const { return m_rejectedCalls; }
+    size_t cacheSize() const
+    {
+        ReadGuard l(x_cache);
+        return m_cache.size();
+    }
+
+protected:
+    virtual bool tryAcquire();
+    static std::string cacheKey(protocol::Transaction const& _tx);
+    protocol::TransactionReceipt::Ptr getCachedReceipt(std::string const& _key);
+    void cacheReceipt(
+        std::string _key, protocol::TransactionReceipt::Ptr _receipt, uint64_t _generation);
+
+private:
+    uint64_t m_maxCallsPerSecond;
+    // the calls accepted in the current one-second window
+    uint64_t m_windowStart = 0;
+    uint64_t m_windowCalls = 0;
+    bcos::Mutex x_limiter;
+
+    size_t m_cacheCapacity;
+    std::unordered_map<std::string, protocol::TransactionReceipt::Ptr> m_cache;
+    mutable bcos::SharedMutex x_cache;
+    // increased on every commit, the results of the calls started before the commit are not cached
+    std::atomic<uint64_t> m_generation = {0};
+
+    std::atomic<uint64_t> m_cacheHits = {0};
+    std::atomic<uint64_t> m_cacheMisses = {0};
+    std::atomic<uint64_t> m_rejectedCalls = {0};
+};
+}  // namespace bcos::scheduler
@@ -40,6 +40,7 @@ public:
 
         scheduler->registerBlockNumberReceiver(m_blockNumberReceiver);
         scheduler->registerTransactionNotifier(m_txNotifier);
+        scheduler->setCallEngine(m_callEngine);
 
         return scheduler;
     }
@@ -58,6 +59,9 @@ public:
 
     bcos::ledger::LedgerInterface::Ptr getLedger() { return m_ledger; }
 
+    // the CallEngine is kept by the factory and shared by the schedulers of all the terms
+    void setCallEngine(CallEngine::Ptr _callEngine) { m_callEngine = std::move(_callEngine); }
+
 private:
     ExecutorManager::Ptr m_executorManager;
     bcos::ledger::LedgerInterface::Ptr m_ledger;
@@ -75,6 +79,7 @@ private:
     std::function<void(bcos::protocol::BlockNumber, bcos::protocol::TransactionSubmitResultsPtr,
         std::function<void(Error::Ptr)>)>
         m_txNotifier;
+    CallEngine::Ptr m_callEngine;
 };
 
 }  // namespace bcos::scheduler
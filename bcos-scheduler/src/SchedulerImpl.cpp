@@ -7,6 +7,8 @@
 #include <bcos-framework/protocol/ProtocolTypeDef.h>
 #include <bcos-tool/VersionConverter.h>
 #include <bcos-utilities/Error.h>
+#include <bcos-utilities/Metrics.h>
+#include <bcos-utilities/Tracer.h>
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/format.hpp>
 #include <boost/lexical_cast.hpp>
@@ -18,6 +20,35 @@
 
 using namespace bcos::scheduler;
 
+namespace
+{
+struct SchedulerMetrics
+{
+    bcos::metrics::Histogram& executeBlockTime =
+        bcos::metrics::MetricsRegistry::instance().histogram(
+            "bcos_scheduler_execute_block_seconds", "The time to execute a block");
+    bcos::metrics::Histogram& commitBlockTime =
+        bcos::metrics::MetricsRegistry::instance().histogram(
+            "bcos_scheduler_commit_block_seconds", "The time to commit a block");
+    bcos::metrics::Counter& executedTxs = bcos::metrics::MetricsRegistry::instance().counter(
+        "bcos_scheduler_executed_txs_total", "The txs of the executed blocks");
+    bcos::metrics::Counter& failedBlocks = bcos::metrics::MetricsRegistry::instance().counter(
+        "bcos_scheduler_failed_blocks_total", "The blocks failed to execute or commit");
+};
+SchedulerMetrics& schedulerMetrics()
+{
+    static SchedulerMetrics schedulerMetrics;
+    return schedulerMetrics;
+}
+
+uint64_t elapsedMicroseconds(std::chrono::steady_clock::time_point _start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - _start)
+        .count();
+}
+}  // namespace
+
 void SchedulerImpl::handleBlockQueue(bcos::protocol::BlockNumber requestBlockNumber,
     std::function<void(bcos::protocol::BlockNumber)> whenOlder,  // whenOlder(frontNumber)
     std::function<void(BlockExecutive::Ptr)> whenQueueFront, std::function<void()> afterFront,
@@ -168,10 +199,24 @@ void SchedulerImpl::executeBlock(bcos::protocol::Block::Ptr block, bool verify,
                         << LOG_KV("version", (bcos::protocol::Version)(block->version()))
                         << LOG_KV("waitT", waitT);
 
-    auto callback = [requestBlockNumber, _callback = std::move(_callback)](bcos::Error::Ptr&& error,
-                        bcos::protocol::BlockHeader::Ptr&& blockHeader, bool _sysBlock) {
+    auto txsSize = std::max(block->transactionsSize(), block->transactionsMetaDataSize());
+    auto callback = [requestBlockNumber, txsSize, startT = std::chrono::steady_clock::now(),
+                        spanStart = bcos::trace::spanStart(), _callback = std::move(_callback)](
+                        bcos::Error::Ptr&& error, bcos::protocol::BlockHeader::Ptr&& blockHeader,
+                        bool _sysBlock) {
         SCHEDULER_LOG(INFO) << METRIC << BLOCK_NUMBER(requestBlockNumber) << "ExecuteBlock response"
                             << LOG_KV(error ? "error" : "ok", error ? error->what() : "ok");
+        bcos::trace::spanEnd(bcos::trace::c_scheduler, "executeBlock", requestBlockNumber,
+            spanStart, txsSize);
+        if (error)
+        {
+            schedulerMetrics().failedBlocks.inc();
+        }
+        else
+        {
+            schedulerMetrics().executeBlockTime.observe(elapsedMicroseconds(startT));
+            schedulerMetrics().executedTxs.inc(txsSize);
+        }
         _callback(error == nullptr ? nullptr : std::move(error), std::move(blockHeader), _sysBlock);
     };
 
@@ -211,6 +256,23 @@ void SchedulerImpl::executeBlock(bcos::protocol::Block::Ptr block, bool verify,
                              "request header not the same with cached"),
                     nullptr, false);
             }
+            else if (!verify && blockExecutive->block()->blockHeaderConst()->hash() !=
+                                    block->blockHeaderConst()->hash())
+            {
+                // the cached block is executed from another proposal of the same number, e.g. a
+                // speculatively executed proposal that the consensus didn't commit
+                SCHEDULER_LOG(WARNING)
+                    << BLOCK_NUMBER(requestBlockNumber)
+                    << "ExecuteBlock failed. The cached block is executed from another proposal. "
+                       "Trigger switch."
+                    << LOG_KV("cachedProposalHash",
+                           blockExecutive->block()->blockHeaderConst()->hash().abridged())
+                    << LOG_KV("requestProposalHash", block->blockHeaderConst()->hash().abridged());
+                triggerSwitch();
+                callback(BCOS_ERROR_UNIQUE_PTR(SchedulerError::InvalidBlocks,
+                             "request proposal not the same with cached"),
+                    nullptr, false);
+            }
             else
             {
                 SCHEDULER_LOG(INFO)
@@ -359,10 +421,21 @@ void SchedulerImpl::commitBlock(bcos::protocol::BlockHeader::Ptr header,
     SCHEDULER_LOG(INFO) << BLOCK_NUMBER(header->number()) << "CommitBlock request";
 
     auto requestBlockNumber = header->number();
-    auto callback = [requestBlockNumber, _callback = std::move(_callback)](
+    auto callback = [requestBlockNumber, startT = std::chrono::steady_clock::now(),
+                        spanStart = bcos::trace::spanStart(), _callback = std::move(_callback)](
                         bcos::Error::Ptr&& error, bcos::ledger::LedgerConfig::Ptr&& config) {
         SCHEDULER_LOG(INFO) << METRIC << BLOCK_NUMBER(requestBlockNumber) << "CommitBlock response"
                             << LOG_KV(error ? "error" : "ok", error ? error->what() : "ok");
+        bcos::trace::spanEnd(
+            bcos::trace::c_scheduler, "commitBlock", requestBlockNumber, spanStart);
+        if (error)
+        {
+            schedulerMetrics().failedBlocks.inc();
+        }
+        else
+        {
+            schedulerMetrics().commitBlockTime.observe(elapsedMicroseconds(startT));
+        }
         _callback(error == nullptr ? nullptr : std::move(error), std::move(config));
     };
 
@@ -527,6 +600,10 @@ void SchedulerImpl::commitBlock(bcos::protocol::BlockHeader::Ptr header,
 
                 SCHEDULER_LOG(INFO) << "CommitBlock success" << LOG_KV("blockNumber", blockNumber)
                                     << LOG_KV("gas limit", m_gasLimit);
+                if (m_callEngine)
+                {
+                    m_callEngine->onBlockCommitted(blockNumber);
+                }
 
                 // Note: blockNumber = 0, means system deploy, and tx is not existed in txpool.
                 // So it should not exec tx notifier
@@ -596,6 +673,30 @@ void SchedulerImpl::call(protocol::Transaction::Ptr tx,
     // set attribute before call
     tx->setAttribute(m_isWasm ? bcos::protocol::Transaction::Attribute::LIQUID_SCALE_CODEC :
                                 bcos::protocol::Transaction::Attribute::EVM_ABI_CODEC);
+    if (!m_callEngine)
+    {
+        executeCall(std::move(tx), std::move(callback));
+        return;
+    }
+    auto self = std::weak_ptr<SchedulerImpl>(shared_from_this());
+    m_callEngine->asyncCall(
+        std::move(tx),
+        [self](protocol::Transaction::Ptr _tx, CallEngine::Callback _callback) {
+            auto scheduler = self.lock();
+            if (!scheduler)
+            {
+                _callback(
+                    BCOS_ERROR_PTR(SchedulerError::Stopped, "Scheduler is not running"), nullptr);
+                return;
+            }
+            scheduler->executeCall(std::move(_tx), std::move(_callback));
+        },
+        std::move(callback));
+}
+
+void SchedulerImpl::executeCall(protocol::Transaction::Ptr tx,
+    std::function<void(Error::Ptr&&, protocol::TransactionReceipt::Ptr&&)> callback)
+{
     // Create temp block
     auto block = m_blockFactory->createBlock();
     block->appendTransaction(std::move(tx));
@@ -2,6 +2,7 @@
 
 #include "BlockExecutive.h"
 #include "BlockExecutiveFactory.h"
+#include "CallEngine.h"
 #include "ExecutorManager.h"
 #include "bcos-protocol/TransactionSubmitResultFactoryImpl.h"
 #include <bcos-crypto/interfaces/crypto/CommonType.h>
@@ -190,7 +191,13 @@ public:
 
     bcos::crypto::Hash::Ptr getHashImpl() { return m_hashImpl; }
 
+    // dispatch the calls through the CallEngine, the calls are executed directly if not set
+    void setCallEngine(CallEngine::Ptr _callEngine) { m_callEngine = std::move(_callEngine); }
+
 private:
+    void executeCall(protocol::Transaction::Ptr tx,
+        std::function<void(Error::Ptr&&, protocol::TransactionReceipt::Ptr&&)> callback);
+
     void handleBlockQueue(bcos::protocol::BlockNumber requestBlockNumber,
         std::function<void(bcos::protocol::BlockNumber)> whenOlder,  // whenOlder(frontNumber)
         std::function<void(BlockExecutive::Ptr)> whenQueueFront, std::function<void()> afterFront,
@@ -251,6 +258,7 @@ private:
     std::function<void(bcos::protocol::BlockNumber, bcos::protocol::TransactionSubmitResultsPtr,
         std::function<void(Error::Ptr)>)>
         m_txNotifier;
+    CallEngine::Ptr m_callEngine;
     uint64_t m_lastExecuteFinishTime = 0;
 
     int64_t m_schedulerTermId;
@@ -0,0 +1,127 @@
+#include "bcos-scheduler/src/CallEngine.h"
+#include <bcos-crypto/hash/Keccak256.h>
+#include <bcos-crypto/interfaces/crypto/CryptoSuite.h>
+#include <bcos-crypto/signature/secp256k1/Secp256k1Crypto.h>
+#include <bcos-tars-protocol/protocol/TransactionFactoryImpl.h>
+#include <bcos-tars-protocol/protocol/TransactionReceiptFactoryImpl.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::scheduler;
+
+namespace bcos::test
+{
+struct CallEngineFixture
+{
+    CallEngineFixture()
+    {
+        auto hashImpl = std::make_shared<bcos::crypto::Keccak256>();
+        auto signature = std::make_shared<bcos::crypto::Secp256k1Crypto>();
+        suite = std::make_shared<bcos::crypto::CryptoSuite>(hashImpl, signature, nullptr);
+        transactionFactory = std::make_shared<bcostars::protocol::TransactionFactoryImpl>(suite);
+        receiptFactory = std::make_shared<bcostars::protocol::TransactionReceiptFactoryImpl>(suite);
+
+        // echo the input of the call as the output
+        executeCall = [this](protocol::Transaction::Ptr _tx, CallEngine::Callback _callback) {
+            executedCalls++;
+            auto input = _tx->input();
+            auto receipt = receiptFactory->createReceipt(0, "",
+                std::make_shared<std::vector<bcos::protocol::LogEntry>>(), 0,
+                bytes(input.begin(), input.end()), 0);
+            _callback(nullptr, std::move(receipt));
+        };
+    }
+
+    protocol::Transaction::Ptr createCall(std::string const& _to, std::string const& _input)
+    {
+        return transactionFactory->createTransaction(
+            0, _to, bytes(_input.begin(), _input.end()), u256(0), 0, "", "", 0);
+    }
+
+    std::string call(CallEngine& _engine, protocol::Transaction::Ptr _tx)
+    {
+        std::string output;
+        _engine.asyncCall(std::move(_tx), executeCall,
+            [&output](Error::Ptr&& _error, protocol::TransactionReceipt::Ptr&& _receipt) {
+                BOOST_CHECK(!_error);
+                output = std::string((char*)_receipt->output().data(), _receipt->output().size());
+            });
+        return output;
+    }
+
+    bcos::crypto::CryptoSuite::Ptr suite;
+    std::shared_ptr<bcostars::protocol::TransactionFactoryImpl> transactionFactory;
+    std::shared_ptr<bcostars::protocol::TransactionReceiptFactoryImpl> receiptFactory;
+    CallEngine::ExecuteCallFunc executeCall;
+    size_t executedCalls = 0;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestCallEngine, CallEngineFixture)
+
+BOOST_AUTO_TEST_CASE(callWithoutCache)
+{
+    CallEngine engine(0, 0);
+    BOOST_CHECK_EQUAL(call(engine, createCall("0x1234", "balanceOf")), "balanceOf");
+    BOOST_CHECK_EQUAL(call(engine, createCall("0x1234", "balanceOf")), "balanceOf");
+    BOOST_CHECK_EQUAL(executedCalls, 2);
+    BOOST_CHECK_EQUAL(engine.cacheSize(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(cacheUntilCommit)
+{
+    CallEngine engine(0, 2);
+    BOOST_CHECK_EQUAL(call(engine, createCall("0x1234", "balanceOf")), "balanceOf");
+    BOOST_CHECK_EQUAL(call(engine, createCall("0x1234", "balanceOf")), "balanceOf");
+    BOOST_CHECK_EQUAL(executedCalls, 1);
+    BOOST_CHECK_EQUAL(engine.cacheHits(), 1);
+
+    // different contract or input
+    call(engine, createCall("0x5678", "balanceOf"));
+    call(engine, createCall("0x1234", "totalSupply"));
+    BOOST_CHECK_EQUAL(executedCalls, 3);
+    // the capacity is 2
+    BOOST_CHECK_EQUAL(engine.cacheSize(), 2);
+
+    engine.onBlockCommitted(1);
+    BOOST_CHECK_EQUAL(engine.cacheSize(), 0);
+    call(engine, createCall("0x1234", "balanceOf"));
+    BOOST_CHECK_EQUAL(executedCalls, 4);
+}
+
+BOOST_AUTO_TEST_CASE(skipStaleResult)
+{
+    CallEngine engine(0, 10);
+    // the block is committed while the call is executing
+    engine.asyncCall(
+        createCall("0x1234", "balanceOf"),
+        [&engine, this](protocol::Transaction::Ptr _tx, CallEngine::Callback _callback) {
+            engine.onBlockCommitted(1);
+            executeCall(std::move(_tx), std::move(_callback));
+        },
+        [](Error::Ptr&& _error, protocol::TransactionReceipt::Ptr&&) { BOOST_CHECK(!_error); });
+    BOOST_CHECK_EQUAL(engine.cacheSize(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(rateLimit)
+{
+    CallEngine engine(3, 0);
+    size_t rejected = 0;
+    for (int i = 0; i < 5; i++)
+    {
+        engine.asyncCall(createCall("0x1234", "balanceOf"), executeCall,
+            [&rejected](Error::Ptr&& _error, protocol::TransactionReceipt::Ptr&& _receipt) {
+                if (_error)
+                {
+                    BOOST_CHECK_EQUAL(_error->errorCode(), SchedulerError::CallRateLimited);
+                    BOOST_CHECK(!_receipt);
+                    rejected++;
+                }
+            });
+    }
+    BOOST_CHECK_EQUAL(executedCalls, 3);
+    BOOST_CHECK_EQUAL(rejected, 2);
+    BOOST_CHECK_EQUAL(engine.rejectedCalls(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
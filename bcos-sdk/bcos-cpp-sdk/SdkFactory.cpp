@@ -29,12 +29,14 @@
 #include <bcos-cpp-sdk/multigroup/JsonGroupInfoCodec.h>
 #include <bcos-cpp-sdk/rpc/Common.h>
 #include <bcos-cpp-sdk/rpc/JsonRpcImpl.h>
+#include <bcos-cpp-sdk/rpc/TxSubmitter.h>
 #include <bcos-cpp-sdk/ws/Service.h>
 #include <bcos-framework/multigroup/GroupInfoFactory.h>
 #include <bcos-framework/protocol/Protocol.h>
 #include <bcos-utilities/BoostLog.h>
 #include <bcos-utilities/BoostLogInitializer.h>
 #include <bcos-utilities/Common.h>
+#include <algorithm>
 #include <memory>
 #include <mutex>
 
@@ -140,6 +142,46 @@ bcos::cppsdk::jsonrpc::JsonRpcImpl::Ptr SdkFactory::buildJsonRpc(Service::Ptr _s
     return jsonRpc;
 }
 
+TxSubmitter::Ptr SdkFactory::buildTxSubmitter(
+    std::shared_ptr<bcos::boostssl::ws::WsConfig> _config, const std::string& _groupID,
+    uint32_t _connections, TxSubmitter::Config _submitterConfig)
+{
+    if (!_config)
+    {
+        _config = m_config;
+    }
+
+    std::vector<Service::Ptr> services;
+    std::vector<TxBatchSendFunc> senders;
+    for (uint32_t i = 0; i < std::max<uint32_t>(_connections, 1); ++i)
+    {
+        auto service = buildService(_config);
+        services.push_back(service);
+        senders.emplace_back([service, batchTimeout = _submitterConfig.batchTimeout](
+                                 const std::string& _group, const std::string& _node,
+                                 std::shared_ptr<bcos::bytes> _request,
+                                 bcos::cppsdk::jsonrpc::RespFunc _respFunc) {
+            auto msg = service->messageFactory()->buildMessage();
+            msg->setSeq(service->messageFactory()->newSeq());
+            msg->setPacketType(bcos::protocol::MessageType::RPC_SUBMIT_TRANSACTIONS);
+            msg->setPayload(_request);
+
+            // the response waits for the receipts of all the transactions of the batch
+            service->asyncSendMessageByGroupAndNode(_group, _node, msg, Options(batchTimeout),
+                [_respFunc](Error::Ptr _error, std::shared_ptr<MessageFace> _msg,
+                    std::shared_ptr<WsSession> _session) {
+                    (void)_session;
+                    _respFunc(_error, _msg ? _msg->payload() : nullptr);
+                });
+        });
+    }
+
+    auto submitter =
+        std::make_shared<TxSubmitter>(_groupID, std::move(senders), std::move(_submitterConfig));
+    submitter->setServices(std::move(services));
+    return submitter;
+}
+
 bcos::cppsdk::amop::AMOP::Ptr SdkFactory::buildAMOP(bcos::cppsdk::service::Service::Ptr _service)
 {
     auto amop = std::make_shared<bcos::cppsdk::amop::AMOP>();
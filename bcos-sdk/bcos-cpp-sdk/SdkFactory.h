@@ -24,6 +24,7 @@
 #include <bcos-cpp-sdk/amop/AMOP.h>
 #include <bcos-cpp-sdk/event/EventSub.h>
 #include <bcos-cpp-sdk/rpc/JsonRpcImpl.h>
+#include <bcos-cpp-sdk/rpc/TxSubmitter.h>
 #include <bcos-cpp-sdk/ws/Service.h>
 #include <bcos-utilities/ThreadPool.h>
 
@@ -45,6 +46,10 @@ public:
         bcos::cppsdk::service::Service::Ptr _service);
     bcos::cppsdk::amop::AMOP::Ptr buildAMOP(bcos::cppsdk::service::Service::Ptr _service);
     bcos::cppsdk::event::EventSub::Ptr buildEventSub(bcos::cppsdk::service::Service::Ptr _service);
+    // every connection is a service of its own, with its own sessions to all the nodes
+    bcos::cppsdk::jsonrpc::TxSubmitter::Ptr buildTxSubmitter(
+        std::shared_ptr<bcos::boostssl::ws::WsConfig> _config, const std::string& _groupID,
+        uint32_t _connections, bcos::cppsdk::jsonrpc::TxSubmitter::Config _submitterConfig);
 
 public:
     bcos::cppsdk::Sdk::UniquePtr buildSdk(
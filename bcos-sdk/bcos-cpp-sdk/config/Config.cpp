@@ -85,19 +85,24 @@ void Config::loadCommon(
         thread_pool_size = 8
         ; send message timeout(ms)
         message_timeout_ms = 10000
+        ; the pending requests with the integer seq of every connection, default: 0
+        ; callback_slab_size = 65536
     */
     bool disableSsl = _pt.get<bool>("common.disable_ssl", false);
     int threadPoolSize = _pt.get<int>("common.thread_pool_size", 8);
     int messageTimeOut = _pt.get<int>("common.message_timeout_ms", 10000);
+    uint32_t callbackSlabSize = _pt.get<uint32_t>("common.callback_slab_size", 0);
 
     _config.setDisableSsl(disableSsl);
     _config.setSendMsgTimeout(messageTimeOut);
     _config.setThreadPoolSize(threadPoolSize);
+    _config.setCallbackSlabSize(callbackSlabSize);
 
 
     BCOS_LOG(INFO) << LOG_BADGE("loadCommon") << LOG_DESC("load common section config items ok")
                    << LOG_KV("disableSsl", disableSsl) << LOG_KV("threadPoolSize", threadPoolSize)
-                   << LOG_KV("messageTimeOut", messageTimeOut);
+                   << LOG_KV("messageTimeOut", messageTimeOut)
+                   << LOG_KV("callbackSlabSize", callbackSlabSize);
 }
 
 void Config::loadPeers(
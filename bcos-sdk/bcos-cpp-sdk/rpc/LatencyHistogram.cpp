@@ -0,0 +1,134 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the client-side latency histogram
+ * @file LatencyHistogram.cpp
+ */
+
+#include <bcos-cpp-sdk/rpc/LatencyHistogram.h>
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::jsonrpc;
+
+void LatencyHistogram::record(uint64_t _us)
+{
+    m_buckets[bucketIndex(_us)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(_us, std::memory_order_relaxed);
+    auto max = m_max.load(std::memory_order_relaxed);
+    while (_us > max && !m_max.compare_exchange_weak(max, _us, std::memory_order_relaxed))
+    {
+    }
+}
+
+void LatencyHistogram::reset()
+{
+    for (auto& bucket : m_buckets)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+double LatencyHistogram::mean() const
+{
+    auto count = m_count.load(std::memory_order_relaxed);
+    if (count == 0)
+    {
+        return 0;
+    }
+    return (double)m_sum.load(std::memory_order_relaxed) / count;
+}
+
+uint64_t LatencyHistogram::percentile(double _percentile) const
+{
+    // the buckets are read one by one, the count is summed here rather than loaded from m_count
+    std::array<uint64_t, BUCKETS> buckets;
+    uint64_t count = 0;
+    for (size_t i = 0; i < BUCKETS; ++i)
+    {
+        buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+        count += buckets[i];
+    }
+    if (count == 0)
+    {
+        return 0;
+    }
+    auto rank = (uint64_t)std::ceil(std::clamp(_percentile, 0.0, 100.0) / 100 * count);
+    rank = std::max<uint64_t>(rank, 1);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i)
+    {
+        seen += buckets[i];
+        if (seen >= rank)
+        {
+            // never report more than the max recorded
+            return std::min(bucketUpperBound(i), std::max(max(), bucketLowerBound(i)));
+        }
+    }
+    return max();
+}
+
+std::string LatencyHistogram::toString() const
+{
+    std::stringstream ss;
+    ss << "count: " << count() << ", mean: " << (uint64_t)mean() << "us, p50: " << percentile(50)
+       << "us, p90: " << percentile(90) << "us, p99: " << percentile(99)
+       << "us, p999: " << percentile(99.9) << "us, max: " << max() << "us";
+    return ss.str();
+}
+
+size_t LatencyHistogram::bucketIndex(uint64_t _us)
+{
+    if (_us < SUB_BUCKETS)
+    {
+        return _us;
+    }
+    // the position of the highest bit, at least SUB_BUCKET_BITS
+    uint64_t exponent = 63 - __builtin_clzll(_us);
+    if (exponent > MAX_EXPONENT)
+    {
+        return BUCKETS - 1;
+    }
+    auto subBucket = (_us >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+    return SUB_BUCKETS + (exponent - SUB_BUCKET_BITS) * SUB_BUCKETS + subBucket;
+}
+
+uint64_t LatencyHistogram::bucketLowerBound(size_t _index)
+{
+    if (_index < SUB_BUCKETS)
+    {
+        return _index;
+    }
+    auto shift = (_index - SUB_BUCKETS) / SUB_BUCKETS;
+    auto subBucket = (_index - SUB_BUCKETS) % SUB_BUCKETS;
+    return (SUB_BUCKETS + subBucket) << shift;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t _index)
+{
+    if (_index < SUB_BUCKETS)
+    {
+        return _index;
+    }
+    auto shift = (_index - SUB_BUCKETS) / SUB_BUCKETS;
+    return bucketLowerBound(_index) + ((uint64_t)1 << shift) - 1;
+}
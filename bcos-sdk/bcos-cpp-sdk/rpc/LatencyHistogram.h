@@ -0,0 +1,75 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the client-side latency histogram
+ * @file LatencyHistogram.h
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace jsonrpc
+{
+/**
+ * @brief LatencyHistogram records the latencies in microseconds into log-linear buckets: the
+ * values below SUB_BUCKETS have a bucket each, and every power of two above is split into
+ * SUB_BUCKETS buckets, so the percentiles are within 1/SUB_BUCKETS of the recorded values.
+ *
+ * The buckets are atomic counters, record never locks and may be called from the callback threads
+ * of all the connections.
+ */
+class LatencyHistogram
+{
+public:
+    constexpr static uint64_t SUB_BUCKETS = 16;
+    constexpr static uint64_t SUB_BUCKET_BITS = 4;
+    // up to 2^40us, more than 12 days
+    constexpr static uint64_t MAX_EXPONENT = 40;
+    constexpr static size_t BUCKETS = SUB_BUCKETS * (MAX_EXPONENT - SUB_BUCKET_BITS + 2);
+
+    LatencyHistogram() { reset(); }
+
+    void record(uint64_t _us);
+    void reset();
+
+    uint64_t count() const { return m_count.load(std::memory_order_relaxed); }
+    uint64_t max() const { return m_max.load(std::memory_order_relaxed); }
+    double mean() const;
+    // the upper bound of the bucket the _percentile(0 to 100) falls in, 0 if nothing recorded
+    uint64_t percentile(double _percentile) const;
+
+    // count, mean, p50, p90, p99, p999 and max
+    std::string toString() const;
+
+    static size_t bucketIndex(uint64_t _us);
+    static uint64_t bucketLowerBound(size_t _index);
+    static uint64_t bucketUpperBound(size_t _index);
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKETS> m_buckets;
+    std::atomic<uint64_t> m_count;
+    std::atomic<uint64_t> m_sum;
+    std::atomic<uint64_t> m_max;
+};
+}  // namespace jsonrpc
+}  // namespace cppsdk
+}  // namespace bcos
@@ -0,0 +1,245 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief submit the signed transactions in pipelined batches
+ * @file TxSubmitter.cpp
+ */
+
+#include <bcos-boostssl/websocket/WsError.h>
+#include <bcos-cpp-sdk/rpc/TxSubmitter.h>
+#include <bcos-tars-protocol/Common.h>
+#include <bcos-tars-protocol/tars/TransactionBatch.h>
+#include <algorithm>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::jsonrpc;
+
+TxSubmitter::TxSubmitter(
+    std::string _groupID, std::vector<TxBatchSendFunc> _connections, Config _config)
+  : m_groupID(std::move(_groupID)), m_connections(std::move(_connections)), m_config(_config)
+{
+    m_config.window = std::max<size_t>(m_config.window, 1);
+    m_config.batchSize = std::max<size_t>(m_config.batchSize, 1);
+}
+
+void TxSubmitter::start()
+{
+    for (auto& service : m_services)
+    {
+        service->start();
+    }
+    TXSUBMITTER_LOG(INFO) << LOG_BADGE("start") << LOG_KV("group", m_groupID)
+                          << LOG_KV("connections", m_connections.size())
+                          << LOG_KV("window", m_config.window)
+                          << LOG_KV("batchSize", m_config.batchSize);
+}
+
+void TxSubmitter::stop()
+{
+    std::deque<PendingTx> pending;
+    {
+        Guard l(x_pending);
+        pending.swap(m_pending);
+    }
+    // the batches in flight are answered by the services when the sessions are dropped
+    for (auto& service : m_services)
+    {
+        service->stop();
+    }
+    if (pending.empty())
+    {
+        return;
+    }
+    TXSUBMITTER_LOG(INFO) << LOG_BADGE("stop") << LOG_DESC("drop the pending transactions")
+                          << LOG_KV("group", m_groupID) << LOG_KV("pending", pending.size());
+    auto error = std::make_shared<Error>(
+        boostssl::ws::WsError::UserDisconnect, "the transaction submitter has been stopped");
+    for (auto const& tx : pending)
+    {
+        onTxResult(tx, error, nullptr);
+    }
+}
+
+void TxSubmitter::asyncSubmit(std::shared_ptr<bcos::bytes> _transaction, RespFunc _respFunc)
+{
+    std::vector<Batch> batches;
+    {
+        Guard l(x_pending);
+        m_pending.push_back(PendingTx{
+            std::move(_transaction), std::move(_respFunc), std::chrono::steady_clock::now()});
+        takeBatches(batches);
+    }
+    for (auto& batch : batches)
+    {
+        sendBatch(std::move(batch));
+    }
+}
+
+size_t TxSubmitter::pendingSize() const
+{
+    Guard l(x_pending);
+    return m_pending.size();
+}
+
+size_t TxSubmitter::inflightSize() const
+{
+    Guard l(x_pending);
+    return m_inflight;
+}
+
+void TxSubmitter::takeBatches(std::vector<Batch>& _batches)
+{
+    if (m_connections.empty())
+    {
+        return;
+    }
+    while (m_inflight < m_config.window && !m_pending.empty())
+    {
+        auto size = std::min(m_config.batchSize, m_pending.size());
+        Batch batch;
+        batch.txs.reserve(size);
+        std::move(m_pending.begin(), m_pending.begin() + size, std::back_inserter(batch.txs));
+        m_pending.erase(m_pending.begin(), m_pending.begin() + size);
+        batch.connection = m_nextConnection++ % m_connections.size();
+        m_inflight++;
+        _batches.emplace_back(std::move(batch));
+    }
+}
+
+void TxSubmitter::sendBatch(Batch _batch)
+{
+    bcostars::TransactionBatchRequest request;
+    request.groupID = m_groupID;
+    request.nodeName = m_config.nodeName;
+    request.requireProof = m_config.requireProof;
+    request.transactions.reserve(_batch.txs.size());
+    for (auto const& tx : _batch.txs)
+    {
+        request.transactions.emplace_back(tx.transaction->begin(), tx.transaction->end());
+    }
+    tars::TarsOutputStream<bcostars::protocol::BufferWriterByteVector> output;
+    request.writeTo(output);
+    auto buffer = std::make_shared<bcos::bytes>();
+    output.getByteBuffer().swap(*buffer);
+    m_batchSizes.record(_batch.txs.size());
+
+    auto connection = _batch.connection;
+    auto sendTime = std::chrono::steady_clock::now();
+    auto batch = std::make_shared<Batch>(std::move(_batch));
+    auto self = std::weak_ptr<TxSubmitter>(shared_from_this());
+    m_connections[connection](m_groupID, m_config.nodeName, buffer,
+        [self, batch, sendTime](Error::Ptr _error, std::shared_ptr<bcos::bytes> _response) {
+            auto submitter = self.lock();
+            if (!submitter)
+            {
+                return;
+            }
+            submitter->onBatchResponse(*batch, sendTime, std::move(_error), std::move(_response));
+        });
+}
+
+void TxSubmitter::onBatchResponse(Batch const& _batch,
+    std::chrono::steady_clock::time_point _sendTime, Error::Ptr _error,
+    std::shared_ptr<bcos::bytes> _response)
+{
+    m_batchLatency.record(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - _sendTime)
+                              .count());
+    // free the slot of the window first, the next batch is on the wire while the results of this
+    // one are delivered
+    std::vector<Batch> batches;
+    {
+        Guard l(x_pending);
+        m_inflight--;
+        takeBatches(batches);
+    }
+    for (auto& batch : batches)
+    {
+        sendBatch(std::move(batch));
+    }
+
+    bcostars::TransactionBatchResponse response;
+    if (!_error || _error->errorCode() == 0)
+    {
+        try
+        {
+            if (!_response)
+            {
+                BOOST_THROW_EXCEPTION(std::invalid_argument("empty response"));
+            }
+            tars::TarsInputStream<tars::BufferReader> input;
+            input.setBuffer((const char*)_response->data(), _response->size());
+            response.readFrom(input);
+            if (response.error.errorCode != 0)
+            {
+                _error = std::make_shared<Error>(
+                    response.error.errorCode, response.error.errorMessage);
+            }
+            else if (response.results.size() != _batch.txs.size())
+            {
+                BOOST_THROW_EXCEPTION(std::invalid_argument("mismatched results"));
+            }
+        }
+        catch (std::exception const& e)
+        {
+            TXSUBMITTER_LOG(WARNING) << LOG_BADGE("onBatchResponse")
+                                     << LOG_DESC("invalid transaction batch response")
+                                     << LOG_KV("group", m_groupID)
+                                     << LOG_KV("txs", _batch.txs.size())
+                                     << LOG_KV("error", boost::diagnostic_information(e));
+            _error = std::make_shared<Error>(
+                boostssl::ws::WsError::PacketError, "invalid transaction batch response");
+        }
+    }
+
+    if (_error && _error->errorCode() != 0)
+    {
+        TXSUBMITTER_LOG(WARNING) << LOG_BADGE("onBatchResponse") << LOG_DESC("batch failed")
+                                 << LOG_KV("group", m_groupID) << LOG_KV("txs", _batch.txs.size())
+                                 << LOG_KV("errorCode", _error->errorCode())
+                                 << LOG_KV("errorMessage", _error->errorMessage());
+        for (auto const& tx : _batch.txs)
+        {
+            onTxResult(tx, _error, nullptr);
+        }
+        return;
+    }
+    for (size_t i = 0; i < _batch.txs.size(); ++i)
+    {
+        auto& result = response.results[i];
+        if (result.error.errorCode != 0)
+        {
+            onTxResult(_batch.txs[i],
+                std::make_shared<Error>(result.error.errorCode, result.error.errorMessage),
+                nullptr);
+            continue;
+        }
+        onTxResult(_batch.txs[i], nullptr,
+            std::make_shared<bcos::bytes>(result.result.begin(), result.result.end()));
+    }
+}
+
+void TxSubmitter::onTxResult(
+    PendingTx const& _tx, Error::Ptr _error, std::shared_ptr<bcos::bytes> _result)
+{
+    m_txLatency.record(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - _tx.submitTime)
+                           .count());
+    if (_tx.respFunc)
+    {
+        _tx.respFunc(std::move(_error), std::move(_result));
+    }
+}
@@ -0,0 +1,141 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief submit the signed transactions in pipelined batches
+ * @file TxSubmitter.h
+ */
+
+#pragma once
+#include <bcos-cpp-sdk/rpc/JsonRpcInterface.h>
+#include <bcos-cpp-sdk/rpc/LatencyHistogram.h>
+#include <bcos-cpp-sdk/ws/Service.h>
+#include <bcos-utilities/Common.h>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define TXSUBMITTER_LOG(LEVEL) BCOS_LOG(LEVEL) << "[RPC][TXSUBMITTER]"
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace jsonrpc
+{
+// send the encoded TransactionBatchRequest on one connection, _respFunc is called with the encoded
+// TransactionBatchResponse
+using TxBatchSendFunc = std::function<void(const std::string& _group, const std::string& _node,
+    std::shared_ptr<bcos::bytes> _request, RespFunc _respFunc)>;
+
+/**
+ * @brief TxSubmitter submits the signed transactions of a group over a pool of connections.
+ *
+ * At most window batches are in flight, a batch is sent as soon as a slot of the window is free,
+ * so the transactions go out one by one when the load is light, and queue up into batches of up to
+ * batchSize transactions when the window is full. The batches are spread over the connections in
+ * turn, every batch is one RPC_SUBMIT_TRANSACTIONS request with the binary transactions.
+ *
+ * The callback of every transaction gets the json result of sendTransaction, and the time from
+ * asyncSubmit to the callback is recorded into txLatency.
+ */
+class TxSubmitter : public std::enable_shared_from_this<TxSubmitter>
+{
+public:
+    using Ptr = std::shared_ptr<TxSubmitter>;
+
+    struct Config
+    {
+        // the batches in flight over all the connections
+        size_t window = 64;
+        // the transactions of one batch, no more than rpc.max_batch_request_size of the node
+        size_t batchSize = 100;
+        // in milliseconds, the node responds a batch after all its transactions are committed
+        uint32_t batchTimeout = 60000;
+        bool requireProof = false;
+        // empty means any node of the group
+        std::string nodeName;
+    };
+
+    TxSubmitter(std::string _groupID, std::vector<TxBatchSendFunc> _connections, Config _config);
+    virtual ~TxSubmitter() { stop(); }
+
+    virtual void start();
+    virtual void stop();
+
+    virtual void asyncSubmit(std::shared_ptr<bcos::bytes> _transaction, RespFunc _respFunc);
+
+    const std::string& groupID() const { return m_groupID; }
+    const Config& config() const { return m_config; }
+    size_t connectionSize() const { return m_connections.size(); }
+
+    // the transactions waiting for a free slot of the window
+    size_t pendingSize() const;
+    // the batches in flight
+    size_t inflightSize() const;
+
+    // from asyncSubmit to the callback of the transaction
+    const LatencyHistogram& txLatency() const { return m_txLatency; }
+    // from the request of the batch to its response
+    const LatencyHistogram& batchLatency() const { return m_batchLatency; }
+    // the transactions of the batches sent
+    const LatencyHistogram& batchSizes() const { return m_batchSizes; }
+
+    // the services the connections are opened on, started and stopped with the submitter
+    void setServices(std::vector<bcos::cppsdk::service::Service::Ptr> _services)
+    {
+        m_services = std::move(_services);
+    }
+
+private:
+    struct PendingTx
+    {
+        std::shared_ptr<bcos::bytes> transaction;
+        RespFunc respFunc;
+        std::chrono::steady_clock::time_point submitTime;
+    };
+    struct Batch
+    {
+        std::vector<PendingTx> txs;
+        size_t connection;
+    };
+
+    // move the pending transactions into batches while the window has free slots, x_pending held
+    void takeBatches(std::vector<Batch>& _batches);
+    void sendBatch(Batch _batch);
+    void onBatchResponse(Batch const& _batch, std::chrono::steady_clock::time_point _sendTime,
+        bcos::Error::Ptr _error, std::shared_ptr<bcos::bytes> _response);
+    void onTxResult(
+        PendingTx const& _tx, bcos::Error::Ptr _error, std::shared_ptr<bcos::bytes> _result);
+
+    std::string m_groupID;
+    std::vector<TxBatchSendFunc> m_connections;
+    Config m_config;
+    std::vector<bcos::cppsdk::service::Service::Ptr> m_services;
+
+    mutable bcos::Mutex x_pending;
+    std::deque<PendingTx> m_pending;
+    size_t m_inflight = 0;
+    size_t m_nextConnection = 0;
+
+    LatencyHistogram m_txLatency;
+    LatencyHistogram m_batchLatency;
+    LatencyHistogram m_batchSizes;
+};
+}  // namespace jsonrpc
+}  // namespace cppsdk
+}  // namespace bcos
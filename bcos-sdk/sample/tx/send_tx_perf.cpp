@@ -0,0 +1,172 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file send_tx_perf.cpp
+ * @date 2022-06-20
+ */
+
+#include <bcos-tars-protocol/impl/TarsSerializable.h>
+
+#include "bcos-concepts/Serialize.h"
+#include "bcos-crypto/interfaces/crypto/CryptoSuite.h"
+#include "bcos-crypto/signature/sm2/SM2Crypto.h"
+#include "bcos-tars-protocol/protocol/TransactionImpl.h"
+#include <bcos-cpp-sdk/SdkFactory.h>
+#include <bcos-cpp-sdk/config/Config.h>
+#include <bcos-crypto/hash/Keccak256.h>
+#include <bcos-crypto/hash/SM3.h>
+#include <bcos-crypto/signature/secp256k1/Secp256k1Crypto.h>
+#include <bcos-tars-protocol/protocol/TransactionFactoryImpl.h>
+#include <bcos-utilities/Common.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::jsonrpc;
+
+void usage()
+{
+    std::cerr << "Desc: send signed transactions through the pooled and batched submitter\n"
+              << "Usage: send_tx_perf <config> <groupID> <txCount> [connections] [window] "
+                 "[batchSize]\n"
+              << "Example:\n"
+              << "    ./send_tx_perf ./config_sample.ini group0 100000\n"
+              << "    ./send_tx_perf ./config_sample.ini group0 100000 4 64 100\n"
+                 "\n";
+    std::exit(0);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 4)
+    {
+        usage();
+    }
+
+    std::string configFile = argv[1];
+    std::string group = argv[2];
+    uint32_t txCount = std::stoul(argv[3]);
+    uint32_t connections = argc > 4 ? std::stoul(argv[4]) : 4;
+    TxSubmitter::Config submitterConfig;
+    submitterConfig.window = argc > 5 ? std::stoul(argv[5]) : 64;
+    submitterConfig.batchSize = argc > 6 ? std::stoul(argv[6]) : 100;
+
+    std::cout << LOG_DESC(" [SendTxPerf] params ===>>>> ") << LOG_KV("\n\t # config", configFile)
+              << LOG_KV("\n\t # groupID", group) << LOG_KV("\n\t # txCount", txCount)
+              << LOG_KV("\n\t # connections", connections)
+              << LOG_KV("\n\t # window", submitterConfig.window)
+              << LOG_KV("\n\t # batchSize", submitterConfig.batchSize) << std::endl;
+
+    auto config = std::make_shared<bcos::cppsdk::config::Config>();
+    auto wsConfig = config->loadConfig(configFile);
+    auto factory = std::make_shared<SdkFactory>();
+    // the sdk for the group info and the block limit
+    auto sdk = factory->buildSdk(wsConfig);
+    sdk->start();
+
+    auto groupInfo = sdk->service()->getGroupInfo(group);
+    if (!groupInfo)
+    {
+        std::cout << LOG_DESC(" [SendTxPerf] group not exist") << LOG_KV("group", group)
+                  << std::endl;
+        exit(-1);
+    }
+    int64_t blockLimit = -1;
+    sdk->service()->getBlockLimit(group, blockLimit);
+
+    crypto::SignatureCrypto::Ptr keyPairFactory;
+    crypto::Hash::Ptr hashImpl;
+    if (groupInfo->smCryptoType())
+    {
+        keyPairFactory = std::make_shared<bcos::crypto::SM2Crypto>();
+        hashImpl = std::make_shared<bcos::crypto::SM3>();
+    }
+    else
+    {
+        keyPairFactory = std::make_shared<bcos::crypto::Secp256k1Crypto>();
+        hashImpl = std::make_shared<bcos::crypto::Keccak256>();
+    }
+    auto cryptoSuite =
+        std::make_shared<bcos::crypto::CryptoSuite>(hashImpl, keyPairFactory, nullptr);
+    auto transactionFactory =
+        std::make_shared<bcostars::protocol::TransactionFactoryImpl>(cryptoSuite);
+    auto keyPair =
+        std::shared_ptr<bcos::crypto::KeyPairInterface>(keyPairFactory->generateKeyPair());
+
+    // sign all the transactions first, only the submission is measured
+    std::cout << LOG_DESC(" [SendTxPerf] sign transactions ...")
+              << LOG_KV("blockLimit", blockLimit) << std::endl;
+    std::vector<std::shared_ptr<bcos::bytes>> transactions;
+    transactions.reserve(txCount);
+    auto nonce = bcos::u256(utcTimeUs());
+    for (uint32_t i = 0; i < txCount; ++i)
+    {
+        auto tx = transactionFactory->createTransaction(0, "to", bcos::bytes(), nonce + i,
+            blockLimit, groupInfo->chainID(), group, utcTime(), keyPair);
+        auto buffer = std::make_shared<bcos::bytes>();
+        bcos::concepts::serialize::encode(
+            std::dynamic_pointer_cast<bcostars::protocol::TransactionImpl>(tx)->inner(), *buffer);
+        transactions.emplace_back(std::move(buffer));
+    }
+
+    auto submitter = factory->buildTxSubmitter(wsConfig, group, connections, submitterConfig);
+    submitter->start();
+    std::cout << LOG_DESC(" [SendTxPerf] start submitter ...") << std::endl;
+
+    std::promise<void> finished;
+    std::atomic<uint32_t> received = 0;
+    std::atomic<uint32_t> failed = 0;
+    auto startPoint = std::chrono::high_resolution_clock::now();
+    for (auto& transaction : transactions)
+    {
+        submitter->asyncSubmit(std::move(transaction),
+            [&](bcos::Error::Ptr _error, std::shared_ptr<bcos::bytes>) {
+                if (_error && _error->errorCode() != 0)
+                {
+                    ++failed;
+                }
+                if (++received == txCount)
+                {
+                    finished.set_value();
+                }
+            });
+    }
+    if (txCount > 0)
+    {
+        finished.get_future().wait();
+    }
+    auto endPoint = std::chrono::high_resolution_clock::now();
+    auto elapsedMS = std::max<long long>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(endPoint - startPoint).count(), 1);
+
+    printf(" [SendTxPerf] total txs: %u, failed: %u, total elapsed(ms): %lld, txs/s: %lld \n",
+        txCount, failed.load(), elapsedMS, 1000 * (long long)txCount / elapsedMS);
+    std::cout << " [SendTxPerf] tx latency: " << submitter->txLatency().toString() << std::endl;
+    std::cout << " [SendTxPerf] batch latency: " << submitter->batchLatency().toString()
+              << std::endl;
+    std::cout << " [SendTxPerf] batches: " << submitter->batchSizes().count()
+              << ", mean txs: " << submitter->batchSizes().mean()
+              << ", max txs: " << submitter->batchSizes().max() << std::endl;
+
+    submitter->stop();
+    sdk->stop();
+    return 0;
+}
@@ -0,0 +1,205 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for TxSubmitter and LatencyHistogram
+ * @file TxSubmitterTest.cpp
+ */
+#include <bcos-cpp-sdk/rpc/LatencyHistogram.h>
+#include <bcos-cpp-sdk/rpc/TxSubmitter.h>
+#include <bcos-tars-protocol/Common.h>
+#include <bcos-tars-protocol/tars/TransactionBatch.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+#include <deque>
+
+using namespace bcos;
+using namespace bcos::cppsdk::jsonrpc;
+using namespace bcos::test;
+
+namespace
+{
+struct SentBatch
+{
+    size_t connection;
+    bcostars::TransactionBatchRequest request;
+    RespFunc respFunc;
+};
+
+// the connections keep the requests, the test answers them
+std::vector<TxBatchSendFunc> fakeConnections(size_t _size, std::deque<SentBatch>& _sent)
+{
+    std::vector<TxBatchSendFunc> connections;
+    for (size_t i = 0; i < _size; ++i)
+    {
+        connections.emplace_back([i, &_sent](const std::string&, const std::string&,
+                                     std::shared_ptr<bcos::bytes> _request, RespFunc _respFunc) {
+            SentBatch batch{i, {}, std::move(_respFunc)};
+            tars::TarsInputStream<tars::BufferReader> input;
+            input.setBuffer((const char*)_request->data(), _request->size());
+            batch.request.readFrom(input);
+            _sent.emplace_back(std::move(batch));
+        });
+    }
+    return connections;
+}
+
+// echo every transaction as its result, the one equal to _failed gets an error
+void answer(SentBatch const& _batch, std::string const& _failed = "")
+{
+    bcostars::TransactionBatchResponse response;
+    for (auto const& tx : _batch.request.transactions)
+    {
+        bcostars::TransactionBatchResult result;
+        if (std::string(tx.begin(), tx.end()) == _failed)
+        {
+            result.error.errorCode = -1;
+            result.error.errorMessage = "failed";
+        }
+        else
+        {
+            result.result = tx;
+        }
+        response.results.emplace_back(std::move(result));
+    }
+    tars::TarsOutputStream<bcostars::protocol::BufferWriterByteVector> output;
+    response.writeTo(output);
+    auto buffer = std::make_shared<bcos::bytes>();
+    output.getByteBuffer().swap(*buffer);
+    _batch.respFunc(nullptr, buffer);
+}
+
+std::shared_ptr<bcos::bytes> toTx(std::string const& _tx)
+{
+    return std::make_shared<bcos::bytes>(_tx.begin(), _tx.end());
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(TxSubmitterTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(test_windowAndBatch)
+{
+    std::deque<SentBatch> sent;
+    TxSubmitter::Config config;
+    config.window = 2;
+    config.batchSize = 3;
+    auto submitter = std::make_shared<TxSubmitter>("group0", fakeConnections(2, sent), config);
+
+    std::vector<std::string> results;
+    std::vector<int64_t> errors;
+    auto respFunc = [&](Error::Ptr _error, std::shared_ptr<bcos::bytes> _result) {
+        if (_error)
+        {
+            errors.push_back(_error->errorCode());
+            return;
+        }
+        results.emplace_back(_result->begin(), _result->end());
+    };
+
+    // the window is free, sent one by one
+    submitter->asyncSubmit(toTx("tx0"), respFunc);
+    submitter->asyncSubmit(toTx("tx1"), respFunc);
+    BOOST_REQUIRE_EQUAL(sent.size(), 2);
+    BOOST_CHECK_EQUAL(sent[0].connection, 0);
+    BOOST_CHECK_EQUAL(sent[1].connection, 1);
+    BOOST_CHECK_EQUAL(sent[0].request.groupID, "group0");
+    BOOST_CHECK_EQUAL(sent[0].request.transactions.size(), 1);
+    BOOST_CHECK_EQUAL(submitter->inflightSize(), 2);
+
+    // the window is full, queued
+    for (int i = 2; i < 7; ++i)
+    {
+        submitter->asyncSubmit(toTx("tx" + std::to_string(i)), respFunc);
+    }
+    BOOST_CHECK_EQUAL(sent.size(), 2);
+    BOOST_CHECK_EQUAL(submitter->pendingSize(), 5);
+
+    // a free slot takes a full batch
+    answer(sent[0]);
+    BOOST_REQUIRE_EQUAL(sent.size(), 3);
+    BOOST_CHECK_EQUAL(sent[2].request.transactions.size(), 3);
+    BOOST_CHECK_EQUAL(sent[2].connection, 0);
+    BOOST_CHECK_EQUAL(submitter->pendingSize(), 2);
+    BOOST_REQUIRE_EQUAL(results.size(), 1);
+    BOOST_CHECK_EQUAL(results[0], "tx0");
+
+    answer(sent[1]);
+    BOOST_REQUIRE_EQUAL(sent.size(), 4);
+    BOOST_CHECK_EQUAL(sent[3].request.transactions.size(), 2);
+    BOOST_CHECK_EQUAL(submitter->pendingSize(), 0);
+
+    answer(sent[2], "tx3");
+    // the whole batch fails
+    sent[3].respFunc(std::make_shared<Error>(-4008, "timeout"), nullptr);
+    BOOST_CHECK_EQUAL(sent.size(), 4);
+    BOOST_CHECK_EQUAL(submitter->inflightSize(), 0);
+
+    BOOST_CHECK_EQUAL(results.size(), 4);
+    BOOST_CHECK_EQUAL(results[2], "tx2");
+    BOOST_CHECK_EQUAL(results[3], "tx4");
+    BOOST_REQUIRE_EQUAL(errors.size(), 3);
+    BOOST_CHECK_EQUAL(errors[0], -1);
+    BOOST_CHECK_EQUAL(errors[1], -4008);
+    BOOST_CHECK_EQUAL(errors[2], -4008);
+
+    BOOST_CHECK_EQUAL(submitter->txLatency().count(), 7);
+    BOOST_CHECK_EQUAL(submitter->batchLatency().count(), 4);
+    BOOST_CHECK_EQUAL(submitter->batchSizes().max(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_invalidResponse)
+{
+    std::deque<SentBatch> sent;
+    auto submitter =
+        std::make_shared<TxSubmitter>("group0", fakeConnections(1, sent), TxSubmitter::Config());
+    Error::Ptr error;
+    submitter->asyncSubmit(toTx("tx0"),
+        [&error](Error::Ptr _error, std::shared_ptr<bcos::bytes>) { error = _error; });
+    BOOST_REQUIRE_EQUAL(sent.size(), 1);
+    sent[0].respFunc(nullptr, std::make_shared<bcos::bytes>(3, 0xff));
+    BOOST_REQUIRE(error);
+    BOOST_CHECK_NE(error->errorCode(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_latencyHistogram)
+{
+    // the buckets are continuous
+    for (size_t i = 0; i + 1 < LatencyHistogram::BUCKETS; ++i)
+    {
+        BOOST_CHECK_EQUAL(LatencyHistogram::bucketIndex(LatencyHistogram::bucketLowerBound(i)), i);
+        BOOST_CHECK_EQUAL(LatencyHistogram::bucketIndex(LatencyHistogram::bucketUpperBound(i)), i);
+        BOOST_CHECK_EQUAL(
+            LatencyHistogram::bucketUpperBound(i) + 1, LatencyHistogram::bucketLowerBound(i + 1));
+    }
+
+    LatencyHistogram histogram;
+    BOOST_CHECK_EQUAL(histogram.percentile(50), 0);
+    for (uint64_t i = 1; i <= 1000; ++i)
+    {
+        histogram.record(i * 10);
+    }
+    BOOST_CHECK_EQUAL(histogram.count(), 1000);
+    BOOST_CHECK_EQUAL(histogram.max(), 10000);
+    BOOST_CHECK_CLOSE(histogram.mean(), 5005, 0.01);
+    // within 1/16 of the value
+    BOOST_CHECK_CLOSE((double)histogram.percentile(50), 5000, 100.0 / 16);
+    BOOST_CHECK_CLOSE((double)histogram.percentile(99), 9900, 100.0 / 16);
+    BOOST_CHECK_EQUAL(histogram.percentile(100), 10000);
+
+    histogram.reset();
+    BOOST_CHECK_EQUAL(histogram.count(), 0);
+    BOOST_CHECK_EQUAL(histogram.max(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -20,11 +20,30 @@
 #include "Sealer.h"
 #include "Common.h"
 #include <bcos-framework/protocol/GlobalConfig.h>
+#include <bcos-utilities/Metrics.h>
 
 using namespace bcos;
 using namespace bcos::sealer;
 using namespace bcos::protocol;
 
+namespace
+{
+struct SealerMetrics
+{
+    metrics::Counter& proposals = metrics::MetricsRegistry::instance().counter(
+        "bcos_sealer_proposals_total", "The proposals generated by the sealer");
+    metrics::Counter& sealedTxs = metrics::MetricsRegistry::instance().counter(
+        "bcos_sealer_sealed_txs_total", "The txs sealed into the proposals");
+    metrics::Histogram& submitTime = metrics::MetricsRegistry::instance().histogram(
+        "bcos_sealer_submit_proposal_seconds", "The time to encode and submit a proposal");
+};
+SealerMetrics& sealerMetrics()
+{
+    static SealerMetrics sealerMetrics;
+    return sealerMetrics;
+}
+}  // namespace
+
 void Sealer::start()
 {
     if (m_running)
@@ -128,6 +147,9 @@ void Sealer::submitProposal(bool _containSysTxs, bcos::protocol::Block::Ptr _blo
         m_sealingManager->notifyResetProposal(_block);
         return;
     }
+    metrics::ScopedTimer timer(sealerMetrics().submitTime);
+    sealerMetrics().proposals.inc();
+    sealerMetrics().sealedTxs.inc(_block->transactionsHashSize());
     // supplement the header info: set sealerList and weightList
     std::vector<bytes> sealerList;
     std::vector<uint64_t> weightList;
@@ -20,6 +20,7 @@
 #pragma once
 #include "bcos-framework/consensus/ConsensusInterface.h"
 #include "bcos-framework/protocol/BlockFactory.h"
+#include "SealingController.h"
 #include "bcos-framework/txpool/TxPoolInterface.h"
 namespace bcos
 {
@@ -44,6 +45,18 @@ public:
     virtual unsigned minSealTime() const { return m_minSealTime; }
     virtual void setMinSealTime(unsigned _minSealTime) { m_minSealTime = _minSealTime; }
 
+    virtual SealingPolicy sealingPolicy() const { return m_sealingPolicy; }
+    virtual void setSealingPolicy(SealingPolicy _sealingPolicy)
+    {
+        m_sealingPolicy = _sealingPolicy;
+    }
+    // in milliseconds, the adaptive sealing sizes the proposals to commit within the latency
+    virtual unsigned targetBlockLatency() const { return m_targetBlockLatency; }
+    virtual void setTargetBlockLatency(unsigned _targetBlockLatency)
+    {
+        m_targetBlockLatency = _targetBlockLatency;
+    }
+
     bcos::protocol::BlockFactory::Ptr blockFactory() { return m_blockFactory; }
     bcos::consensus::ConsensusInterface::Ptr consensus() { return m_consensus; }
 
@@ -52,6 +65,8 @@ protected:
     bcos::protocol::BlockFactory::Ptr m_blockFactory;
     bcos::consensus::ConsensusInterface::Ptr m_consensus;
     unsigned m_minSealTime = 500;
+    SealingPolicy m_sealingPolicy = SealingPolicy::Static;
+    unsigned m_targetBlockLatency = 1000;
 };
 }  // namespace sealer
 }  // namespace bcos
\ No newline at end of file
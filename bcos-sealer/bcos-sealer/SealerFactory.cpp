@@ -23,13 +23,20 @@ using namespace bcos;
 using namespace bcos::sealer;
 
 SealerFactory::SealerFactory(bcos::protocol::BlockFactory::Ptr _blockFactory,
-    bcos::txpool::TxPoolInterface::Ptr _txpool, unsigned _minSealTime)
-  : m_blockFactory(_blockFactory), m_txpool(_txpool), m_minSealTime(_minSealTime)
+    bcos::txpool::TxPoolInterface::Ptr _txpool, unsigned _minSealTime,
+    SealingPolicy _sealingPolicy, unsigned _targetBlockLatency)
+  : m_blockFactory(_blockFactory),
+    m_txpool(_txpool),
+    m_minSealTime(_minSealTime),
+    m_sealingPolicy(_sealingPolicy),
+    m_targetBlockLatency(_targetBlockLatency)
 {}
 
 Sealer::Ptr SealerFactory::createSealer()
 {
     auto sealerConfig = std::make_shared<SealerConfig>(m_blockFactory, m_txpool);
     sealerConfig->setMinSealTime(m_minSealTime);
+    sealerConfig->setSealingPolicy(m_sealingPolicy);
+    sealerConfig->setTargetBlockLatency(m_targetBlockLatency);
     return std::make_shared<Sealer>(sealerConfig);
 }
\ No newline at end of file
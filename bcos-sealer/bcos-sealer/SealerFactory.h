@@ -29,7 +29,9 @@ class SealerFactory
 public:
     using Ptr = std::shared_ptr<SealerFactory>;
     SealerFactory(bcos::protocol::BlockFactory::Ptr _blockFactory,
-        bcos::txpool::TxPoolInterface::Ptr _txpool, unsigned _minSealTime);
+        bcos::txpool::TxPoolInterface::Ptr _txpool, unsigned _minSealTime,
+        SealingPolicy _sealingPolicy = SealingPolicy::Static,
+        unsigned _targetBlockLatency = 1000);
 
     virtual ~SealerFactory() {}
     Sealer::Ptr createSealer();
@@ -38,6 +40,8 @@ protected:
     bcos::protocol::BlockFactory::Ptr m_blockFactory;
     bcos::txpool::TxPoolInterface::Ptr m_txpool;
     unsigned m_minSealTime;
+    SealingPolicy m_sealingPolicy;
+    unsigned m_targetBlockLatency;
 };
 }  // namespace sealer
 }  // namespace bcos
\ No newline at end of file
@@ -0,0 +1,196 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file SealingController.cpp
+ * @brief size the proposals according to the measured throughput of the block pipeline
+ */
+#include "SealingController.h"
+#include "Common.h"
+#include <bcos-utilities/Metrics.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace bcos;
+using namespace bcos::sealer;
+
+namespace
+{
+struct SealingControllerMetrics
+{
+    metrics::Gauge& targetTxs = metrics::MetricsRegistry::instance().gauge(
+        "bcos_sealer_target_block_txs", "The txs the sealer expects to seal into a proposal");
+    metrics::Gauge& txCost = metrics::MetricsRegistry::instance().gauge(
+        "bcos_sealer_tx_cost_microseconds", "The estimated time to commit a tx");
+    metrics::Gauge& baseCost = metrics::MetricsRegistry::instance().gauge(
+        "bcos_sealer_block_base_cost_microseconds", "The estimated fixed time to commit a block");
+    metrics::Gauge& inflight = metrics::MetricsRegistry::instance().gauge(
+        "bcos_sealer_inflight_proposals", "The proposals sealed by this node and not committed");
+    metrics::Histogram& commitLatency = metrics::MetricsRegistry::instance().histogram(
+        "bcos_sealer_commit_latency_seconds",
+        "The time from sealing a proposal to committing it");
+};
+SealingControllerMetrics& controllerMetrics()
+{
+    static SealingControllerMetrics controllerMetrics;
+    return controllerMetrics;
+}
+}  // namespace
+
+SealingController::SealingController(SealingPolicy _policy, uint64_t _targetBlockLatency)
+  : m_policy(_policy), m_targetBlockLatency(_targetBlockLatency)
+{
+    metrics::MetricsRegistry::instance()
+        .gauge("bcos_sealer_policy", "The sealing policy in use",
+            _policy == SealingPolicy::Adaptive ? "policy=\"adaptive\"" : "policy=\"static\"")
+        .set(1);
+    SEAL_LOG(INFO) << LOG_DESC("create SealingController")
+                   << LOG_KV("adaptive", _policy == SealingPolicy::Adaptive)
+                   << LOG_KV("targetBlockLatency", _targetBlockLatency);
+}
+
+size_t SealingController::targetTxsPerBlock(size_t _maxTxsPerBlock) const
+{
+    if (m_policy != SealingPolicy::Adaptive || m_samplesSize < c_minSamples || _maxTxsPerBlock == 0)
+    {
+        return _maxTxsPerBlock;
+    }
+    auto txCost = m_txCost.load();
+    if (txCost <= 0)
+    {
+        return _maxTxsPerBlock;
+    }
+    auto budget = std::max((double)m_targetBlockLatency - m_baseCost.load(), 0.0);
+    auto minTxs = std::max(_maxTxsPerBlock / c_minTxsDivisor, (size_t)1);
+    auto targetTxs = (size_t)std::min(budget / txCost, (double)_maxTxsPerBlock);
+    targetTxs = std::clamp(targetTxs, minTxs, _maxTxsPerBlock);
+    controllerMetrics().targetTxs.set(targetTxs);
+    return targetTxs;
+}
+
+bool SealingController::shouldHold(uint64_t _lastSealTime, uint64_t _now) const
+{
+    if (m_policy != SealingPolicy::Adaptive || m_samplesSize < c_minSamples)
+    {
+        return false;
+    }
+    // never hold longer than the target latency, the pipeline has drained by then, and the leader
+    // must propose before the consensus timeout
+    if (_now >= _lastSealTime + m_targetBlockLatency)
+    {
+        return false;
+    }
+    auto baseCost = m_baseCost.load();
+    auto txCost = m_txCost.load();
+    double drainTime = 0;
+    {
+        Guard l(x_state);
+        for (auto const& it : m_inflight)
+        {
+            drainTime += baseCost + it.second.txsSize * txCost;
+        }
+    }
+    return drainTime >= (double)m_targetBlockLatency;
+}
+
+void SealingController::onProposalSealed(int64_t _number, size_t _txsSize, uint64_t _now)
+{
+    Guard l(x_state);
+    m_inflight[_number] = Proposal{_txsSize, _now};
+    controllerMetrics().inflight.set(m_inflight.size());
+}
+
+void SealingController::onBlockCommitted(int64_t _number, uint64_t _now)
+{
+    Guard l(x_state);
+    // the proposals sealed before the committed one will never be committed with the sealed txs
+    while (!m_inflight.empty() && m_inflight.begin()->first <= _number)
+    {
+        auto const& [number, proposal] = *m_inflight.begin();
+        if (number == _number && _now >= proposal.sealTime)
+        {
+            controllerMetrics().commitLatency.observe((_now - proposal.sealTime) * 1000);
+            // the proposal starts to occupy the pipeline after the previous block is committed
+            auto startTime = std::max(proposal.sealTime, m_lastCommitTime);
+            addSample(proposal.txsSize, _now - std::min(startTime, _now));
+        }
+        m_inflight.erase(m_inflight.begin());
+    }
+    m_lastCommitTime = std::max(m_lastCommitTime, _now);
+    controllerMetrics().inflight.set(m_inflight.size());
+}
+
+void SealingController::resetInflight()
+{
+    Guard l(x_state);
+    m_inflight.clear();
+    controllerMetrics().inflight.set(0);
+}
+
+void SealingController::addSample(size_t _txsSize, uint64_t _blockTime)
+{
+    if (_txsSize == 0)
+    {
+        return;
+    }
+    m_samples.emplace_back(Sample{_txsSize, _blockTime});
+    if (m_samples.size() > c_sampleWindow)
+    {
+        m_samples.pop_front();
+    }
+    fit();
+}
+
+// least squares fit of blockTime = base + txsSize * txCost over the samples
+void SealingController::fit()
+{
+    double meanTxs = 0;
+    double meanTime = 0;
+    for (auto const& sample : m_samples)
+    {
+        meanTxs += sample.txsSize;
+        meanTime += sample.blockTime;
+    }
+    meanTxs /= m_samples.size();
+    meanTime /= m_samples.size();
+
+    double varTxs = 0;
+    double covariance = 0;
+    for (auto const& sample : m_samples)
+    {
+        varTxs += (sample.txsSize - meanTxs) * (sample.txsSize - meanTxs);
+        covariance += (sample.txsSize - meanTxs) * (sample.blockTime - meanTime);
+    }
+    double txCost = 0;
+    double baseCost = 0;
+    // the block sizes spread enough to separate the fixed cost from the per-tx cost
+    auto stdevTxs = std::sqrt(varTxs / m_samples.size());
+    if (stdevTxs >= meanTxs * 0.1 && covariance > 0)
+    {
+        txCost = covariance / varTxs;
+        baseCost = std::max(meanTime - txCost * meanTxs, 0.0);
+    }
+    else
+    {
+        // charge all the time to the txs, the blocks grow until they take the target latency
+        txCost = meanTime / meanTxs;
+    }
+    // the block time is in milliseconds, a tx costs at least 1us
+    txCost = std::max(txCost, 0.001);
+    m_txCost = txCost;
+    m_baseCost = baseCost;
+    m_samplesSize = m_samples.size();
+    controllerMetrics().txCost.set((int64_t)(txCost * 1000));
+    controllerMetrics().baseCost.set((int64_t)(baseCost * 1000));
+}
@@ -0,0 +1,106 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file SealingController.h
+ * @brief size the proposals according to the measured throughput of the block pipeline
+ */
+#pragma once
+#include <bcos-utilities/Common.h>
+#include <atomic>
+#include <deque>
+#include <map>
+#include <memory>
+
+namespace bcos
+{
+namespace sealer
+{
+enum class SealingPolicy
+{
+    // seal maxTxsPerBlock txs, or the pending txs after min_seal_time
+    Static,
+    // seal the txs that the pipeline is expected to commit within the target block latency
+    Adaptive,
+};
+
+// SealingController measures how long the proposals sealed by this node take from the moment the
+// pipeline is free for them to their commit, fits the time as base + txs * txCost, and sizes the
+// next proposals so that every block commits within the target latency.
+// The sealing is held while the proposals in flight already fill the target latency, so the
+// proposals don't queue up behind a slow execution.
+class SealingController
+{
+public:
+    using Ptr = std::shared_ptr<SealingController>;
+    // the samples used to fit the block time
+    constexpr static size_t c_sampleWindow = 32;
+    // fit the block time after the given samples, seal maxTxsPerBlock txs before
+    constexpr static size_t c_minSamples = 4;
+    // the target block txs is at least maxTxsPerBlock / c_minTxsDivisor
+    constexpr static size_t c_minTxsDivisor = 32;
+
+    // _targetBlockLatency: in milliseconds
+    SealingController(SealingPolicy _policy, uint64_t _targetBlockLatency);
+    virtual ~SealingController() = default;
+
+    SealingPolicy policy() const { return m_policy; }
+    uint64_t targetBlockLatency() const { return m_targetBlockLatency; }
+
+    // the txs expected to seal into a proposal
+    virtual size_t targetTxsPerBlock(size_t _maxTxsPerBlock) const;
+    // whether to wait for the proposals in flight before sealing a new one
+    virtual bool shouldHold(uint64_t _lastSealTime, uint64_t _now) const;
+
+    virtual void onProposalSealed(int64_t _number, size_t _txsSize, uint64_t _now);
+    virtual void onBlockCommitted(int64_t _number, uint64_t _now);
+    // the proposals in flight will not be committed, e.g. after viewchange
+    virtual void resetInflight();
+
+    // the estimated time in milliseconds to commit a tx, and the fixed time of a block
+    double txCost() const { return m_txCost.load(); }
+    double baseCost() const { return m_baseCost.load(); }
+    size_t samples() const { return m_samplesSize.load(); }
+
+protected:
+    void addSample(size_t _txsSize, uint64_t _blockTime);
+    void fit();
+
+private:
+    struct Proposal
+    {
+        size_t txsSize;
+        uint64_t sealTime;
+    };
+    struct Sample
+    {
+        size_t txsSize;
+        uint64_t blockTime;
+    };
+
+    SealingPolicy m_policy;
+    uint64_t m_targetBlockLatency;
+
+    mutable Mutex x_state;
+    // number => the proposals sealed by this node and not committed yet
+    std::map<int64_t, Proposal> m_inflight;
+    std::deque<Sample> m_samples;
+    uint64_t m_lastCommitTime = 0;
+
+    std::atomic<double> m_txCost = {0};
+    std::atomic<double> m_baseCost = {0};
+    std::atomic<size_t> m_samplesSize = {0};
+};
+}  // namespace sealer
+}  // namespace bcos
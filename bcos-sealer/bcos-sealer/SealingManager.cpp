@@ -18,17 +18,41 @@
  * @date: 2021-05-14
  */
 #include "SealingManager.h"
+#include <bcos-utilities/Metrics.h>
+#include <bcos-utilities/Tracer.h>
 using namespace bcos;
 using namespace bcos::sealer;
 using namespace bcos::crypto;
 using namespace bcos::protocol;
 
+namespace
+{
+struct SealingDecisionMetrics
+{
+    // the proposal reaches the target txs
+    metrics::Counter& full = metrics::MetricsRegistry::instance().counter(
+        "bcos_sealer_decisions_total", "The sealing decisions", "decision=\"full\"");
+    // the proposal is sealed with the pending txs after min_seal_time
+    metrics::Counter& timeout = metrics::MetricsRegistry::instance().counter(
+        "bcos_sealer_decisions_total", "The sealing decisions", "decision=\"timeout\"");
+    // the sealing waits for the proposals in flight
+    metrics::Counter& hold = metrics::MetricsRegistry::instance().counter(
+        "bcos_sealer_decisions_total", "The sealing decisions", "decision=\"hold\"");
+};
+SealingDecisionMetrics& decisionMetrics()
+{
+    static SealingDecisionMetrics decisionMetrics;
+    return decisionMetrics;
+}
+}  // namespace
+
 void SealingManager::resetSealing()
 {
     SEAL_LOG(INFO) << LOG_DESC("resetSealing") << LOG_KV("startNum", m_startSealingNumber)
                    << LOG_KV("endNum", m_endSealingNumber) << LOG_KV("sealingNum", m_sealingNumber)
                    << LOG_KV("pendingTxs", pendingTxsSize());
     m_sealingNumber = m_endSealingNumber + 1;
+    m_controller->resetInflight();
     clearPendingTxs();
 }
 
@@ -59,7 +83,16 @@ bool SealingManager::shouldGenerateProposal()
     }
     // check the txs size
     auto txsSize = pendingTxsSize();
-    if (txsSize >= m_maxTxsPerBlock || reachMinSealTimeCondition())
+    if (txsSize > 0 && m_controller->shouldHold(m_lastSealTime, utcSteadyTime()))
+    {
+        if (!m_holding.exchange(true))
+        {
+            decisionMetrics().hold.inc();
+        }
+        return false;
+    }
+    m_holding = false;
+    if (txsSize >= targetTxsPerBlock() || reachMinSealTimeCondition())
     {
         return true;
     }
@@ -149,8 +182,17 @@ std::pair<bool, bcos::protocol::Block::Ptr> SealingManager::generateProposal()
     blockHeader->setNumber(m_sealingNumber);
     blockHeader->setTimestamp(utcTime());
     block->setBlockHeader(blockHeader);
-    auto txsSize =
-        std::min((size_t)m_maxTxsPerBlock, (m_pendingTxs->size() + m_pendingSysTxs->size()));
+    auto targetTxs = targetTxsPerBlock();
+    auto pendingSize = m_pendingTxs->size() + m_pendingSysTxs->size();
+    auto txsSize = std::min(targetTxs, pendingSize);
+    if (pendingSize >= targetTxs)
+    {
+        decisionMetrics().full.inc();
+    }
+    else
+    {
+        decisionMetrics().timeout.inc();
+    }
     // prioritize seal from the system txs list
     auto systemTxsSize = std::min(txsSize, m_pendingSysTxs->size());
     if (m_pendingSysTxs->size() > 0)
@@ -172,9 +214,10 @@ std::pair<bool, bcos::protocol::Block::Ptr> SealingManager::generateProposal()
         block->appendTransactionMetaData(m_pendingTxs->front());
         m_pendingTxs->pop_front();
     }
+    m_lastSealTime = utcSteadyTime();
+    m_controller->onProposalSealed(m_sealingNumber, txsSize, m_lastSealTime);
     m_sealingNumber++;
 
-    m_lastSealTime = utcSteadyTime();
     // Note: When the last block(N) sealed by this node contains system transactions,
     //       if other nodes do not wait until block(N) is committed and directly seal block(N+1),
     //       will cause system exceptions.
@@ -193,13 +236,27 @@ bool SealingManager::reachMinSealTimeCondition()
     {
         return false;
     }
-    if ((utcSteadyTime() - m_lastSealTime) < m_config->minSealTime())
+    auto sealElapsed = utcSteadyTime() - m_lastSealTime;
+    if (sealElapsed < m_config->minSealTime())
+    {
+        return false;
+    }
+    // the txpool still has unsealed txs to fill up the proposal, wait for fetching them rather
+    // than sealing a small proposal, at most another min_seal_time
+    if (m_controller->policy() == SealingPolicy::Adaptive &&
+        (m_fetchingTxs || m_unsealedTxsSize > 0) && txsSize < targetTxsPerBlock() &&
+        sealElapsed < 2 * m_config->minSealTime())
     {
         return false;
     }
     return true;
 }
 
+size_t SealingManager::targetTxsPerBlock()
+{
+    return m_controller->targetTxsPerBlock(m_maxTxsPerBlock);
+}
+
 bool SealingManager::shouldFetchTransaction()
 {
     // fetching transactions currently
@@ -217,7 +274,7 @@ bool SealingManager::shouldFetchTransaction()
 
 int64_t SealingManager::txsSizeExpectedToFetch()
 {
-    auto txsSizeToFetch = (m_endSealingNumber - m_sealingNumber + 1) * m_maxTxsPerBlock;
+    auto txsSizeToFetch = (m_endSealingNumber - m_sealingNumber + 1) * targetTxsPerBlock();
     auto txsSize = pendingTxsSize();
     if (txsSizeToFetch <= txsSize)
     {
@@ -243,10 +300,17 @@ void SealingManager::fetchTransactions()
     ssize_t endSealingNumber = m_endSealingNumber;
     auto self = std::weak_ptr<SealingManager>(shared_from_this());
     m_config->txpool()->asyncSealTxs(txsToFetch, nullptr,
-        [self, startSealingNumber, endSealingNumber](
+        [self, startSealingNumber, endSealingNumber, sealingNumber = m_sealingNumber.load(),
+            spanStart = trace::spanStart()](
             Error::Ptr _error, Block::Ptr _txsHashList, Block::Ptr _sysTxsList) {
             try
             {
+                if (_error == nullptr)
+                {
+                    trace::spanEnd(trace::c_txpool, "sealTxs", sealingNumber, spanStart,
+                        _txsHashList->transactionsMetaDataSize() +
+                            _sysTxsList->transactionsMetaDataSize());
+                }
                 auto sealingMgr = self.lock();
                 if (!sealingMgr)
                 {
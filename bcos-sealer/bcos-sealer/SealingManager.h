@@ -20,6 +20,7 @@
 #pragma once
 #include "Common.h"
 #include "SealerConfig.h"
+#include "SealingController.h"
 #include "bcos-framework/protocol/BlockFactory.h"
 #include "bcos-framework/protocol/TransactionMetaData.h"
 #include <bcos-utilities/CallbackCollectionHandler.h>
@@ -38,7 +39,9 @@ public:
       : m_config(_config),
         m_pendingTxs(std::make_shared<TxsMetaDataQueue>()),
         m_pendingSysTxs(std::make_shared<TxsMetaDataQueue>()),
-        m_worker(std::make_shared<ThreadPool>("sealerWorker", 1))
+        m_worker(std::make_shared<ThreadPool>("sealerWorker", 1)),
+        m_controller(std::make_shared<SealingController>(
+            _config->sealingPolicy(), _config->targetBlockLatency()))
     {}
 
     virtual ~SealingManager() { stop(); }
@@ -85,6 +88,7 @@ public:
             m_startSealingNumber = _startSealingNumber;
             m_sealingNumber = _startSealingNumber;
             m_lastSealTime = utcSteadyTime();
+            m_controller->resetInflight();
             if (m_waitUntil >= m_startSealingNumber)
             {
                 SEAL_LOG(INFO) << LOG_DESC("resetSealingInfo: reset waitUntil for reseal");
@@ -100,7 +104,11 @@ public:
                        << LOG_KV("waitUntil", m_waitUntil);
     }
 
-    virtual void resetCurrentNumber(int64_t _currentNumber) { m_currentNumber = _currentNumber; }
+    virtual void resetCurrentNumber(int64_t _currentNumber)
+    {
+        m_currentNumber = _currentNumber;
+        m_controller->onBlockCommitted(_currentNumber, utcSteadyTime());
+    }
     virtual int64_t currentNumber() const { return m_currentNumber; }
     virtual void fetchTransactions();
 
@@ -111,6 +119,8 @@ public:
     }
     virtual void notifyResetProposal(bcos::protocol::Block::Ptr _block);
 
+    SealingController::Ptr controller() const { return m_controller; }
+
 protected:
     virtual void appendTransactions(
         std::shared_ptr<TxsMetaDataQueue> _txsQueue, bcos::protocol::Block::Ptr _fetchedTxs);
@@ -121,6 +131,8 @@ protected:
 
     virtual int64_t txsSizeExpectedToFetch();
     virtual size_t pendingTxsSize();
+    // the txs to seal into the next proposal, maxTxsPerBlock for the static sealing policy
+    virtual size_t targetTxsPerBlock();
 
 private:
     SealerConfig::Ptr m_config;
@@ -129,6 +141,9 @@ private:
     SharedMutex x_pendingTxs;
 
     ThreadPool::Ptr m_worker;
+    SealingController::Ptr m_controller;
+    // the sealing is held for the proposals in flight
+    std::atomic_bool m_holding = {false};
 
     std::atomic<uint64_t> m_lastSealTime = {0};
 
@@ -0,0 +1,177 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for SealingController
+ * @file SealingControllerTest.cpp
+ * @date 2022-10-19
+ */
+#include "bcos-sealer/SealingController.h"
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::sealer;
+
+namespace bcos
+{
+namespace test
+{
+// seal and commit the proposals one after another, every block takes _base + txs * _txCost ms
+uint64_t commitBlocks(SealingController& _controller, std::vector<size_t> const& _txsSizes,
+    double _base, double _txCost, int64_t _number = 1, uint64_t _now = 100000)
+{
+    for (auto txsSize : _txsSizes)
+    {
+        _controller.onProposalSealed(_number, txsSize, _now);
+        _now += (uint64_t)(_base + txsSize * _txCost);
+        _controller.onBlockCommitted(_number, _now);
+        _number++;
+        _now += 10;
+    }
+    return _now;
+}
+
+BOOST_FIXTURE_TEST_SUITE(SealingControllerTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(testStaticPolicy)
+{
+    SealingController controller(SealingPolicy::Static, 1000);
+    auto now = commitBlocks(controller, {400, 800, 1200, 1600, 2000}, 100, 0.5);
+    BOOST_CHECK_EQUAL(controller.samples(), 5);
+    // the static policy always seals the tx count limit and never holds
+    BOOST_CHECK_EQUAL(controller.targetTxsPerBlock(1000), 1000);
+    controller.onProposalSealed(100, 10000, now);
+    controller.onProposalSealed(101, 10000, now);
+    BOOST_CHECK(!controller.shouldHold(now, now + 1));
+}
+
+BOOST_AUTO_TEST_CASE(testFit)
+{
+    SealingController controller(SealingPolicy::Adaptive, 1000);
+    // seal the tx count limit before enough samples
+    auto now = commitBlocks(controller, {400, 800, 1200}, 100, 0.5);
+    BOOST_CHECK_EQUAL(controller.samples(), 3);
+    BOOST_CHECK_EQUAL(controller.targetTxsPerBlock(3000), 3000);
+
+    // blockTime = 100 + txs * 0.5
+    now = commitBlocks(controller, {1600, 2000}, 100, 0.5, 4, now);
+    BOOST_CHECK_EQUAL(controller.samples(), 5);
+    BOOST_CHECK_CLOSE(controller.txCost(), 0.5, 0.01);
+    BOOST_CHECK_CLOSE(controller.baseCost(), 100, 0.01);
+
+    // the empty blocks are not sampled
+    now = commitBlocks(controller, {0}, 100, 0.5, 6, now);
+    BOOST_CHECK_EQUAL(controller.samples(), 5);
+
+    // only the last c_sampleWindow samples are fitted
+    std::vector<size_t> txsSizes;
+    for (size_t i = 0; i < SealingController::c_sampleWindow; i++)
+    {
+        txsSizes.push_back(200 + (i % 4) * 200);
+    }
+    commitBlocks(controller, txsSizes, 50, 0.25, 7, now);
+    BOOST_CHECK_EQUAL(controller.samples(), SealingController::c_sampleWindow);
+    BOOST_CHECK_CLOSE(controller.txCost(), 0.25, 0.01);
+    BOOST_CHECK_CLOSE(controller.baseCost(), 50, 0.01);
+}
+
+BOOST_AUTO_TEST_CASE(testFitUniformBlocks)
+{
+    SealingController controller(SealingPolicy::Adaptive, 1000);
+    // the block sizes don't spread, all the time is charged to the txs
+    commitBlocks(controller, {1000, 1000, 1000, 1000}, 0, 0.5);
+    BOOST_CHECK_CLOSE(controller.txCost(), 0.5, 0.01);
+    BOOST_CHECK_EQUAL(controller.baseCost(), 0);
+    BOOST_CHECK_EQUAL(controller.targetTxsPerBlock(10000), 2000);
+}
+
+BOOST_AUTO_TEST_CASE(testCommitLatency)
+{
+    SealingController controller(SealingPolicy::Adaptive, 1000);
+    // proposal 2 is sealed before 1 commits, and occupies the pipeline after the commit of 1
+    controller.onProposalSealed(1, 1000, 1000);
+    controller.onProposalSealed(2, 1000, 1100);
+    controller.onBlockCommitted(1, 1500);
+    controller.onBlockCommitted(2, 2000);
+    // the proposals sealed before a committed one will never commit
+    controller.onProposalSealed(3, 1000, 2000);
+    controller.onProposalSealed(4, 1000, 2000);
+    controller.onBlockCommitted(4, 2500);
+    controller.onProposalSealed(5, 1000, 2500);
+    controller.onBlockCommitted(5, 3000);
+    BOOST_CHECK_EQUAL(controller.samples(), 4);
+    BOOST_CHECK_CLOSE(controller.txCost(), 0.5, 0.01);
+}
+
+BOOST_AUTO_TEST_CASE(testTarget)
+{
+    SealingController controller(SealingPolicy::Adaptive, 1000);
+    commitBlocks(controller, {400, 800, 1200, 1600}, 100, 0.5);
+    // (1000 - 100) / 0.5
+    BOOST_CHECK_EQUAL(controller.targetTxsPerBlock(10000), 1800);
+    // never more than the tx count limit
+    BOOST_CHECK_EQUAL(controller.targetTxsPerBlock(1000), 1000);
+    BOOST_CHECK_EQUAL(controller.targetTxsPerBlock(0), 0);
+
+    // never less than 1/c_minTxsDivisor of the tx count limit
+    SealingController slowController(SealingPolicy::Adaptive, 150);
+    commitBlocks(slowController, {400, 800, 1200, 1600}, 100, 0.5);
+    // (150 - 100) / 0.5 = 100
+    BOOST_CHECK_EQUAL(slowController.targetTxsPerBlock(3200), 100);
+    BOOST_CHECK_EQUAL(
+        slowController.targetTxsPerBlock(32000), 32000 / SealingController::c_minTxsDivisor);
+
+    // the base cost exceeds the target latency
+    SealingController overloadedController(SealingPolicy::Adaptive, 100);
+    commitBlocks(overloadedController, {400, 800, 1200, 1600}, 200, 0.5);
+    BOOST_CHECK_EQUAL(overloadedController.targetTxsPerBlock(3200), 100);
+}
+
+BOOST_AUTO_TEST_CASE(testHold)
+{
+    SealingController controller(SealingPolicy::Adaptive, 1000);
+    // never hold before enough samples
+    controller.onProposalSealed(1, 10000, 0);
+    controller.onProposalSealed(2, 10000, 0);
+    BOOST_CHECK(!controller.shouldHold(0, 1));
+    controller.resetInflight();
+
+    auto now = commitBlocks(controller, {400, 800, 1200, 1600}, 100, 0.5);
+    BOOST_CHECK(!controller.shouldHold(now, now + 1));
+
+    // 100 + 1000 * 0.5 = 600ms to drain
+    controller.onProposalSealed(10, 1000, now);
+    BOOST_CHECK(!controller.shouldHold(now, now + 1));
+    // 1200ms to drain
+    controller.onProposalSealed(11, 1000, now);
+    BOOST_CHECK(controller.shouldHold(now, now + 1));
+    BOOST_CHECK(controller.shouldHold(now, now + 999));
+    // hold for at most the target latency
+    BOOST_CHECK(!controller.shouldHold(now, now + 1000));
+
+    // the proposals committed no longer hold the sealing
+    controller.onBlockCommitted(10, now + 600);
+    BOOST_CHECK(!controller.shouldHold(now, now + 601));
+    controller.onProposalSealed(12, 1000, now + 601);
+    BOOST_CHECK(controller.shouldHold(now + 601, now + 602));
+
+    // the proposals in flight are dropped after viewchange
+    controller.resetInflight();
+    BOOST_CHECK(!controller.shouldHold(now + 601, now + 602));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -23,6 +23,7 @@
 #include "bcos-framework/protocol/ProtocolTypeDef.h"
 #include "bcos-framework/storage/Table.h"
 #include <bcos-utilities/Error.h>
+#include <bcos-utilities/Metrics.h>
 #include <rocksdb/cleanable.h>
 #include <rocksdb/options.h>
 #include <rocksdb/slice.h>
@@ -41,6 +42,24 @@ using namespace std;
 
 #define STORAGE_ROCKSDB_LOG(LEVEL) BCOS_LOG(LEVEL) << "[STORAGE-RocksDB]"
 
+namespace
+{
+struct StorageMetrics
+{
+    bcos::metrics::Histogram& prepareTime = bcos::metrics::MetricsRegistry::instance().histogram(
+        "bcos_storage_prepare_seconds", "The time to prepare the write batch of a block");
+    bcos::metrics::Histogram& commitTime = bcos::metrics::MetricsRegistry::instance().histogram(
+        "bcos_storage_commit_seconds", "The time to write the batch of a block into rocksdb");
+    bcos::metrics::Counter& writtenEntries = bcos::metrics::MetricsRegistry::instance().counter(
+        "bcos_storage_written_entries_total", "The entries written or deleted in rocksdb");
+};
+StorageMetrics& storageMetrics()
+{
+    static StorageMetrics storageMetrics;
+    return storageMetrics;
+}
+}  // namespace
+
 RocksDBStorage::RocksDBStorage(std::unique_ptr<rocksdb::DB, std::function<void(rocksdb::DB*)>>&& db,
     const bcos::security::DataEncryptInterface::Ptr dataEncryption)
   : m_db(std::move(db)), m_dataEncryption(dataEncryption)
@@ -307,6 +326,8 @@ void RocksDBStorage::asyncPrepare(const TwoPCParams& param, const TraverseStorag
     {
         STORAGE_ROCKSDB_LOG(INFO) << LOG_DESC("asyncPrepare") << LOG_KV("number", param.number);
         auto start = utcTime();
+        std::optional<bcos::metrics::ScopedTimer> timer(
+            std::in_place, storageMetrics().prepareTime);
         {
             tbb::spin_mutex::scoped_lock lock(m_writeBatchMutex);
             if (!m_writeBatch)
@@ -370,6 +391,7 @@ void RocksDBStorage::asyncPrepare(const TwoPCParams& param, const TraverseStorag
             callback(BCOS_ERROR_UNIQUE_PTR(TableNotExists, "empty tableName or key"), 0);
             return;
         }
+        timer.reset();
         auto end = utcTime();
         callback(nullptr, 0);
         STORAGE_ROCKSDB_LOG(INFO) << LOG_DESC("asyncPrepare") << LOG_KV("number", param.number)
@@ -391,6 +413,7 @@ void RocksDBStorage::asyncCommit(
     auto start = utcTime();
     std::ignore = params;
     {
+        bcos::metrics::ScopedTimer timer(storageMetrics().commitTime);
         tbb::spin_mutex::scoped_lock lock(m_writeBatchMutex);
         if (m_writeBatch)
         {
@@ -409,6 +432,7 @@ void RocksDBStorage::asyncCommit(
                 return;
             }
             m_writeBatch = nullptr;
+            storageMetrics().writtenEntries.inc(count);
         }
     }
     auto end = utcTime();
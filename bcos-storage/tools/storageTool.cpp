@@ -108,6 +108,7 @@ std::shared_ptr<std::set<std::string, std::less<>>> getKeyPageIgnoreTables()
             std::string(ledger::SYS_NUMBER_2_TXS),
             std::string(ledger::SYS_HASH_2_TX),
             std::string(ledger::SYS_HASH_2_RECEIPT),
+            std::string(ledger::SYS_HASH_2_LOCATION),
             std::string(ledger::FS_ROOT),
             std::string(ledger::FS_APPS),
             std::string(ledger::FS_USER),
@@ -503,6 +504,7 @@ int main(int argc, const char* argv[])
 
         // calculate receipts data size
         getTableSize(db, ledger::SYS_HASH_2_RECEIPT);
+        getTableSize(db, ledger::SYS_HASH_2_LOCATION);
     }
     else if (params.count("stateSize") || params.count("S"))
     {  // calculate contract data size
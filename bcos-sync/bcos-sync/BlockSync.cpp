@@ -42,6 +42,8 @@ BlockSync::BlockSync(BlockSyncConfig::Ptr _config, unsigned _idleWaitMs)
     m_downloadingTimer->registerTimeoutHandler(boost::bind(&BlockSync::onDownloadTimeout, this));
     m_downloadingQueue->registerNewBlockHandler(
         boost::bind(&BlockSync::onNewBlock, this, boost::placeholders::_1));
+    // apply the block once its txs are recovered
+    m_downloadingQueue->registerVerifiedHandler([this]() { m_signalled.notify_all(); });
     initSendResponseHandler();
 }
 
@@ -410,6 +412,7 @@ void BlockSync::onPeerBlocks(NodeIDPtr _nodeID, BlockSyncMsgInterface::Ptr _sync
     BLKSYNC_LOG(DEBUG) << LOG_BADGE("Download") << LOG_BADGE("BlockSync")
                        << LOG_DESC("Receive peer block packet")
                        << LOG_KV("peer", _nodeID->shortHex());
+    onBlocksReceived(_nodeID, blockMsg);
     m_downloadingQueue->push(blockMsg);
     m_signalled.notify_all();
 }
@@ -453,12 +456,84 @@ void BlockSync::onDownloadTimeout()
     // stop the timer and reset the state to idle
     m_downloadingTimer->stop();
     m_state = SyncState::Idle;
+    clearBlockRequests(true);
 }
 
 void BlockSync::downloadFinish()
 {
     m_downloadingTimer->stop();
     m_state = SyncState::Idle;
+    clearBlockRequests(false);
+}
+
+void BlockSync::onBlocksRequested(NodeIDPtr _peer, BlockNumber _from, BlockNumber _to)
+{
+    std::lock_guard<std::mutex> l(x_blockRequests);
+    m_blockRequests[_from] = BlockRequestRecord{_peer, _to, utcTime()};
+}
+
+void BlockSync::onBlocksReceived(NodeIDPtr _peer, BlocksMsgInterface::Ptr _blocksMsg)
+{
+    uint64_t bytes = 0;
+    for (size_t i = 0; i < _blocksMsg->blocksSize(); i++)
+    {
+        bytes += _blocksMsg->blockData(i).size();
+    }
+    if (_blocksMsg->blocksSize() > 0)
+    {
+        auto blockBytes = bytes / _blocksMsg->blocksSize();
+        auto average = m_averageBlockBytes.load();
+        m_averageBlockBytes = (average == 0) ? blockBytes : (average * 7 + blockBytes) / 8;
+    }
+
+    std::lock_guard<std::mutex> l(x_blockRequests);
+    // the request covering the block: from <= number <= to
+    auto it = m_blockRequests.upper_bound(_blocksMsg->number());
+    if (it == m_blockRequests.begin())
+    {
+        return;
+    }
+    --it;
+    auto& record = it->second;
+    if (_blocksMsg->number() > record.to || !(record.peer->data() == _peer->data()))
+    {
+        return;
+    }
+    auto elapsed = utcTime() - record.sendTime;
+    auto const& peerScores = m_config->peerScores();
+    if (record.receivedBlocks == 0)
+    {
+        peerScores->onResponse(_peer, elapsed);
+    }
+    record.receivedBlocks += _blocksMsg->blocksSize();
+    record.receivedBytes += bytes;
+    if (record.receivedBlocks >= (record.to - it->first + 1))
+    {
+        peerScores->onTransfer(_peer, record.receivedBytes, elapsed);
+        m_blockRequests.erase(it);
+    }
+}
+
+void BlockSync::clearBlockRequests(bool _timeout)
+{
+    std::lock_guard<std::mutex> l(x_blockRequests);
+    if (_timeout)
+    {
+        auto now = utcTime();
+        auto const& peerScores = m_config->peerScores();
+        for (auto const& it : m_blockRequests)
+        {
+            auto const& record = it.second;
+            if (record.receivedBlocks == 0)
+            {
+                peerScores->onFailure(record.peer);
+                continue;
+            }
+            // the peer responds, but too slow to complete the request in time
+            peerScores->onTransfer(record.peer, record.receivedBytes, now - record.sendTime);
+        }
+    }
+    m_blockRequests.clear();
 }
 
 void BlockSync::tryToRequestBlocks()
@@ -510,11 +585,13 @@ void BlockSync::requestBlocks(BlockNumber _from, BlockNumber _to)
     auto blockSizePerShard = m_config->maxRequestBlocks();
     auto shardNumber = (_to - _from + blockSizePerShard - 1) / blockSizePerShard;
     size_t shard = 0;
+    // request the peers expected to respond a shard sooner first
+    uint64_t requestBytes = m_averageBlockBytes * blockSizePerShard;
     // at most request `maxShardPerPeer` shards every time
     for (size_t loop = 0; loop < m_config->maxShardPerPeer() && shard < shardNumber; loop++)
     {
         bool findPeer = false;
-        m_syncStatus->foreachPeerRandom([&](PeerStatus::Ptr _p) {
+        m_syncStatus->foreachPeerByScore(requestBytes, [&](PeerStatus::Ptr _p) {
             if (_p->number() < m_config->knownHighestNumber())
             {
                 // Only send request to nodes which are not syncing(has max number)
@@ -533,6 +610,7 @@ void BlockSync::requestBlocks(BlockNumber _from, BlockNumber _to)
             blockRequest->setNumber(from);
             blockRequest->setSize(to - from + 1);
             auto encodedData = blockRequest->encode();
+            onBlocksRequested(_p->nodeId(), from, to);
             m_config->frontService()->asyncSendMessageByNodeID(
                 ModuleID::BlockSync, _p->nodeId(), ref(*encodedData), 0, nullptr);
 
@@ -615,6 +693,11 @@ void BlockSync::maintainDownloadingQueue()
         {
             return;
         }
+        // wait for the verify pipeline to recover the txs of the block
+        if (!m_downloadingQueue->readyToApply(block))
+        {
+            return;
+        }
         m_downloadingQueue->pop();
         auto blockHeader = block->blockHeader();
         auto header = block->blockHeader();
@@ -818,6 +901,13 @@ void BlockSync::asyncGetSyncInfo(std::function<void(Error::Ptr, std::string)> _o
         info["genesisHash"] = *toHexString(_p->genesisHash());
         info["blockNumber"] = Json::UInt64(_p->number());
         info["latestHash"] = *toHexString(_p->hash());
+        auto score = m_config->peerScores()->score(_p->nodeId());
+        if (score)
+        {
+            info["rtt"] = score->rtt;
+            info["throughput"] = score->throughput;
+            info["failureRate"] = score->failureRate;
+        }
         peersInfo.append(info);
         return true;
     });
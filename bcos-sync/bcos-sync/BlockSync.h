@@ -114,6 +114,12 @@ protected:
         bcos::protocol::BlockNumber _number);
     void printSyncInfo();
 
+    // measure the peers on the block requests and their responses
+    void onBlocksRequested(bcos::crypto::NodeIDPtr _peer, bcos::protocol::BlockNumber _from,
+        bcos::protocol::BlockNumber _to);
+    void onBlocksReceived(bcos::crypto::NodeIDPtr _peer, BlocksMsgInterface::Ptr _blocksMsg);
+    void clearBlockRequests(bool _timeout);
+
 protected:
     BlockSyncConfig::Ptr m_config;
     SyncPeerStatus::Ptr m_syncStatus;
@@ -137,6 +143,20 @@ protected:
     bcos::protocol::BlockNumber c_FaultyNodeBlockDelta = 50;
 
     std::atomic_bool m_masterNode = {false};
+
+    struct BlockRequestRecord
+    {
+        bcos::crypto::NodeIDPtr peer;
+        bcos::protocol::BlockNumber to;
+        uint64_t sendTime;
+        bcos::protocol::BlockNumber receivedBlocks = 0;
+        uint64_t receivedBytes = 0;
+    };
+    // the block requests waiting for the response, keyed by the first block number requested
+    std::map<bcos::protocol::BlockNumber, BlockRequestRecord> m_blockRequests;
+    std::mutex x_blockRequests;
+    // the moving average of the encoded block size, to estimate the bytes of a block request
+    std::atomic<uint64_t> m_averageBlockBytes = {0};
 };
 }  // namespace sync
 }  // namespace bcos
\ No newline at end of file
@@ -26,6 +26,19 @@ using namespace bcos::crypto;
 using namespace bcos::protocol;
 using namespace bcos::ledger;
 
+namespace
+{
+bool sameConsensusNodes(bcos::consensus::ConsensusNodeList const& _first,
+    bcos::consensus::ConsensusNodeList const& _second)
+{
+    return std::equal(_first.begin(), _first.end(), _second.begin(), _second.end(),
+        [](auto const& _firstNode, auto const& _secondNode) {
+            return _firstNode->nodeID()->data() == _secondNode->nodeID()->data() &&
+                   _firstNode->weight() == _secondNode->weight();
+        });
+}
+}  // namespace
+
 void BlockSyncConfig::resetConfig(LedgerConfig::Ptr _ledgerConfig)
 {
     if (_ledgerConfig->blockNumber() <= m_blockNumber && m_blockNumber > 0)
@@ -53,7 +66,15 @@ void BlockSyncConfig::resetConfig(LedgerConfig::Ptr _ledgerConfig)
         return;
     }
     resetBlockInfo(_ledgerConfig->blockNumber(), _ledgerConfig->hash());
+    auto consensusChanged =
+        !sameConsensusNodes(consensusNodeList(), _ledgerConfig->consensusNodeList());
     setConsensusNodeList(_ledgerConfig->consensusNodeList());
+    // Note: increase the epoch after the consensus module has been reset, so the checks of the
+    // new epoch use the new consensus node list
+    if (consensusChanged)
+    {
+        ++m_consensusEpoch;
+    }
     setObserverList(_ledgerConfig->observerNodeList());
     auto type = determineNodeType();
     if (type != m_nodeType)
@@ -91,6 +91,14 @@ public:
 
     size_t downloadTimeout() const { return m_downloadTimeout; }
 
+    // the downloaded blocks verified ahead of the execution and commit, 0 means verifying the
+    // blocks one by one before commit
+    size_t verifyDepth() const { return m_verifyDepth; }
+    void setVerifyDepth(size_t _verifyDepth) { m_verifyDepth = _verifyDepth; }
+
+    // increased when the consensus node list changes, the block checks before it are out of date
+    uint64_t consensusEpoch() const { return m_consensusEpoch; }
+
     size_t maxRequestBlocks() const { return m_maxRequestBlocks; }
     size_t maxShardPerPeer() const { return m_maxShardPerPeer; }
 
@@ -171,6 +179,9 @@ private:
 
     std::atomic<size_t> m_maxShardPerPeer = {2};
 
+    std::atomic<size_t> m_verifyDepth = {8};
+    std::atomic<uint64_t> m_consensusEpoch = {0};
+
     std::atomic<bcos::protocol::BlockNumber> m_committedProposalNumber = {0};
 
     // TODO: ensure thread-safe
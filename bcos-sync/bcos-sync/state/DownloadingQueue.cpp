@@ -21,6 +21,7 @@
 #include "DownloadingQueue.h"
 #include "bcos-sync/utilities/Common.h"
 #include <bcos-framework/dispatcher/SchedulerTypeDef.h>
+#include <bcos-utilities/Metrics.h>
 #include <future>
 
 using namespace std;
@@ -29,6 +30,43 @@ using namespace bcos::protocol;
 using namespace bcos::sync;
 using namespace bcos::ledger;
 
+namespace
+{
+struct SyncMetrics
+{
+    static metrics::Histogram& stageTime(std::string const& _stage)
+    {
+        return metrics::MetricsRegistry::instance().histogram("bcos_sync_stage_seconds",
+            "The time spent in each stage of the downloaded blocks", "stage=\"" + _stage + "\"");
+    }
+
+    metrics::Histogram& decodeTime = stageTime("decode");
+    metrics::Histogram& recoverTime = stageTime("recover");
+    metrics::Histogram& checkTime = stageTime("check");
+    metrics::Histogram& executeTime = stageTime("execute");
+    metrics::Histogram& storeTxsTime = stageTime("storeTxs");
+    metrics::Histogram& commitTime = stageTime("commit");
+    metrics::Counter& precheckedBlocks = metrics::MetricsRegistry::instance().counter(
+        "bcos_sync_prechecked_blocks_total", "The blocks committed with the header checked ahead");
+    metrics::Counter& checkedBlocks = metrics::MetricsRegistry::instance().counter(
+        "bcos_sync_checked_blocks_total", "The blocks whose header is checked before commit");
+    metrics::Counter& invalidBlocks = metrics::MetricsRegistry::instance().counter(
+        "bcos_sync_invalid_blocks_total", "The downloaded blocks with invalid txs");
+};
+SyncMetrics& syncMetrics()
+{
+    static SyncMetrics syncMetrics;
+    return syncMetrics;
+}
+
+uint64_t elapsedMicroseconds(std::chrono::steady_clock::time_point _start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - _start)
+        .count();
+}
+}  // namespace
+
 void DownloadingQueue::push(BlocksMsgInterface::Ptr _blocksData)
 {
     // push to the blockBuffer firstly
@@ -93,63 +131,82 @@ void DownloadingQueue::clear()
 
 void DownloadingQueue::clearQueue()
 {
-    WriteGuard l(x_blocks);
-    BlockQueue emptyQueue;
-    swap(m_blocks, emptyQueue);  // Does memory leak here ?
+    {
+        WriteGuard l(x_blocks);
+        BlockQueue emptyQueue;
+        swap(m_blocks, emptyQueue);  // Does memory leak here ?
+    }
+    clearVerifyingBlocks(false);
 }
 
 void DownloadingQueue::flushBufferToQueue()
 {
-    WriteGuard l(x_blockBuffer);
-    bool ret = true;
-    while (m_blockBuffer->size() > 0 && ret)
     {
-        auto blocksShard = m_blockBuffer->front();
-        m_blockBuffer->pop_front();
-        ret = flushOneShard(blocksShard);
+        WriteGuard l(x_blockBuffer);
+        bool ret = true;
+        while (m_blockBuffer->size() > 0 && ret)
+        {
+            auto blocksShard = m_blockBuffer->front();
+            m_blockBuffer->pop_front();
+            ret = flushOneShard(blocksShard);
+        }
     }
+    preVerifyBlocks();
 }
 
 bool DownloadingQueue::flushOneShard(BlocksMsgInterface::Ptr _blocksData)
 {
-    // pop buffer into queue
-    WriteGuard l(x_blocks);
-    if (m_blocks.size() >= m_config->maxDownloadingBlockQueueSize())
     {
-        BLKSYNC_LOG(DEBUG) << LOG_BADGE("Download") << LOG_BADGE("BlockSync")
-                           << LOG_DESC("DownloadingBlockQueueBuffer is full")
-                           << LOG_KV("queueSize", m_blocks.size());
+        ReadGuard l(x_blocks);
+        if (m_blocks.size() >= m_config->maxDownloadingBlockQueueSize())
+        {
+            BLKSYNC_LOG(DEBUG) << LOG_BADGE("Download") << LOG_BADGE("BlockSync")
+                               << LOG_DESC("DownloadingBlockQueueBuffer is full")
+                               << LOG_KV("queueSize", m_blocks.size());
 
-        return false;
+            return false;
+        }
     }
     BLKSYNC_LOG(TRACE) << LOG_BADGE("Download") << LOG_BADGE("BlockSync")
                        << LOG_DESC("Decoding block buffer")
                        << LOG_KV("blocksShardSize", _blocksData->blocksSize());
     size_t blocksSize = _blocksData->blocksSize();
-    for (size_t i = 0; i < blocksSize; i++)
-    {
-        try
-        {
-            auto block =
-                m_config->blockFactory()->createBlock(_blocksData->blockData(i), true, true);
-            auto blockHeader = block->blockHeader();
-            if (isNewerBlock(block))
+    // decode the blocks of the shard in parallel without holding the queue
+    Blocks blocks(blocksSize);
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, blocksSize), [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i < range.end(); ++i)
             {
-                m_blocks.push(block);
-                BLKSYNC_LOG(DEBUG) << LOG_BADGE("Download") << LOG_BADGE("BlockSync")
-                                   << LOG_DESC("Flush block to the queue")
-                                   << LOG_KV("number", blockHeader->number())
-                                   << LOG_KV("nodeId", m_config->nodeID()->shortHex());
+                try
+                {
+                    metrics::ScopedTimer timer(syncMetrics().decodeTime);
+                    blocks[i] = m_config->blockFactory()->createBlock(
+                        _blocksData->blockData(i), true, true);
+                }
+                catch (std::exception const& e)
+                {
+                    BLKSYNC_LOG(WARNING)
+                        << LOG_BADGE("Download") << LOG_BADGE("BlockSync")
+                        << LOG_DESC("Invalid block data")
+                        << LOG_KV("reason", boost::diagnostic_information(e))
+                        << LOG_KV("blockDataSize", _blocksData->blockData(i).size());
+                }
             }
-        }
-        catch (std::exception const& e)
+        });
+    // pop buffer into queue
+    WriteGuard l(x_blocks);
+    for (auto const& block : blocks)
+    {
+        // ignore the invalid, expired and duplicated blocks
+        if (!block || !isNewerBlock(block) || !addVerifyingBlock(block))
         {
-            BLKSYNC_LOG(WARNING) << LOG_BADGE("Download") << LOG_BADGE("BlockSync")
-                                 << LOG_DESC("Invalid block data")
-                                 << LOG_KV("reason", boost::diagnostic_information(e))
-                                 << LOG_KV("blockDataSize", _blocksData->blockData(i).size());
             continue;
         }
+        m_blocks.push(block);
+        BLKSYNC_LOG(DEBUG) << LOG_BADGE("Download") << LOG_BADGE("BlockSync")
+                           << LOG_DESC("Flush block to the queue")
+                           << LOG_KV("number", block->blockHeader()->number())
+                           << LOG_KV("nodeId", m_config->nodeID()->shortHex());
     }
     if (m_blocks.size() == 0)
     {
@@ -281,6 +338,7 @@ void DownloadingQueue::applyBlock(Block::Ptr _block)
     m_config->scheduler()->executeBlock(_block, true,
         [self, startT, _block](
             Error::Ptr&& _error, protocol::BlockHeader::Ptr&& _blockHeader, bool _sysBlock) {
+            syncMetrics().executeTime.observe((utcTime() - startT) * 1000);
             auto orgBlockHeader = _block->blockHeader();
             try
             {
@@ -404,8 +462,41 @@ bool DownloadingQueue::checkAndCommitBlock(bcos::protocol::Block::Ptr _block)
                       << LOG_KV("hash", blockHeader->hash().abridged());
 
     auto self = std::weak_ptr<DownloadingQueue>(shared_from_this());
-    m_config->consensus()->asyncCheckBlock(_block, [self, _block, blockHeader](
+    bool checked = false;
+    {
+        Guard l(x_verifyingBlocks);
+        auto verifying = verifyingBlockNoLock(_block);
+        if (verifying && verifying->stage == VerifyStage::CHECKING)
+        {
+            // commit the block after the pending header check
+            verifying->onChecked = [self, _block]() {
+                auto downloadQueue = self.lock();
+                if (downloadQueue)
+                {
+                    downloadQueue->checkAndCommitBlock(_block);
+                }
+            };
+            return true;
+        }
+        // Note: the check is out of date if the consensus node list changed after it
+        checked = verifying && verifying->stage == VerifyStage::CHECKED &&
+                  verifying->epoch == m_config->consensusEpoch() &&
+                  blockHeader->number() > m_config->committedProposalNumber();
+    }
+    if (checked)
+    {
+        syncMetrics().precheckedBlocks.inc();
+        BLKSYNC_LOG(INFO) << LOG_DESC("the header has been checked ahead, commit the block")
+                          << LOG_KV("blockNumber", blockHeader->number())
+                          << LOG_KV("hash", blockHeader->hash().abridged());
+        commitBlock(_block);
+        return true;
+    }
+    syncMetrics().checkedBlocks.inc();
+    auto checkStartT = std::chrono::steady_clock::now();
+    m_config->consensus()->asyncCheckBlock(_block, [self, _block, blockHeader, checkStartT](
                                                        Error::Ptr _error, bool _ret) {
+        syncMetrics().checkTime.observe(elapsedMicroseconds(checkStartT));
         try
         {
             auto downloadQueue = self.lock();
@@ -518,6 +609,7 @@ void DownloadingQueue::commitBlock(bcos::protocol::Block::Ptr _block)
     auto self = std::weak_ptr<DownloadingQueue>(shared_from_this());
     m_config->ledger()->asyncStoreTransactions(
         txsData, txsHashList, [self, startT, _block, blockHeader](Error::Ptr _error) {
+            syncMetrics().storeTxsTime.observe((utcTime() - startT) * 1000);
             try
             {
                 auto downloadingQueue = self.lock();
@@ -560,6 +652,7 @@ void DownloadingQueue::commitBlockState(bcos::protocol::Block::Ptr _block)
     m_config->scheduler()->commitBlock(blockHeader, [self, startT, _block, blockHeader](
                                                         Error::Ptr&& _error,
                                                         LedgerConfig::Ptr&& _ledgerConfig) {
+        syncMetrics().commitTime.observe((utcTime() - startT) * 1000);
         try
         {
             auto downloadingQueue = self.lock();
@@ -623,12 +716,15 @@ void DownloadingQueue::finalizeBlock(bcos::protocol::Block::Ptr, LedgerConfig::P
     }
     // try to commit the next block
     tryToCommitBlockToLedger();
+    // verify the blocks entering the window
+    preVerifyBlocks();
 }
 
 void DownloadingQueue::clearExpiredQueueCache()
 {
     clearExpiredCache(m_blocks, x_blocks);
     clearExpiredCache(m_commitQueue, x_commitQueue);
+    clearVerifyingBlocks(true);
 }
 
 void DownloadingQueue::clearExpiredCache(BlockQueue& _queue, SharedMutex& _lock)
@@ -757,4 +853,237 @@ void DownloadingQueue::fetchAndUpdatesLedgerConfig()
         BLKSYNC_LOG(WARNING) << LOG_DESC("fetchAndUpdatesLedgerConfig exception")
                              << LOG_KV("msg", boost::diagnostic_information(e));
     }
-}
\ No newline at end of file
+}
+
+bool DownloadingQueue::addVerifyingBlock(Block::Ptr _block)
+{
+    if (m_config->verifyDepth() == 0)
+    {
+        return true;
+    }
+    auto blockHeader = _block->blockHeader();
+    Guard l(x_verifyingBlocks);
+    auto [it, inserted] = m_verifyingBlocks.try_emplace(
+        std::make_pair(blockHeader->number(), blockHeader->hash()), nullptr);
+    // the same block downloaded from other peers
+    if (!inserted && it->second->stage != VerifyStage::INVALID)
+    {
+        return false;
+    }
+    it->second = std::make_shared<VerifyingBlock>(_block);
+    return true;
+}
+
+void DownloadingQueue::clearVerifyingBlocks(bool _onlyExpired)
+{
+    Guard l(x_verifyingBlocks);
+    if (!_onlyExpired)
+    {
+        m_verifyingBlocks.clear();
+        return;
+    }
+    auto blockNumber = m_config->blockNumber();
+    while (!m_verifyingBlocks.empty() && m_verifyingBlocks.begin()->first.first <= blockNumber)
+    {
+        m_verifyingBlocks.erase(m_verifyingBlocks.begin());
+    }
+}
+
+DownloadingQueue::VerifyingBlock::Ptr DownloadingQueue::verifyingBlockNoLock(Block::Ptr _block)
+{
+    auto blockHeader = _block->blockHeader();
+    auto it = m_verifyingBlocks.find(std::make_pair(blockHeader->number(), blockHeader->hash()));
+    if (it == m_verifyingBlocks.end() || it->second->block != _block)
+    {
+        return nullptr;
+    }
+    return it->second;
+}
+
+void DownloadingQueue::preVerifyBlocks()
+{
+    auto verifyDepth = m_config->verifyDepth();
+    if (verifyDepth == 0)
+    {
+        return;
+    }
+    auto maxNumber = m_config->blockNumber() + (BlockNumber)verifyDepth;
+    std::vector<VerifyingBlock::Ptr> verifyingBlocks;
+    {
+        Guard l(x_verifyingBlocks);
+        for (auto const& [key, verifying] : m_verifyingBlocks)
+        {
+            if (key.first > maxNumber)
+            {
+                break;
+            }
+            if (verifying->stage == VerifyStage::QUEUED)
+            {
+                verifying->stage = VerifyStage::RECOVERING;
+                verifyingBlocks.emplace_back(verifying);
+            }
+        }
+    }
+    for (auto const& verifying : verifyingBlocks)
+    {
+        preVerifyBlock(verifying);
+    }
+}
+
+bool DownloadingQueue::readyToApply(Block::Ptr _block)
+{
+    VerifyingBlock::Ptr verifying;
+    {
+        Guard l(x_verifyingBlocks);
+        verifying = verifyingBlockNoLock(_block);
+        if (!verifying)
+        {
+            return true;
+        }
+        if (verifying->stage == VerifyStage::RECOVERING ||
+            verifying->stage == VerifyStage::INVALID)
+        {
+            return false;
+        }
+        if (verifying->stage != VerifyStage::QUEUED)
+        {
+            return true;
+        }
+        // the block is beyond the window, verify it now
+        verifying->stage = VerifyStage::RECOVERING;
+    }
+    preVerifyBlock(verifying);
+    return false;
+}
+
+void DownloadingQueue::preVerifyBlock(VerifyingBlock::Ptr _verifying)
+{
+    auto self = std::weak_ptr<DownloadingQueue>(shared_from_this());
+    m_verifier->enqueue([self, _verifying]() {
+        auto downloadQueue = self.lock();
+        if (!downloadQueue)
+        {
+            return;
+        }
+        auto block = _verifying->block;
+        // Note: get the epoch before the check, the check may use a newer consensus node list
+        auto epoch = downloadQueue->m_config->consensusEpoch();
+        try
+        {
+            if (!downloadQueue->recoverBlock(block))
+            {
+                downloadQueue->removeInvalidBlock(_verifying);
+                return;
+            }
+            {
+                Guard l(downloadQueue->x_verifyingBlocks);
+                _verifying->stage = VerifyStage::CHECKING;
+            }
+            if (downloadQueue->m_verifiedHandler)
+            {
+                downloadQueue->m_verifiedHandler();
+            }
+            auto checkStartT = std::chrono::steady_clock::now();
+            downloadQueue->m_config->consensus()->asyncCheckBlock(
+                block, [self, _verifying, epoch, checkStartT](Error::Ptr _error, bool _ret) {
+                    syncMetrics().checkTime.observe(elapsedMicroseconds(checkStartT));
+                    auto downloadQueue = self.lock();
+                    if (downloadQueue)
+                    {
+                        downloadQueue->onHeaderChecked(_verifying, epoch, !_error && _ret);
+                    }
+                });
+        }
+        catch (std::exception const& e)
+        {
+            BLKSYNC_LOG(WARNING) << LOG_DESC("preVerifyBlock exception")
+                                 << LOG_KV("number", block->blockHeader()->number())
+                                 << LOG_KV("error", boost::diagnostic_information(e));
+            // apply the block and check it before commit
+            downloadQueue->onHeaderChecked(_verifying, epoch, false);
+            if (downloadQueue->m_verifiedHandler)
+            {
+                downloadQueue->m_verifiedHandler();
+            }
+        }
+    });
+}
+
+bool DownloadingQueue::recoverBlock(Block::Ptr _block)
+{
+    metrics::ScopedTimer timer(syncMetrics().recoverTime);
+    auto blockHeader = _block->blockHeader();
+    auto txsSize = _block->transactionsSize();
+    if (txsSize == 0)
+    {
+        return true;
+    }
+    try
+    {
+        // Note: recover the senders by the signatures instead of trusting the downloaded senders
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, txsSize), [&](const tbb::blocked_range<size_t>& range) {
+                for (size_t i = range.begin(); i < range.end(); ++i)
+                {
+                    auto tx = _block->transaction(i);
+                    tx->forceSender(bytes());
+                    tx->verify();
+                }
+            });
+    }
+    catch (std::exception const& e)
+    {
+        syncMetrics().invalidBlocks.inc();
+        BLKSYNC_LOG(WARNING) << LOG_DESC("recoverBlock: invalid transaction")
+                             << LOG_KV("number", blockHeader->number())
+                             << LOG_KV("hash", blockHeader->hash().abridged())
+                             << LOG_KV("error", boost::diagnostic_information(e));
+        return false;
+    }
+    if (_block->calculateTransactionRoot() != blockHeader->txsRoot())
+    {
+        syncMetrics().invalidBlocks.inc();
+        BLKSYNC_LOG(WARNING) << LOG_DESC("recoverBlock: inconsistent txsRoot")
+                             << LOG_KV("number", blockHeader->number())
+                             << LOG_KV("hash", blockHeader->hash().abridged())
+                             << LOG_KV("txsRoot", blockHeader->txsRoot().abridged());
+        return false;
+    }
+    return true;
+}
+
+void DownloadingQueue::onHeaderChecked(VerifyingBlock::Ptr _verifying, uint64_t _epoch, bool _ret)
+{
+    std::function<void()> onChecked;
+    {
+        Guard l(x_verifyingBlocks);
+        _verifying->stage = _ret ? VerifyStage::CHECKED : VerifyStage::UNCHECKED;
+        _verifying->epoch = _epoch;
+        std::swap(onChecked, _verifying->onChecked);
+    }
+    if (onChecked)
+    {
+        onChecked();
+    }
+}
+
+void DownloadingQueue::removeInvalidBlock(VerifyingBlock::Ptr _verifying)
+{
+    {
+        // the valid block with the same hash can be downloaded again
+        Guard l(x_verifyingBlocks);
+        _verifying->stage = VerifyStage::INVALID;
+    }
+    // Note: this operation is low performance and low frequency
+    WriteGuard l(x_blocks);
+    BlockQueue blocks;
+    while (!m_blocks.empty())
+    {
+        if (m_blocks.top() != _verifying->block)
+        {
+            blocks.push(m_blocks.top());
+        }
+        m_blocks.pop();
+    }
+    swap(m_blocks, blocks);
+}
@@ -23,6 +23,8 @@
 #include "bcos-sync/interfaces/BlocksMsgInterface.h"
 #include <bcos-framework/protocol/Block.h>
 #include <bcos-tool/LedgerConfigFetcher.h>
+#include <bcos-utilities/ThreadPool.h>
+#include <map>
 #include <queue>
 namespace bcos
 {
@@ -51,8 +53,9 @@ public:
       : m_config(_config), m_blockBuffer(std::make_shared<BlocksMessageQueue>())
     {
         m_ledgerFetcher = std::make_shared<bcos::tool::LedgerConfigFetcher>(m_config->ledger());
+        m_verifier = std::make_shared<ThreadPool>("syncVerifier", TaskClass::SYNC);
     }
-    virtual ~DownloadingQueue() {}
+    virtual ~DownloadingQueue() { m_verifier->stop(); }
 
     virtual void push(BlocksMsgInterface::Ptr _blocksData);
     // Is the queue empty?
@@ -70,6 +73,8 @@ public:
     virtual void clearFullQueueIfNotHas(bcos::protocol::BlockNumber _blockNumber);
 
     virtual void applyBlock(bcos::protocol::Block::Ptr _block);
+    // the txs of the block have been recovered by the verify pipeline, the block can be applied
+    virtual bool readyToApply(bcos::protocol::Block::Ptr _block);
     // clear queue and buffer
     virtual void clear();
 
@@ -79,6 +84,12 @@ public:
         m_newBlockHandler = _newBlockHandler;
     }
 
+    // called when a block is ready to apply
+    virtual void registerVerifiedHandler(std::function<void()> _verifiedHandler)
+    {
+        m_verifiedHandler = _verifiedHandler;
+    }
+
     // flush m_buffer into queue
     virtual void flushBufferToQueue();
     virtual void clearExpiredQueueCache();
@@ -109,6 +120,50 @@ protected:
     virtual bool verifyExecutedBlock(
         bcos::protocol::Block::Ptr _block, bcos::protocol::BlockHeader::Ptr _blockHeader);
 
+    // The verify pipeline: the blocks of the next verifyDepth numbers are verified on the verifier
+    // pool while the current block executes and commits:
+    // 1. recover the senders of the txs and check the txs root
+    // 2. check the sealer list and the signature list of the header by the consensus
+    // The blocks are applied after the first stage, and committed without checking again if the
+    // header check passed with the current consensus node list.
+    virtual void preVerifyBlocks();
+    virtual bool addVerifyingBlock(bcos::protocol::Block::Ptr _block);
+    virtual void clearVerifyingBlocks(bool _onlyExpired);
+
+private:
+    enum class VerifyStage : int
+    {
+        QUEUED = 0,
+        RECOVERING,
+        CHECKING,
+        CHECKED,
+        // the header check failed, check it again before commit in case of the stale config
+        UNCHECKED,
+        // the txs are invalid, the block has been removed
+        INVALID,
+    };
+    struct VerifyingBlock
+    {
+        using Ptr = std::shared_ptr<VerifyingBlock>;
+        explicit VerifyingBlock(bcos::protocol::Block::Ptr _block) : block(std::move(_block)) {}
+
+        bcos::protocol::Block::Ptr block;
+        VerifyStage stage = VerifyStage::QUEUED;
+        // the consensus epoch of the header check
+        uint64_t epoch = 0;
+        // continue to commit the block after the header check
+        std::function<void()> onChecked;
+    };
+    using VerifyingBlocks =
+        std::map<std::pair<bcos::protocol::BlockNumber, bcos::crypto::HashType>,
+            VerifyingBlock::Ptr>;
+
+    void preVerifyBlock(VerifyingBlock::Ptr _verifying);
+    bool recoverBlock(bcos::protocol::Block::Ptr _block);
+    void onHeaderChecked(VerifyingBlock::Ptr _verifying, uint64_t _epoch, bool _ret);
+    VerifyingBlock::Ptr verifyingBlockNoLock(bcos::protocol::Block::Ptr _block);
+    void removeInvalidBlock(VerifyingBlock::Ptr _verifying);
+
 private:
     // Note: this function should not be called frequently
     std::string printBlockHeader(bcos::protocol::BlockHeader::Ptr _header);
@@ -126,6 +181,11 @@ private:
     mutable SharedMutex x_commitQueue;
 
     std::function<void(bcos::ledger::LedgerConfig::Ptr)> m_newBlockHandler;
+    std::function<void()> m_verifiedHandler;
+
+    VerifyingBlocks m_verifyingBlocks;
+    mutable Mutex x_verifyingBlocks;
+    ThreadPool::Ptr m_verifier;
 
     std::shared_ptr<bcos::tool::LedgerConfigFetcher> m_ledgerFetcher;
 };
@@ -164,17 +164,30 @@ void SyncPeerStatus::deletePeer(PublicPtr _peer)
 void SyncPeerStatus::foreachPeerRandom(std::function<bool(PeerStatus::Ptr)> const& _f) const
 {
     ReadGuard l(x_peersStatus);
-    if (m_peersStatus.empty())
-    {
-        return;
-    }
+    foreachPeerIn(randomPeers(), _f);
+}
+
+void SyncPeerStatus::foreachPeerByScore(
+    uint64_t _bytes, std::function<bool(PeerStatus::Ptr)> const& _f) const
+{
+    ReadGuard l(x_peersStatus);
+    auto nodeIds = randomPeers();
+    m_config->peerScores()->sortPeersByCost(nodeIds, _bytes);
+    foreachPeerIn(nodeIds, _f);
+}
 
+NodeIDs SyncPeerStatus::randomPeers() const
+{
     // Get nodeid list
     NodeIDs nodeIds;
     for (auto& peer : m_peersStatus)
     {
         nodeIds.emplace_back(peer.first);
     }
+    if (nodeIds.empty())
+    {
+        return nodeIds;
+    }
 
     // Random nodeid list
     for (size_t i = nodeIds.size() - 1; i > 0; --i)
@@ -182,9 +195,14 @@ void SyncPeerStatus::foreachPeerRandom(std::function<bool(PeerStatus::Ptr)> cons
         size_t select = rand() % (i + 1);
         swap(nodeIds[i], nodeIds[select]);
     }
+    return nodeIds;
+}
 
-    // access _f() according to the random list
-    for (auto nodeId : nodeIds)
+void SyncPeerStatus::foreachPeerIn(
+    NodeIDs const& _nodeIds, std::function<bool(PeerStatus::Ptr)> const& _f) const
+{
+    // access _f() according to the given list
+    for (auto const& nodeId : _nodeIds)
     {
         auto const& peer = m_peersStatus.find(nodeId);
         if (peer == m_peersStatus.end())
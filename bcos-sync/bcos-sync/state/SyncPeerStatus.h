@@ -89,12 +89,18 @@ public:
     virtual void deletePeer(bcos::crypto::PublicPtr _peer);
 
     void foreachPeerRandom(std::function<bool(PeerStatus::Ptr)> const& _f) const;
+    // access the peers with the lower cost to send _bytes first, the peers of the same cost are
+    // accessed randomly
+    void foreachPeerByScore(uint64_t _bytes, std::function<bool(PeerStatus::Ptr)> const& _f) const;
     void foreachPeer(std::function<bool(PeerStatus::Ptr)> const& _f) const;
     std::shared_ptr<bcos::crypto::NodeIDs> peers();
     PeerStatus::Ptr insertEmptyPeer(bcos::crypto::PublicPtr _peer);
 
 protected:
     virtual void updateKnownMaxBlockInfo(BlockSyncStatusInterface::ConstPtr _peerStatus);
+    void foreachPeerIn(
+        bcos::crypto::NodeIDs const& _nodeIds, std::function<bool(PeerStatus::Ptr)> const& _f) const;
+    bcos::crypto::NodeIDs randomPeers() const;
 
 private:
     std::map<bcos::crypto::PublicPtr, PeerStatus::Ptr, bcos::crypto::KeyCompare> m_peersStatus;
@@ -54,6 +54,7 @@ public:
     // the sync module calls this interface to check block
     void asyncCheckBlock(Block::Ptr, std::function<void(Error::Ptr, bool)> _onVerifyFinish) override
     {
+        ++m_checkBlockCount;
         m_taskPool->enqueue(
             [_onVerifyFinish, this]() { _onVerifyFinish(nullptr, m_checkBlockResult); });
     }
@@ -73,6 +74,7 @@ public:
 
     bool checkBlockResult() const { return m_checkBlockResult; }
     void setCheckBlockResult(bool _checkBlockResult) { m_checkBlockResult = _checkBlockResult; }
+    size_t checkBlockCount() const { return m_checkBlockCount; }
 
     LedgerConfig::Ptr ledgerConfig() { return m_ledgerConfig; }
 
@@ -87,6 +89,7 @@ public:
 
 private:
     std::atomic_bool m_checkBlockResult = {true};
+    std::atomic<size_t> m_checkBlockCount = {0};
     LedgerConfig::Ptr m_ledgerConfig;
     ThreadPool::Ptr m_taskPool;
 };
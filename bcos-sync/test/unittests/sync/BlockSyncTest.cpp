@@ -197,6 +197,34 @@ void testComplicatedCase(CryptoSuite::Ptr _cryptoSuite)
 }
 
 
+void testPreVerifyBlocks(CryptoSuite::Ptr _cryptoSuite, size_t _verifyDepth)
+{
+    auto gateWay = std::make_shared<FakeGateWay>();
+    BlockNumber maxBlock = 20;
+    auto newerPeer = std::make_shared<SyncFixture>(_cryptoSuite, gateWay, (maxBlock + 1));
+    BlockNumber minBlock = 2;
+    auto lowerPeer = std::make_shared<SyncFixture>(_cryptoSuite, gateWay, (minBlock + 1));
+    lowerPeer->syncConfig()->setVerifyDepth(_verifyDepth);
+    std::vector<NodeIDPtr> nodeList;
+    nodeList.push_back(newerPeer->nodeID());
+    nodeList.push_back(lowerPeer->nodeID());
+    newerPeer->setObservers(nodeList);
+    lowerPeer->setObservers(nodeList);
+    newerPeer->init();
+    lowerPeer->init();
+
+    auto startT = utcTime();
+    while (lowerPeer->ledger()->blockNumber() != maxBlock && (utcTime() - startT <= 60 * 1000))
+    {
+        newerPeer->sync()->executeWorker();
+        lowerPeer->sync()->executeWorker();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    BOOST_CHECK_EQUAL(lowerPeer->ledger()->blockNumber(), maxBlock);
+    // every downloaded block is checked once, ahead of the execution or before commit
+    BOOST_CHECK_EQUAL(lowerPeer->consensus()->checkBlockCount(), (size_t)(maxBlock - minBlock));
+}
+
 BOOST_AUTO_TEST_CASE(testNonSMRequestAndDownloadBlock)
 {
     auto hashImpl = std::make_shared<Keccak256>();
@@ -205,6 +233,18 @@ BOOST_AUTO_TEST_CASE(testNonSMRequestAndDownloadBlock)
     testRequestAndDownloadBlock(cryptoSuite);
     testComplicatedCase(cryptoSuite);
 }
+
+BOOST_AUTO_TEST_CASE(testPreVerifyDownloadedBlocks)
+{
+    auto hashImpl = std::make_shared<Keccak256>();
+    auto signatureImpl = std::make_shared<Secp256k1Crypto>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+    // verify the blocks one by one, ahead within the window, and all ahead
+    for (size_t verifyDepth : {0, 4, 32})
+    {
+        testPreVerifyBlocks(cryptoSuite, verifyDepth);
+    }
+}
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace bcos
\ No newline at end of file
@@ -0,0 +1,240 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief dump the hot keys of the cache storage and prefetch them after restart
+ * @file CacheWarmer.cpp
+ */
+#include "CacheWarmer.h"
+#include <tbb/parallel_for.h>
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+using namespace bcos;
+using namespace bcos::storage;
+
+namespace
+{
+constexpr uint32_t c_hotKeysVersion = 1;
+// the keys of one table are loaded in batches
+constexpr size_t c_prefetchBatchSize = 1000;
+
+template <class T>
+void writeValue(std::ofstream& _out, T _value)
+{
+    _out.write((const char*)&_value, sizeof(_value));
+}
+
+template <class T>
+bool readValue(std::ifstream& _in, T& _value)
+{
+    return (bool)_in.read((char*)&_value, sizeof(_value));
+}
+}  // namespace
+
+CacheWarmer::CacheWarmer(std::shared_ptr<LRUStateStorage> _cache, std::string _path, size_t _maxKeys)
+  : m_cache(std::move(_cache)), m_path(std::move(_path)), m_maxKeys(_maxKeys)
+{}
+
+size_t CacheWarmer::prefetch()
+{
+    auto startTime = utcSteadyTime();
+    auto hotKeys = readHotKeys(m_path);
+    if (!hotKeys)
+    {
+        STORAGE_LOG(INFO) << LOG_DESC("CacheWarmer: no hot keys to prefetch")
+                          << LOG_KV("path", m_path);
+        return 0;
+    }
+
+    std::map<std::string, std::vector<std::string>, std::less<>> tableKeys;
+    for (auto& [table, key, hits] : *hotKeys)
+    {
+        tableKeys[table].emplace_back(std::move(key));
+    }
+    std::vector<std::tuple<std::string_view, gsl::span<std::string const>>> batches;
+    for (auto const& [table, keys] : tableKeys)
+    {
+        for (size_t i = 0; i < keys.size(); i += c_prefetchBatchSize)
+        {
+            batches.emplace_back(table, gsl::span<std::string const>(keys.data() + i,
+                                            std::min(c_prefetchBatchSize, keys.size() - i)));
+        }
+    }
+
+    std::atomic_size_t loaded = 0;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, batches.size()),
+        [this, &batches, &loaded](const tbb::blocked_range<size_t>& range) {
+            for (auto i = range.begin(); i < range.end(); ++i)
+            {
+                auto& [table, keys] = batches[i];
+                std::promise<void> prefetchPromise;
+                m_cache->asyncGetRows(table, keys,
+                    [&loaded, &prefetchPromise, table = table](
+                        Error::UniquePtr error, std::vector<std::optional<Entry>> entries) {
+                        if (error)
+                        {
+                            STORAGE_LOG(WARNING)
+                                << LOG_DESC("CacheWarmer: prefetch failed") << LOG_KV("table", table)
+                                << LOG_KV("message", error->errorMessage());
+                        }
+                        for (auto const& entry : entries)
+                        {
+                            if (entry)
+                            {
+                                ++loaded;
+                            }
+                        }
+                        prefetchPromise.set_value();
+                    });
+                prefetchPromise.get_future().get();
+            }
+        });
+
+    STORAGE_LOG(INFO) << METRIC << LOG_DESC("CacheWarmer: prefetch hot keys")
+                      << LOG_KV("keys", hotKeys->size()) << LOG_KV("loaded", loaded)
+                      << LOG_KV("tables", tableKeys.size())
+                      << LOG_KV("timeCost", utcSteadyTime() - startTime);
+    return loaded;
+}
+
+size_t CacheWarmer::dump()
+{
+    auto startTime = utcSteadyTime();
+    auto hotKeys = m_cache->hotKeys(m_maxKeys);
+    if (!writeHotKeys(m_path, hotKeys))
+    {
+        STORAGE_LOG(WARNING) << LOG_DESC("CacheWarmer: dump hot keys failed")
+                             << LOG_KV("path", m_path);
+        return 0;
+    }
+    STORAGE_LOG(INFO) << LOG_DESC("CacheWarmer: dump hot keys") << LOG_KV("keys", hotKeys.size())
+                      << LOG_KV("path", m_path) << LOG_KV("timeCost", utcSteadyTime() - startTime);
+    return hotKeys.size();
+}
+
+void CacheWarmer::start()
+{
+    if (m_timer)
+    {
+        return;
+    }
+    m_startTime = utcSteadyTime();
+    std::tie(m_lastHits, m_lastMisses) = m_cache->hitsAndMisses();
+    m_timer = std::make_shared<bcos::Timer>(c_sampleInterval, "cacheWarmer");
+    m_timer->registerTimeoutHandler([this]() { sampleHitRate(); });
+    m_timer->start();
+}
+
+void CacheWarmer::stop()
+{
+    if (m_timer)
+    {
+        m_timer->stop();
+        m_timer->destroy();
+    }
+}
+
+void CacheWarmer::sampleHitRate()
+{
+    auto [hits, misses] = m_cache->hitsAndMisses();
+    auto windowHits = hits - m_lastHits;
+    auto windowLookups = windowHits + misses - m_lastMisses;
+    m_lastHits = hits;
+    m_lastMisses = misses;
+
+    auto elapsed = utcSteadyTime() - m_startTime;
+    double hitRate = windowLookups > 0 ? (double)windowHits / (double)windowLookups : 0;
+    if (windowLookups > 0 && hitRate >= c_steadyHitRate)
+    {
+        STORAGE_LOG(INFO) << METRIC << LOG_DESC("CacheWarmer: cache reached steady state")
+                          << LOG_KV("timeToSteadyState", elapsed) << LOG_KV("hitRate", hitRate)
+                          << LOG_KV("lookups", windowLookups);
+        return;
+    }
+    if (elapsed >= c_maxSampleTime)
+    {
+        STORAGE_LOG(INFO) << METRIC << LOG_DESC("CacheWarmer: cache not steady after max time")
+                          << LOG_KV("elapsed", elapsed) << LOG_KV("hitRate", hitRate);
+        return;
+    }
+    STORAGE_LOG(DEBUG) << LOG_DESC("CacheWarmer: sample hit rate") << LOG_KV("hitRate", hitRate)
+                       << LOG_KV("lookups", windowLookups) << LOG_KV("elapsed", elapsed);
+    m_timer->restart();
+}
+
+bool CacheWarmer::writeHotKeys(std::string const& _path, HotKeys const& _keys)
+{
+    // write to a temp file and rename, never leave a partial file
+    auto tmpPath = _path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            return false;
+        }
+        writeValue(out, c_hotKeysVersion);
+        writeValue(out, (uint64_t)_keys.size());
+        for (auto const& [table, key, hits] : _keys)
+        {
+            writeValue(out, (uint32_t)table.size());
+            writeValue(out, (uint32_t)key.size());
+            writeValue(out, hits);
+            out.write(table.data(), (std::streamsize)table.size());
+            out.write(key.data(), (std::streamsize)key.size());
+        }
+        if (!out.flush())
+        {
+            return false;
+        }
+    }
+    boost::system::error_code error;
+    boost::filesystem::rename(tmpPath, _path, error);
+    return !error;
+}
+
+std::optional<CacheWarmer::HotKeys> CacheWarmer::readHotKeys(std::string const& _path)
+{
+    std::ifstream in(_path, std::ios::binary);
+    if (!in)
+    {
+        return std::nullopt;
+    }
+    uint32_t version = 0;
+    uint64_t count = 0;
+    if (!readValue(in, version) || version != c_hotKeysVersion || !readValue(in, count))
+    {
+        return std::nullopt;
+    }
+
+    HotKeys keys;
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        uint32_t tableSize = 0;
+        uint32_t keySize = 0;
+        uint32_t hits = 0;
+        if (!readValue(in, tableSize) || !readValue(in, keySize) || !readValue(in, hits))
+        {
+            return std::nullopt;
+        }
+        std::string table(tableSize, '\0');
+        std::string key(keySize, '\0');
+        if (!in.read(table.data(), tableSize) || !in.read(key.data(), keySize))
+        {
+            return std::nullopt;
+        }
+        keys.emplace_back(std::move(table), std::move(key), hits);
+    }
+    return keys;
+}
@@ -0,0 +1,76 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief dump the hot keys of the cache storage and prefetch them after restart
+ * @file CacheWarmer.h
+ */
+#pragma once
+
+#include "StateStorage.h"
+#include <bcos-framework/Common.h>
+#include <bcos-utilities/Timer.h>
+
+namespace bcos::storage
+{
+// The hot key set (table, key, access count) of the LRU cache is dumped to a file on shutdown, and
+// prefetched from the backend storage in parallel on start, so the executor does not start with a
+// cold cache. The contract ABIs and the table infos are rows of the storage, they are warmed up as
+// part of the hot keys.
+class CacheWarmer
+{
+public:
+    using Ptr = std::shared_ptr<CacheWarmer>;
+    using HotKeys = std::vector<std::tuple<std::string, std::string, uint32_t>>;
+
+    // the hit rate from which the cache is considered warm
+    constexpr static double c_steadyHitRate = 0.9;
+    constexpr static uint64_t c_sampleInterval = 10000;
+    // stop sampling if the steady state is not reached after 30 minutes
+    constexpr static uint64_t c_maxSampleTime = 30 * 60 * 1000;
+
+    CacheWarmer(std::shared_ptr<LRUStateStorage> _cache, std::string _path, size_t _maxKeys);
+    virtual ~CacheWarmer() { stop(); }
+
+    CacheWarmer(const CacheWarmer&) = delete;
+    CacheWarmer(CacheWarmer&&) = delete;
+    CacheWarmer& operator=(const CacheWarmer&) = delete;
+    CacheWarmer& operator=(CacheWarmer&&) = delete;
+
+    // load the dumped keys into the cache, return the number of the loaded keys
+    virtual size_t prefetch();
+    // save the hot keys of the cache, return the number of the saved keys
+    virtual size_t dump();
+
+    // report the time to the steady hit rate
+    virtual void start();
+    virtual void stop();
+
+    static bool writeHotKeys(std::string const& _path, HotKeys const& _keys);
+    static std::optional<HotKeys> readHotKeys(std::string const& _path);
+
+protected:
+    virtual void sampleHitRate();
+
+private:
+    std::shared_ptr<LRUStateStorage> m_cache;
+    std::string m_path;
+    size_t m_maxKeys;
+
+    std::shared_ptr<bcos::Timer> m_timer;
+    uint64_t m_startTime = 0;
+    uint64_t m_lastHits = 0;
+    uint64_t m_lastMisses = 0;
+};
+}  // namespace bcos::storage
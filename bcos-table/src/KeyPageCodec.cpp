@@ -0,0 +1,271 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the binary codec of the key pages
+ * @file KeyPageCodec.cpp
+ */
+#include "KeyPageCodec.h"
+#include <bcos-framework/storage/Common.h>
+#include <bcos-utilities/Error.h>
+#include <zstd.h>
+#include <boost/throw_exception.hpp>
+#include <algorithm>
+
+using namespace bcos;
+using namespace bcos::storage;
+
+namespace
+{
+void appendUint32(std::string& _out, uint32_t _value)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        _out.push_back((char)(_value >> (8 * i)));
+    }
+}
+
+uint32_t readUint32(char const* _in)
+{
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        value |= (uint32_t)(uint8_t)_in[i] << (8 * i);
+    }
+    return value;
+}
+
+void appendVarint(std::string& _out, uint32_t _value)
+{
+    while (_value >= 0x80)
+    {
+        _out.push_back((char)(_value | 0x80));
+        _value >>= 7;
+    }
+    _out.push_back((char)_value);
+}
+
+[[noreturn]] void throwCorrupted(std::string const& _message)
+{
+    BOOST_THROW_EXCEPTION(BCOS_ERROR(StorageError::ReadError, "Corrupted key page: " + _message));
+}
+}  // namespace
+
+KeyPageEncoder::KeyPageEncoder(size_t _sizeHint)
+{
+    m_block.reserve(_sizeHint);
+}
+
+void KeyPageEncoder::add(std::string_view _key, std::string_view _value)
+{
+    size_t shared = 0;
+    if (m_count % KeyPageCodec::c_restartInterval == 0)
+    {
+        appendUint32(m_restarts, m_block.size());
+        ++m_restartCount;
+    }
+    else
+    {
+        auto limit = std::min(m_lastKey.size(), _key.size());
+        while (shared < limit && m_lastKey[shared] == _key[shared])
+        {
+            ++shared;
+        }
+    }
+    appendVarint(m_block, shared);
+    appendVarint(m_block, _key.size() - shared);
+    appendVarint(m_block, _value.size());
+    m_block.append(_key.substr(shared));
+    m_block.append(_value);
+    m_lastKey.assign(_key);
+    ++m_count;
+}
+
+std::string KeyPageEncoder::finish(bool _compress)
+{
+    m_block.append(m_restarts);
+    appendUint32(m_block, m_restartCount);
+    appendUint32(m_block, m_count);
+
+    std::string out;
+    auto compression = KeyPageCodec::NONE;
+    if (_compress && m_block.size() >= KeyPageCodec::c_minCompressSize)
+    {
+        out.resize(KeyPageCodec::c_headerSize + ZSTD_compressBound(m_block.size()));
+        auto size = ZSTD_compress(out.data() + KeyPageCodec::c_headerSize,
+            out.size() - KeyPageCodec::c_headerSize, m_block.data(), m_block.size(),
+            KeyPageCodec::c_compressionLevel);
+        // keep the raw block if it's not compressible
+        if (!ZSTD_isError(size) && size < m_block.size())
+        {
+            out.resize(KeyPageCodec::c_headerSize + size);
+            compression = KeyPageCodec::ZSTD;
+        }
+    }
+    if (compression == KeyPageCodec::NONE)
+    {
+        out.resize(KeyPageCodec::c_headerSize);
+        out.append(m_block);
+    }
+    std::copy(std::begin(KeyPageCodec::c_magic), std::end(KeyPageCodec::c_magic), out.begin());
+    out[4] = (char)KeyPageCodec::c_version;
+    out[5] = (char)compression;
+    std::string blockSize;
+    appendUint32(blockSize, m_block.size());
+    std::copy(blockSize.begin(), blockSize.end(), out.begin() + 6);
+    return out;
+}
+
+KeyPageReader::KeyPageReader(std::string_view _value)
+{
+    if (!KeyPageCodec::isBinary(_value))
+    {
+        throwCorrupted("invalid magic");
+    }
+    if ((uint8_t)_value[4] != KeyPageCodec::c_version)
+    {
+        throwCorrupted("unsupported version " + std::to_string((uint8_t)_value[4]));
+    }
+    auto blockSize = readUint32(_value.data() + 6);
+    if (blockSize > KeyPageCodec::c_maxBlockSize)
+    {
+        throwCorrupted("invalid block size " + std::to_string(blockSize));
+    }
+    auto payload = _value.substr(KeyPageCodec::c_headerSize);
+    switch ((uint8_t)_value[5])
+    {
+    case KeyPageCodec::NONE:
+        m_block = payload;
+        break;
+    case KeyPageCodec::ZSTD:
+    {
+        // the encoder writes the content size into the frame
+        auto contentSize = ZSTD_getFrameContentSize(payload.data(), payload.size());
+        if (contentSize != blockSize)
+        {
+            throwCorrupted("invalid frame content size " + std::to_string(contentSize));
+        }
+        m_buffer.resize(blockSize);
+        auto size = ZSTD_decompress(m_buffer.data(), blockSize, payload.data(), payload.size());
+        if (ZSTD_isError(size))
+        {
+            throwCorrupted(ZSTD_getErrorName(size));
+        }
+        m_block = std::string_view(m_buffer.data(), size);
+        break;
+    }
+    default:
+        throwCorrupted("unsupported compression " + std::to_string((uint8_t)_value[5]));
+    }
+    if (m_block.size() != blockSize || blockSize < 8)
+    {
+        throwCorrupted("invalid block size " + std::to_string(m_block.size()));
+    }
+    m_count = readUint32(m_block.data() + blockSize - 4);
+    m_restartCount = readUint32(m_block.data() + blockSize - 8);
+    auto expectedRestarts = (m_count + KeyPageCodec::c_restartInterval - 1) /
+                            KeyPageCodec::c_restartInterval;
+    if (m_restartCount != expectedRestarts || 8 + 4 * (size_t)m_restartCount > blockSize)
+    {
+        throwCorrupted("invalid restart count " + std::to_string(m_restartCount));
+    }
+    m_recordsSize = blockSize - 8 - 4 * m_restartCount;
+}
+
+uint32_t KeyPageReader::restart(uint32_t _index) const
+{
+    auto offset = readUint32(m_block.data() + m_recordsSize + 4 * _index);
+    if (offset >= m_recordsSize)
+    {
+        throwCorrupted("invalid restart offset " + std::to_string(offset));
+    }
+    return offset;
+}
+
+std::string_view KeyPageReader::next(uint32_t& _offset, std::string& _key) const
+{
+    auto readVarint = [this, &_offset]() {
+        uint32_t value = 0;
+        for (int shift = 0; shift < 32; shift += 7)
+        {
+            if (_offset >= m_recordsSize)
+            {
+                break;
+            }
+            auto byte = (uint8_t)m_block[_offset++];
+            value |= (uint32_t)(byte & 0x7F) << shift;
+            if (byte < 0x80)
+            {
+                return value;
+            }
+        }
+        throwCorrupted("invalid varint at " + std::to_string(_offset));
+    };
+    auto shared = readVarint();
+    auto unshared = readVarint();
+    auto valueSize = readVarint();
+    if (shared > _key.size() || (size_t)_offset + unshared + valueSize > m_recordsSize)
+    {
+        throwCorrupted("invalid record at " + std::to_string(_offset));
+    }
+    _key.resize(shared);
+    _key.append(m_block.data() + _offset, unshared);
+    _offset += unshared;
+    auto value = m_block.substr(_offset, valueSize);
+    _offset += valueSize;
+    return value;
+}
+
+std::optional<std::string_view> KeyPageReader::find(std::string_view _key) const
+{
+    if (m_count == 0)
+    {
+        return std::nullopt;
+    }
+    // the last restart point whose key is not greater than the key
+    std::string key;
+    uint32_t low = 0;
+    uint32_t high = m_restartCount;
+    while (high - low > 1)
+    {
+        auto middle = low + (high - low) / 2;
+        auto offset = restart(middle);
+        key.clear();
+        next(offset, key);
+        if (key <= _key)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    auto offset = restart(low);
+    auto end = std::min<uint32_t>((low + 1) * KeyPageCodec::c_restartInterval, m_count);
+    key.clear();
+    for (auto i = low * KeyPageCodec::c_restartInterval; i < end; ++i)
+    {
+        auto value = next(offset, key);
+        if (key == _key)
+        {
+            return value;
+        }
+        if (key > _key)
+        {
+            break;
+        }
+    }
+    return std::nullopt;
+}
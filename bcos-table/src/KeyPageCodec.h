@@ -0,0 +1,145 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the binary codec of the key pages
+ * @file KeyPageCodec.h
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace bcos::storage
+{
+enum class KeyPageFormat : uint8_t
+{
+    // boost::serialization archive, readable by all the versions
+    LEGACY = 0,
+    BINARY = 1,
+};
+
+/// The binary page is a block of sorted key-value records:
+///
+///   header:  magic(4) | version(1) | compression(1) | block size(4)
+///   block:   record... | restart offset(4)... | restart count(4) | record count(4)
+///   record:  varint shared | varint unshared | varint value size | key[shared:] | value
+///
+/// The key shares the prefix of the previous key, except the keys at the restart points which
+/// are stored in full. The restart offsets make the lookup a binary search on the restart points
+/// plus a scan of at most c_restartInterval records, without decoding the whole page. The block
+/// is optionally compressed by zstd.
+///
+/// The legacy archive starts with the uint32 valid count of the page or the uint64 page count of
+/// the table meta, the magic doesn't collide with them.
+class KeyPageCodec
+{
+public:
+    constexpr static uint8_t c_magic[] = {0xFF, 'K', 'P', 0xFF};
+    constexpr static uint8_t c_version = 1;
+    constexpr static size_t c_headerSize = 10;
+    constexpr static size_t c_restartInterval = 16;
+    // the smaller blocks are not compressed
+    constexpr static size_t c_minCompressSize = 256;
+    constexpr static int c_compressionLevel = 1;
+    // a page exceeds key_page_size(32M at most) by its last entry only, the larger blocks are
+    // corrupted
+    constexpr static size_t c_maxBlockSize = 256 * 1024 * 1024;
+
+    enum Compression : uint8_t
+    {
+        NONE = 0,
+        ZSTD = 1,
+    };
+
+    // the format of the pages to write, all the formats are readable
+    static void setFormat(KeyPageFormat _format, bool _compress)
+    {
+        s_format.store(_format, std::memory_order_relaxed);
+        s_compress.store(_compress, std::memory_order_relaxed);
+    }
+    static KeyPageFormat format() { return s_format.load(std::memory_order_relaxed); }
+    static bool compress() { return s_compress.load(std::memory_order_relaxed); }
+
+    static bool isBinary(std::string_view _value)
+    {
+        return _value.size() >= c_headerSize &&
+               std::string_view(_value.data(), sizeof(c_magic)) ==
+                   std::string_view((char const*)c_magic, sizeof(c_magic));
+    }
+
+private:
+    inline static std::atomic<KeyPageFormat> s_format = KeyPageFormat::LEGACY;
+    inline static std::atomic_bool s_compress = false;
+};
+
+class KeyPageEncoder
+{
+public:
+    explicit KeyPageEncoder(size_t _sizeHint = 0);
+
+    // the keys must be added in ascending order
+    void add(std::string_view _key, std::string_view _value);
+    size_t count() const { return m_count; }
+    std::string finish(bool _compress = KeyPageCodec::compress());
+
+private:
+    std::string m_block;
+    std::string m_lastKey;
+    std::string m_restarts;
+    uint32_t m_restartCount = 0;
+    uint32_t m_count = 0;
+};
+
+/// KeyPageReader refers to the encoded value if it's not compressed, the value must outlive it
+class KeyPageReader
+{
+public:
+    // throw if the value is not a valid binary page
+    explicit KeyPageReader(std::string_view _value);
+
+    size_t count() const { return m_count; }
+    // Note: KeyPageStorage decodes the whole page with forEach, since it caches and modifies the
+    // decoded pages, find is not on its read path
+    std::optional<std::string_view> find(std::string_view _key) const;
+
+    // _callback(std::string_view key, std::string_view value), the key is valid in the callback
+    template <class Callback>
+    void forEach(Callback&& _callback) const
+    {
+        std::string key;
+        auto offset = 0u;
+        for (uint32_t i = 0; i < m_count; ++i)
+        {
+            auto value = next(offset, key);
+            _callback(std::string_view(key), value);
+        }
+    }
+
+private:
+    uint32_t restart(uint32_t _index) const;
+    // decode the record at the offset, the key is rebuilt on the previous key
+    std::string_view next(uint32_t& _offset, std::string& _key) const;
+
+    std::string m_buffer;
+    std::string_view m_block;
+    // the size of the records
+    uint32_t m_recordsSize = 0;
+    uint32_t m_restartCount = 0;
+    uint32_t m_count = 0;
+};
+}  // namespace bcos::storage
@@ -250,7 +250,7 @@ void KeyPageStorage::parallelTraverse(bool onlyDirty,
                     auto meta = &std::get<1>(it.second->data);
                     auto readLock = meta->rLock();
                     Entry entry;
-                    entry.setObject(*meta);
+                    meta->encode(entry);
                     readLock.unlock();
                     if (meta->size() < 5)
                     {  // FIXME: this log is only for debug, comment it when release
@@ -285,7 +285,7 @@ void KeyPageStorage::parallelTraverse(bool onlyDirty,
                     }
                     else
                     {
-                        entry.setObject(*page);
+                        page->encode(entry);
                         entry.setStatus(it.second->entry.status());
                         if (c_fileLogLevel >= TRACE)
                         {
@@ -666,7 +666,7 @@ std::pair<Error::UniquePtr, std::optional<Entry>> KeyPageStorage::getEntryFromPa
             if (data.value()->entry.dirty())
             {
                 Entry entry;
-                entry.setObject(*meta);
+                meta->encode(entry);
                 entry.setStatus(data.value()->entry.status());
                 return std::make_pair(nullptr, std::move(entry));
             }
@@ -677,6 +677,10 @@ std::pair<Error::UniquePtr, std::optional<Entry>> KeyPageStorage::getEntryFromPa
         }
         return std::make_pair(nullptr, std::nullopt);
     }
+    if (adaptivePageSize())
+    {
+        meta->recordRead();
+    }
     auto pageInfoOp = meta->getPageInfoNoLock(key);
     if (pageInfoOp)
     {
@@ -741,7 +745,7 @@ std::pair<Error::UniquePtr, std::optional<Entry>> KeyPageStorage::getEntryFromPa
                         << LOG_KV("dirty", data.value()->entry.dirty());
                 }
                 Entry entry;
-                entry.setObject(*page);
+                page->encode(entry);
                 entry.setStatus(pageData->entry.status());
                 return std::make_pair(nullptr, std::move(entry));
             }
@@ -803,6 +807,7 @@ Error::UniquePtr KeyPageStorage::setEntryToPage(std::string table, std::string k
     }
     // if new entry is too big, it will trigger split
     auto page = &std::get<0>(pageData->data);
+    auto entrySize = key.size() + entry.size();
     {
         auto ret = page->setEntry(key, std::move(entry));
         entryOld = std::move(std::get<0>(ret));
@@ -841,18 +846,26 @@ Error::UniquePtr KeyPageStorage::setEntryToPage(std::string table, std::string k
         // page is modified, the meta maybe modified, mark meta as dirty
         data.value()->entry.setStatus(Entry::Status::MODIFIED);
     }
+    if (adaptivePageSize())
+    {
+        meta->recordWriteNoLock(entryOld.has_value(), entrySize);
+        meta->adaptPageSizeNoLock(m_pageSize);
+    }
+    size_t pageSize = meta->getPageSize() > 0 ? meta->getPageSize() : m_pageSize;
+    size_t splitSize = pageSize / 3 * 2;
+    size_t mergeSize = pageSize / 4;
     pageKey = page->endKey();
-    if (page->size() > m_pageSize && page->validCount() > 1)
+    if (page->size() > pageSize && page->validCount() > 1)
     {  // split page, TODO: if dag trigger split, it maybe split to different page?
         if (c_fileLogLevel >= TRACE)
         {
             KeyPage_LOG(TRACE) << LOG_DESC("trigger split page") << LOG_KV("table", table)
                                << LOG_KV("pageKey", toHex(pageKey)) << LOG_KV("size", page->size())
-                               << LOG_KV("m_pageSize", m_pageSize)
+                               << LOG_KV("pageSize", pageSize)
                                << LOG_KV("validCount", page->validCount())
                                << LOG_KV("count", page->count());
         }
-        auto newPage = page->split(m_splitSize);
+        auto newPage = page->split(splitSize);
         // update old meta pageInfo
         auto oldStartKey = meta->updatePageInfoNoLock(
             pageKey, page->endKey(), page->validCount(), page->size(), pageInfoOption);
@@ -874,7 +887,7 @@ Error::UniquePtr KeyPageStorage::setEntryToPage(std::string table, std::string k
         insertNewPage(table, newPage.endKey(), meta, std::move(newPage));
         data.value()->entry.setStatus(Entry::Status::MODIFIED);
     }
-    else if (page->size() < m_mergeSize)
+    else if (page->size() < mergeSize)
     {  // merge operation
         // get next page, check size and merge current into next
         auto nextPageKey = meta->getNextPageKeyNoLock(page->endKey());
@@ -889,7 +902,7 @@ Error::UniquePtr KeyPageStorage::setEntryToPage(std::string table, std::string k
                     << LOG_KV("key", toHex(key)) << LOG_KV("pageKey", toHex(pageKey));
             }
             auto nextPage = &std::get<0>(nextPageData.value()->data);
-            if (nextPage->size() < m_splitSize && nextPage != page)
+            if (nextPage->size() < splitSize && nextPage != page)
             {
                 auto endKey = page->endKey();
                 auto nextEndKey = nextPage->endKey();
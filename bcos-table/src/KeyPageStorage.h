@@ -20,6 +20,7 @@
  */
 #pragma once
 
+#include "KeyPageCodec.h"
 #include "StateStorageInterface.h"
 #include <boost/archive/basic_archive.hpp>
 #include <boost/archive/binary_iarchive.hpp>
@@ -84,6 +85,8 @@ constexpr static int32_t ARCHIVE_FLAG =
 
 const char* const TABLE_META_KEY = "";
 const size_t MIN_PAGE_SIZE = 2048;
+// the adaptive page size is limited by the uint16 size of PageInfo
+const size_t MAX_ADAPTIVE_PAGE_SIZE = 60 * 1024;
 class KeyPageStorage : public virtual storage::StateStorageInterface
 {
 public:
@@ -94,8 +97,6 @@ public:
         bool _ignoreNotExist = false)
       : storage::StateStorageInterface(_prev),
         m_pageSize(_pageSize > MIN_PAGE_SIZE ? _pageSize : MIN_PAGE_SIZE),
-        m_splitSize(m_pageSize / 3 * 2),
-        m_mergeSize(m_pageSize / 4),
         m_buckets(std::thread::hardware_concurrency()),
         m_ignoreTables(_ignoreTables),
         m_ignoreNotExist(_ignoreNotExist)
@@ -148,6 +149,13 @@ public:
 
     void rollback(const Recoder& recoder) override;
 
+    // adapt the page sizes of the tables to their workloads, see TableMeta::adaptPageSizeNoLock
+    static void setAdaptivePageSize(bool _enable)
+    {
+        s_adaptivePageSize.store(_enable, std::memory_order_relaxed);
+    }
+    static bool adaptivePageSize() { return s_adaptivePageSize.load(std::memory_order_relaxed); }
+
     struct Data;
     class PageInfo
     {  // all methods is not thread safe
@@ -239,15 +247,43 @@ public:
             {
                 return;
             }
+            if (KeyPageCodec::isBinary(value))
+            {
+                KeyPageReader reader(value);
+                pages = std::make_unique<std::vector<PageInfo>>();
+                pages->reserve(reader.count());
+                reader.forEach([this](std::string_view pageKey, std::string_view info) {
+                    if (info.size() != 4)
+                    {
+                        BOOST_THROW_EXCEPTION(
+                            BCOS_ERROR(StorageError::ReadError, "Corrupted key page meta"));
+                    }
+                    auto low = (uint16_t)((uint8_t)info[0] | (uint8_t)info[1] << 8);
+                    auto high = (uint16_t)((uint8_t)info[2] | (uint8_t)info[3] << 8);
+                    if (pageKey.empty())
+                    {  // the page key is never empty, the empty key records the page size
+                        pageSize = low | (uint32_t)high << 16;
+                        return;
+                    }
+                    pages->emplace_back(std::string(pageKey), low, high, nullptr);
+                });
+                return;
+            }
             boost::iostreams::stream<boost::iostreams::array_source> inputStream(
                 value.data(), value.size());
             boost::archive::binary_iarchive archive(inputStream, ARCHIVE_FLAG);
             archive >> *this;
+            // the page size is appended to the pages, the older versions ignore it
+            if (inputStream.peek() != std::char_traits<char>::eof())
+            {
+                archive >> pageSize;
+            }
         }
         TableMeta(const TableMeta& t)
         {
             pages = std::make_unique<std::vector<PageInfo>>();
             *pages = *t.pages;
+            copyWorkload(t);
         }
         TableMeta& operator=(const TableMeta& t)
         {
@@ -255,15 +291,21 @@ public:
             {
                 pages = std::make_unique<std::vector<PageInfo>>();
                 *pages = *t.pages;
+                copyWorkload(t);
             }
             return *this;
         }
-        TableMeta(TableMeta&& t) { pages = std::move(t.pages); }
+        TableMeta(TableMeta&& t)
+        {
+            pages = std::move(t.pages);
+            copyWorkload(t);
+        }
         TableMeta& operator=(TableMeta&& t)
         {
             if (this != &t)
             {
                 pages = std::move(t.pages);
+                copyWorkload(t);
             }
             return *this;
         }
@@ -463,6 +505,91 @@ public:
         }
         double hitRate() { return hit / (double)getPageInfoCount; }
 
+        // the page size of the table, 0 means the page size of the storage
+        uint32_t getPageSize() const { return pageSize; }
+        void setPageSize(uint32_t _pageSize) { pageSize = _pageSize; }
+        // the reads hold the read lock, the writes hold the write lock
+        void recordRead() { reads.fetch_add(1, std::memory_order_relaxed); }
+        void recordWriteNoLock(bool update, size_t size)
+        {
+            ++workload.writes;
+            workload.updates += update ? 1 : 0;
+            workload.writeBytes += size;
+        }
+
+        /// decide the page size by the workload observed in the last c_adaptInterval operations:
+        /// the update-heavy tables use smaller pages, for every update rewrites the whole page;
+        /// the insert-heavy tables use bigger pages, for the pages are rarely rewritten. A page
+        /// holds at least c_minEntriesPerPage entries of the average size.
+        /// @return true if the page size is changed
+        bool adaptPageSizeNoLock(size_t defaultPageSize)
+        {
+            constexpr static uint32_t c_adaptInterval = 1024;
+            constexpr static size_t c_minEntriesPerPage = 8;
+            auto readCount = reads.load(std::memory_order_relaxed);
+            if (readCount + workload.writes < c_adaptInterval || workload.writes == 0)
+            {
+                return false;
+            }
+            auto writeRatio = workload.writes / (double)(readCount + workload.writes);
+            auto updateRatio = workload.updates / (double)workload.writes;
+            auto averageSize = workload.writeBytes / workload.writes;
+            size_t target = defaultPageSize;
+            if (writeRatio >= 0.3 && updateRatio >= 0.5)
+            {
+                target = defaultPageSize / 4;
+            }
+            else if (writeRatio >= 0.3 && updateRatio < 0.2)
+            {
+                target = defaultPageSize * 4;
+            }
+            target = std::max(target, averageSize * c_minEntriesPerPage);
+            target = std::min(target, std::max(defaultPageSize, MAX_ADAPTIVE_PAGE_SIZE));
+            target = std::max(target, MIN_PAGE_SIZE);
+            // decay the workload to follow its changes
+            reads.store(readCount / 2, std::memory_order_relaxed);
+            workload.writes /= 2;
+            workload.updates /= 2;
+            workload.writeBytes /= 2;
+            auto newPageSize = target == defaultPageSize ? 0 : (uint32_t)target;
+            if (newPageSize == pageSize)
+            {
+                return false;
+            }
+            KeyPage_LOG(DEBUG) << LOG_DESC("adapt page size") << LOG_KV("old", pageSize)
+                               << LOG_KV("new", target) << LOG_KV("writeRatio", writeRatio)
+                               << LOG_KV("updateRatio", updateRatio)
+                               << LOG_KV("averageSize", averageSize);
+            pageSize = newPageSize;
+            return true;
+        }
+
+        // encode the meta in the format of KeyPageCodec, the empty pages are removed
+        void encode(Entry& entry) const
+        {
+            if (KeyPageCodec::format() == KeyPageFormat::LEGACY)
+            {
+                entry.setObject(*this);
+                return;
+            }
+            eraseEmptyPages();
+            KeyPageEncoder encoder;
+            if (pageSize != 0)
+            {
+                char size[] = {(char)pageSize, (char)(pageSize >> 8), (char)(pageSize >> 16),
+                    (char)(pageSize >> 24)};
+                encoder.add("", std::string_view(size, sizeof(size)));
+            }
+            for (auto& pageInfo : *pages)
+            {
+                auto count = pageInfo.getCount();
+                auto size = pageInfo.getSize();
+                char info[] = {(char)count, (char)(count >> 8), (char)size, (char)(size >> 8)};
+                encoder.add(pageInfo.getPageKey(), std::string_view(info, sizeof(info)));
+            }
+            entry.setField(0, encoder.finish());
+        }
+
     private:
         uint32_t getPageInfoCount = 0;
         uint32_t hit = 0;
@@ -470,20 +597,23 @@ public:
         std::unique_ptr<std::vector<PageInfo>> pages = nullptr;
         friend class boost::serialization::access;
         size_t lastPageInfoIndex = 0;
-        template <class Archive>
-        void save(Archive& ar, const unsigned int version) const
+        uint32_t pageSize = 0;
+        struct Workload
+        {
+            uint32_t writes = 0;
+            uint32_t updates = 0;
+            uint64_t writeBytes = 0;
+        };
+        std::atomic_uint32_t reads = 0;
+        Workload workload;
+        void copyWorkload(const TableMeta& t)
+        {
+            pageSize = t.pageSize;
+            reads.store(t.reads.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            workload = t.workload;
+        }
+        void eraseEmptyPages() const
         {
-            std::ignore = version;
-            // auto len = (uint32_t)pages->size();
-            // ar& len;
-            // for (size_t i = 0; i < pages->size(); ++i)
-            // {
-            //     if (pages->at(i).getCount() == 0)
-            //     {
-            //         continue;
-            //     }
-            //     ar & pages->at(i);
-            // }
             int invalid = 0;
             for (auto it = pages->begin(); it != pages->end();)
             {
@@ -501,11 +631,31 @@ public:
                     ++it;
                 }
             }
-            ar << *pages;
             KeyPage_LOG(DEBUG) << LOG_DESC("Serialize meta") << LOG_KV("valid", pages->size())
                                << LOG_KV("invalid", invalid);
         }
         template <class Archive>
+        void save(Archive& ar, const unsigned int version) const
+        {
+            std::ignore = version;
+            // auto len = (uint32_t)pages->size();
+            // ar& len;
+            // for (size_t i = 0; i < pages->size(); ++i)
+            // {
+            //     if (pages->at(i).getCount() == 0)
+            //     {
+            //         continue;
+            //     }
+            //     ar & pages->at(i);
+            // }
+            eraseEmptyPages();
+            ar << *pages;
+            if (pageSize != 0)
+            {
+                ar << pageSize;
+            }
+        }
+        template <class Archive>
         void load(Archive& ar, const unsigned int version)
         {
             std::ignore = version;
@@ -532,10 +682,17 @@ public:
             {
                 return;
             }
-            boost::iostreams::stream<boost::iostreams::array_source> inputStream(
-                value.data(), value.size());
-            boost::archive::binary_iarchive archive(inputStream, ARCHIVE_FLAG);
-            archive >> *this;
+            if (KeyPageCodec::isBinary(value))
+            {
+                decode(value);
+            }
+            else
+            {
+                boost::iostreams::stream<boost::iostreams::array_source> inputStream(
+                    value.data(), value.size());
+                boost::archive::binary_iarchive archive(inputStream, ARCHIVE_FLAG);
+                archive >> *this;
+            }
             if (pageKey != entries.rbegin()->first)
             {
                 KeyPage_LOG(INFO) << LOG_DESC("load page with invalid pageKey")
@@ -955,10 +1112,42 @@ public:
                 }
             }
         }
+        // encode the valid entries in the format of KeyPageCodec, not thread safe like save
+        void encode(Entry& entry) const
+        {
+            if (KeyPageCodec::format() == KeyPageFormat::LEGACY)
+            {
+                entry.setObject(*this);
+                return;
+            }
+            KeyPageEncoder encoder(m_size + m_validCount * 4);
+            for (auto& i : entries)
+            {
+                if (i.second.status() == Entry::Status::DELETED)
+                {  // skip deleted entry
+                    continue;
+                }
+                encoder.add(i.first, i.second.get());
+            }
+            assert(encoder.count() == m_validCount);
+            entry.setField(0, encoder.finish());
+        }
         std::unique_lock<std::shared_mutex> lock() { return std::unique_lock(mutex); }
         std::shared_lock<std::shared_mutex> rLock() { return std::shared_lock(mutex); }
 
     private:
+        void decode(std::string_view encoded)
+        {
+            KeyPageReader reader(encoded);
+            m_validCount = reader.count();
+            reader.forEach([this](std::string_view key, std::string_view value) {
+                m_size += key.size() + value.size();
+                Entry e;
+                e.setPointer(std::make_shared<std::vector<uint8_t>>(value.begin(), value.end()));
+                e.setStatus(Entry::Status::NORMAL);
+                entries.emplace_hint(entries.end(), std::string(key), std::move(e));
+            });
+        }
         //   PageInfo* pageInfo;
         mutable std::shared_mutex mutex;
         std::map<std::string, Entry, std::less<>> entries;
@@ -1232,9 +1421,8 @@ private:
         std::string_view table, std::string_view key);
     Error::UniquePtr setEntryToPage(std::string table, std::string key, Entry entry);
 
+    inline static std::atomic_bool s_adaptivePageSize = false;
     size_t m_pageSize = 8 * 1024;
-    size_t m_splitSize;
-    size_t m_mergeSize;
     std::atomic_uint64_t m_readLength{0};
     std::atomic_uint64_t m_writeLength{0};
     std::vector<Bucket> m_buckets;
@@ -0,0 +1,479 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief multi-version state for the parallel execution of one block
+ * @file MVCCStorage.h
+ */
+#pragma once
+
+#include "StateStorageInterface.h"
+#include "bcos-framework/storage/Table.h"
+#include <bcos-crypto/interfaces/crypto/Hash.h>
+#include <bcos-utilities/Error.h>
+#include <boost/format.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/mem_fun.hpp>
+#include <boost/multi_index_container.hpp>
+#include <limits>
+#include <map>
+#include <shared_mutex>
+#include <thread>
+
+namespace bcos::storage
+{
+// Every write creates a version of the key tagged with the index of the writing transaction, and a
+// read of transaction i returns the latest version written by the transactions [0, i], falling back
+// to the prev storage. The executives of different transactions read consistent snapshots and write
+// concurrently without copying the state or locking the keys.
+// The transaction index of the current thread is set by setTxIndex, c_latestVersion by default.
+// rollback(Recoder) reverts the versions of the transaction executing on the current thread.
+class MVCCStorage : public virtual storage::StateStorageInterface,
+                    public virtual storage::MergeableStorageInterface
+{
+public:
+    using Ptr = std::shared_ptr<MVCCStorage>;
+    constexpr static int64_t c_latestVersion = std::numeric_limits<int64_t>::max();
+    // the key is read from the prev storage
+    constexpr static int64_t c_prevVersion = -1;
+
+    explicit MVCCStorage(std::shared_ptr<StorageInterface> prev)
+      : storage::StateStorageInterface(std::move(prev)),
+        m_txIndex(c_latestVersion),
+        m_buckets(std::thread::hardware_concurrency())
+    {}
+
+    MVCCStorage(const MVCCStorage&) = delete;
+    MVCCStorage& operator=(const MVCCStorage&) = delete;
+
+    MVCCStorage(MVCCStorage&&) = delete;
+    MVCCStorage& operator=(MVCCStorage&&) = delete;
+
+    ~MVCCStorage() override { m_recoder.clear(); }
+
+    void setTxIndex(int64_t txIndex) { m_txIndex.local() = txIndex; }
+    int64_t txIndex() const { return m_txIndex.local(); }
+
+    void asyncGetPrimaryKeys(std::string_view table,
+        const std::optional<storage::Condition const>& _condition,
+        std::function<void(Error::UniquePtr, std::vector<std::string>)> _callback) override
+    {
+        auto txIndex = m_txIndex.local();
+        std::map<std::string, storage::Entry::Status> localKeys;
+        for (auto& bucket : m_buckets)
+        {
+            std::shared_lock lock(bucket.mutex);
+            for (auto const& it : bucket.container)
+            {
+                if (it.table != table || (_condition && !_condition->isValid(it.key)))
+                {
+                    continue;
+                }
+                auto version = findVersion(it.versions, txIndex);
+                if (version != it.versions.end())
+                {
+                    localKeys.emplace(it.key, version->second.status());
+                }
+            }
+        }
+
+        auto prev = getPrev();
+        if (!prev)
+        {
+            std::vector<std::string> resultKeys;
+            for (auto& localIt : localKeys)
+            {
+                if (localIt.second != Entry::DELETED)
+                {
+                    resultKeys.push_back(localIt.first);
+                }
+            }
+            _callback(nullptr, std::move(resultKeys));
+            return;
+        }
+
+        prev->asyncGetPrimaryKeys(table, _condition,
+            [localKeys = std::move(localKeys), callback = std::move(_callback)](
+                auto&& error, std::vector<std::string>&& remoteKeys) mutable {
+                if (error)
+                {
+                    callback(BCOS_ERROR_WITH_PREV_UNIQUE_PTR(StorageError::ReadError,
+                                 "Get primary keys from prev failed!", *error),
+                        std::vector<std::string>());
+                    return;
+                }
+
+                std::vector<std::string> resultKeys;
+                resultKeys.reserve(remoteKeys.size() + localKeys.size());
+                for (auto& key : remoteKeys)
+                {
+                    if (localKeys.find(key) == localKeys.end())
+                    {
+                        resultKeys.emplace_back(std::move(key));
+                    }
+                }
+                for (auto& localIt : localKeys)
+                {
+                    if (localIt.second != Entry::DELETED)
+                    {
+                        resultKeys.push_back(localIt.first);
+                    }
+                }
+                callback(nullptr, std::move(resultKeys));
+            });
+    }
+
+    void asyncGetRow(std::string_view tableView, std::string_view keyView,
+        std::function<void(Error::UniquePtr, std::optional<Entry>)> _callback) override
+    {
+        std::optional<Entry> entry;
+        if (readVersion(tableView, keyView, m_txIndex.local(), entry) != c_prevVersion)
+        {
+            _callback(nullptr, std::move(entry));
+            return;
+        }
+
+        auto prev = getPrev();
+        if (!prev)
+        {
+            _callback(nullptr, std::nullopt);
+            return;
+        }
+        prev->asyncGetRow(tableView, keyView,
+            [_callback = std::move(_callback)](Error::UniquePtr error, std::optional<Entry> entry) {
+                if (error)
+                {
+                    _callback(BCOS_ERROR_WITH_PREV_UNIQUE_PTR(StorageError::ReadError,
+                                  "Get row from storage failed!", *error),
+                        {});
+                    return;
+                }
+                _callback(nullptr, std::move(entry));
+            });
+    }
+
+    void asyncGetRows(std::string_view tableView,
+        const std::variant<const gsl::span<std::string_view const>,
+            const gsl::span<std::string const>>& _keys,
+        std::function<void(Error::UniquePtr, std::vector<std::optional<Entry>>)> _callback) override
+    {
+        std::visit(
+            [this, &tableView, &_callback](auto&& _keys) {
+                auto txIndex = m_txIndex.local();
+                std::vector<std::optional<Entry>> results(_keys.size());
+                std::vector<std::string_view> missingKeys;
+                std::vector<size_t> missingIndexes;
+                for (size_t i = 0; i < _keys.size(); ++i)
+                {
+                    if (readVersion(tableView, _keys[i], txIndex, results[i]) == c_prevVersion)
+                    {
+                        missingKeys.emplace_back(_keys[i]);
+                        missingIndexes.emplace_back(i);
+                    }
+                }
+
+                auto prev = getPrev();
+                if (missingKeys.empty() || !prev)
+                {
+                    _callback(nullptr, std::move(results));
+                    return;
+                }
+                prev->asyncGetRows(tableView, missingKeys,
+                    [callback = std::move(_callback), missingIndexes = std::move(missingIndexes),
+                        results = std::move(results)](
+                        auto&& error, std::vector<std::optional<Entry>>&& entries) mutable {
+                        if (error)
+                        {
+                            callback(BCOS_ERROR_WITH_PREV_UNIQUE_PTR(StorageError::ReadError,
+                                         "async get perv rows failed!", *error),
+                                std::vector<std::optional<Entry>>());
+                            return;
+                        }
+                        for (size_t i = 0; i < entries.size(); ++i)
+                        {
+                            results[missingIndexes[i]] = std::move(entries[i]);
+                        }
+                        callback(nullptr, std::move(results));
+                    });
+            },
+            _keys);
+    }
+
+    void asyncSetRow(std::string_view tableView, std::string_view keyView, Entry entry,
+        std::function<void(Error::UniquePtr)> callback) override
+    {
+        if (m_readOnly)
+        {
+            callback(BCOS_ERROR_UNIQUE_PTR(
+                StorageError::ReadOnly, "Try to operate a read-only storage"));
+            return;
+        }
+
+        auto txIndex = m_txIndex.local();
+        std::optional<Entry> entryOld;
+        {
+            auto& bucket = getBucket(tableView, keyView);
+            std::unique_lock lock(bucket.mutex);
+            auto it = bucket.container.find(std::make_tuple(tableView, keyView));
+            if (it == bucket.container.end())
+            {
+                it = bucket.container.emplace(Data{std::string(tableView), std::string(keyView), {}})
+                         .first;
+            }
+            auto version = it->versions.find(txIndex);
+            if (version != it->versions.end())
+            {
+                entryOld.emplace(std::move(version->second));
+                version->second = std::move(entry);
+            }
+            else
+            {
+                it->versions.emplace(txIndex, std::move(entry));
+            }
+        }
+
+        if (m_recoder.local())
+        {
+            m_recoder.local()->log(
+                Recoder::Change(std::string(tableView), std::string(keyView), std::move(entryOld)));
+        }
+        callback(nullptr);
+    }
+
+    // return the index of the transaction which wrote the version visible to txIndex, or
+    // c_prevVersion if the key is not written by the transactions in [0, txIndex]
+    int64_t lastWriter(std::string_view table, std::string_view key, int64_t txIndex) const
+    {
+        auto& bucket = getBucket(table, key);
+        std::shared_lock lock(bucket.mutex);
+        auto it = bucket.container.find(std::make_tuple(table, key));
+        if (it == bucket.container.end())
+        {
+            return c_prevVersion;
+        }
+        auto version = findVersion(it->versions, txIndex);
+        return version == it->versions.end() ? c_prevVersion : version->first;
+    }
+
+    // drop all the versions written by the transaction, for re-executing it
+    void discard(int64_t txIndex)
+    {
+        for (auto& bucket : m_buckets)
+        {
+            std::unique_lock lock(bucket.mutex);
+            for (auto it = bucket.container.begin(); it != bucket.container.end();)
+            {
+                it->versions.erase(txIndex);
+                if (it->versions.empty())
+                {
+                    it = bucket.container.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+    }
+
+    size_t versionCount() const
+    {
+        size_t count = 0;
+        for (auto& bucket : m_buckets)
+        {
+            std::shared_lock lock(bucket.mutex);
+            for (auto const& it : bucket.container)
+            {
+                count += it.versions.size();
+            }
+        }
+        return count;
+    }
+
+    // traverse the latest version of each key
+    void parallelTraverse(bool onlyDirty, std::function<bool(const std::string_view& table,
+                                              const std::string_view& key, const Entry& entry)>
+                                              callback) const override
+    {
+#pragma omp parallel for
+        for (size_t i = 0; i < m_buckets.size(); ++i)
+        {
+            auto& bucket = m_buckets[i];
+            std::shared_lock lock(bucket.mutex);
+            for (auto const& it : bucket.container)
+            {
+                auto const& entry = it.versions.rbegin()->second;
+                if (!onlyDirty || entry.dirty())
+                {
+                    callback(it.table, it.key, entry);
+                }
+            }
+        }
+    }
+
+    void merge(bool onlyDirty, const TraverseStorageInterface& source) override
+    {
+        if (&source == this)
+        {
+            STORAGE_LOG(ERROR) << "Can't merge from self!";
+            BOOST_THROW_EXCEPTION(BCOS_ERROR(-1, "Can't merge from self!"));
+        }
+
+        std::atomic_size_t count = 0;
+        source.parallelTraverse(
+            onlyDirty, [this, &count](const std::string_view& table, const std::string_view& key,
+                           const storage::Entry& entry) {
+                asyncSetRow(table, key, entry, [](Error::UniquePtr) {});
+                ++count;
+                return true;
+            });
+
+        STORAGE_LOG(INFO) << "Successful merged records" << LOG_KV("count", count);
+    }
+
+    crypto::HashType hash(const bcos::crypto::Hash::Ptr& hashImpl) const override
+    {
+        bcos::crypto::HashType totalHash(0);
+        parallelTraverse(true, [&hashImpl, &totalHash, this](const std::string_view& table,
+                                   const std::string_view& key, const Entry& entry) {
+            auto entryHash = hashImpl->hash(std::string(table)) ^
+                             hashImpl->hash(std::string(key)) ^ entry.hash(table, key, hashImpl);
+            std::unique_lock lock(x_hash);
+            totalHash ^= entryHash;
+            return true;
+        });
+        return totalHash;
+    }
+
+    void rollback(const Recoder& recoder) override
+    {
+        if (m_readOnly)
+        {
+            return;
+        }
+
+        auto txIndex = m_txIndex.local();
+        for (auto& change : recoder)
+        {
+            auto& bucket = getBucket(change.table, change.key);
+            std::unique_lock lock(bucket.mutex);
+            auto it = bucket.container.find(
+                std::make_tuple(std::string_view(change.table), std::string_view(change.key)));
+            if (it == bucket.container.end())
+            {
+                auto message = (boost::format("Not found rollback entry: %s:%s") % change.table %
+                                change.key)
+                                   .str();
+                BOOST_THROW_EXCEPTION(BCOS_ERROR(StorageError::UnknownError, message));
+            }
+
+            if (change.entry)
+            {
+                it->versions.insert_or_assign(txIndex, std::move(*change.entry));
+            }
+            else
+            {
+                // nullopt means the transaction had not written the key
+                it->versions.erase(txIndex);
+                if (it->versions.empty())
+                {
+                    bucket.container.erase(it);
+                }
+            }
+        }
+    }
+
+private:
+    using Versions = std::map<int64_t, Entry>;
+
+    // the latest version not after txIndex
+    static Versions::const_iterator findVersion(Versions const& versions, int64_t txIndex)
+    {
+        auto it = versions.upper_bound(txIndex);
+        if (it == versions.begin())
+        {
+            return versions.end();
+        }
+        return --it;
+    }
+
+    int64_t readVersion(std::string_view table, std::string_view key, int64_t txIndex,
+        std::optional<Entry>& entry) const
+    {
+        auto& bucket = getBucket(table, key);
+        std::shared_lock lock(bucket.mutex);
+        auto it = bucket.container.find(std::make_tuple(table, key));
+        if (it == bucket.container.end())
+        {
+            return c_prevVersion;
+        }
+        auto version = findVersion(it->versions, txIndex);
+        if (version == it->versions.end())
+        {
+            return c_prevVersion;
+        }
+        if (version->second.status() == Entry::DELETED)
+        {
+            entry = std::nullopt;
+        }
+        else
+        {
+            entry.emplace(version->second);
+        }
+        return version->first;
+    }
+
+    std::shared_ptr<StorageInterface> getPrev()
+    {
+        std::shared_lock<std::shared_mutex> lock(m_prevMutex);
+        auto prev = m_prev;
+        return prev;
+    }
+
+    struct Data
+    {
+        std::string table;
+        std::string key;
+        // the versions are not part of the index
+        mutable Versions versions;
+
+        std::tuple<std::string_view, std::string_view> view() const
+        {
+            return std::make_tuple(std::string_view(table), std::string_view(key));
+        }
+    };
+
+    using Container = boost::multi_index_container<Data,
+        boost::multi_index::indexed_by<boost::multi_index::hashed_unique<boost::multi_index::
+                const_mem_fun<Data, std::tuple<std::string_view, std::string_view>, &Data::view>>>>;
+
+    struct Bucket
+    {
+        Container container;
+        mutable std::shared_mutex mutex;
+    };
+
+    Bucket& getBucket(std::string_view table, std::string_view key) const
+    {
+        auto hash = std::hash<std::string_view>{}(table);
+        boost::hash_combine(hash, std::hash<std::string_view>{}(key));
+        return m_buckets[hash % m_buckets.size()];
+    }
+
+    mutable tbb::enumerable_thread_specific<int64_t> m_txIndex;
+    mutable std::vector<Bucket> m_buckets;
+    mutable std::mutex x_hash;
+};
+}  // namespace bcos::storage
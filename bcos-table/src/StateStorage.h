@@ -211,6 +211,7 @@ public:
                 auto optionalEntry = std::make_optional(entry);
                 if constexpr (enableLRU)
                 {
+                    ++bucket->hits;
                     updateMRUAndCheck(*bucket, it);
                 }
 
@@ -224,6 +225,10 @@ public:
         else
         {
             STORAGE_REPORT_GET(tableView, keyView, std::nullopt, "NO ENTRY");
+            if constexpr (enableLRU)
+            {
+                ++bucket->misses;
+            }
         }
         lock.unlock();
 
@@ -292,6 +297,7 @@ public:
 
                             if constexpr (enableLRU)
                             {
+                                ++bucket->hits;
                                 updateMRUAndCheck(*bucket, it);
                             }
                         }
@@ -303,6 +309,10 @@ public:
                     }
                     else
                     {
+                        if constexpr (enableLRU)
+                        {
+                            ++bucket->misses;
+                        }
 #pragma omp critical
                         {
                             std::get<1>(missinges).emplace_back(std::string(_keys[i]), i);
@@ -549,6 +559,45 @@ public:
         m_enableTraverse = enableTraverse;
     }
 
+    // the most frequently accessed keys, for warming up the cache after restart
+    std::vector<std::tuple<std::string, std::string, uint32_t>> hotKeys(size_t limit)
+    {
+        std::vector<std::tuple<std::string, std::string, uint32_t>> keys;
+        for (auto& bucket : m_buckets)
+        {
+            std::unique_lock<std::mutex> lock(bucket.mutex);
+            for (auto& it : bucket.container)
+            {
+                if (it.entry.status() != Entry::DELETED)
+                {
+                    keys.emplace_back(it.table, it.key, it.hits);
+                }
+            }
+        }
+        if (keys.size() > limit)
+        {
+            std::nth_element(keys.begin(), keys.begin() + limit, keys.end(),
+                [](auto const& lhs, auto const& rhs) { return std::get<2>(lhs) > std::get<2>(rhs); });
+            keys.resize(limit);
+        }
+        return keys;
+    }
+
+    // the lookups served by the cache and the lookups passed to the prev storage, only counted by
+    // the LRU storage
+    std::tuple<uint64_t, uint64_t> hitsAndMisses()
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        for (auto& bucket : m_buckets)
+        {
+            std::unique_lock<std::mutex> lock(bucket.mutex);
+            hits += bucket.hits;
+            misses += bucket.misses;
+        }
+        return {hits, misses};
+    }
+
     void setMaxCapacity(ssize_t capacity)
     {
         m_maxCapacity = capacity;
@@ -608,6 +657,8 @@ private:
         std::string table;
         std::string key;
         Entry entry;
+        // the access count, only updated by the LRU storage
+        mutable uint32_t hits = 0;
 
         std::tuple<std::string_view, std::string_view> view() const
         {
@@ -630,6 +681,8 @@ private:
         Container container;
         std::mutex mutex;
         ssize_t capacity = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
     };
     std::vector<Bucket> m_buckets;
 
@@ -647,6 +700,7 @@ private:
     void updateMRUAndCheck(
         Bucket& bucket, typename Container::template nth_index<0>::type::iterator it)
     {
+        ++it->hits;
         auto seqIt = bucket.container.template get<1>().iterator_to(*it);
         bucket.container.template get<1>().relocate(
             bucket.container.template get<1>().end(), seqIt);
@@ -0,0 +1,116 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief Unit tests for the CacheWarmer
+ * @file TestCacheWarmer.cpp
+ */
+
+#include "bcos-table/src/CacheWarmer.h"
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+
+using namespace bcos;
+using namespace bcos::storage;
+
+namespace bcos::test
+{
+struct CacheWarmerFixture
+{
+    CacheWarmerFixture()
+    {
+        path = (boost::filesystem::temp_directory_path() /
+                boost::filesystem::unique_path("hot_keys_%%%%%%"))
+                   .string();
+        backend = std::make_shared<StateStorage>(nullptr);
+        for (int i = 0; i < 10; ++i)
+        {
+            Entry entry;
+            entry.importFields({"value" + std::to_string(i)});
+            backend->asyncSetRow(table, "key" + std::to_string(i), std::move(entry),
+                [](Error::UniquePtr error) { BOOST_CHECK(!error); });
+        }
+    }
+    ~CacheWarmerFixture() { boost::filesystem::remove(path); }
+
+    static void getRow(StorageInterface& storage, std::string_view key)
+    {
+        storage.asyncGetRow(table, key,
+            [](Error::UniquePtr error, std::optional<Entry> entry) {
+                BOOST_CHECK(!error);
+                BOOST_CHECK(entry);
+            });
+    }
+
+    constexpr static std::string_view table = "t_test";
+    std::string path;
+    std::shared_ptr<StateStorage> backend;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestCacheWarmer, CacheWarmerFixture)
+
+BOOST_AUTO_TEST_CASE(hotKeysFile)
+{
+    CacheWarmer::HotKeys keys{{"t_a", "key1", 3}, {"t_b", std::string("\0key2", 5), 1}};
+    BOOST_CHECK(CacheWarmer::writeHotKeys(path, keys));
+    auto loaded = CacheWarmer::readHotKeys(path);
+    BOOST_REQUIRE(loaded);
+    BOOST_CHECK(*loaded == keys);
+
+    // truncated file
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write("\1\0\0\0", 4);
+    out.close();
+    BOOST_CHECK(!CacheWarmer::readHotKeys(path));
+    BOOST_CHECK(!CacheWarmer::readHotKeys(path + ".missing"));
+}
+
+BOOST_AUTO_TEST_CASE(dumpAndPrefetch)
+{
+    auto cache = std::make_shared<LRUStateStorage>(backend);
+    for (int i = 0; i < 5; ++i)
+    {
+        for (int hit = 0; hit <= i; ++hit)
+        {
+            getRow(*cache, "key" + std::to_string(i));
+        }
+    }
+    // only the 3 hottest keys are dumped
+    CacheWarmer warmer(cache, path, 3);
+    BOOST_CHECK_EQUAL(warmer.dump(), 3);
+    auto keys = CacheWarmer::readHotKeys(path);
+    BOOST_REQUIRE(keys);
+    std::set<std::string> dumped;
+    for (auto const& [tableName, key, hits] : *keys)
+    {
+        BOOST_CHECK_EQUAL(tableName, table);
+        dumped.insert(key);
+    }
+    BOOST_CHECK(dumped == std::set<std::string>({"key2", "key3", "key4"}));
+
+    // restart with an empty cache
+    auto restarted = std::make_shared<LRUStateStorage>(backend);
+    CacheWarmer restartedWarmer(restarted, path, 3);
+    BOOST_CHECK_EQUAL(restartedWarmer.prefetch(), 3);
+    auto [hitsBefore, missesBefore] = restarted->hitsAndMisses();
+    getRow(*restarted, "key4");
+    auto [hits, misses] = restarted->hitsAndMisses();
+    BOOST_CHECK_EQUAL(hits, hitsBefore + 1);
+    BOOST_CHECK_EQUAL(misses, missesBefore);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
@@ -0,0 +1,244 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief Unit tests for the KeyPageCodec
+ * @file TestKeyPageCodec.cpp
+ */
+
+#include "bcos-table/src/KeyPageCodec.h"
+#include "bcos-table/src/KeyPageStorage.h"
+#include "bcos-table/src/StateStorage.h"
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::storage;
+
+namespace bcos::test
+{
+struct KeyPageCodecFixture
+{
+    KeyPageCodecFixture() { boost::log::core::get()->set_logging_enabled(false); }
+    ~KeyPageCodecFixture()
+    {
+        KeyPageCodec::setFormat(KeyPageFormat::LEGACY, false);
+        boost::log::core::get()->set_logging_enabled(true);
+    }
+
+    static std::string keyOf(int i)
+    {
+        auto key = std::to_string(i);
+        return "account_" + std::string(6 - key.size(), '0') + key;
+    }
+
+    static KeyPageStorage::Page makePage(int count)
+    {
+        KeyPageStorage::Page page;
+        for (int i = 0; i < count; ++i)
+        {
+            Entry entry;
+            entry.setField(0, "value" + std::to_string(i));
+            entry.setStatus(i % 7 == 3 ? Entry::Status::DELETED : Entry::Status::MODIFIED);
+            page.setEntry(keyOf(i), std::move(entry));
+        }
+        return page;
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestKeyPageCodec, KeyPageCodecFixture)
+
+BOOST_AUTO_TEST_CASE(encodeAndFind)
+{
+    for (auto count : {0, 1, 16, 17, 100})
+    {
+        KeyPageEncoder encoder;
+        for (int i = 0; i < count; ++i)
+        {
+            encoder.add(keyOf(i * 2), "value" + std::to_string(i));
+        }
+        auto encoded = encoder.finish(false);
+        BOOST_CHECK(KeyPageCodec::isBinary(encoded));
+
+        KeyPageReader reader(encoded);
+        BOOST_CHECK_EQUAL(reader.count(), count);
+        int index = 0;
+        reader.forEach([&index](std::string_view key, std::string_view value) {
+            BOOST_CHECK_EQUAL(key, keyOf(index * 2));
+            BOOST_CHECK_EQUAL(value, "value" + std::to_string(index));
+            ++index;
+        });
+        BOOST_CHECK_EQUAL(index, count);
+        for (int i = 0; i < count; ++i)
+        {
+            auto value = reader.find(keyOf(i * 2));
+            BOOST_REQUIRE(value);
+            BOOST_CHECK_EQUAL(*value, "value" + std::to_string(i));
+            BOOST_CHECK(!reader.find(keyOf(i * 2 + 1)));
+        }
+        BOOST_CHECK(!reader.find(""));
+        BOOST_CHECK(!reader.find("account_"));
+        BOOST_CHECK(!reader.find("z"));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(compression)
+{
+    KeyPageEncoder encoder;
+    for (int i = 0; i < 100; ++i)
+    {
+        encoder.add(keyOf(i), std::string(64, 'a' + i % 4));
+    }
+    auto encoded = encoder.finish(true);
+    BOOST_CHECK_EQUAL(encoded[5], KeyPageCodec::ZSTD);
+    BOOST_CHECK_LT(encoded.size(), 100 * 64);
+    KeyPageReader reader(encoded);
+    BOOST_CHECK_EQUAL(reader.count(), 100);
+    BOOST_CHECK_EQUAL(*reader.find(keyOf(42)), std::string(64, 'c'));
+
+    // the small block is not compressed
+    KeyPageEncoder small;
+    small.add("key", "value");
+    BOOST_CHECK_EQUAL(small.finish(true)[5], KeyPageCodec::NONE);
+}
+
+BOOST_AUTO_TEST_CASE(corrupted)
+{
+    KeyPageEncoder encoder;
+    for (int i = 0; i < 20; ++i)
+    {
+        encoder.add(keyOf(i), "value");
+    }
+    auto encoded = encoder.finish(false);
+    BOOST_CHECK_THROW(KeyPageReader(encoded.substr(0, encoded.size() - 1)), bcos::Error);
+    auto badVersion = encoded;
+    badVersion[4] = 2;
+    BOOST_CHECK_THROW(KeyPageReader{badVersion}, bcos::Error);
+
+    // the block size of the compressed page must match the zstd frame, and is bounded
+    KeyPageEncoder compressedEncoder;
+    for (int i = 0; i < 100; ++i)
+    {
+        compressedEncoder.add(keyOf(i), std::string(64, 'a'));
+    }
+    auto compressed = compressedEncoder.finish(true);
+    BOOST_REQUIRE_EQUAL(compressed[5], KeyPageCodec::ZSTD);
+    // larger than c_maxBlockSize, and larger than the frame content
+    for (auto blockSize :
+        {std::string("\xFF\xFF\xFF\xFF", 4), std::string("\x00\x00\x00\x08", 4)})
+    {
+        auto badSize = compressed;
+        badSize.replace(6, 4, blockSize);
+        BOOST_CHECK_THROW(KeyPageReader{badSize}, bcos::Error);
+    }
+    BOOST_CHECK(!KeyPageCodec::isBinary(std::string("\x05\0\0\0", 4)));
+    BOOST_CHECK(!KeyPageCodec::isBinary(""));
+}
+
+BOOST_AUTO_TEST_CASE(pageFormats)
+{
+    auto page = makePage(50);
+    KeyPageStorage::TableMeta meta;
+    meta.insertPageInfoNoLock(KeyPageStorage::PageInfo(keyOf(20), 18, 300, nullptr));
+    meta.insertPageInfoNoLock(KeyPageStorage::PageInfo(keyOf(49), 25, 400, nullptr));
+
+    for (auto compress : {false, true})
+    {
+        Entry legacy;
+        page.encode(legacy);
+        Entry legacyMeta;
+        meta.encode(legacyMeta);
+        BOOST_CHECK(!KeyPageCodec::isBinary(legacy.get()));
+        BOOST_CHECK(!KeyPageCodec::isBinary(legacyMeta.get()));
+
+        KeyPageCodec::setFormat(KeyPageFormat::BINARY, compress);
+        Entry binary;
+        page.encode(binary);
+        Entry binaryMeta;
+        meta.encode(binaryMeta);
+        BOOST_CHECK(KeyPageCodec::isBinary(binary.get()));
+        BOOST_CHECK_LT(binary.size(), legacy.size());
+        BOOST_CHECK_LT(binaryMeta.size(), legacyMeta.size());
+
+        // both the formats are readable
+        for (auto const* value : {&legacy, &binary})
+        {
+            KeyPageStorage::Page decoded(value->get(), keyOf(49));
+            BOOST_CHECK_EQUAL(decoded.validCount(), page.validCount());
+            BOOST_CHECK_EQUAL(decoded.count(), page.validCount());
+            BOOST_CHECK_EQUAL(decoded.startKey(), keyOf(0));
+            BOOST_CHECK_EQUAL(decoded.endKey(), keyOf(49));
+            BOOST_CHECK(decoded.invalidKeySet().empty());
+            auto entry = decoded.getEntry(keyOf(11));
+            BOOST_REQUIRE(entry);
+            BOOST_CHECK_EQUAL(entry->get(), "value11");
+            BOOST_CHECK(!decoded.getEntry(keyOf(3)));
+        }
+        KeyPageStorage::Page legacyPage(legacy.get(), keyOf(49));
+        KeyPageStorage::Page binaryPage(binary.get(), keyOf(49));
+        BOOST_CHECK_EQUAL(legacyPage.size(), binaryPage.size());
+        for (auto const* value : {&legacyMeta, &binaryMeta})
+        {
+            KeyPageStorage::TableMeta decoded(value->get());
+            auto& pages = decoded.getAllPageInfoNoLock();
+            BOOST_REQUIRE_EQUAL(pages.size(), 2);
+            BOOST_CHECK_EQUAL(pages[1].getPageKey(), keyOf(49));
+            BOOST_CHECK_EQUAL(pages[1].getCount(), 25);
+            BOOST_CHECK_EQUAL(pages[1].getSize(), 400);
+        }
+        KeyPageCodec::setFormat(KeyPageFormat::LEGACY, false);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(storage)
+{
+    KeyPageCodec::setFormat(KeyPageFormat::BINARY, true);
+    auto backend = std::make_shared<StateStorage>(nullptr);
+    auto storage = std::make_shared<KeyPageStorage>(backend);
+    storage->createTable("t_test", "value");
+    auto table = storage->openTable("t_test");
+    for (int i = 0; i < 200; ++i)
+    {
+        auto entry = table->newEntry();
+        entry.setField(0, "value" + std::to_string(i));
+        table->setRow(keyOf(i), std::move(entry));
+    }
+    storage->parallelTraverse(
+        true, [&backend](auto const& table, auto const& key, auto const& entry) {
+            backend->asyncSetRow(table, key, entry, [](Error::UniquePtr error) {
+                BOOST_CHECK(!error);
+            });
+            return true;
+        });
+    std::atomic_bool binary = false;
+    backend->parallelTraverse(false, [&binary](auto const&, auto const&, auto const& entry) {
+        binary = binary || KeyPageCodec::isBinary(entry.get());
+        return true;
+    });
+    BOOST_CHECK(binary);
+
+    auto reader = std::make_shared<KeyPageStorage>(backend);
+    table = reader->openTable("t_test");
+    BOOST_REQUIRE(table);
+    for (int i = 0; i < 200; ++i)
+    {
+        auto entry = table->getRow(keyOf(i));
+        BOOST_REQUIRE(entry);
+        BOOST_CHECK_EQUAL(entry->get(), "value" + std::to_string(i));
+    }
+    BOOST_CHECK(!table->getRow(keyOf(200)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
@@ -2705,6 +2705,74 @@ BOOST_AUTO_TEST_CASE(insertAndDelete)
     }
 }
 
+BOOST_AUTO_TEST_CASE(adaptivePageSize)
+{
+    KeyPageStorage::TableMeta hotMeta;
+    for (int i = 0; i < 4096; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            hotMeta.recordRead();
+        }
+        else
+        {
+            hotMeta.recordWriteNoLock(true, 40);
+        }
+    }
+    BOOST_CHECK(hotMeta.adaptPageSizeNoLock(10240));
+    BOOST_CHECK_EQUAL(hotMeta.getPageSize(), 2560);
+    // the decision is kept until the next interval
+    BOOST_CHECK(!hotMeta.adaptPageSizeNoLock(10240));
+
+    KeyPageStorage::TableMeta appendMeta;
+    for (int i = 0; i < 4096; ++i)
+    {
+        appendMeta.recordWriteNoLock(false, 100);
+    }
+    BOOST_CHECK(appendMeta.adaptPageSizeNoLock(10240));
+    BOOST_CHECK_EQUAL(appendMeta.getPageSize(), 40960);
+    appendMeta.insertPageInfoNoLock(KeyPageStorage::PageInfo("key", 1, 100, nullptr));
+
+    // the page size is persisted in both the formats
+    for (auto format : {KeyPageFormat::LEGACY, KeyPageFormat::BINARY})
+    {
+        KeyPageCodec::setFormat(format, false);
+        Entry entry;
+        appendMeta.encode(entry);
+        KeyPageStorage::TableMeta decoded(entry.get());
+        BOOST_CHECK_EQUAL(decoded.getPageSize(), 40960);
+        BOOST_CHECK_EQUAL(decoded.size(), 1);
+    }
+    KeyPageCodec::setFormat(KeyPageFormat::LEGACY, false);
+
+    // the hot table is split into smaller pages, the hash doesn't depend on the pages
+    auto updateBalances = [this](bool adaptive) {
+        KeyPageStorage::setAdaptivePageSize(adaptive);
+        auto storage = make_shared<KeyPageStorage>(make_shared<StateStorage>(nullptr), 10240);
+        storage->createTable("t_balance", "value");
+        auto table = storage->openTable("t_balance");
+        for (int i = 0; i < 10000; ++i)
+        {
+            auto key = "account" + std::to_string(i % 200);
+            table->getRow(key);
+            auto entry = table->newEntry();
+            entry.setField(0, std::to_string(i));
+            table->setRow(key, std::move(entry));
+        }
+        auto meta = storage->copyData("t_balance", "");
+        BOOST_REQUIRE(meta);
+        auto& tableMeta = std::get<1>(meta.value()->data);
+        return std::make_tuple(
+            tableMeta.getPageSize(), tableMeta.size(), storage->hash(hashImpl).hex());
+    };
+    auto [pageSize, pageCount, hash] = updateBalances(false);
+    auto [adaptivePageSize, adaptivePageCount, adaptiveHash] = updateBalances(true);
+    KeyPageStorage::setAdaptivePageSize(false);
+    BOOST_CHECK_EQUAL(pageSize, 0);
+    BOOST_CHECK_EQUAL(adaptivePageSize, 2560);
+    BOOST_CHECK_GT(adaptivePageCount, pageCount);
+    BOOST_CHECK_EQUAL(adaptiveHash, hash);
+}
 
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
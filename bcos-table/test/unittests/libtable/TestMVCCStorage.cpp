@@ -0,0 +1,175 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief Unit tests for the MVCCStorage
+ * @file TestMVCCStorage.cpp
+ */
+
+#include "bcos-table/src/MVCCStorage.h"
+#include "bcos-table/src/StateStorage.h"
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <tbb/parallel_for.h>
+#include <boost/lexical_cast.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::storage;
+
+namespace bcos::test
+{
+struct MVCCStorageFixture
+{
+    MVCCStorageFixture()
+    {
+        prev = std::make_shared<StateStorage>(nullptr);
+        setRow(*prev, "key", "prev");
+        mvcc = std::make_shared<MVCCStorage>(prev);
+    }
+
+    static void setRow(StorageInterface& storage, std::string_view key, std::string_view value)
+    {
+        Entry entry;
+        entry.importFields({std::string(value)});
+        storage.asyncSetRow(table, key, std::move(entry),
+            [](Error::UniquePtr error) { BOOST_CHECK(!error); });
+    }
+
+    static void deleteRow(StorageInterface& storage, std::string_view key)
+    {
+        Entry entry;
+        entry.setStatus(Entry::DELETED);
+        storage.asyncSetRow(table, key, std::move(entry),
+            [](Error::UniquePtr error) { BOOST_CHECK(!error); });
+    }
+
+    static std::string getRow(StorageInterface& storage, std::string_view key)
+    {
+        std::string value = "<none>";
+        storage.asyncGetRow(
+            table, key, [&value](Error::UniquePtr error, std::optional<Entry> entry) {
+                BOOST_CHECK(!error);
+                if (entry)
+                {
+                    value = entry->getField(0);
+                }
+            });
+        return value;
+    }
+
+    std::string getRowAt(int64_t txIndex, std::string_view key)
+    {
+        mvcc->setTxIndex(txIndex);
+        return getRow(*mvcc, key);
+    }
+
+    void setRowAt(int64_t txIndex, std::string_view key, std::string_view value)
+    {
+        mvcc->setTxIndex(txIndex);
+        setRow(*mvcc, key, value);
+    }
+
+    constexpr static std::string_view table = "t_test";
+    std::shared_ptr<StateStorage> prev;
+    std::shared_ptr<MVCCStorage> mvcc;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestMVCCStorage, MVCCStorageFixture)
+
+BOOST_AUTO_TEST_CASE(snapshotRead)
+{
+    setRowAt(2, "key", "tx2");
+    setRowAt(5, "key", "tx5");
+    setRowAt(3, "other", "tx3");
+    mvcc->setTxIndex(6);
+    deleteRow(*mvcc, "other");
+
+    BOOST_CHECK_EQUAL(getRowAt(0, "key"), "prev");
+    BOOST_CHECK_EQUAL(getRowAt(2, "key"), "tx2");
+    BOOST_CHECK_EQUAL(getRowAt(4, "key"), "tx2");
+    BOOST_CHECK_EQUAL(getRowAt(6, "key"), "tx5");
+    BOOST_CHECK_EQUAL(getRowAt(MVCCStorage::c_latestVersion, "key"), "tx5");
+    // deleted by tx 6
+    BOOST_CHECK_EQUAL(getRowAt(5, "other"), "tx3");
+    BOOST_CHECK_EQUAL(getRowAt(6, "other"), "<none>");
+
+    BOOST_CHECK_EQUAL(mvcc->lastWriter(table, "key", 1), MVCCStorage::c_prevVersion);
+    BOOST_CHECK_EQUAL(mvcc->lastWriter(table, "key", 3), 2);
+    BOOST_CHECK_EQUAL(mvcc->lastWriter(table, "key", 100), 5);
+
+    // the prev storage is not changed
+    BOOST_CHECK_EQUAL(getRow(*prev, "key"), "prev");
+}
+
+BOOST_AUTO_TEST_CASE(rollback)
+{
+    setRowAt(1, "key", "tx1");
+
+    auto recoder = std::make_shared<Recoder>();
+    mvcc->setTxIndex(3);
+    mvcc->setRecoder(recoder);
+    setRow(*mvcc, "key", "tx3-a");
+    setRow(*mvcc, "key", "tx3-b");
+    setRow(*mvcc, "new", "tx3");
+    BOOST_CHECK_EQUAL(getRowAt(3, "key"), "tx3-b");
+
+    mvcc->setTxIndex(3);
+    mvcc->rollback(*recoder);
+    mvcc->setRecoder(nullptr);
+    BOOST_CHECK_EQUAL(getRowAt(3, "key"), "tx1");
+    BOOST_CHECK_EQUAL(getRowAt(3, "new"), "<none>");
+    BOOST_CHECK_EQUAL(mvcc->versionCount(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(discardAndMerge)
+{
+    setRowAt(1, "key", "tx1");
+    setRowAt(2, "key", "tx2");
+    setRowAt(2, "new", "tx2");
+    mvcc->discard(2);
+    BOOST_CHECK_EQUAL(getRowAt(3, "key"), "tx1");
+    BOOST_CHECK_EQUAL(getRowAt(3, "new"), "<none>");
+
+    setRowAt(4, "key", "tx4");
+    setRowAt(4, "new", "tx4");
+    auto block = std::make_shared<StateStorage>(prev);
+    block->merge(true, *mvcc);
+    BOOST_CHECK_EQUAL(getRow(*block, "key"), "tx4");
+    BOOST_CHECK_EQUAL(getRow(*block, "new"), "tx4");
+}
+
+BOOST_AUTO_TEST_CASE(concurrentWrite)
+{
+    size_t count = 1000;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, count),
+        [this](const tbb::blocked_range<size_t>& range) {
+            for (auto i = range.begin(); i < range.end(); ++i)
+            {
+                // all the transactions write the same hot key
+                setRowAt(i, "key", boost::lexical_cast<std::string>(i));
+                setRowAt(i, "key_" + boost::lexical_cast<std::string>(i), "value");
+            }
+        });
+
+    BOOST_CHECK_EQUAL(mvcc->versionCount(), count * 2);
+    for (size_t i = 0; i < count; ++i)
+    {
+        BOOST_CHECK_EQUAL(getRowAt(i, "key"), boost::lexical_cast<std::string>(i));
+    }
+    BOOST_CHECK_EQUAL(getRowAt(MVCCStorage::c_latestVersion, "key"),
+        boost::lexical_cast<std::string>(count - 1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
@@ -22,6 +22,8 @@
 #include "../ErrorConverter.h"
 #include "../protocol/BlockHeaderImpl.h"
 #include "../protocol/ExecutionMessageImpl.h"
+#include <bcos-framework/executor/ExecuteError.h>
+#include <algorithm>
 
 using namespace bcostars;
 
@@ -173,151 +175,339 @@ void ExecutorServiceClient::executeTransactions(std::string contractAddress,
         bcos::Error::UniquePtr, std::vector<bcos::protocol::ExecutionMessage::UniquePtr>)>
         callback)
 {
-    class Callback : public ExecutorServicePrxCallback
-    {
-    public:
-        Callback(std::function<void(bcos::Error::UniquePtr,
-                std::vector<bcos::protocol::ExecutionMessage::UniquePtr>)>&& _callback)
-          : m_callback(std::move(_callback))
-        {}
-        ~Callback() override {}
+    asyncExecuteBatch(bcostars::protocol::ExecutorBatchType::EXECUTE, contractAddress, inputs,
+        std::move(callback));
+}
 
-        void callback_executeTransactions(const bcostars::Error& ret,
-            std::vector<bcostars::ExecutionMessage> const& executionMessages) override
+void ExecutorServiceClient::dmcExecuteTransactions(std::string contractAddress,
+    gsl::span<bcos::protocol::ExecutionMessage::UniquePtr> inputs,
+    std::function<void(
+        bcos::Error::UniquePtr, std::vector<bcos::protocol::ExecutionMessage::UniquePtr>)>
+        callback)
+{
+    asyncExecuteBatch(bcostars::protocol::ExecutorBatchType::DMC_EXECUTE, contractAddress, inputs,
+        std::move(callback));
+}
+
+void ExecutorServiceClient::dagExecuteTransactions(
+    gsl::span<bcos::protocol::ExecutionMessage::UniquePtr> inputs,
+    std::function<void(
+        bcos::Error::UniquePtr, std::vector<bcos::protocol::ExecutionMessage::UniquePtr>)>
+        callback)
+{
+    asyncExecuteBatch(
+        bcostars::protocol::ExecutorBatchType::DAG_EXECUTE, "", inputs, std::move(callback));
+}
+
+namespace
+{
+// the batches the calling thread is in
+thread_local std::vector<void*> t_batches;
+}  // namespace
+
+class ExecutorServiceClient::RequestBatch : public Batch
+{
+public:
+    RequestBatch(ExecutorServiceClient const* _client, ExecutorServicePrx _prx,
+        std::shared_ptr<std::atomic_bool> _legacy)
+      : m_client(_client), m_prx(std::move(_prx)), m_legacy(std::move(_legacy))
+    {}
+    ~RequestBatch() override {}
+
+    void enter() override { t_batches.emplace_back(this); }
+    void leave() override
+    {
+        auto it = std::find(t_batches.rbegin(), t_batches.rend(), this);
+        if (it != t_batches.rend())
         {
-            std::vector<bcos::protocol::ExecutionMessage::UniquePtr> inputList;
-            for (auto const& it : executionMessages)
+            t_batches.erase(std::next(it).base());
+        }
+    }
+    void flush() override
+    {
+        Requests requests;
+        {
+            std::lock_guard lock(x_requests);
+            if (m_requests.callbacks.empty())
             {
-                auto bcosExecutionMessage =
-                    std::make_unique<bcostars::protocol::ExecutionMessageImpl>(
-                        [m_executionMessage = it]() mutable { return &m_executionMessage; });
-                inputList.emplace_back(std::move(bcosExecutionMessage));
+                return;
             }
-            m_callback(toUniqueBcosError(ret), std::move(inputList));
+            std::swap(requests, m_requests);
         }
+        sendBatch(m_prx, m_legacy, std::move(requests));
+    }
 
-        void callback_executeTransactions_exception(tars::Int32 ret) override
+    // the batch of _client the calling thread is in
+    static RequestBatch* current(ExecutorServiceClient const* _client)
+    {
+        for (auto it = t_batches.rbegin(); it != t_batches.rend(); ++it)
         {
-            m_callback(
-                toUniqueBcosError(ret), std::vector<bcos::protocol::ExecutionMessage::UniquePtr>());
+            auto batch = static_cast<RequestBatch*>(*it);
+            if (batch->m_client == _client)
+            {
+                return batch;
+            }
         }
+        return nullptr;
+    }
 
-    private:
-        std::function<void(
-            bcos::Error::UniquePtr, std::vector<bcos::protocol::ExecutionMessage::UniquePtr>)>
-            m_callback;
+    template <class Encode>
+    void append(Encode&& _encode)
+    {
+        std::lock_guard lock(x_requests);
+        _encode(m_requests);
+    }
+
+private:
+    ExecutorServiceClient const* m_client;
+    ExecutorServicePrx m_prx;
+    std::shared_ptr<std::atomic_bool> m_legacy;
+    std::mutex x_requests;
+    Requests m_requests;
+};
+
+ExecutorServiceClient::Batch::Ptr ExecutorServiceClient::createBatch()
+{
+    if (*m_legacy)
+    {
+        return nullptr;
+    }
+    return std::make_shared<RequestBatch>(this, m_prx, m_legacy);
+}
+
+void ExecutorServiceClient::asyncExecuteBatch(bcostars::protocol::ExecutorBatchType _type,
+    std::string_view _contractAddress,
+    gsl::span<bcos::protocol::ExecutionMessage::UniquePtr> _inputs, BatchCallback _callback)
+{
+    if (*m_legacy)
+    {
+        std::vector<bcostars::ExecutionMessage> tarsInputs;
+        for (auto& it : _inputs)
+        {
+            auto executionMsgImpl =
+                std::move((bcostars::protocol::ExecutionMessageImpl::UniquePtr&)it);
+            tarsInputs.emplace_back(executionMsgImpl->inner());
+        }
+        sendLegacyRequest(
+            m_prx, _type, std::string(_contractAddress), tarsInputs, std::move(_callback));
+        return;
+    }
+    auto encodeRequest = [&](Requests& _requests) {
+        bcostars::protocol::ExecutorBatchCodec::encodeRequest(
+            _requests.frame, _type, _contractAddress, _inputs);
+        _requests.callbacks.emplace_back(std::move(_callback));
+        // the inputs are encoded into the frame, release them as early as before
+        for (auto& input : _inputs)
+        {
+            input.reset();
+        }
     };
-    std::vector<bcostars::ExecutionMessage> tarsInputs;
-    for (auto const& it : inputs)
+    if (auto batch = RequestBatch::current(this))
     {
-        auto executionMsgImpl = std::move((bcostars::protocol::ExecutionMessageImpl::UniquePtr&)it);
-        tarsInputs.emplace_back(executionMsgImpl->inner());
+        batch->append(encodeRequest);
+        return;
     }
-    // timeout is 30s
-    m_prx->tars_set_timeout(30000)->async_executeTransactions(
-        new Callback(std::move(callback)), contractAddress, tarsInputs);
+    Requests requests;
+    encodeRequest(requests);
+    sendBatch(m_prx, m_legacy, std::move(requests));
 }
 
-void ExecutorServiceClient::dmcExecuteTransactions(std::string contractAddress,
-    gsl::span<bcos::protocol::ExecutionMessage::UniquePtr> inputs,
-    std::function<void(
-        bcos::Error::UniquePtr, std::vector<bcos::protocol::ExecutionMessage::UniquePtr>)>
-        callback)
+void ExecutorServiceClient::sendBatch(
+    ExecutorServicePrx _prx, std::shared_ptr<std::atomic_bool> _legacy, Requests _requests)
 {
     class Callback : public ExecutorServicePrxCallback
     {
     public:
-        Callback(std::function<void(bcos::Error::UniquePtr,
-                std::vector<bcos::protocol::ExecutionMessage::UniquePtr>)>&& _callback)
-          : m_callback(std::move(_callback))
+        Callback(ExecutorServicePrx _prx, std::shared_ptr<std::atomic_bool> _legacy,
+            Requests&& _requests)
+          : m_prx(std::move(_prx)), m_legacy(std::move(_legacy)), m_requests(std::move(_requests))
         {}
         ~Callback() override {}
 
-        void callback_dmcExecuteTransactions(const bcostars::Error& ret,
-            std::vector<bcostars::ExecutionMessage> const& executionMessages) override
+        bcostars::protocol::ExecutorBatchCodec::Frame const& frame() const
         {
-            std::vector<bcos::protocol::ExecutionMessage::UniquePtr> inputList;
-            for (auto const& it : executionMessages)
+            return m_requests.frame;
+        }
+
+        void callback_executeBatch(
+            const bcostars::Error& ret, std::vector<tars::Char> const& _responses) override
+        {
+            if (ret.errorCode != 0)
             {
-                auto bcosExecutionMessage =
-                    std::make_unique<bcostars::protocol::ExecutionMessageImpl>(
-                        [m_executionMessage = it]() mutable { return &m_executionMessage; });
-                inputList.emplace_back(std::move(bcosExecutionMessage));
+                onError(ret.errorCode, ret.errorMessage);
+                return;
+            }
+            std::vector<bcostars::protocol::ExecutorBatchResponse> responses;
+            try
+            {
+                responses = bcostars::protocol::ExecutorBatchCodec::decodeResponses(
+                    bcostars::protocol::ExecutorBatchCodec::toBytesRef(_responses));
+            }
+            catch (std::exception const& e)
+            {
+                onError(bcos::executor::ExecuteError::EXECUTE_ERROR, e.what());
+                return;
+            }
+            auto& callbacks = m_requests.callbacks;
+            if (responses.size() != callbacks.size())
+            {
+                onError(bcos::executor::ExecuteError::EXECUTE_ERROR,
+                    "executeBatch: expect " + std::to_string(callbacks.size()) +
+                        " responses, but got " + std::to_string(responses.size()));
+                return;
+            }
+            for (size_t i = 0; i < callbacks.size(); ++i)
+            {
+                callbacks[i](std::move(responses[i].error), std::move(responses[i].messages));
             }
-            m_callback(toUniqueBcosError(ret), std::move(inputList));
         }
 
-        void callback_dmcExecuteTransactions_exception(tars::Int32 ret) override
+        void callback_executeBatch_exception(tars::Int32 ret) override
         {
-            m_callback(
-                toUniqueBcosError(ret), std::vector<bcos::protocol::ExecutionMessage::UniquePtr>());
+            if (ret == tars::TARSSERVERNOFUNCERR)
+            {
+                resendByLegacyRequests();
+                return;
+            }
+            for (auto& callback : m_requests.callbacks)
+            {
+                callback(toUniqueBcosError(ret),
+                    std::vector<bcos::protocol::ExecutionMessage::UniquePtr>());
+            }
         }
 
     private:
-        std::function<void(
-            bcos::Error::UniquePtr, std::vector<bcos::protocol::ExecutionMessage::UniquePtr>)>
-            m_callback;
+        void onError(int64_t _errorCode, std::string const& _errorMessage)
+        {
+            for (auto& callback : m_requests.callbacks)
+            {
+                callback(std::make_unique<bcos::Error>(_errorCode, _errorMessage),
+                    std::vector<bcos::protocol::ExecutionMessage::UniquePtr>());
+            }
+        }
+
+        // the executor is older than executeBatch, send the requests of the frame one by one
+        void resendByLegacyRequests()
+        {
+            if (!m_legacy->exchange(true))
+            {
+                BCOS_LOG(WARNING) << LOG_BADGE("ExecutorServiceClient")
+                                  << LOG_DESC("executeBatch is not supported by the executor, "
+                                              "fall back to the per-call requests");
+            }
+            std::vector<bcostars::protocol::ExecutorBatchRequest> requests;
+            try
+            {
+                requests = bcostars::protocol::ExecutorBatchCodec::decodeRequests(
+                    bcostars::protocol::ExecutorBatchCodec::toBytesRef(m_requests.frame));
+            }
+            catch (std::exception const& e)
+            {
+                onError(bcos::executor::ExecuteError::EXECUTE_ERROR, e.what());
+                return;
+            }
+            auto& callbacks = m_requests.callbacks;
+            for (size_t i = 0; i < callbacks.size() && i < requests.size(); ++i)
+            {
+                std::vector<bcostars::ExecutionMessage> tarsInputs;
+                tarsInputs.reserve(requests[i].messages.size());
+                for (auto& message : requests[i].messages)
+                {
+                    tarsInputs.emplace_back(
+                        static_cast<bcostars::protocol::ExecutionMessageImpl&>(*message).inner());
+                }
+                sendLegacyRequest(m_prx, requests[i].type, requests[i].contractAddress,
+                    tarsInputs, std::move(callbacks[i]));
+            }
+        }
+
+        ExecutorServicePrx m_prx;
+        std::shared_ptr<std::atomic_bool> m_legacy;
+        Requests m_requests;
     };
-    std::vector<bcostars::ExecutionMessage> tarsInputs;
-    for (auto const& it : inputs)
-    {
-        auto executionMsgImpl = std::move((bcostars::protocol::ExecutionMessageImpl::UniquePtr&)it);
-        tarsInputs.emplace_back(executionMsgImpl->inner());
-    }
+    auto callback = new Callback(_prx, std::move(_legacy), std::move(_requests));
     // timeout is 30s
-    m_prx->tars_set_timeout(30000)->async_dmcExecuteTransactions(
-        new Callback(std::move(callback)), contractAddress, tarsInputs);
+    _prx->tars_set_timeout(30000)->async_executeBatch(callback, callback->frame());
 }
 
-void ExecutorServiceClient::dagExecuteTransactions(
-    gsl::span<bcos::protocol::ExecutionMessage::UniquePtr> inputs,
-    std::function<void(
-        bcos::Error::UniquePtr, std::vector<bcos::protocol::ExecutionMessage::UniquePtr>)>
-        callback)
+void ExecutorServiceClient::sendLegacyRequest(ExecutorServicePrx _prx,
+    bcostars::protocol::ExecutorBatchType _type, std::string const& _contractAddress,
+    std::vector<bcostars::ExecutionMessage> const& _inputs, BatchCallback _callback)
 {
     class Callback : public ExecutorServicePrxCallback
     {
     public:
-        Callback(std::function<void(bcos::Error::UniquePtr,
-                std::vector<bcos::protocol::ExecutionMessage::UniquePtr>)>&& _callback)
-          : m_callback(std::move(_callback))
-        {}
+        Callback(BatchCallback&& _callback) : m_callback(std::move(_callback)) {}
         ~Callback() override {}
 
+        void callback_executeTransactions(const bcostars::Error& ret,
+            std::vector<bcostars::ExecutionMessage> const& executionMessages) override
+        {
+            onResponse(ret, executionMessages);
+        }
+        void callback_executeTransactions_exception(tars::Int32 ret) override
+        {
+            onException(ret);
+        }
+
+        void callback_dmcExecuteTransactions(const bcostars::Error& ret,
+            std::vector<bcostars::ExecutionMessage> const& executionMessages) override
+        {
+            onResponse(ret, executionMessages);
+        }
+        void callback_dmcExecuteTransactions_exception(tars::Int32 ret) override
+        {
+            onException(ret);
+        }
+
         void callback_dagExecuteTransactions(const bcostars::Error& ret,
             std::vector<bcostars::ExecutionMessage> const& executionMessages) override
         {
-            std::vector<bcos::protocol::ExecutionMessage::UniquePtr> inputList;
+            onResponse(ret, executionMessages);
+        }
+        void callback_dagExecuteTransactions_exception(tars::Int32 ret) override
+        {
+            onException(ret);
+        }
+
+    private:
+        void onResponse(const bcostars::Error& ret,
+            std::vector<bcostars::ExecutionMessage> const& executionMessages)
+        {
+            std::vector<bcos::protocol::ExecutionMessage::UniquePtr> outputs;
             for (auto const& it : executionMessages)
             {
                 auto bcosExecutionMessage =
                     std::make_unique<bcostars::protocol::ExecutionMessageImpl>(
                         [m_executionMessage = it]() mutable { return &m_executionMessage; });
-                inputList.emplace_back(std::move(bcosExecutionMessage));
+                outputs.emplace_back(std::move(bcosExecutionMessage));
             }
-            m_callback(toUniqueBcosError(ret), std::move(inputList));
+            m_callback(toUniqueBcosError(ret), std::move(outputs));
         }
-
-        void callback_dagExecuteTransactions_exception(tars::Int32 ret) override
+        void onException(tars::Int32 ret)
         {
             m_callback(
                 toUniqueBcosError(ret), std::vector<bcos::protocol::ExecutionMessage::UniquePtr>());
         }
 
-    private:
-        std::function<void(
-            bcos::Error::UniquePtr, std::vector<bcos::protocol::ExecutionMessage::UniquePtr>)>
-            m_callback;
+        BatchCallback m_callback;
     };
-    std::vector<bcostars::ExecutionMessage> tarsInput;
-    for (auto const& it : inputs)
+    // timeout is 30s
+    switch (_type)
     {
-        auto executionMsgImpl = std::move((bcostars::protocol::ExecutionMessageImpl::UniquePtr&)it);
-        tarsInput.emplace_back(executionMsgImpl->inner());
+    case bcostars::protocol::ExecutorBatchType::EXECUTE:
+        _prx->tars_set_timeout(30000)->async_executeTransactions(
+            new Callback(std::move(_callback)), _contractAddress, _inputs);
+        break;
+    case bcostars::protocol::ExecutorBatchType::DMC_EXECUTE:
+        _prx->tars_set_timeout(30000)->async_dmcExecuteTransactions(
+            new Callback(std::move(_callback)), _contractAddress, _inputs);
+        break;
+    case bcostars::protocol::ExecutorBatchType::DAG_EXECUTE:
+        _prx->tars_set_timeout(30000)->async_dagExecuteTransactions(
+            new Callback(std::move(_callback)), _inputs);
+        break;
     }
-    // timeout is 30s
-    m_prx->tars_set_timeout(30000)->async_dagExecuteTransactions(
-        new Callback(std::move(callback)), tarsInput);
 }
 
 void ExecutorServiceClient::dmcCall(bcos::protocol::ExecutionMessage::UniquePtr input,
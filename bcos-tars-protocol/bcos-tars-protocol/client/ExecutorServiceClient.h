@@ -23,7 +23,10 @@
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 
 #include <bcos-framework/executor/ParallelTransactionExecutorInterface.h>
+#include <bcos-tars-protocol/protocol/ExecutorBatchCodec.h>
 #include <bcos-tars-protocol/tars/ExecutorService.h>
+#include <atomic>
+#include <mutex>
 
 namespace bcostars
 {
@@ -95,7 +98,31 @@ public:
     void getABI(std::string_view contract,
         std::function<void(bcos::Error::Ptr, std::string)> callback) override;
 
+    // the requests issued by the threads in the batch are sent to the executor in one executeBatch
+    Batch::Ptr createBatch() override;
+
 private:
+    using BatchCallback = std::function<void(
+        bcos::Error::UniquePtr, std::vector<bcos::protocol::ExecutionMessage::UniquePtr>)>;
+    struct Requests
+    {
+        bcostars::protocol::ExecutorBatchCodec::Frame frame;
+        std::vector<BatchCallback> callbacks;
+    };
+    class RequestBatch;
+
+    void asyncExecuteBatch(bcostars::protocol::ExecutorBatchType _type,
+        std::string_view _contractAddress,
+        gsl::span<bcos::protocol::ExecutionMessage::UniquePtr> _inputs, BatchCallback _callback);
+    // the executors before executeBatch get the requests by the per-call RPCs
+    static void sendBatch(ExecutorServicePrx _prx, std::shared_ptr<std::atomic_bool> _legacy,
+        Requests _requests);
+    static void sendLegacyRequest(ExecutorServicePrx _prx,
+        bcostars::protocol::ExecutorBatchType _type, std::string const& _contractAddress,
+        std::vector<bcostars::ExecutionMessage> const& _inputs, BatchCallback _callback);
+
     ExecutorServicePrx m_prx;
+    // the executor doesn't support executeBatch
+    std::shared_ptr<std::atomic_bool> m_legacy = std::make_shared<std::atomic_bool>(false);
 };
 }  // namespace bcostars
\ No newline at end of file
@@ -0,0 +1,337 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the binary framing of the ExecutionMessage batches between the scheduler and the executor
+ * @file ExecutorBatchCodec.cpp
+ */
+#include "ExecutorBatchCodec.h"
+#include <boost/endian/conversion.hpp>
+#include <boost/lexical_cast.hpp>
+#include <cstring>
+#include <stdexcept>
+
+using namespace bcostars;
+using namespace bcostars::protocol;
+
+namespace
+{
+using Frame = ExecutorBatchCodec::Frame;
+
+// the flags of the bool fields of the message
+constexpr uint8_t c_create = 0x01;
+constexpr uint8_t c_internalCreate = 0x02;
+constexpr uint8_t c_internalCall = 0x04;
+constexpr uint8_t c_staticCall = 0x08;
+
+template <class T>
+void writeInt(Frame& _frame, T _value)
+{
+    boost::endian::native_to_big_inplace(_value);
+    auto data = reinterpret_cast<tars::Char const*>(&_value);
+    _frame.insert(_frame.end(), data, data + sizeof(T));
+}
+
+void writeBytes(Frame& _frame, void const* _data, size_t _size)
+{
+    writeInt<uint32_t>(_frame, _size);
+    auto data = reinterpret_cast<tars::Char const*>(_data);
+    _frame.insert(_frame.end(), data, data + _size);
+}
+
+void writeString(Frame& _frame, std::string_view _value)
+{
+    writeBytes(_frame, _value.data(), _value.size());
+}
+
+void writeVersion(Frame& _frame)
+{
+    if (_frame.empty())
+    {
+        _frame.push_back(ExecutorBatchCodec::VERSION);
+    }
+}
+
+// the encoded size of the message except the salt, used to reserve the frame
+size_t estimateSize(bcos::protocol::ExecutionMessage const& _message)
+{
+    size_t size = 128 + _message.origin().size() + _message.from().size() + _message.to().size() +
+                  _message.abi().size() + _message.data().size() + _message.message().size() +
+                  _message.newEVMContractAddress().size() + _message.keyLockAcquired().size();
+    for (auto const& logEntry : _message.logEntries())
+    {
+        size += 12 + logEntry.address().size() + logEntry.topics().size() * 36 +
+                logEntry.data().size();
+    }
+    for (auto const& keyLock : _message.keyLocks())
+    {
+        size += 4 + keyLock.size();
+    }
+    return size;
+}
+
+size_t estimateSize(gsl::span<bcos::protocol::ExecutionMessage::UniquePtr const> _messages)
+{
+    size_t size = 0;
+    for (auto const& message : _messages)
+    {
+        size += estimateSize(*message);
+    }
+    return size;
+}
+
+class FrameReader
+{
+public:
+    FrameReader(bcos::bytesConstRef _frame) : m_frame(_frame) {}
+
+    bool eof() const { return m_offset == m_frame.size(); }
+
+    template <class T>
+    T readInt()
+    {
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return boost::endian::big_to_native(value);
+    }
+
+    // the size of a list, every item takes at least one byte
+    uint32_t readSize()
+    {
+        auto size = readInt<uint32_t>();
+        if (size > m_frame.size() - m_offset)
+        {
+            throw std::runtime_error("ExecutorBatchCodec: truncated frame");
+        }
+        return size;
+    }
+
+    std::string_view readString()
+    {
+        auto size = readInt<uint32_t>();
+        return std::string_view((char const*)take(size), size);
+    }
+
+    template <class Container>
+    void readBytes(Container& _value)
+    {
+        auto size = readInt<uint32_t>();
+        auto data = take(size);
+        _value.assign(data, data + size);
+    }
+
+private:
+    bcos::byte const* take(size_t _size)
+    {
+        if (_size > m_frame.size() - m_offset)
+        {
+            throw std::runtime_error("ExecutorBatchCodec: truncated frame");
+        }
+        auto data = m_frame.data() + m_offset;
+        m_offset += _size;
+        return data;
+    }
+
+    bcos::bytesConstRef m_frame;
+    size_t m_offset = 0;
+};
+
+void readVersion(FrameReader& _reader)
+{
+    auto version = _reader.readInt<uint8_t>();
+    if (version != ExecutorBatchCodec::VERSION)
+    {
+        throw std::runtime_error(
+            "ExecutorBatchCodec: unsupported version " + std::to_string(version));
+    }
+}
+
+// decode into the tars structure directly, the fields are copied from the frame only once
+bcos::protocol::ExecutionMessage::UniquePtr decodeMessage(FrameReader& _reader)
+{
+    bcostars::ExecutionMessage message;
+    message.type = _reader.readInt<uint8_t>();
+    _reader.readBytes(message.transactionHash);
+    message.contextID = _reader.readInt<int64_t>();
+    message.seq = _reader.readInt<int64_t>();
+    message.origin = _reader.readString();
+    message.from = _reader.readString();
+    message.to = _reader.readString();
+    message.abi = _reader.readString();
+    message.depth = _reader.readInt<int32_t>();
+    auto flags = _reader.readInt<uint8_t>();
+    message.create = flags & c_create;
+    message.internalCreate = flags & c_internalCreate;
+    message.internalCall = flags & c_internalCall;
+    message.staticCall = flags & c_staticCall;
+    message.gasAvailable = _reader.readInt<int64_t>();
+    _reader.readBytes(message.data);
+    message.salt = _reader.readString();
+    message.status = _reader.readInt<int32_t>();
+    message.message = _reader.readString();
+    auto logEntriesSize = _reader.readSize();
+    message.logEntries.resize(logEntriesSize);
+    for (auto& logEntry : message.logEntries)
+    {
+        logEntry.address = _reader.readString();
+        logEntry.topic.resize(_reader.readSize());
+        for (auto& topic : logEntry.topic)
+        {
+            _reader.readBytes(topic);
+        }
+        _reader.readBytes(logEntry.data);
+    }
+    message.newEVMContractAddress = _reader.readString();
+    auto keyLocksSize = _reader.readSize();
+    message.keyLocks.reserve(keyLocksSize);
+    for (uint32_t i = 0; i < keyLocksSize; ++i)
+    {
+        message.keyLocks.emplace_back(_reader.readString());
+    }
+    message.keyLockAcquired = _reader.readString();
+    return std::make_unique<ExecutionMessageImpl>(
+        [m_message = std::move(message)]() mutable { return &m_message; });
+}
+
+std::vector<bcos::protocol::ExecutionMessage::UniquePtr> decodeMessages(FrameReader& _reader)
+{
+    auto size = _reader.readSize();
+    std::vector<bcos::protocol::ExecutionMessage::UniquePtr> messages;
+    messages.reserve(size);
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        messages.emplace_back(decodeMessage(_reader));
+    }
+    return messages;
+}
+}  // namespace
+
+void ExecutorBatchCodec::encodeMessage(
+    Frame& _frame, bcos::protocol::ExecutionMessage const& _message)
+{
+    writeInt<uint8_t>(_frame, _message.type());
+    auto transactionHash = _message.transactionHash();
+    writeBytes(_frame, transactionHash.data(), bcos::crypto::HashType::SIZE);
+    writeInt<int64_t>(_frame, _message.contextID());
+    writeInt<int64_t>(_frame, _message.seq());
+    writeString(_frame, _message.origin());
+    writeString(_frame, _message.from());
+    writeString(_frame, _message.to());
+    writeString(_frame, _message.abi());
+    writeInt<int32_t>(_frame, _message.depth());
+    uint8_t flags = (_message.create() ? c_create : 0) |
+                    (_message.internalCreate() ? c_internalCreate : 0) |
+                    (_message.internalCall() ? c_internalCall : 0) |
+                    (_message.staticCall() ? c_staticCall : 0);
+    writeInt<uint8_t>(_frame, flags);
+    writeInt<int64_t>(_frame, _message.gasAvailable());
+    writeBytes(_frame, _message.data().data(), _message.data().size());
+    // same as the tars structure, the salt is the decimal string, empty means no salt
+    auto salt = _message.createSalt();
+    writeString(_frame, salt ? boost::lexical_cast<std::string>(*salt) : std::string());
+    writeInt<int32_t>(_frame, _message.status());
+    writeString(_frame, _message.message());
+    auto logEntries = _message.logEntries();
+    writeInt<uint32_t>(_frame, logEntries.size());
+    for (auto const& logEntry : logEntries)
+    {
+        writeString(_frame, logEntry.address());
+        writeInt<uint32_t>(_frame, logEntry.topics().size());
+        for (auto const& topic : logEntry.topics())
+        {
+            writeBytes(_frame, topic.data(), bcos::h256::SIZE);
+        }
+        writeBytes(_frame, logEntry.data().data(), logEntry.data().size());
+    }
+    writeString(_frame, _message.newEVMContractAddress());
+    auto keyLocks = _message.keyLocks();
+    writeInt<uint32_t>(_frame, keyLocks.size());
+    for (auto const& keyLock : keyLocks)
+    {
+        writeString(_frame, keyLock);
+    }
+    writeString(_frame, _message.keyLockAcquired());
+}
+
+void ExecutorBatchCodec::encodeRequest(Frame& _frame, ExecutorBatchType _type,
+    std::string_view _contractAddress,
+    gsl::span<bcos::protocol::ExecutionMessage::UniquePtr const> _messages)
+{
+    _frame.reserve(_frame.size() + 16 + _contractAddress.size() + estimateSize(_messages));
+    writeVersion(_frame);
+    writeInt<uint8_t>(_frame, (uint8_t)_type);
+    writeString(_frame, _contractAddress);
+    writeInt<uint32_t>(_frame, _messages.size());
+    for (auto const& message : _messages)
+    {
+        encodeMessage(_frame, *message);
+    }
+}
+
+std::vector<ExecutorBatchRequest> ExecutorBatchCodec::decodeRequests(bcos::bytesConstRef _frame)
+{
+    FrameReader reader(_frame);
+    readVersion(reader);
+    std::vector<ExecutorBatchRequest> requests;
+    while (!reader.eof())
+    {
+        ExecutorBatchRequest request;
+        auto type = reader.readInt<uint8_t>();
+        if (type > (uint8_t)ExecutorBatchType::DAG_EXECUTE)
+        {
+            throw std::runtime_error(
+                "ExecutorBatchCodec: unknown request type " + std::to_string(type));
+        }
+        request.type = (ExecutorBatchType)type;
+        request.contractAddress = reader.readString();
+        request.messages = decodeMessages(reader);
+        requests.emplace_back(std::move(request));
+    }
+    return requests;
+}
+
+void ExecutorBatchCodec::encodeResponse(Frame& _frame, bcos::Error const* _error,
+    gsl::span<bcos::protocol::ExecutionMessage::UniquePtr const> _messages)
+{
+    _frame.reserve(_frame.size() + 16 + (_error ? _error->errorMessage().size() : 0) +
+                   estimateSize(_messages));
+    writeVersion(_frame);
+    writeInt<int64_t>(_frame, _error ? _error->errorCode() : 0);
+    writeString(_frame, _error ? _error->errorMessage() : std::string_view());
+    writeInt<uint32_t>(_frame, _messages.size());
+    for (auto const& message : _messages)
+    {
+        encodeMessage(_frame, *message);
+    }
+}
+
+std::vector<ExecutorBatchResponse> ExecutorBatchCodec::decodeResponses(bcos::bytesConstRef _frame)
+{
+    FrameReader reader(_frame);
+    readVersion(reader);
+    std::vector<ExecutorBatchResponse> responses;
+    while (!reader.eof())
+    {
+        ExecutorBatchResponse response;
+        auto errorCode = reader.readInt<int64_t>();
+        auto errorMessage = reader.readString();
+        if (errorCode != 0)
+        {
+            response.error = std::make_unique<bcos::Error>(errorCode, std::string(errorMessage));
+        }
+        response.messages = decodeMessages(reader);
+        responses.emplace_back(std::move(response));
+    }
+    return responses;
+}
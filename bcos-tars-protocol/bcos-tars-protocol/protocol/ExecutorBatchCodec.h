@@ -0,0 +1,88 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the binary framing of the ExecutionMessage batches between the scheduler and the executor
+ * @file ExecutorBatchCodec.h
+ */
+
+#pragma once
+
+#include "ExecutionMessageImpl.h"
+#include <bcos-utilities/Error.h>
+#include <gsl/span>
+
+namespace bcostars
+{
+namespace protocol
+{
+enum class ExecutorBatchType : uint8_t
+{
+    DMC_EXECUTE = 0,
+    EXECUTE = 1,
+    DAG_EXECUTE = 2,
+};
+
+struct ExecutorBatchRequest
+{
+    ExecutorBatchType type;
+    std::string contractAddress;
+    std::vector<bcos::protocol::ExecutionMessage::UniquePtr> messages;
+};
+
+struct ExecutorBatchResponse
+{
+    bcos::Error::UniquePtr error;
+    std::vector<bcos::protocol::ExecutionMessage::UniquePtr> messages;
+};
+
+/**
+ * @brief ExecutorBatchCodec frames all the requests the scheduler sends to an executor in a DMC
+ * round into one buffer, and the responses of the executor into another one.
+ *
+ * The messages are encoded from the ExecutionMessage interface straight into the frame, and
+ * decoded from the frame straight into the tars structure of ExecutionMessageImpl, without
+ * converting to the vector<bcostars::ExecutionMessage> and tars-encoding it.
+ *
+ * frame:    version(1B) | item | item | ...
+ * request:  type(1B) | contractAddress | messageSize(4B) | message | message | ...
+ * response: errorCode(8B) | errorMessage | messageSize(4B) | message | message | ...
+ * the integers are big-endian, the strings and the bytes are prefixed by the length(4B)
+ */
+class ExecutorBatchCodec
+{
+public:
+    using Frame = std::vector<tars::Char>;
+    constexpr static uint8_t VERSION = 1;
+
+    static void encodeRequest(Frame& _frame, ExecutorBatchType _type,
+        std::string_view _contractAddress,
+        gsl::span<bcos::protocol::ExecutionMessage::UniquePtr const> _messages);
+    // throw std::runtime_error if the frame is malformed
+    static std::vector<ExecutorBatchRequest> decodeRequests(bcos::bytesConstRef _frame);
+
+    static void encodeResponse(Frame& _frame, bcos::Error const* _error,
+        gsl::span<bcos::protocol::ExecutionMessage::UniquePtr const> _messages);
+    // throw std::runtime_error if the frame is malformed
+    static std::vector<ExecutorBatchResponse> decodeResponses(bcos::bytesConstRef _frame);
+
+    static void encodeMessage(Frame& _frame, bcos::protocol::ExecutionMessage const& _message);
+
+    static bcos::bytesConstRef toBytesRef(Frame const& _frame)
+    {
+        return bcos::bytesConstRef((bcos::byte const*)_frame.data(), _frame.size());
+    }
+};
+}  // namespace protocol
+}  // namespace bcostars
@@ -4,12 +4,14 @@
 #include <bcos-crypto/interfaces/crypto/CryptoSuite.h>
 #include <bcos-crypto/signature/secp256k1/Secp256k1Crypto.h>
 #include <bcos-crypto/signature/sm2/SM2Crypto.h>
+#include <bcos-framework/executor/ExecuteError.h>
 #include <bcos-framework/protocol/LogEntry.h>
 #include <bcos-framework/protocol/ProtocolTypeDef.h>
 #include <bcos-framework/protocol/Transaction.h>
 #include <bcos-tars-protocol/protocol/BlockFactoryImpl.h>
 #include <bcos-tars-protocol/protocol/BlockHeaderFactoryImpl.h>
 #include <bcos-tars-protocol/protocol/ExecutionMessageImpl.h>
+#include <bcos-tars-protocol/protocol/ExecutorBatchCodec.h>
 #include <bcos-tars-protocol/protocol/GroupInfoCodecImpl.h>
 #include <bcos-tars-protocol/protocol/MemberImpl.h>
 #include <bcos-tars-protocol/protocol/TransactionFactoryImpl.h>
@@ -692,6 +694,118 @@ BOOST_AUTO_TEST_CASE(testExecutionMessage)
         [m_inner = executionMsg->inner()]() mutable { return &m_inner; });
     checkExecutionMessage(anotherExecutionMsg, executionMsg);
 }
+
+BOOST_AUTO_TEST_CASE(testExecutorBatchCodec)
+{
+    auto fakeMessage = [this](int64_t _contextID) {
+        auto executionMsg = std::make_unique<bcostars::protocol::ExecutionMessageImpl>();
+        executionMsg->setType(bcos::protocol::ExecutionMessage::MESSAGE);
+        executionMsg->setTransactionHash(cryptoSuite->hash(std::to_string(_contextID)));
+        executionMsg->setContextID(_contextID);
+        executionMsg->setSeq(_contextID + 1);
+        executionMsg->setOrigin("origin");
+        executionMsg->setFrom("from");
+        executionMsg->setTo("to");
+        executionMsg->setABI("abi");
+        executionMsg->setDepth(3);
+        executionMsg->setInternalCreate(true);
+        executionMsg->setGasAvailable(23423423);
+        executionMsg->setData(bcos::bytes(1024, 'a'));
+        executionMsg->setCreateSalt(bcos::u256(787667543453));
+        executionMsg->setStatus(-1000001);
+        executionMsg->setMessage("message");
+        executionMsg->setNewEVMContractAddress("newAddress");
+        executionMsg->setKeyLockAcquired("keyLockAcquired");
+        std::vector<std::string> keyLocks;
+        for (int i = 0; i < 10; i++)
+        {
+            keyLocks.emplace_back("keyLock" + std::to_string(i));
+        }
+        executionMsg->setKeyLocks(keyLocks);
+        std::vector<bcos::protocol::LogEntry> logEntries;
+        logEntries.emplace_back(bcos::bytes(20, 'b'),
+            bcos::h256s{cryptoSuite->hash("topic0"), cryptoSuite->hash("topic1")},
+            bcos::bytes(100, 'c'));
+        executionMsg->setLogEntries(logEntries);
+        return executionMsg;
+    };
+    auto checkMessages =
+        [this, &fakeMessage](std::vector<bcos::protocol::ExecutionMessage::UniquePtr>& _messages,
+            int64_t _firstContextID) {
+            for (size_t i = 0; i < _messages.size(); ++i)
+            {
+                bcostars::protocol::ExecutionMessageImpl::Ptr expected =
+                    fakeMessage(_firstContextID + i);
+                bcostars::protocol::ExecutionMessageImpl::Ptr decoded(
+                    dynamic_cast<bcostars::protocol::ExecutionMessageImpl*>(
+                        _messages[i].release()));
+                BOOST_REQUIRE(decoded);
+                checkExecutionMessage(expected, decoded);
+                BOOST_CHECK_EQUAL(decoded->newEVMContractAddress(), "newAddress");
+                BOOST_CHECK_EQUAL(decoded->keyLockAcquired(), "keyLockAcquired");
+                BOOST_CHECK(decoded->data().toBytes() == expected->data().toBytes());
+                BOOST_REQUIRE_EQUAL(decoded->logEntries().size(), 1);
+                auto const& logEntry = decoded->logEntries()[0];
+                BOOST_CHECK_EQUAL(logEntry.address(), std::string(20, 'b'));
+                BOOST_REQUIRE_EQUAL(logEntry.topics().size(), 2);
+                BOOST_CHECK(logEntry.topics()[1] == cryptoSuite->hash("topic1"));
+                BOOST_CHECK(logEntry.data().toBytes() == bcos::bytes(100, 'c'));
+            }
+        };
+
+    // two requests in one frame
+    std::vector<bcos::protocol::ExecutionMessage::UniquePtr> messages;
+    for (int64_t i = 0; i < 5; ++i)
+    {
+        messages.emplace_back(fakeMessage(i));
+    }
+    bcostars::protocol::ExecutorBatchCodec::Frame requestFrame;
+    bcostars::protocol::ExecutorBatchCodec::encodeRequest(requestFrame,
+        bcostars::protocol::ExecutorBatchType::DMC_EXECUTE, "contract0",
+        gsl::span(messages.data(), 3));
+    bcostars::protocol::ExecutorBatchCodec::encodeRequest(requestFrame,
+        bcostars::protocol::ExecutorBatchType::DAG_EXECUTE, "",
+        gsl::span(messages.data() + 3, 2));
+    auto requests = bcostars::protocol::ExecutorBatchCodec::decodeRequests(
+        bcostars::protocol::ExecutorBatchCodec::toBytesRef(requestFrame));
+    BOOST_REQUIRE_EQUAL(requests.size(), 2);
+    BOOST_CHECK(requests[0].type == bcostars::protocol::ExecutorBatchType::DMC_EXECUTE);
+    BOOST_CHECK_EQUAL(requests[0].contractAddress, "contract0");
+    BOOST_REQUIRE_EQUAL(requests[0].messages.size(), 3);
+    checkMessages(requests[0].messages, 0);
+    BOOST_CHECK(requests[1].type == bcostars::protocol::ExecutorBatchType::DAG_EXECUTE);
+    BOOST_CHECK(requests[1].contractAddress.empty());
+    BOOST_REQUIRE_EQUAL(requests[1].messages.size(), 2);
+    checkMessages(requests[1].messages, 3);
+
+    // the responses keep the order of the requests
+    bcostars::protocol::ExecutorBatchCodec::Frame responseFrame;
+    bcos::Error error(bcos::executor::ExecuteError::EXECUTE_ERROR, "execute failed");
+    bcostars::protocol::ExecutorBatchCodec::encodeResponse(
+        responseFrame, nullptr, gsl::span(messages.data(), 3));
+    bcostars::protocol::ExecutorBatchCodec::encodeResponse(
+        responseFrame, &error, gsl::span<bcos::protocol::ExecutionMessage::UniquePtr const>());
+    auto responses = bcostars::protocol::ExecutorBatchCodec::decodeResponses(
+        bcostars::protocol::ExecutorBatchCodec::toBytesRef(responseFrame));
+    BOOST_REQUIRE_EQUAL(responses.size(), 2);
+    BOOST_CHECK(!responses[0].error);
+    BOOST_REQUIRE_EQUAL(responses[0].messages.size(), 3);
+    checkMessages(responses[0].messages, 0);
+    BOOST_REQUIRE(responses[1].error);
+    BOOST_CHECK_EQUAL(responses[1].error->errorCode(), error.errorCode());
+    BOOST_CHECK_EQUAL(responses[1].error->errorMessage(), error.errorMessage());
+    BOOST_CHECK(responses[1].messages.empty());
+
+    // the malformed frames
+    requestFrame.resize(requestFrame.size() - 1);
+    BOOST_CHECK_THROW(bcostars::protocol::ExecutorBatchCodec::decodeRequests(
+                          bcostars::protocol::ExecutorBatchCodec::toBytesRef(requestFrame)),
+        std::runtime_error);
+    responseFrame[0] = bcostars::protocol::ExecutorBatchCodec::VERSION + 1;
+    BOOST_CHECK_THROW(bcostars::protocol::ExecutorBatchCodec::decodeResponses(
+                          bcostars::protocol::ExecutorBatchCodec::toBytesRef(responseFrame)),
+        std::runtime_error);
+}
 BOOST_AUTO_TEST_SUITE_END()
 
 }  // namespace test
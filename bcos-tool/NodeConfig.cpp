@@ -25,6 +25,8 @@
 #include "bcos-framework/protocol/ServiceDesc.h"
 #include "bcos-utilities/BoostLog.h"
 #include "bcos-utilities/FileUtility.h"
+#include "bcos-utilities/TaskScheduler.h"
+#include "bcos-utilities/Tracer.h"
 #include "fisco-bcos-tars-service/Common/TarsUtils.h"
 #include <bcos-framework/protocol/GlobalConfig.h>
 #include <json/forwards.h>
@@ -67,6 +69,10 @@ void NodeConfig::loadConfig(boost::property_tree::ptree const& _pt, bool _enforc
     loadSealerConfig(_pt);
     loadStorageConfig(_pt);
     loadConsensusConfig(_pt);
+    loadCallConfig(_pt);
+    loadTaskSchedulerConfig(_pt);
+    loadTraceConfig(_pt);
+    loadSyncConfig(_pt);
     loadOthersConfig(_pt);
 }
 
@@ -312,22 +318,37 @@ void NodeConfig::loadRpcConfig(boost::property_tree::ptree const& _pt)
         thread_count=16
         sm_ssl=false
         disable_ssl=false
+        max_batch_request_size=100
+        enable_metrics=false
     */
     std::string listenIP = _pt.get<std::string>("rpc.listen_ip", "0.0.0.0");
     int listenPort = _pt.get<int>("rpc.listen_port", 20200);
     int threadCount = _pt.get<int>("rpc.thread_count", 8);
     bool smSsl = _pt.get<bool>("rpc.sm_ssl", false);
     bool disableSsl = _pt.get<bool>("rpc.disable_ssl", false);
+    int maxBatchRequestSize = _pt.get<int>("rpc.max_batch_request_size", 100);
+    if (maxBatchRequestSize <= 0)
+    {
+        BOOST_THROW_EXCEPTION(InvalidConfig() << errinfo_comment(
+                                  "Please set rpc.max_batch_request_size to positive !"));
+    }
+    // serve the metrics on GET /metrics of the rpc port, off by default since the rpc port has no
+    // authentication and may listen on the public address
+    bool enableMetrics = _pt.get<bool>("rpc.enable_metrics", false);
 
     m_rpcListenIP = listenIP;
     m_rpcListenPort = listenPort;
     m_rpcThreadPoolSize = threadCount;
     m_rpcDisableSsl = disableSsl;
     m_rpcSmSsl = smSsl;
+    m_rpcMaxBatchRequestSize = maxBatchRequestSize;
+    m_rpcEnableMetrics = enableMetrics;
 
     NodeConfig_LOG(INFO) << LOG_DESC("loadRpcConfig") << LOG_KV("listenIP", listenIP)
                          << LOG_KV("listenPort", listenPort) << LOG_KV("listenPort", listenPort)
-                         << LOG_KV("smSsl", smSsl) << LOG_KV("disableSsl", disableSsl);
+                         << LOG_KV("smSsl", smSsl) << LOG_KV("disableSsl", disableSsl)
+                         << LOG_KV("maxBatchRequestSize", maxBatchRequestSize)
+                         << LOG_KV("enableMetrics", enableMetrics);
 }
 
 void NodeConfig::loadGatewayConfig(boost::property_tree::ptree const& _pt)
@@ -509,7 +530,37 @@ void NodeConfig::loadSealerConfig(boost::property_tree::ptree const& _pt)
         BOOST_THROW_EXCEPTION(InvalidConfig() << errinfo_comment(
                                   "Please set consensus.min_seal_time between 1 and 3000!"));
     }
-    NodeConfig_LOG(INFO) << LOG_DESC("loadSealerConfig") << LOG_KV("minSealTime", m_minSealTime);
+    /*
+    [consensus]
+        ; adaptive: size the proposals by the measured execution throughput to commit every block
+        ; within target_block_latency, static: seal block_tx_count_limit txs or after min_seal_time
+        sealing_policy=static
+        ; in milliseconds, should be less than the consensus_timeout, max(1000, min_seal_time) by
+        ; default
+        target_block_latency=1000
+    */
+    auto sealingPolicy = _pt.get<std::string>("consensus.sealing_policy", "static");
+    if (sealingPolicy != "adaptive" && sealingPolicy != "static")
+    {
+        BOOST_THROW_EXCEPTION(InvalidConfig() << errinfo_comment(
+                                  "Please set consensus.sealing_policy to adaptive or static!"));
+    }
+    m_adaptiveSealing = (sealingPolicy == "adaptive");
+    auto defaultLatency = std::max(m_minSealTime, (size_t)1000);
+    m_targetBlockLatency = checkAndGetValue(
+        _pt, "consensus.target_block_latency", std::to_string(defaultLatency));
+    // the static sealing ignores the target latency unless it is set explicitly
+    auto latencySet = _pt.get_optional<std::string>("consensus.target_block_latency").has_value();
+    if ((m_adaptiveSealing || latencySet) &&
+        (m_targetBlockLatency < m_minSealTime || m_targetBlockLatency > 3000))
+    {
+        BOOST_THROW_EXCEPTION(InvalidConfig() << errinfo_comment(
+                                  "Please set consensus.target_block_latency between "
+                                  "consensus.min_seal_time and 3000!"));
+    }
+    NodeConfig_LOG(INFO) << LOG_DESC("loadSealerConfig") << LOG_KV("minSealTime", m_minSealTime)
+                         << LOG_KV("sealingPolicy", sealingPolicy)
+                         << LOG_KV("targetBlockLatency", m_targetBlockLatency);
 }
 
 void NodeConfig::loadStorageSecurityConfig(boost::property_tree::ptree const& _pt)
@@ -561,14 +612,42 @@ void NodeConfig::loadStorageConfig(boost::property_tree::ptree const& _pt)
         BOOST_THROW_EXCEPTION(
             InvalidConfig() << errinfo_comment("Please set storage.key_page_size in 4K~32M"));
     }
+    m_keyPageFormat = _pt.get<std::string>("storage.key_page_format", "legacy");
+    if (m_keyPageFormat != "legacy" && m_keyPageFormat != "binary")
+    {
+        BOOST_THROW_EXCEPTION(InvalidConfig() << errinfo_comment(
+                                  "Please set storage.key_page_format to legacy or binary"));
+    }
+    m_keyPageCompression = _pt.get<bool>("storage.key_page_compression", false);
+    if (m_keyPageCompression && m_keyPageFormat == "legacy")
+    {
+        BOOST_THROW_EXCEPTION(InvalidConfig() << errinfo_comment(
+                                  "storage.key_page_compression requires "
+                                  "storage.key_page_format=binary"));
+    }
+    m_keyPageAdaptive = _pt.get<bool>("storage.key_page_adaptive", false);
     auto pd_addrs = _pt.get<std::string>("storage.pd_addrs", "127.0.0.1:2379");
     boost::split(m_pd_addrs, pd_addrs, boost::is_any_of(","));
     m_enableLRUCacheStorage = _pt.get<bool>("storage.enable_cache", true);
     m_cacheSize = _pt.get<ssize_t>("storage.cache_size", DEFAULT_CACHE_SIZE);
+    // dump the hot keys of the cache on stop and prefetch them on start
+    m_enableCacheWarmup = _pt.get<bool>("storage.cache_warmup", false);
+    m_cacheWarmupKeys = _pt.get<int64_t>("storage.cache_warmup_keys", DEFAULT_CACHE_WARMUP_KEYS);
+    if (m_cacheWarmupKeys <= 0)
+    {
+        BOOST_THROW_EXCEPTION(InvalidConfig() << errinfo_comment(
+                                  "Please set storage.cache_warmup_keys to positive !"));
+    }
     NodeConfig_LOG(INFO) << LOG_DESC("loadStorageConfig") << LOG_KV("storagePath", m_storagePath)
-                         << LOG_KV("KeyPage", m_keyPageSize) << LOG_KV("storageType", m_storageType)
+                         << LOG_KV("KeyPage", m_keyPageSize)
+                         << LOG_KV("keyPageFormat", m_keyPageFormat)
+                         << LOG_KV("keyPageCompression", m_keyPageCompression)
+                         << LOG_KV("keyPageAdaptive", m_keyPageAdaptive)
+                         << LOG_KV("storageType", m_storageType)
                          << LOG_KV("pd_addrs", pd_addrs)
-                         << LOG_KV("enableLRUCacheStorage", m_enableLRUCacheStorage);
+                         << LOG_KV("enableLRUCacheStorage", m_enableLRUCacheStorage)
+                         << LOG_KV("enableCacheWarmup", m_enableCacheWarmup)
+                         << LOG_KV("cacheWarmupKeys", m_cacheWarmupKeys);
 }
 
 // Note: In components that do not require failover, do not need to set member_id
@@ -612,6 +691,107 @@ void NodeConfig::loadOthersConfig(boost::property_tree::ptree const& _pt)
                          << LOG_KV("sendTxTimeout", m_sendTxTimeout);
 }
 
+void NodeConfig::loadCallConfig(boost::property_tree::ptree const& _pt)
+{
+    /*
+    [executor]
+        ; the threads dedicated to the read-only calls, 0 means sharing the block execution threads
+        call_thread_count=4
+        ; the max calls per second, 0 means no limit
+        call_limit=0
+        ; the max results of the identical calls cached until the next block, 0 means disabled
+        call_cache_size=0
+    */
+    auto defaultCallThreadCount = std::max(std::thread::hardware_concurrency() / 4, 1u);
+    auto callThreadCount = checkAndGetValue(
+        _pt, "executor.call_thread_count", std::to_string(defaultCallThreadCount));
+    auto callLimit = checkAndGetValue(_pt, "executor.call_limit", "0");
+    auto callCacheSize = checkAndGetValue(_pt, "executor.call_cache_size", "0");
+    if (callThreadCount < 0 || callLimit < 0 || callCacheSize < 0)
+    {
+        BOOST_THROW_EXCEPTION(InvalidConfig() << errinfo_comment(
+                                  "Please set executor.call_thread_count, executor.call_limit and "
+                                  "executor.call_cache_size to non-negative !"));
+    }
+    m_callThreadCount = callThreadCount;
+    m_callLimit = callLimit;
+    m_callCacheSize = callCacheSize;
+    NodeConfig_LOG(INFO) << LOG_DESC("loadCallConfig") << LOG_KV("callThreadCount", callThreadCount)
+                         << LOG_KV("callLimit", callLimit)
+                         << LOG_KV("callCacheSize", callCacheSize);
+}
+
+void NodeConfig::loadTaskSchedulerConfig(boost::property_tree::ptree const& _pt)
+{
+    /*
+    [task_scheduler]
+        ; the worker threads shared by the modules, 0 means hardware_concurrency
+        thread_count=0
+        ; pin the worker threads to the cpus, e.g. 0-7,16-23, empty means no affinity
+        cpu_affinity=
+    */
+    auto threadCount = checkAndGetValue(_pt, "task_scheduler.thread_count", "0");
+    if (threadCount < 0)
+    {
+        BOOST_THROW_EXCEPTION(InvalidConfig() << errinfo_comment(
+                                  "Please set task_scheduler.thread_count to non-negative !"));
+    }
+    auto cpuAffinity = _pt.get<std::string>("task_scheduler.cpu_affinity", "");
+    try
+    {
+        m_taskSchedulerCpus = TaskScheduler::parseCpuList(cpuAffinity);
+    }
+    catch (std::exception const&)
+    {
+        BOOST_THROW_EXCEPTION(InvalidConfig() << errinfo_comment(
+                                  "Invalid task_scheduler.cpu_affinity: " + cpuAffinity));
+    }
+    m_taskSchedulerThreadCount = threadCount;
+    NodeConfig_LOG(INFO) << LOG_DESC("loadTaskSchedulerConfig") << LOG_KV("threadCount", threadCount)
+                         << LOG_KV("cpuAffinity", cpuAffinity);
+}
+
+void NodeConfig::loadTraceConfig(boost::property_tree::ptree const& _pt)
+{
+    /*
+    [trace]
+        ; record the spans of the block execution, dumped by the getBlockTrace rpc
+        enable=false
+        ; the spans kept in memory, the oldest spans are overwritten
+        capacity=1048576
+    */
+    auto enableTrace = _pt.get<bool>("trace.enable", false);
+    auto capacity = checkAndGetValue(
+        _pt, "trace.capacity", std::to_string(trace::Tracer::c_defaultCapacity));
+    if (capacity <= 0)
+    {
+        BOOST_THROW_EXCEPTION(
+            InvalidConfig() << errinfo_comment("Please set trace.capacity to positive !"));
+    }
+    m_enableTrace = enableTrace;
+    m_traceCapacity = capacity;
+    NodeConfig_LOG(INFO) << LOG_DESC("loadTraceConfig") << LOG_KV("enable", enableTrace)
+                         << LOG_KV("capacity", capacity);
+}
+
+void NodeConfig::loadSyncConfig(boost::property_tree::ptree const& _pt)
+{
+    /*
+    [sync]
+        ; the downloaded blocks verified ahead of the execution, 0 means verifying the blocks one
+        ; by one before commit
+        verify_depth=8
+    */
+    auto verifyDepth = checkAndGetValue(_pt, "sync.verify_depth", "8");
+    if (verifyDepth < 0)
+    {
+        BOOST_THROW_EXCEPTION(
+            InvalidConfig() << errinfo_comment("Please set sync.verify_depth to non-negative !"));
+    }
+    m_syncVerifyDepth = verifyDepth;
+    NodeConfig_LOG(INFO) << LOG_DESC("loadSyncConfig") << LOG_KV("verifyDepth", verifyDepth);
+}
+
 void NodeConfig::loadConsensusConfig(boost::property_tree::ptree const& _pt)
 {
     m_checkPointTimeoutInterval = checkAndGetValue(
@@ -622,8 +802,11 @@ void NodeConfig::loadConsensusConfig(boost::property_tree::ptree const& _pt)
                                   "Please set consensus.checkpoint_timeout to no less than " +
                                   std::to_string(DEFAULT_MIN_CONSENSUS_TIME_MS) + "ms!"));
     }
+    // execute the proposals before they are committed
+    m_speculativeExecution = _pt.get<bool>("consensus.speculative_execution", false);
     NodeConfig_LOG(INFO) << LOG_DESC("loadConsensusConfig")
-                         << LOG_KV("checkPointTimeoutInterval", m_checkPointTimeoutInterval);
+                         << LOG_KV("checkPointTimeoutInterval", m_checkPointTimeoutInterval)
+                         << LOG_KV("speculativeExecution", m_speculativeExecution);
 }
 
 void NodeConfig::loadLedgerConfig(boost::property_tree::ptree const& _genesisConfig)
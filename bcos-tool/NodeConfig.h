@@ -40,6 +40,7 @@ class NodeConfig
 {
 public:
     constexpr static ssize_t DEFAULT_CACHE_SIZE = 32 * 1024 * 1024;
+    constexpr static int64_t DEFAULT_CACHE_WARMUP_KEYS = 100000;
     constexpr static ssize_t DEFAULT_MIN_CONSENSUS_TIME_MS = 3000;
     constexpr static ssize_t DEFAULT_MIN_LEASE_TTL_SECONDS = 3;
 
@@ -107,11 +108,18 @@ public:
     std::string const& privateKeyPath() const { return m_privateKeyPath; }
 
     size_t minSealTime() const { return m_minSealTime; }
+    bool adaptiveSealing() const { return m_adaptiveSealing; }
+    size_t targetBlockLatency() const { return m_targetBlockLatency; }
     size_t checkPointTimeoutInterval() const { return m_checkPointTimeoutInterval; }
+    bool speculativeExecution() const { return m_speculativeExecution; }
+    size_t syncVerifyDepth() const { return m_syncVerifyDepth; }
 
     std::string const& storagePath() const { return m_storagePath; }
     std::string const& storageType() const { return m_storageType; }
     size_t keyPageSize() const { return m_keyPageSize; }
+    std::string const& keyPageFormat() const { return m_keyPageFormat; }
+    bool keyPageCompression() const { return m_keyPageCompression; }
+    bool keyPageAdaptive() const { return m_keyPageAdaptive; }
     std::vector<std::string> const& pdAddrs() const { return m_pd_addrs; }
     std::string const& storageDBName() const { return m_storageDBName; }
     std::string const& stateDBName() const { return m_stateDBName; }
@@ -129,6 +137,19 @@ public:
     bool isSerialExecute() const { return m_isSerialExecute; }
     std::string const& authAdminAddress() const { return m_authAdminAddress; }
 
+    // the read-only call configurations
+    size_t callThreadCount() const { return m_callThreadCount; }
+    uint64_t callLimit() const { return m_callLimit; }
+    size_t callCacheSize() const { return m_callCacheSize; }
+
+    // the shared task scheduler configurations
+    size_t taskSchedulerThreadCount() const { return m_taskSchedulerThreadCount; }
+    std::vector<int> const& taskSchedulerCpus() const { return m_taskSchedulerCpus; }
+
+    // the block execution trace configurations
+    bool enableTrace() const { return m_enableTrace; }
+    size_t traceCapacity() const { return m_traceCapacity; }
+
     std::string const& rpcServiceName() const { return m_rpcServiceName; }
     std::string const& gatewayServiceName() const { return m_gatewayServiceName; }
 
@@ -149,6 +170,8 @@ public:
     uint32_t rpcThreadPoolSize() const { return m_rpcThreadPoolSize; }
     bool rpcSmSsl() const { return m_rpcSmSsl; }
     bool rpcDisableSsl() const { return m_rpcDisableSsl; }
+    uint32_t rpcMaxBatchRequestSize() const { return m_rpcMaxBatchRequestSize; }
+    bool rpcEnableMetrics() const { return m_rpcEnableMetrics; }
 
     // the gateway configurations
     const std::string& p2pListenIP() const { return m_p2pListenIP; }
@@ -187,6 +210,8 @@ public:
 
     bool enableLRUCacheStorage() const { return m_enableLRUCacheStorage; }
     ssize_t cacheSize() const { return m_cacheSize; }
+    bool enableCacheWarmup() const { return m_enableCacheWarmup; }
+    size_t cacheWarmupKeys() const { return m_cacheWarmupKeys; }
 
     uint32_t compatibilityVersion() const { return m_compatibilityVersion; }
     std::string const& compatibilityVersionStr() const { return m_compatibilityVersionStr; }
@@ -227,6 +252,10 @@ protected:
     virtual void loadFailOverConfig(
         boost::property_tree::ptree const& _pt, bool _enforceMemberID = true);
     virtual void loadOthersConfig(boost::property_tree::ptree const& _pt);
+    virtual void loadCallConfig(boost::property_tree::ptree const& _pt);
+    virtual void loadTaskSchedulerConfig(boost::property_tree::ptree const& _pt);
+    virtual void loadTraceConfig(boost::property_tree::ptree const& _pt);
+    virtual void loadSyncConfig(boost::property_tree::ptree const& _pt);
 
     virtual void loadLedgerConfig(boost::property_tree::ptree const& _genesisConfig);
 
@@ -258,6 +287,19 @@ private:
     int64_t m_txsExpirationTime;
     // TODO: the block sync module need some configurations?
 
+    // read-only call configuration
+    size_t m_callThreadCount = 0;
+    uint64_t m_callLimit = 0;
+    size_t m_callCacheSize = 0;
+
+    // task scheduler configuration
+    size_t m_taskSchedulerThreadCount = 0;
+    std::vector<int> m_taskSchedulerCpus;
+
+    // trace configuration
+    bool m_enableTrace = false;
+    size_t m_traceCapacity = 0;
+
     // chain configuration
     bool m_smCryptoType;
     std::string m_chainId;
@@ -266,7 +308,11 @@ private:
 
     // sealer configuration
     size_t m_minSealTime = 0;
+    bool m_adaptiveSealing = false;
+    size_t m_targetBlockLatency = 1000;
     size_t m_checkPointTimeoutInterval;
+    bool m_speculativeExecution = false;
+    size_t m_syncVerifyDepth = 8;
 
     // for security
     std::string m_privateKeyPath;
@@ -287,6 +333,11 @@ private:
     std::string m_storagePath;
     std::string m_storageType = "RocksDB";
     size_t m_keyPageSize = 8192;
+    // the format of the key pages to write, legacy or binary
+    std::string m_keyPageFormat = "legacy";
+    bool m_keyPageCompression = false;
+    // adapt the page size of the tables to their workloads
+    bool m_keyPageAdaptive = false;
     std::vector<std::string> m_pd_addrs;
     std::string m_storageDBName = "storage";
     std::string m_stateDBName = "state";
@@ -318,6 +369,8 @@ private:
     uint32_t m_rpcThreadPoolSize;
     bool m_rpcSmSsl;
     bool m_rpcDisableSsl = false;
+    uint32_t m_rpcMaxBatchRequestSize = 100;
+    bool m_rpcEnableMetrics = false;
 
     // config for gateway
     std::string m_p2pListenIP;
@@ -341,6 +394,8 @@ private:
 
     bool m_enableLRUCacheStorage = true;
     ssize_t m_cacheSize = DEFAULT_CACHE_SIZE;  // 32MB for default
+    bool m_enableCacheWarmup = false;
+    int64_t m_cacheWarmupKeys = DEFAULT_CACHE_WARMUP_KEYS;
     uint32_t m_compatibilityVersion;
     std::string m_compatibilityVersionStr;
 
@@ -23,6 +23,7 @@
 #include "txpool/validator/TxValidator.h"
 #include <bcos-framework/protocol/CommonError.h>
 #include <bcos-tool/LedgerConfigFetcher.h>
+#include <bcos-utilities/Metrics.h>
 #include <tbb/parallel_for.h>
 using namespace bcos;
 using namespace bcos::txpool;
@@ -31,6 +32,29 @@ using namespace bcos::crypto;
 using namespace bcos::sync;
 using namespace bcos::consensus;
 using namespace bcos::tool;
+
+namespace
+{
+struct ProposalMetrics
+{
+    metrics::Counter& proposalTxs = metrics::MetricsRegistry::instance().counter(
+        "bcos_txpool_proposal_txs_total", "The txs of the proposals verified by the txpool");
+    metrics::Counter& missedTxs = metrics::MetricsRegistry::instance().counter(
+        "bcos_txpool_proposal_missed_txs_total",
+        "The txs of the proposals missing from the txpool when verified");
+    metrics::Histogram& verifyTime = metrics::MetricsRegistry::instance().histogram(
+        "bcos_txpool_verify_proposal_seconds",
+        "The time to verify the txs of a proposal, including fetching the missed txs");
+    metrics::Histogram& fillTime = metrics::MetricsRegistry::instance().histogram(
+        "bcos_txpool_fill_block_seconds", "The time to fill a block with the txs of the txpool");
+};
+ProposalMetrics& proposalMetrics()
+{
+    static ProposalMetrics proposalMetrics;
+    return proposalMetrics;
+}
+}  // namespace
+
 void TxPool::start()
 {
     if (m_running)
@@ -122,6 +146,19 @@ void TxPool::asyncSealTxs(uint64_t _txsLimit, TxsHashSetPtr _avoidTxs,
         auto fetchedTxs = txpool->m_config->blockFactory()->createBlock();
         auto sysTxs = txpool->m_config->blockFactory()->createBlock();
         txpool->m_txpoolStorage->batchFetchTxs(fetchedTxs, sysTxs, _txsLimit, _avoidTxs, true);
+        // push the txs received from RPC and not broadcast yet to the peers, the push runs on the
+        // txs sync worker and doesn't delay the proposal
+        HashList sealedTxs;
+        sealedTxs.reserve(
+            fetchedTxs->transactionsMetaDataSize() + sysTxs->transactionsMetaDataSize());
+        for (auto const& txs : {sysTxs, fetchedTxs})
+        {
+            for (size_t i = 0; i < txs->transactionsMetaDataSize(); i++)
+            {
+                sealedTxs.emplace_back(txs->transactionHash(i));
+            }
+        }
+        txpool->m_transactionSync->onSealedTxs(sealedTxs);
         _sealCallback(nullptr, fetchedTxs, sysTxs);
     });
 }
@@ -147,7 +184,7 @@ void TxPool::asyncVerifyBlock(PublicPtr _generatedNodeID, bytesConstRef const& _
                      << LOG_KV("consNum", blockHeader ? blockHeader->number() : -1)
                      << LOG_KV("hash", blockHeader ? blockHeader->hash().abridged() : "null");
     // Note: here must have thread pool for lock in the callback
-    // use single thread here to decrease thread competition
+    // the verifier runs the proposals on the consensus class of the TaskScheduler
     auto self = std::weak_ptr<TxPool>(shared_from_this());
     m_verifier->enqueue([self, _generatedNodeID, blockHeader, block, _onVerifyFinished]() {
         try
@@ -166,6 +203,8 @@ void TxPool::asyncVerifyBlock(PublicPtr _generatedNodeID, bytesConstRef const& _
             }
             auto txpoolStorage = txpool->m_txpoolStorage;
             auto missedTxs = txpoolStorage->batchVerifyProposal(block);
+            proposalMetrics().proposalTxs.add(block->transactionsHashSize());
+            proposalMetrics().missedTxs.add(missedTxs->size());
             auto onVerifyFinishedWrapper =
                 [txpool, txpoolStorage, _onVerifyFinished, block, blockHeader, missedTxs, startT](
                     Error::Ptr _error, bool _ret) {
@@ -190,6 +229,7 @@ void TxPool::asyncVerifyBlock(PublicPtr _generatedNodeID, bytesConstRef const& _
                         << LOG_KV("code", verifyError ? verifyError->errorCode() : 0)
                         << LOG_KV("msg", verifyError ? verifyError->errorMessage() : "success")
                         << LOG_KV("result", verifyRet) << LOG_KV("timecost", (utcTime() - startT));
+                    proposalMetrics().verifyTime.observe((utcTime() - startT) * 1000);
                     if (!_onVerifyFinished)
                     {
                         return;
@@ -323,13 +363,20 @@ void TxPool::asyncFillBlock(
     HashListPtr _txsHash, std::function<void(Error::Ptr, TransactionsPtr)> _onBlockFilled)
 {
     auto self = std::weak_ptr<TxPool>(shared_from_this());
-    m_filler->enqueue([self, _txsHash, _onBlockFilled]() {
+    auto startT = utcTime();
+    m_filler->enqueue([self, _txsHash, _onBlockFilled, startT]() {
         auto txpool = self.lock();
         if (!txpool)
         {
             return;
         }
-        txpool->fillBlock(_txsHash, _onBlockFilled, true);
+        txpool->fillBlock(
+            _txsHash,
+            [_onBlockFilled, startT](Error::Ptr _error, TransactionsPtr _txs) {
+                proposalMetrics().fillTime.observe((utcTime() - startT) * 1000);
+                _onBlockFilled(std::move(_error), std::move(_txs));
+            },
+            true);
     });
 }
 
@@ -40,10 +40,10 @@ public:
         // threadpool for submit txs
         m_worker = std::make_shared<ThreadPool>("submitter", _verifierWorkerNum);
         // threadpool for verify block
-        m_verifier = std::make_shared<ThreadPool>("verifier", 4);
+        m_verifier = std::make_shared<ThreadPool>("verifier", TaskClass::CONSENSUS);
         m_sealer = std::make_shared<ThreadPool>("txsSeal", 1);
         m_txsResultNotifier = std::make_shared<ThreadPool>("txsResultNotify", 1);
-        m_filler = std::make_shared<ThreadPool>("txsFiller", std::thread::hardware_concurrency());
+        m_filler = std::make_shared<ThreadPool>("txsFiller", TaskClass::CONSENSUS);
         TXPOOL_LOG(INFO) << LOG_DESC("create TxPool")
                          << LOG_KV("submitterWorkerNum", _verifierWorkerNum);
     }
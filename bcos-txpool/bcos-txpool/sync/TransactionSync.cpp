@@ -22,6 +22,7 @@
 #include "bcos-txpool/sync/utilities/Common.h"
 #include <bcos-framework/protocol/CommonError.h>
 #include <bcos-framework/protocol/Protocol.h>
+#include <bcos-utilities/Metrics.h>
 
 using namespace bcos;
 using namespace bcos::sync;
@@ -32,6 +33,33 @@ using namespace bcos::ledger;
 using namespace bcos::consensus;
 static unsigned const c_maxSendTransactions = 10000;
 
+namespace
+{
+struct TxsSyncMetrics
+{
+    metrics::Counter& prefilledTxs = metrics::MetricsRegistry::instance().counter(
+        "bcos_txsync_prefilled_txs_total",
+        "The txs pushed to the consensus nodes ahead of the proposals sealed by this node");
+    static metrics::Counter& missedTxs(std::string const& _source)
+    {
+        return metrics::MetricsRegistry::instance().counter("bcos_txsync_proposal_missed_txs_total",
+            "The txs of the proposals missing from the txpool, by where they were found",
+            "source=\"" + _source + "\"");
+    }
+    metrics::Counter& missedTxsFromBuffer = missedTxs("buffer");
+    metrics::Counter& missedTxsFromLedger = missedTxs("ledger");
+    metrics::Counter& missedTxsFromPeer = missedTxs("peer");
+    metrics::Histogram& fetchFromPeerTime = metrics::MetricsRegistry::instance().histogram(
+        "bcos_txsync_fetch_missed_txs_seconds",
+        "The time to fetch the missed txs of the proposals from the leader");
+};
+TxsSyncMetrics& txsSyncMetrics()
+{
+    static TxsSyncMetrics txsSyncMetrics;
+    return txsSyncMetrics;
+}
+}  // namespace
+
 void TransactionSync::start()
 {
     startWorking();
@@ -200,6 +228,21 @@ void TransactionSync::requestMissedTxs(PublicPtr _generatedNodeID, HashListPtr _
 {
     auto missedTxsSet =
         std::make_shared<std::set<HashType>>(_missedTxs->begin(), _missedTxs->end());
+    if (_verifiedProposal && !downloadTxsBufferEmpty())
+    {
+        fetchMissedTxsFromDownloadBuffer(*missedTxsSet, _verifiedProposal);
+        if (missedTxsSet->empty())
+        {
+            SYNC_LOG(DEBUG) << LOG_DESC("requestMissedTxs: hit all transactions downloaded")
+                            << LOG_KV("txsSize", _missedTxs->size());
+            if (_onVerifyFinished)
+            {
+                _onVerifyFinished(nullptr, true);
+            }
+            return;
+        }
+        _missedTxs = std::make_shared<HashList>(missedTxsSet->begin(), missedTxsSet->end());
+    }
     auto startT = utcTime();
     m_config->ledger()->asyncGetBatchTxsByHashList(_missedTxs, false,
         [this, startT, _verifiedProposal, missedTxsSet, _generatedNodeID, _onVerifyFinished](
@@ -242,6 +285,48 @@ void TransactionSync::requestMissedTxs(PublicPtr _generatedNodeID, HashListPtr _
         });
 }
 
+void TransactionSync::fetchMissedTxsFromDownloadBuffer(
+    std::set<HashType>& _missedTxs, Block::Ptr _verifiedProposal)
+{
+    auto localBuffer = swapDownloadTxsBuffer();
+    size_t hitTxsSize = 0;
+    for (auto const& txsBuffer : *localBuffer)
+    {
+        auto transactions =
+            m_config->blockFactory()->createBlock(txsBuffer->txsData(), true, false);
+        auto hitTxs = std::make_shared<Transactions>();
+        auto otherTxs = std::make_shared<Transactions>();
+        for (size_t i = 0; i < transactions->transactionsSize(); i++)
+        {
+            auto tx = std::const_pointer_cast<Transaction>(transactions->transaction(i));
+            if (_missedTxs.count(tx->hash()))
+            {
+                hitTxs->emplace_back(tx);
+                continue;
+            }
+            otherTxs->emplace_back(tx);
+        }
+        if (!hitTxs->empty() && importDownloadedTxs(txsBuffer->from(), hitTxs, _verifiedProposal))
+        {
+            for (auto const& tx : *hitTxs)
+            {
+                _missedTxs.erase(tx->hash());
+            }
+            hitTxsSize += hitTxs->size();
+        }
+        if (otherTxs->empty())
+        {
+            continue;
+        }
+        auto from = txsBuffer->from();
+        m_worker->enqueue([this, from, otherTxs]() { importDownloadedTxs(from, otherTxs); });
+    }
+    txsSyncMetrics().missedTxsFromBuffer.add(hitTxsSize);
+    SYNC_LOG(DEBUG) << LOG_DESC("fetchMissedTxsFromDownloadBuffer")
+                    << LOG_KV("hitTxs", hitTxsSize) << LOG_KV("missCount", _missedTxs.size())
+                    << LOG_KV("bufferSize", localBuffer->size());
+}
+
 size_t TransactionSync::onGetMissedTxsFromLedger(std::set<HashType>& _missedTxs, Error::Ptr _error,
     TransactionsPtr _fetchedTxs, Block::Ptr _verifiedProposal,
     VerifyResponseCallback _onVerifyFinished)
@@ -260,6 +345,10 @@ size_t TransactionSync::onGetMissedTxsFromLedger(std::set<HashType>& _missedTxs,
         SYNC_LOG(WARNING) << LOG_DESC("onGetMissedTxsFromLedger: verify tx failed");
         return _missedTxs.size();
     }
+    if (_verifiedProposal)
+    {
+        txsSyncMetrics().missedTxsFromLedger.add(_fetchedTxs->size());
+    }
     // fetch missed transactions from the local ledger
     for (auto tx : *_fetchedTxs)
     {
@@ -309,9 +398,9 @@ void TransactionSync::requestMissedTxsFromPeer(PublicPtr _generatedNodeID, HashL
     auto self = std::weak_ptr<TransactionSync>(shared_from_this());
     m_config->frontService()->asyncSendMessageByNodeID(protocolID, _generatedNodeID,
         ref(*encodedData), m_config->networkTimeout(),
-        [self, startT, _missedTxs, _verifiedProposal, proposalHeader, _onVerifyFinished](
-            Error::Ptr _error, NodeIDPtr _nodeID, bytesConstRef _data, const std::string&,
-            SendResponseCallback) {
+        [self, startT, _generatedNodeID, _missedTxs, _verifiedProposal, proposalHeader,
+            _onVerifyFinished](Error::Ptr _error, NodeIDPtr _nodeID, bytesConstRef _data,
+            const std::string&, SendResponseCallback) {
             try
             {
                 auto transactionSync = self.lock();
@@ -321,6 +410,20 @@ void TransactionSync::requestMissedTxsFromPeer(PublicPtr _generatedNodeID, HashL
                 }
                 auto networkT = utcTime() - startT;
                 auto recordT = utcTime();
+                auto const& peerScores = transactionSync->m_config->peerScores();
+                if (_error != nullptr)
+                {
+                    peerScores->onFailure(_generatedNodeID);
+                }
+                else
+                {
+                    peerScores->onResponse(_generatedNodeID, networkT);
+                    peerScores->onTransfer(_generatedNodeID, _data.size(), networkT);
+                }
+                if (_verifiedProposal)
+                {
+                    txsSyncMetrics().fetchFromPeerTime.observe(networkT * 1000);
+                }
                 transactionSync->verifyFetchedTxs(_error, _nodeID, _data, _missedTxs,
                     _verifiedProposal,
                     [networkT, recordT, proposalHeader, _onVerifyFinished](
@@ -433,6 +536,10 @@ void TransactionSync::verifyFetchedTxs(Error::Ptr _error, NodeIDPtr _nodeID, byt
             return;
         }
     }
+    if (_verifiedProposal)
+    {
+        txsSyncMetrics().missedTxsFromPeer.add(_missedTxs->size());
+    }
     _onVerifyFinished(error, true);
     SYNC_LOG(DEBUG) << METRIC << LOG_DESC("requestMissedTxs and verify success")
                     << LOG_KV(
@@ -588,11 +695,15 @@ void TransactionSync::maintainTransactions()
     forwardTxsFromP2P(connectedNodeList, consensusNodeList, txs);
 }
 
-// Randomly select a number of nodes to forward the transaction status
+// Select a number of nodes to forward the transaction status, the nearer nodes first, and the
+// nodes of the same cost at random
 void TransactionSync::forwardTxsFromP2P(bcos::crypto::NodeIDSet const& _connectedPeers,
     bcos::consensus::ConsensusNodeList const& _consensusNodeList, ConstTransactionsPtr _txs)
 {
     auto expectedPeers = (_connectedPeers.size() * m_config->forwardPercent() + 99) / 100;
+    auto consensusNodeList = _consensusNodeList;
+    auto costBuckets = m_config->peerScores()->sortByCost(
+        consensusNodeList, [](auto const& _node) { return _node->nodeID(); });
     std::map<NodeIDPtr, HashListPtr, KeyCompare> peerToForwardedTxs;
     for (auto tx : *_txs)
     {
@@ -607,7 +718,9 @@ void TransactionSync::forwardTxsFromP2P(bcos::crypto::NodeIDSet const& _connecte
         {
             continue;
         }*/
-        auto selectedPeers = selectPeers(tx, _connectedPeers, _consensusNodeList, expectedPeers);
+        // spread the txs over the nodes of the same cost
+        PeerScores::shuffleBuckets(consensusNodeList, costBuckets);
+        auto selectedPeers = selectPeers(tx, _connectedPeers, consensusNodeList, expectedPeers);
         for (auto peer : *selectedPeers)
         {
             if (!peerToForwardedTxs.count(peer))
@@ -682,14 +795,25 @@ void TransactionSync::broadcastTxsFromRpc(NodeIDSet const& _connectedPeers,
         {
             continue;
         }
+        bool knownByAllPeers = true;
         for (auto const& node : _consensusNodeList)
         {
             if (!_connectedPeers.count(node->nodeID()))
             {
                 continue;
             }
+            if (knownByAllPeers && node->nodeID()->data() != m_config->nodeID()->data() &&
+                !tx->isKnownBy(node->nodeID()))
+            {
+                knownByAllPeers = false;
+            }
             tx->appendKnownNode(node->nodeID());
         }
+        // the tx has been pushed ahead of the proposal sealed by this node
+        if (knownByAllPeers)
+        {
+            continue;
+        }
         block->appendTransaction(std::const_pointer_cast<Transaction>(tx));
     }
     if (block->transactionsSize() == 0)
@@ -761,4 +885,90 @@ void TransactionSync::onEmptyTxs()
     auto packetData = txsStatus->encode();
     m_config->frontService()->asyncSendBroadcastMessage(
         bcos::protocol::NodeType::CONSENSUS_NODE, ModuleID::TxsSync, ref(*packetData));
+}
+
+void TransactionSync::onSealedTxs(HashList const& _sealedTxs)
+{
+    if (_sealedTxs.empty() || !m_config->existsInGroup())
+    {
+        return;
+    }
+    // push the txs off the sealing thread
+    auto sealedTxs = std::make_shared<HashList>(_sealedTxs);
+    auto self = std::weak_ptr<TransactionSync>(shared_from_this());
+    m_forwardWorker->enqueue([self, sealedTxs]() {
+        try
+        {
+            auto transactionSync = self.lock();
+            if (!transactionSync)
+            {
+                return;
+            }
+            transactionSync->pushSealedTxs(*sealedTxs);
+        }
+        catch (std::exception const& e)
+        {
+            SYNC_LOG(WARNING) << LOG_DESC("onSealedTxs exception")
+                              << LOG_KV("error", boost::diagnostic_information(e));
+        }
+    });
+}
+
+void TransactionSync::pushSealedTxs(HashList const& _sealedTxs)
+{
+    auto consensusNodeList = m_config->consensusNodeList();
+    auto connectedNodeList = m_config->connectedNodeList();
+    HashList missedTxs;
+    auto txs = m_config->txpoolStorage()->fetchTxs(missedTxs, _sealedTxs);
+    // the peers missing the same txs share one packet, in most cases all the peers miss the txs
+    // submitted to this node after the last broadcast
+    std::map<std::vector<size_t>, NodeIDs> peersByUnknownTxs;
+    for (auto const& node : consensusNodeList)
+    {
+        auto nodeID = node->nodeID();
+        if (!connectedNodeList.count(nodeID) || nodeID->data() == m_config->nodeID()->data())
+        {
+            continue;
+        }
+        std::vector<size_t> unknownTxs;
+        for (size_t i = 0; i < txs->size(); i++)
+        {
+            auto const& tx = (*txs)[i];
+            // only the txs received from the RPC of this node and not broadcast yet, the txs
+            // received from the peers have been broadcast by the node that received them from RPC
+            if (!tx || !tx->submitCallback() || tx->synced() || tx->isKnownBy(nodeID))
+            {
+                continue;
+            }
+            tx->appendKnownNode(nodeID);
+            unknownTxs.emplace_back(i);
+        }
+        if (!unknownTxs.empty())
+        {
+            peersByUnknownTxs[std::move(unknownTxs)].emplace_back(nodeID);
+        }
+    }
+    for (auto const& [unknownTxs, peers] : peersByUnknownTxs)
+    {
+        auto block = m_config->blockFactory()->createBlock();
+        for (auto index : unknownTxs)
+        {
+            block->appendTransaction((*txs)[index]);
+        }
+        auto encodedData = std::make_shared<bytes>();
+        block->encode(*encodedData);
+        auto txsPacket = m_config->msgFactory()->createTxsSyncMsg(
+            TxsSyncPacketType::TxsPacket, std::move(*encodedData));
+        auto packetData = txsPacket->encode();
+        for (auto const& peer : peers)
+        {
+            m_config->frontService()->asyncSendMessageByNodeID(
+                ModuleID::TxsSync, peer, ref(*packetData), 0, nullptr);
+        }
+        txsSyncMetrics().prefilledTxs.add(unknownTxs.size() * peers.size());
+        SYNC_LOG(DEBUG) << LOG_DESC("onSealedTxs: push the txs unknown by the peers")
+                        << LOG_KV("txsSize", unknownTxs.size()) << LOG_KV("peers", peers.size())
+                        << LOG_KV("sealedTxs", _sealedTxs.size())
+                        << LOG_KV("packetSize", packetData->size());
+    }
 }
\ No newline at end of file
@@ -40,9 +40,8 @@ public:
       : TransactionSyncInterface(_config),
         Worker("txsSync", 0),
         m_downloadTxsBuffer(std::make_shared<TxsSyncMsgList>()),
-        m_worker(
-            std::make_shared<ThreadPool>("txsSyncWorker", std::thread::hardware_concurrency())),
-        m_txsRequester(std::make_shared<ThreadPool>("txsRequester", 4)),
+        m_worker(std::make_shared<ThreadPool>("txsSyncWorker", TaskClass::SYNC)),
+        m_txsRequester(std::make_shared<ThreadPool>("txsRequester", TaskClass::SYNC)),
         m_forwardWorker(std::make_shared<ThreadPool>("txsForward", 1))
     {
         m_txsSubmitted = m_config->txpoolStorage()->onReady([&]() { this->noteNewTransactions(); });
@@ -65,9 +64,11 @@ public:
     virtual void maintainTransactions();
     virtual void maintainDownloadingTransactions();
     void onEmptyTxs() override;
+    void onSealedTxs(bcos::crypto::HashList const& _sealedTxs) override;
 
 protected:
     virtual void responseTxsStatus(bcos::crypto::NodeIDPtr _fromNode);
+    virtual void pushSealedTxs(bcos::crypto::HashList const& _sealedTxs);
     void executeWorker() override;
 
     virtual void broadcastTxsFromRpc(bcos::crypto::NodeIDSet const& _connectedPeers,
@@ -93,6 +94,11 @@ protected:
         bcos::crypto::HashListPtr _missedTxs, bcos::protocol::Block::Ptr _verifiedProposal,
         VerifyResponseCallback _onVerifyFinished);
 
+    // import the missed txs that have been downloaded but not imported yet, e.g. the txs pushed by
+    // the leader ahead of the proposal, and erase them from _missedTxs
+    virtual void fetchMissedTxsFromDownloadBuffer(std::set<bcos::crypto::HashType>& _missedTxs,
+        bcos::protocol::Block::Ptr _verifiedProposal);
+
     virtual size_t onGetMissedTxsFromLedger(std::set<bcos::crypto::HashType>& _missedTxs,
         Error::Ptr _error, bcos::protocol::TransactionsPtr _fetchedTxs,
         bcos::protocol::Block::Ptr _verifiedProposal, VerifyResponseCallback _onVerifyFinished);
@@ -48,6 +48,11 @@ public:
     virtual TransactionSyncConfig::Ptr config() { return m_config; }
     virtual void onEmptyTxs() = 0;
 
+    // push the txs sealed by this node, received from RPC and not broadcast yet, to the consensus
+    // nodes that have not received them, so that the proposal can be verified without fetching
+    // the missed txs
+    virtual void onSealedTxs(bcos::crypto::HashList const& _sealedTxs) = 0;
+
 protected:
     TransactionSyncConfig::Ptr m_config;
 };
@@ -19,6 +19,7 @@
  * @date 2021-05-07
  */
 #include "bcos-txpool/txpool/storage/MemoryStorage.h"
+#include <bcos-utilities/Metrics.h>
 #include <tbb/parallel_invoke.h>
 #include <memory>
 #include <tuple>
@@ -28,6 +29,31 @@ using namespace bcos::txpool;
 using namespace bcos::crypto;
 using namespace bcos::protocol;
 
+namespace
+{
+struct TxPoolMetrics
+{
+    metrics::Counter& acceptedTxs = metrics::MetricsRegistry::instance().counter(
+        "bcos_txpool_submitted_txs_total", "The txs submitted to the txpool", "result=\"ok\"");
+    metrics::Counter& rejectedTxs = metrics::MetricsRegistry::instance().counter(
+        "bcos_txpool_submitted_txs_total", "The txs submitted to the txpool",
+        "result=\"rejected\"");
+    metrics::Counter& committedTxs = metrics::MetricsRegistry::instance().counter(
+        "bcos_txpool_committed_txs_total", "The txs removed from the txpool after committed");
+    metrics::Gauge& pendingTxs = metrics::MetricsRegistry::instance().gauge(
+        "bcos_txpool_pending_txs", "The txs in the txpool");
+    metrics::Histogram& batchFetchTime = metrics::MetricsRegistry::instance().histogram(
+        "bcos_txpool_batch_fetch_seconds", "The time to fetch the txs for a proposal");
+    metrics::Histogram& batchRemoveTime = metrics::MetricsRegistry::instance().histogram(
+        "bcos_txpool_batch_remove_seconds", "The time to remove the committed txs");
+};
+TxPoolMetrics& txPoolMetrics()
+{
+    static TxPoolMetrics txPoolMetrics;
+    return txPoolMetrics;
+}
+}  // namespace
+
 MemoryStorage::MemoryStorage(TxPoolConfig::Ptr _config, size_t _notifyWorkerNum,
     int64_t _txsExpirationTime, bool _preStoreTxs)
   : m_config(_config), m_txsExpirationTime(_txsExpirationTime), m_preStoreTxs(_preStoreTxs)
@@ -79,12 +105,18 @@ TransactionStatus MemoryStorage::submitTransaction(
         auto result = verifyAndSubmitTransaction(tx, _txSubmitCallback, true, true);
         if (result != TransactionStatus::None)
         {
+            txPoolMetrics().rejectedTxs.inc();
             notifyInvalidReceipt(tx->hash(), result, _txSubmitCallback);
         }
+        else
+        {
+            txPoolMetrics().acceptedTxs.inc();
+        }
         return result;
     }
     catch (std::exception const& e)
     {
+        txPoolMetrics().rejectedTxs.inc();
         TXPOOL_LOG(WARNING) << LOG_DESC("Invalid transaction for decode exception")
                             << LOG_KV("error", boost::diagnostic_information(e));
         notifyInvalidReceipt(HashType(), TransactionStatus::Malform, _txSubmitCallback);
@@ -439,6 +471,7 @@ void MemoryStorage::printPendingTxs()
 }
 void MemoryStorage::batchRemove(BlockNumber _batchId, TransactionSubmitResults const& _txsResult)
 {
+    metrics::ScopedTimer timer(txPoolMetrics().batchRemoveTime);
     auto startT = utcTime();
     auto recordT = utcTime();
     int64_t lockT = 0;
@@ -469,6 +502,8 @@ void MemoryStorage::batchRemove(BlockNumber _batchId, TransactionSubmitResults c
             m_blockNumber = _batchId;
         }
         m_onChainTxsCount += _txsResult.size();
+        txPoolMetrics().committedTxs.inc(_txsResult.size());
+        txPoolMetrics().pendingTxs.set(m_txsTable.size());
         // stop stat the tps when there has no pending txs
         if (m_tpsStatstartTime.load() > 0 && m_txsTable.size() == 0)
         {
@@ -551,6 +586,7 @@ void MemoryStorage::batchFetchTxs(Block::Ptr _txsList, Block::Ptr _sysTxsList, s
 {
     TXPOOL_LOG(INFO) << LOG_DESC("begin batchFetchTxs") << LOG_KV("pendingTxs", m_txsTable.size())
                      << LOG_KV("limit", _txsLimit);
+    metrics::ScopedTimer timer(txPoolMetrics().batchFetchTime);
     auto blockFactory = m_config->blockFactory();
     auto recordT = utcTime();
     auto startT = utcTime();
@@ -651,6 +687,7 @@ void MemoryStorage::batchFetchTxs(Block::Ptr _txsList, Block::Ptr _sysTxsList, s
         }
     }
     auto fetchTxsT = utcTime() - startT;
+    txPoolMetrics().pendingTxs.set(m_txsTable.size());
     notifyUnsealedTxsSize();
     removeInvalidTxs();
     TXPOOL_LOG(INFO) << METRIC << LOG_DESC("batchFetchTxs success")
@@ -230,6 +230,97 @@ BOOST_AUTO_TEST_CASE(testOnPeerTxsStatus)
 {
     testTransactionSync(true);
 }
+
+BOOST_AUTO_TEST_CASE(testPushSealedTxs)
+{
+    auto hashImpl = std::make_shared<Keccak256>();
+    auto signatureImpl = std::make_shared<Secp256k1Crypto>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+    std::string groupId = "test-group";
+    std::string chainId = "test-chain";
+    int64_t blockLimit = 15;
+    auto fakeGateWay = std::make_shared<FakeGateWay>();
+    auto leader = std::make_shared<TxPoolFixture>(signatureImpl->generateKeyPair()->publicKey(),
+        cryptoSuite, groupId, chainId, blockLimit, fakeGateWay);
+    auto replica = std::make_shared<TxPoolFixture>(signatureImpl->generateKeyPair()->publicKey(),
+        cryptoSuite, groupId, chainId, blockLimit, fakeGateWay);
+    leader->init();
+    replica->init();
+    for (auto const& node : {leader, replica})
+    {
+        node->appendSealer(leader->nodeID());
+        node->appendSealer(replica->nodeID());
+    }
+
+    // the txs submitted to the leader have not been broadcast when sealed
+    size_t txsNum = 10;
+    importTransactions(txsNum, cryptoSuite, leader);
+    auto blockFactory = leader->txpool()->txpoolConfig()->blockFactory();
+    auto block = blockFactory->createBlock();
+    bool finish = false;
+    leader->txpool()->asyncSealTxs(
+        100000, nullptr, [&](Error::Ptr _error, Block::Ptr _fetchedTxs, Block::Ptr) {
+            BOOST_CHECK(_error == nullptr);
+            for (size_t i = 0; i < _fetchedTxs->transactionsMetaDataSize(); i++)
+            {
+                auto txMetaData = blockFactory->createTransactionMetaData();
+                txMetaData->setHash(_fetchedTxs->transactionHash(i));
+                txMetaData->setTo(_fetchedTxs->transactionHash(i).abridged());
+                block->appendTransactionMetaData(txMetaData);
+            }
+            finish = true;
+        });
+    while (!finish)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    BOOST_CHECK_EQUAL(block->transactionsMetaDataSize(), txsNum);
+    // the unknown txs are pushed to the replica by the txs sync worker
+    auto startT = utcTime();
+    while (leader->frontService()->getAsyncSendSizeByNodeID(replica->nodeID()) == 0 &&
+           (utcTime() - startT <= 10000))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    BOOST_CHECK_EQUAL(leader->frontService()->getAsyncSendSizeByNodeID(replica->nodeID()), 1);
+
+    // the replica verifies the proposal with the pushed txs, without fetching from the leader
+    auto encodedData = std::make_shared<bytes>();
+    block->encode(*encodedData);
+    finish = false;
+    replica->txpool()->asyncVerifyBlock(
+        leader->nodeID(), ref(*encodedData), [&](Error::Ptr _error, bool _result) {
+            BOOST_CHECK(_error == nullptr);
+            BOOST_CHECK(_result == true);
+            finish = true;
+        });
+    while (!finish)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    BOOST_CHECK_EQUAL(replica->frontService()->getAsyncSendSizeByNodeID(leader->nodeID()), 0);
+    BOOST_CHECK_EQUAL(replica->txpool()->txpoolStorage()->size(), txsNum);
+
+    // the pushed txs are not broadcast again
+    auto originSendSize = leader->frontService()->totalSendMsgSize();
+    leader->sync()->maintainTransactions();
+    BOOST_CHECK_EQUAL(leader->frontService()->totalSendMsgSize(), originSendSize);
+
+    // the replica doesn't push the txs received from the leader when sealing them
+    finish = false;
+    replica->txpool()->asyncSealTxs(
+        100000, nullptr, [&](Error::Ptr _error, Block::Ptr _fetchedTxs, Block::Ptr) {
+            BOOST_CHECK(_error == nullptr);
+            BOOST_CHECK_EQUAL(_fetchedTxs->transactionsMetaDataSize(), txsNum);
+            finish = true;
+        });
+    while (!finish)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    BOOST_CHECK_EQUAL(replica->frontService()->getAsyncSendSizeByNodeID(leader->nodeID()), 0);
+}
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace bcos
@@ -0,0 +1,302 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief: asynchronous binary logging backend
+ *
+ * @file AsyncLog.cpp
+ */
+#include "AsyncLog.h"
+#include "Common.h"
+#include <boost/date_time/c_local_time_adjustor.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/log/attributes/mutable_constant.hpp>
+#include <boost/log/sources/record_ostream.hpp>
+#include <algorithm>
+#include <cstdio>
+
+using namespace bcos;
+using namespace bcos::asynclog;
+
+namespace
+{
+constexpr size_t c_recordAlignment = 8;
+
+// the buffer of the current thread, closed when the thread exits
+struct ThreadBuffer
+{
+    ~ThreadBuffer()
+    {
+        if (buffer)
+        {
+            buffer->closed = true;
+        }
+    }
+    std::shared_ptr<Buffer> buffer;
+};
+thread_local ThreadBuffer t_threadBuffer;
+
+template <class T>
+T readValue(uint8_t const*& _in)
+{
+    T value;
+    std::memcpy(&value, _in, sizeof(T));
+    _in += sizeof(T);
+    return value;
+}
+
+void appendArg(std::string& _out, uint8_t const*& _args)
+{
+    auto type = (ArgType)*_args++;
+    switch (type)
+    {
+    case ArgType::INT:
+        _out.append(std::to_string(readValue<int64_t>(_args)));
+        break;
+    case ArgType::UINT:
+        _out.append(std::to_string(readValue<uint64_t>(_args)));
+        break;
+    case ArgType::DOUBLE:
+    {
+        // the same as the default format of std::ostream
+        char buffer[32];
+        auto size = std::snprintf(buffer, sizeof(buffer), "%g", readValue<double>(_args));
+        _out.append(buffer, size);
+        break;
+    }
+    case ArgType::BOOL:
+        // the same as LOG_KV, std::ostream prints bool as 1/0 without std::boolalpha
+        _out.append(*_args++ ? "1" : "0");
+        break;
+    case ArgType::STRING:
+    {
+        auto size = readValue<uint32_t>(_args);
+        _out.append((char const*)_args, size);
+        _args += size;
+        break;
+    }
+    }
+}
+}  // namespace
+
+Buffer::Buffer(size_t _capacity, uint64_t _generation) : m_generation(_generation)
+{
+    size_t capacity = 1024;
+    while (capacity < _capacity)
+    {
+        capacity <<= 1;
+    }
+    m_data.resize(capacity);
+    m_mask = capacity - 1;
+}
+
+uint8_t* Buffer::reserve(size_t _size)
+{
+    auto size = (_size + c_recordAlignment - 1) & ~(c_recordAlignment - 1);
+    auto writePos = m_writePos.load(std::memory_order_relaxed);
+    auto readPos = m_readPos.load(std::memory_order_acquire);
+    auto offset = writePos & m_mask;
+    // the records are contiguous, skip the end of the ring if the record doesn't fit
+    size_t padding = offset + size > capacity() ? capacity() - offset : 0;
+    if (writePos + padding + size - readPos > capacity())
+    {
+        return nullptr;
+    }
+    if (padding > 0)
+    {
+        auto* header = reinterpret_cast<Header*>(&m_data[offset]);
+        header->size = padding;
+        header->argsSize = c_padding;
+        offset = 0;
+    }
+    m_reserved = padding + size;
+    auto* header = reinterpret_cast<Header*>(&m_data[offset]);
+    header->size = size;
+    return &m_data[offset];
+}
+
+void Buffer::commit()
+{
+    m_writePos.store(m_writePos.load(std::memory_order_relaxed) + m_reserved,
+        std::memory_order_release);
+}
+
+void AsyncLogger::start(AsyncLogPolicy _policy, size_t _bufferSize, Writer _writer)
+{
+    if (running())
+    {
+        return;
+    }
+    m_policy = _policy;
+    m_bufferSize = std::max(_bufferSize, sizeof(Buffer::Header) * 2);
+    m_writer = _writer ? std::move(_writer) : Writer(&AsyncLogger::writeFileLog);
+    // the buffers of the last run are not reused
+    ++m_generation;
+    m_running.store(true, std::memory_order_seq_cst);
+    m_consumer = std::make_unique<std::thread>([this]() { run(); });
+}
+
+void AsyncLogger::stop()
+{
+    if (!running())
+    {
+        return;
+    }
+    m_running.store(false, std::memory_order_seq_cst);
+    m_consumerCV.notify_one();
+    if (m_consumer && m_consumer->joinable())
+    {
+        m_consumer->join();
+    }
+    m_consumer.reset();
+    std::lock_guard<std::mutex> lock(x_buffers);
+    m_buffers.clear();
+}
+
+void AsyncLogger::format(
+    std::string& _out, std::string_view _format, uint8_t const* _args, uint8_t const* _argsEnd)
+{
+    size_t pos = 0;
+    while (pos < _format.size())
+    {
+        auto next = _format.find("{}", pos);
+        if (next == std::string_view::npos || _args >= _argsEnd)
+        {
+            _out.append(_format.substr(pos));
+            break;
+        }
+        _out.append(_format.substr(pos, next - pos));
+        appendArg(_out, _args);
+        pos = next + 2;
+    }
+    // the arguments without placeholder
+    while (_args < _argsEnd)
+    {
+        _out.push_back(' ');
+        appendArg(_out, _args);
+    }
+}
+
+void AsyncLogger::writeFileLog(
+    LogLevel _level, std::chrono::system_clock::time_point _timestamp, std::string_view _message)
+{
+    // the record carries the time when it's logged rather than written
+    thread_local boost::log::attributes::mutable_constant<boost::posix_time::ptime> timestamp(
+        boost::posix_time::ptime{});
+    thread_local auto logger = []() {
+        boost::log::sources::severity_channel_logger<boost::log::trivial::severity_level,
+            std::string>
+            logger(boost::log::keywords::channel = FileLogger);
+        logger.add_attribute("TimeStamp", timestamp);
+        return logger;
+    }();
+
+    auto microseconds =
+        std::chrono::duration_cast<std::chrono::microseconds>(_timestamp.time_since_epoch())
+            .count();
+    auto utcTime = boost::posix_time::from_time_t(microseconds / 1000000) +
+                   boost::posix_time::microseconds(microseconds % 1000000);
+    timestamp.set(
+        boost::date_time::c_local_adjustor<boost::posix_time::ptime>::utc_to_local(utcTime));
+    BOOST_LOG_SEV(logger, (boost::log::trivial::severity_level)_level) << _message;
+}
+
+Buffer* AsyncLogger::threadBuffer()
+{
+    auto& buffer = t_threadBuffer.buffer;
+    auto generation = m_generation.load(std::memory_order_relaxed);
+    if (!buffer || buffer->generation() != generation)
+    {
+        if (buffer)
+        {
+            buffer->closed = true;
+        }
+        buffer = std::make_shared<Buffer>(m_bufferSize, generation);
+        std::lock_guard<std::mutex> lock(x_buffers);
+        m_buffers.push_back(buffer);
+    }
+    return buffer.get();
+}
+
+void AsyncLogger::run()
+{
+    bcos::pthread_setThreadName("asyncLog");
+    while (true)
+    {
+        auto stopping = !running();
+        if (stopping)
+        {
+            // the records being written are drained below
+            while (m_producers.load(std::memory_order_seq_cst) > 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+        auto count = drain();
+        if (stopping)
+        {
+            break;
+        }
+        if (count == 0)
+        {
+            std::unique_lock<std::mutex> lock(x_consumer);
+            m_consumerCV.wait_for(lock, std::chrono::milliseconds(1));
+        }
+    }
+}
+
+size_t AsyncLogger::drain()
+{
+    std::vector<std::shared_ptr<Buffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(x_buffers);
+        buffers = m_buffers;
+    }
+    for (auto const& buffer : buffers)
+    {
+        buffer->consume([this](Buffer::Header const& _header, uint8_t const* _args,
+                            uint8_t const* _argsEnd) {
+            auto& record = m_batch.emplace_back();
+            record.timestamp = _header.timestamp;
+            record.level = _header.format->level;
+            format(record.message, _header.format->format, _args, _argsEnd);
+        });
+    }
+    // the records of the threads are merged by the time they are logged
+    std::stable_sort(m_batch.begin(), m_batch.end(),
+        [](Record const& _lhs, Record const& _rhs) { return _lhs.timestamp < _rhs.timestamp; });
+    for (auto const& record : m_batch)
+    {
+        m_writer(record.level,
+            std::chrono::system_clock::time_point(std::chrono::microseconds(record.timestamp)),
+            record.message);
+    }
+    auto count = m_batch.size();
+    m_batch.clear();
+
+    auto dropped = m_dropped.load(std::memory_order_relaxed);
+    if (dropped > m_reportedDropped)
+    {
+        m_writer(LogLevel::WARNING, std::chrono::system_clock::now(),
+            "[AsyncLog]drop the logs for the buffer is full,dropped=" +
+                std::to_string(dropped - m_reportedDropped));
+        m_reportedDropped = dropped;
+    }
+
+    std::lock_guard<std::mutex> lock(x_buffers);
+    m_buffers.erase(std::remove_if(m_buffers.begin(), m_buffers.end(),
+                        [](auto const& _buffer) { return _buffer->closed && _buffer->empty(); }),
+        m_buffers.end());
+    return count;
+}
@@ -0,0 +1,382 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief: asynchronous binary logging backend
+ *
+ * @file AsyncLog.h
+ */
+#pragma once
+#include "BoostLog.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace bcos
+{
+/// The static part of a log statement, its address identifies the statement in the records.
+/// Every "{}" in the format is replaced by the next argument.
+struct AsyncLogFormat
+{
+    std::string_view format;
+    LogLevel level;
+};
+
+// what the callers do when their buffer is full
+enum class AsyncLogPolicy
+{
+    DROP,
+    BLOCK,
+};
+
+namespace asynclog
+{
+enum class ArgType : uint8_t
+{
+    INT,
+    UINT,
+    DOUBLE,
+    BOOL,
+    STRING,
+};
+
+// convert the argument to one of the encodable types, the others are formatted by operator<< on
+// the calling thread
+template <class T>
+auto normalize(T const& _arg)
+{
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        return _arg;
+    }
+    else if constexpr (std::is_same_v<T, char>)
+    {
+        return std::string(1, _arg);
+    }
+    else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+    {
+        return (int64_t)_arg;
+    }
+    else if constexpr (std::is_integral_v<T>)
+    {
+        return (uint64_t)_arg;
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        return (double)_arg;
+    }
+    else if constexpr (std::is_convertible_v<T const&, std::string_view>)
+    {
+        return std::string_view(_arg);
+    }
+    else
+    {
+        std::ostringstream stream;
+        stream << _arg;
+        return stream.str();
+    }
+}
+
+template <class T>
+size_t encodedSize(T const& _arg)
+{
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        return 2;
+    }
+    else if constexpr (std::is_arithmetic_v<T>)
+    {
+        return 1 + sizeof(T);
+    }
+    else
+    {
+        return 1 + sizeof(uint32_t) + _arg.size();
+    }
+}
+
+template <class T>
+void encode(uint8_t*& _out, T const& _arg)
+{
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        *_out++ = (uint8_t)ArgType::BOOL;
+        *_out++ = _arg ? 1 : 0;
+        return;
+    }
+    else if constexpr (std::is_arithmetic_v<T>)
+    {
+        if constexpr (std::is_same_v<T, int64_t>)
+        {
+            *_out++ = (uint8_t)ArgType::INT;
+        }
+        else if constexpr (std::is_same_v<T, uint64_t>)
+        {
+            *_out++ = (uint8_t)ArgType::UINT;
+        }
+        else
+        {
+            *_out++ = (uint8_t)ArgType::DOUBLE;
+        }
+        std::memcpy(_out, &_arg, sizeof(T));
+        _out += sizeof(T);
+    }
+    else
+    {
+        *_out++ = (uint8_t)ArgType::STRING;
+        auto size = (uint32_t)_arg.size();
+        std::memcpy(_out, &size, sizeof(size));
+        _out += sizeof(size);
+        std::memcpy(_out, _arg.data(), size);
+        _out += size;
+    }
+}
+
+/// The records of one thread. Only the owner thread writes and only the backend thread reads, so
+/// the ring needs no lock: the writer publishes the records by m_writePos and the reader frees
+/// them by m_readPos.
+class Buffer
+{
+public:
+    constexpr static uint32_t c_padding = UINT32_MAX;
+
+    // the records are aligned to 8 bytes
+    struct Header
+    {
+        uint32_t size;
+        // c_padding if the rest of the ring is skipped, only size is valid then
+        uint32_t argsSize;
+        AsyncLogFormat const* format;
+        int64_t timestamp;  // microseconds since epoch
+    };
+
+    Buffer(size_t _capacity, uint64_t _generation);
+
+    // return the space of a record of _size bytes, nullptr if the ring is full, the size of the
+    // header is set
+    uint8_t* reserve(size_t _size);
+    // publish the reserved record
+    void commit();
+
+    // call _reader(header, args, argsEnd) for every published record
+    template <class Reader>
+    size_t consume(Reader&& _reader)
+    {
+        auto readPos = m_readPos.load(std::memory_order_relaxed);
+        auto writePos = m_writePos.load(std::memory_order_acquire);
+        size_t count = 0;
+        while (readPos < writePos)
+        {
+            auto* header = reinterpret_cast<Header const*>(&m_data[readPos & m_mask]);
+            if (header->argsSize != c_padding)
+            {
+                auto* args = reinterpret_cast<uint8_t const*>(header + 1);
+                _reader(*header, args, args + header->argsSize);
+                ++count;
+            }
+            readPos += header->size;
+        }
+        m_readPos.store(readPos, std::memory_order_release);
+        return count;
+    }
+
+    bool empty() const
+    {
+        return m_readPos.load(std::memory_order_acquire) ==
+               m_writePos.load(std::memory_order_acquire);
+    }
+    size_t capacity() const { return m_mask + 1; }
+    uint64_t generation() const { return m_generation; }
+
+    // the owner thread exited
+    std::atomic_bool closed = false;
+
+private:
+    std::vector<uint8_t> m_data;
+    size_t m_mask;
+    uint64_t m_generation;
+    size_t m_reserved = 0;
+    alignas(64) std::atomic_uint64_t m_writePos = 0;
+    alignas(64) std::atomic_uint64_t m_readPos = 0;
+};
+}  // namespace asynclog
+
+/// AsyncLogger moves the formatting and the writing of the logs out of the calling threads. The
+/// callers only copy the arguments into their own ring buffer, a background thread decodes the
+/// records of all the threads, formats and writes them in batches ordered by the timestamp.
+/// When the logger is not started, the logs are formatted and written on the calling thread.
+class AsyncLogger
+{
+public:
+    // write a formatted record, the default writer passes it to the FileLogger channel. The writer
+    // is called by the background thread, and by the callers for the records too large to buffer
+    using Writer = std::function<void(
+        LogLevel, std::chrono::system_clock::time_point, std::string_view _message)>;
+
+    constexpr static size_t c_defaultBufferSize = 1024 * 1024;
+
+    static AsyncLogger& instance()
+    {
+        static AsyncLogger logger;
+        return logger;
+    }
+    ~AsyncLogger() { stop(); }
+
+    // _bufferSize: the ring buffer size of each thread, in bytes
+    void start(AsyncLogPolicy _policy, size_t _bufferSize = c_defaultBufferSize,
+        Writer _writer = Writer());
+    // write all the buffered records and stop the background thread
+    void stop();
+
+    bool running() const { return m_running.load(std::memory_order_acquire); }
+    uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    template <class... Args>
+    void log(AsyncLogFormat const& _format, Args const&... _args)
+    {
+        logNormalized(_format, asynclog::normalize(_args)...);
+    }
+
+    // format the encoded arguments
+    static void format(std::string& _out, std::string_view _format, uint8_t const* _args,
+        uint8_t const* _argsEnd);
+
+private:
+    template <class... Args>
+    void logNormalized(AsyncLogFormat const& _format, Args const&... _args)
+    {
+        auto timestamp = std::chrono::system_clock::now();
+        // the fatal logs abort the process in the sink, so they are written synchronously
+        if (_format.level == LogLevel::FATAL || !running())
+        {
+            writeSync(_format, timestamp, _args...);
+            return;
+        }
+        // stop() waits for the producers before the last drain
+        m_producers.fetch_add(1, std::memory_order_seq_cst);
+        if (!running())
+        {
+            m_producers.fetch_sub(1, std::memory_order_seq_cst);
+            writeSync(_format, timestamp, _args...);
+            return;
+        }
+        auto size = sizeof(asynclog::Buffer::Header) + (asynclog::encodedSize(_args) + ... + 0);
+        auto* buffer = threadBuffer();
+        auto* out = buffer->reserve(size);
+        while (!out && m_policy == AsyncLogPolicy::BLOCK && running() &&
+               size * 2 <= buffer->capacity())
+        {
+            m_consumerCV.notify_one();
+            std::this_thread::yield();
+            out = buffer->reserve(size);
+        }
+        if (!out)
+        {
+            m_producers.fetch_sub(1, std::memory_order_seq_cst);
+            if (size * 2 > buffer->capacity() || !running())
+            {
+                // too large for the ring, or the logger is stopping
+                writeSync(_format, timestamp, _args...);
+                return;
+            }
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        auto* header = reinterpret_cast<asynclog::Buffer::Header*>(out);
+        header->argsSize = size - sizeof(asynclog::Buffer::Header);
+        header->format = &_format;
+        header->timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+            timestamp.time_since_epoch())
+                                .count();
+        out += sizeof(asynclog::Buffer::Header);
+        (asynclog::encode(out, _args), ...);
+        buffer->commit();
+        m_producers.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    template <class... Args>
+    void writeSync(AsyncLogFormat const& _format, std::chrono::system_clock::time_point _timestamp,
+        Args const&... _args)
+    {
+        std::vector<uint8_t> args((asynclog::encodedSize(_args) + ... + 0));
+        auto* out = args.data();
+        (asynclog::encode(out, _args), ...);
+        std::string message;
+        format(message, _format.format, args.data(), args.data() + args.size());
+        if (running())
+        {
+            m_writer(_format.level, _timestamp, message);
+        }
+        else
+        {
+            writeFileLog(_format.level, _timestamp, message);
+        }
+    }
+
+    static void writeFileLog(LogLevel _level, std::chrono::system_clock::time_point _timestamp,
+        std::string_view _message);
+
+    asynclog::Buffer* threadBuffer();
+    void run();
+    size_t drain();
+
+    AsyncLogPolicy m_policy = AsyncLogPolicy::BLOCK;
+    size_t m_bufferSize = c_defaultBufferSize;
+    Writer m_writer;
+    std::atomic_uint64_t m_generation = 0;
+
+    std::atomic_bool m_running = false;
+    std::atomic_int64_t m_producers = 0;
+    std::atomic_uint64_t m_dropped = 0;
+    uint64_t m_reportedDropped = 0;
+
+    std::mutex x_buffers;
+    std::vector<std::shared_ptr<asynclog::Buffer>> m_buffers;
+
+    std::mutex x_consumer;
+    std::condition_variable m_consumerCV;
+    std::unique_ptr<std::thread> m_consumer;
+
+    struct Record
+    {
+        int64_t timestamp;
+        LogLevel level;
+        std::string message;
+    };
+    std::vector<Record> m_batch;
+
+    AsyncLogger() = default;
+};
+}  // namespace bcos
+
+// log by the AsyncLogger, e.g. BCOS_ASYNC_LOG(INFO, "[PBFT][execute],index={}", index)
+#define BCOS_ASYNC_LOG(LEVEL, FORMAT, ...)                                                  \
+    do                                                                                      \
+    {                                                                                       \
+        if (bcos::LogLevel::LEVEL >= bcos::c_fileLogLevel)                                  \
+        {                                                                                   \
+            static constexpr bcos::AsyncLogFormat c_asyncLogFormat{                         \
+                FORMAT, bcos::LogLevel::LEVEL};                                             \
+            bcos::AsyncLogger::instance().log(c_asyncLogFormat __VA_OPT__(, ) __VA_ARGS__); \
+        }                                                                                   \
+    } while (0)
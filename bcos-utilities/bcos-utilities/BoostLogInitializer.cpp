@@ -19,10 +19,13 @@
  * @author: yujiechen
  */
 #include "BoostLogInitializer.h"
+#include "AsyncLog.h"
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/log/core/core.hpp>
 #include <boost/log/support/date_time.hpp>
 #include <boost/log/utility/setup/common_attributes.hpp>
+#include <boost/throw_exception.hpp>
+#include <stdexcept>
 
 using namespace bcos;
 
@@ -99,6 +102,27 @@ void BoostLogInitializer::initLog(boost::property_tree::ptree const& _pt,
                         << boost::log::expressions::format_date_time<boost::posix_time::ptime>(
                                "TimeStamp", "%Y-%m-%d %H:%M:%S.%f")
                         << "|" << boost::log::expressions::smessage);
+
+    initAsyncLog(_pt);
+}
+
+/// format and write the logs of BCOS_ASYNC_LOG on a background thread
+void BoostLogInitializer::initAsyncLog(boost::property_tree::ptree const& _pt)
+{
+    if (!_pt.get<bool>("log.async_backend", false))
+    {
+        return;
+    }
+    auto policy = _pt.get<std::string>("log.async_full_policy", "block");
+    if (!boost::iequals(policy, "block") && !boost::iequals(policy, "drop"))
+    {
+        BOOST_THROW_EXCEPTION(
+            std::invalid_argument("log.async_full_policy should be block or drop: " + policy));
+    }
+    // KB
+    auto bufferSize = _pt.get<size_t>("log.async_buffer_size", 1024) * 1024;
+    AsyncLogger::instance().start(
+        boost::iequals(policy, "drop") ? AsyncLogPolicy::DROP : AsyncLogPolicy::BLOCK, bufferSize);
 }
 
 boost::shared_ptr<bcos::BoostLogInitializer::sink_t> BoostLogInitializer::initLogSink(
@@ -166,6 +190,8 @@ void BoostLogInitializer::stopLogging()
         return;
     }
     m_running.store(false);
+    // write the buffered records before the sinks are removed
+    AsyncLogger::instance().stop();
     for (auto const& sink : m_sinks)
     {
         stopLogging(sink);
@@ -79,6 +79,7 @@ public:
 
 private:
     bool canRotate(size_t const& _index);
+    void initAsyncLog(boost::property_tree::ptree const& _pt);
 
     boost::shared_ptr<sink_t> initLogSink(boost::property_tree::ptree const& _pt,
         unsigned const& _logLevel, std::string const& _logPath, std::string const& _logPrefix,
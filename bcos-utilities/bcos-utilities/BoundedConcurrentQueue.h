@@ -0,0 +1,416 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief bounded lock-free multi-producer multi-consumer queue
+ * @file BoundedConcurrentQueue.h
+ */
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <vector>
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace bcos
+{
+/// EventCount lets the threads wait for a condition without a mutex, the notifier only pays a
+/// fence and a load when nobody is waiting.
+/// The waiter: prepareWait(), check the condition again, then cancelWait() if it's satisfied or
+/// wait() otherwise. The notifier: satisfy the condition, then notify().
+class EventCount
+{
+public:
+    uint32_t prepareWait()
+    {
+        m_waiters.fetch_add(1, std::memory_order_seq_cst);
+        return m_epoch.load(std::memory_order_seq_cst);
+    }
+
+    void cancelWait() { m_waiters.fetch_sub(1, std::memory_order_seq_cst); }
+
+    // wait until notified after prepareWait, or timeout, or spuriously
+    void wait(uint32_t _epoch, std::optional<std::chrono::milliseconds> _timeout = std::nullopt)
+    {
+#if defined(__linux__)
+        static_assert(sizeof(m_epoch) == sizeof(uint32_t));
+        struct timespec timeout;
+        if (_timeout)
+        {
+            timeout.tv_sec = _timeout->count() / 1000;
+            timeout.tv_nsec = (_timeout->count() % 1000) * 1000000;
+        }
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_epoch), FUTEX_WAIT_PRIVATE, _epoch,
+            _timeout ? &timeout : nullptr, nullptr, 0);
+#else
+        std::unique_lock<std::mutex> lock(x_epoch);
+        auto notified = [this, _epoch]() { return m_epoch.load() != _epoch; };
+        if (_timeout)
+        {
+            m_cv.wait_for(lock, *_timeout, notified);
+        }
+        else
+        {
+            m_cv.wait(lock, notified);
+        }
+#endif
+        m_waiters.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    void notify(bool _all = false)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_waiters.load(std::memory_order_relaxed) == 0)
+        {
+            return;
+        }
+#if defined(__linux__)
+        m_epoch.fetch_add(1, std::memory_order_seq_cst);
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_epoch), FUTEX_WAKE_PRIVATE,
+            _all ? INT_MAX : 1, nullptr, nullptr, 0);
+#else
+        {
+            std::lock_guard<std::mutex> lock(x_epoch);
+            m_epoch.fetch_add(1, std::memory_order_seq_cst);
+        }
+        if (_all)
+        {
+            m_cv.notify_all();
+        }
+        else
+        {
+            m_cv.notify_one();
+        }
+#endif
+    }
+
+private:
+    std::atomic<uint32_t> m_epoch = 0;
+    std::atomic<uint32_t> m_waiters = 0;
+#if !defined(__linux__)
+    std::mutex x_epoch;
+    std::condition_variable m_cv;
+#endif
+};
+
+/// Bounded lock-free multi-producer multi-consumer queue.
+/// The slots of the ring carry a sequence number, the producers and the consumers claim the slots
+/// by CAS on their own cursor, so push and pop never take a lock. The blocking operations wait on
+/// the EventCount, and push blocks when the queue is full to apply back-pressure to the
+/// producers. The blocked producers are resumed after a quarter of the queue is drained rather
+/// than on every pop, so the consumers don't pay a wake-up syscall per element.
+template <typename _T>
+class BoundedConcurrentQueue
+{
+public:
+    constexpr static size_t c_defaultCapacity = 65536;
+
+    // the capacity is rounded up to the power of 2
+    explicit BoundedConcurrentQueue(size_t _capacity = c_defaultCapacity)
+    {
+        size_t capacity = 2;
+        while (capacity < _capacity)
+        {
+            capacity <<= 1;
+        }
+        m_mask = capacity - 1;
+        m_resumeSize = capacity - std::max<size_t>(capacity / 4, 1);
+        m_slots = std::vector<Slot>(capacity);
+        for (size_t i = 0; i < capacity; ++i)
+        {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedConcurrentQueue(const BoundedConcurrentQueue&) = delete;
+    BoundedConcurrentQueue& operator=(const BoundedConcurrentQueue&) = delete;
+
+    size_t capacity() const { return m_mask + 1; }
+
+    // the approximate size when there are concurrent operations
+    size_t size() const
+    {
+        auto pushPos = m_pushPos.load(std::memory_order_acquire);
+        auto popPos = m_popPos.load(std::memory_order_acquire);
+        return pushPos > popPos ? pushPos - popPos : 0;
+    }
+    bool empty() const { return size() == 0; }
+
+    // return false if the queue is full
+    template <typename _U>
+    bool tryPush(_U&& _elem)
+    {
+        if (!doPush(std::forward<_U>(_elem)))
+        {
+            return false;
+        }
+        m_notEmpty.notify();
+        return true;
+    }
+
+    // wait at most _milliseconds for room, return false if timeout
+    template <typename _U>
+    bool tryPush(_U&& _elem, int _milliseconds)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(_milliseconds);
+        while (!doPush(std::forward<_U>(_elem)))
+        {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline)
+            {
+                return false;
+            }
+            waitFor(m_notFull, [this]() { return size() <= m_resumeSize; },
+                std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now) +
+                    std::chrono::milliseconds(1));
+        }
+        m_notEmpty.notify();
+        return true;
+    }
+
+    // block until there is room
+    template <typename _U>
+    void push(_U&& _elem)
+    {
+        while (!doPush(std::forward<_U>(_elem)))
+        {
+            waitFor(m_notFull, [this]() { return size() <= m_resumeSize; });
+        }
+        m_notEmpty.notify();
+    }
+
+    // move all the elements in and wake up the consumers once, block when the queue is full
+    template <typename _Iterator>
+    void pushBatch(_Iterator _begin, _Iterator _end)
+    {
+        for (auto it = _begin; it != _end; ++it)
+        {
+            while (!doPush(std::move(*it)))
+            {
+                m_notEmpty.notify(true);
+                waitFor(m_notFull, [this]() { return size() <= m_resumeSize; });
+            }
+        }
+        m_notEmpty.notify(true);
+    }
+
+    std::optional<_T> tryPop()
+    {
+        auto elem = doPop();
+        if (elem)
+        {
+            notifyNotFull();
+        }
+        return elem;
+    }
+
+    // block until there is an element
+    _T pop()
+    {
+        while (true)
+        {
+            auto elem = doPop();
+            if (elem)
+            {
+                notifyNotFull();
+                return std::move(*elem);
+            }
+            waitFor(m_notEmpty, [this]() { return !empty(); });
+        }
+    }
+
+    // wait at most _milliseconds for an element
+    std::optional<_T> tryPop(int _milliseconds)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(_milliseconds);
+        while (true)
+        {
+            auto elem = doPop();
+            if (elem)
+            {
+                notifyNotFull();
+                return elem;
+            }
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline)
+            {
+                return std::nullopt;
+            }
+            waitFor(m_notEmpty, [this]() { return !empty(); },
+                std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now) +
+                    std::chrono::milliseconds(1));
+        }
+    }
+
+    // block until there is an element, then pop at most _maxSize elements into _elems and wake
+    // up the producers once, return the number of the popped elements
+    size_t popBatch(std::vector<_T>& _elems, size_t _maxSize)
+    {
+        return doPopBatch(_elems, _maxSize, std::nullopt);
+    }
+
+    // popBatch waiting at most _milliseconds, return 0 if timeout
+    size_t tryPopBatch(std::vector<_T>& _elems, size_t _maxSize, int _milliseconds)
+    {
+        return doPopBatch(_elems, _maxSize,
+            std::chrono::steady_clock::now() + std::chrono::milliseconds(_milliseconds));
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        _T value;
+    };
+
+    template <typename _U>
+    bool doPush(_U&& _elem)
+    {
+        auto pos = m_pushPos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            auto& slot = m_slots[pos & m_mask];
+            auto sequence = slot.sequence.load(std::memory_order_acquire);
+            auto diff = (intptr_t)sequence - (intptr_t)pos;
+            if (diff == 0)
+            {
+                if (m_pushPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    slot.value = std::forward<_U>(_elem);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                // full
+                return false;
+            }
+            else
+            {
+                pos = m_pushPos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::optional<_T> doPop()
+    {
+        auto pos = m_popPos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            auto& slot = m_slots[pos & m_mask];
+            auto sequence = slot.sequence.load(std::memory_order_acquire);
+            auto diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+            if (diff == 0)
+            {
+                if (m_popPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    std::optional<_T> elem(std::move(slot.value));
+                    slot.value = _T();
+                    slot.sequence.store(pos + m_mask + 1, std::memory_order_release);
+                    return elem;
+                }
+            }
+            else if (diff < 0)
+            {
+                // empty
+                return std::nullopt;
+            }
+            else
+            {
+                pos = m_popPos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    size_t doPopBatch(std::vector<_T>& _elems, size_t _maxSize,
+        std::optional<std::chrono::steady_clock::time_point> _deadline)
+    {
+        size_t count = 0;
+        while (true)
+        {
+            while (count < _maxSize)
+            {
+                auto elem = doPop();
+                if (!elem)
+                {
+                    break;
+                }
+                _elems.emplace_back(std::move(*elem));
+                ++count;
+            }
+            if (count > 0)
+            {
+                notifyNotFull();
+                return count;
+            }
+            if (!_deadline)
+            {
+                waitFor(m_notEmpty, [this]() { return !empty(); });
+                continue;
+            }
+            auto now = std::chrono::steady_clock::now();
+            if (now >= *_deadline)
+            {
+                return 0;
+            }
+            waitFor(m_notEmpty, [this]() { return !empty(); },
+                std::chrono::duration_cast<std::chrono::milliseconds>(*_deadline - now) +
+                    std::chrono::milliseconds(1));
+        }
+    }
+
+    void notifyNotFull()
+    {
+        if (size() <= m_resumeSize)
+        {
+            m_notFull.notify(true);
+        }
+    }
+
+    template <typename _Ready>
+    static void waitFor(EventCount& _event, _Ready&& _ready,
+        std::optional<std::chrono::milliseconds> _timeout = std::nullopt)
+    {
+        auto epoch = _event.prepareWait();
+        if (_ready())
+        {
+            // the slot is claimed but not published yet, let the other side finish it
+            _event.cancelWait();
+            std::this_thread::yield();
+            return;
+        }
+        _event.wait(epoch, _timeout);
+    }
+
+    size_t m_mask;
+    size_t m_resumeSize;
+    std::vector<Slot> m_slots;
+    alignas(64) std::atomic<size_t> m_pushPos = 0;
+    alignas(64) std::atomic<size_t> m_popPos = 0;
+    EventCount m_notEmpty;
+    EventCount m_notFull;
+};
+}  // namespace bcos
@@ -17,6 +17,8 @@
  *  @file ConcurrentQueue.h
  */
 #pragma once
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
 #include <condition_variable>
 #include <mutex>
 #include <queue>
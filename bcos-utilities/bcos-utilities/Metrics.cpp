@@ -0,0 +1,264 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief: low-overhead counters, gauges and latency histograms, exported in the Prometheus text
+ * format
+ *
+ * @file Metrics.cpp
+ */
+#include "Metrics.h"
+#include <boost/throw_exception.hpp>
+#include <bit>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+using namespace bcos;
+using namespace bcos::metrics;
+
+namespace
+{
+// the le buckets of the exported histograms, in microseconds
+constexpr std::array<uint64_t, 13> c_exportBounds = {10, 50, 100, 500, 1000, 5000, 10000, 50000,
+    100000, 500000, 1000000, 5000000, 10000000};
+
+std::string formatSeconds(uint64_t _microseconds)
+{
+    std::ostringstream stream;
+    stream << (double)_microseconds / 1000000;
+    return stream.str();
+}
+
+// name{labels,extra}
+std::string sample(
+    std::string const& _name, std::string const& _labels, std::string const& _extraLabel = "")
+{
+    if (_labels.empty() && _extraLabel.empty())
+    {
+        return _name;
+    }
+    std::string labels = _labels;
+    if (!_extraLabel.empty())
+    {
+        labels += (labels.empty() ? "" : ",") + _extraLabel;
+    }
+    return _name + "{" + labels + "}";
+}
+}  // namespace
+
+size_t Counter::shardIndex()
+{
+    static std::atomic_size_t nextIndex = 0;
+    thread_local size_t index = nextIndex.fetch_add(1, std::memory_order_relaxed) % c_shardNum;
+    return index;
+}
+
+uint64_t Counter::value() const
+{
+    uint64_t value = 0;
+    for (auto const& shard : m_shards)
+    {
+        value += shard.value.load(std::memory_order_relaxed);
+    }
+    return value;
+}
+
+size_t Histogram::bucketIndex(uint64_t _value)
+{
+    if (_value < c_subBucketNum)
+    {
+        return _value;
+    }
+    size_t shift = std::bit_width(_value) - 1 - c_subBucketBits;
+    return (shift + 1) * c_subBucketNum + ((_value >> shift) & (c_subBucketNum - 1));
+}
+
+uint64_t Histogram::bucketLowerBound(size_t _index)
+{
+    if (_index < c_subBucketNum)
+    {
+        return _index;
+    }
+    size_t shift = _index / c_subBucketNum - 1;
+    return (c_subBucketNum + _index % c_subBucketNum) << shift;
+}
+
+uint64_t Histogram::bucketUpperBound(size_t _index)
+{
+    if (_index + 1 >= c_bucketNum)
+    {
+        return UINT64_MAX;
+    }
+    return bucketLowerBound(_index + 1) - 1;
+}
+
+Histogram::Buckets Histogram::snapshot() const
+{
+    Buckets buckets;
+    for (size_t i = 0; i < c_bucketNum; ++i)
+    {
+        buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+    }
+    return buckets;
+}
+
+uint64_t Histogram::count() const
+{
+    uint64_t count = 0;
+    for (auto const& bucket : m_buckets)
+    {
+        count += bucket.load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+uint64_t Histogram::countLE(uint64_t _bound) const
+{
+    uint64_t count = 0;
+    for (size_t i = 0; i < c_bucketNum && bucketLowerBound(i) <= _bound; ++i)
+    {
+        count += m_buckets[i].load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+uint64_t Histogram::quantile(double _quantile) const
+{
+    auto buckets = snapshot();
+    uint64_t total = 0;
+    for (auto count : buckets)
+    {
+        total += count;
+    }
+    if (total == 0)
+    {
+        return 0;
+    }
+    auto rank = std::max<uint64_t>((uint64_t)std::ceil(_quantile * (double)total), 1);
+    uint64_t count = 0;
+    for (size_t i = 0; i < c_bucketNum; ++i)
+    {
+        count += buckets[i];
+        if (count >= rank)
+        {
+            return bucketUpperBound(i);
+        }
+    }
+    return UINT64_MAX;
+}
+
+template <class T>
+T& MetricsRegistry::getOrCreate(
+    std::string const& _name, std::string const& _help, std::string const& _labels)
+{
+    std::string type;
+    if constexpr (std::is_same_v<T, Counter>)
+    {
+        type = "counter";
+    }
+    else if constexpr (std::is_same_v<T, Gauge>)
+    {
+        type = "gauge";
+    }
+    else
+    {
+        type = "histogram";
+    }
+
+    std::lock_guard<std::mutex> lock(x_families);
+    auto [familyIt, inserted] = m_families.try_emplace(_name, Family{type, _help, {}});
+    if (!inserted && familyIt->second.type != type)
+    {
+        BOOST_THROW_EXCEPTION(std::invalid_argument(
+            "metric " + _name + " is already registered as " + familyIt->second.type));
+    }
+    auto& metric = familyIt->second.metrics[_labels];
+    if (std::holds_alternative<std::unique_ptr<T>>(metric) && std::get<std::unique_ptr<T>>(metric))
+    {
+        return *std::get<std::unique_ptr<T>>(metric);
+    }
+    metric = std::make_unique<T>();
+    return *std::get<std::unique_ptr<T>>(metric);
+}
+
+Counter& MetricsRegistry::counter(
+    std::string const& _name, std::string const& _help, std::string const& _labels)
+{
+    return getOrCreate<Counter>(_name, _help, _labels);
+}
+
+Gauge& MetricsRegistry::gauge(
+    std::string const& _name, std::string const& _help, std::string const& _labels)
+{
+    return getOrCreate<Gauge>(_name, _help, _labels);
+}
+
+Histogram& MetricsRegistry::histogram(
+    std::string const& _name, std::string const& _help, std::string const& _labels)
+{
+    return getOrCreate<Histogram>(_name, _help, _labels);
+}
+
+std::string MetricsRegistry::prometheusText() const
+{
+    std::ostringstream text;
+    std::lock_guard<std::mutex> lock(x_families);
+    for (auto const& [name, family] : m_families)
+    {
+        text << "# HELP " << name << " " << family.help << "\n";
+        text << "# TYPE " << name << " " << family.type << "\n";
+        for (auto const& [labels, metric] : family.metrics)
+        {
+            if (auto const* counter = std::get_if<std::unique_ptr<Counter>>(&metric))
+            {
+                text << sample(name, labels) << " " << (*counter)->value() << "\n";
+            }
+            else if (auto const* gauge = std::get_if<std::unique_ptr<Gauge>>(&metric))
+            {
+                text << sample(name, labels) << " " << (*gauge)->value() << "\n";
+            }
+            else
+            {
+                auto const& histogram = *std::get<std::unique_ptr<Histogram>>(metric);
+                // export from one snapshot to keep the buckets cumulative under concurrent updates
+                auto buckets = histogram.snapshot();
+                uint64_t count = 0;
+                size_t index = 0;
+                for (auto bound : c_exportBounds)
+                {
+                    // the bound is inside a bucket rather than on its edge, count the whole bucket
+                    // in, otherwise the values just below the bound are missed
+                    for (; index < Histogram::c_bucketNum &&
+                           Histogram::bucketLowerBound(index) <= bound;
+                         ++index)
+                    {
+                        count += buckets[index];
+                    }
+                    text << sample(name + "_bucket", labels, "le=\"" + formatSeconds(bound) + "\"")
+                         << " " << count << "\n";
+                }
+                for (; index < Histogram::c_bucketNum; ++index)
+                {
+                    count += buckets[index];
+                }
+                text << sample(name + "_bucket", labels, "le=\"+Inf\"") << " " << count << "\n";
+                text << sample(name + "_sum", labels) << " " << formatSeconds(histogram.sum())
+                     << "\n";
+                text << sample(name + "_count", labels) << " " << count << "\n";
+            }
+        }
+    }
+    return text.str();
+}
@@ -0,0 +1,167 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief: low-overhead counters, gauges and latency histograms, exported in the Prometheus text
+ * format
+ *
+ * @file Metrics.h
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <variant>
+
+namespace bcos::metrics
+{
+// Counter only increases, the increments are spread over the shards to avoid contending on one
+// cache line
+class Counter
+{
+public:
+    constexpr static size_t c_shardNum = 16;
+
+    void inc(uint64_t _value = 1)
+    {
+        m_shards[shardIndex()].value.fetch_add(_value, std::memory_order_relaxed);
+    }
+    uint64_t value() const;
+
+private:
+    struct alignas(64) Shard
+    {
+        std::atomic_uint64_t value = 0;
+    };
+    static size_t shardIndex();
+
+    std::array<Shard, c_shardNum> m_shards;
+};
+
+class Gauge
+{
+public:
+    void set(int64_t _value) { m_value.store(_value, std::memory_order_relaxed); }
+    void add(int64_t _value) { m_value.fetch_add(_value, std::memory_order_relaxed); }
+    int64_t value() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic_int64_t m_value = 0;
+};
+
+// Histogram of the latencies in microseconds. The buckets are HDR-style: every power of 2 is split
+// into 8 linear sub-buckets, so the relative error of the quantiles is at most 12.5% from 1us to
+// hours with less than 500 buckets.
+class Histogram
+{
+public:
+    constexpr static size_t c_subBucketBits = 3;
+    constexpr static size_t c_subBucketNum = 1 << c_subBucketBits;
+    constexpr static size_t c_bucketNum = (64 - c_subBucketBits + 1) * c_subBucketNum;
+
+    void observe(uint64_t _microseconds)
+    {
+        m_buckets[bucketIndex(_microseconds)].fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(_microseconds, std::memory_order_relaxed);
+    }
+
+    using Buckets = std::array<uint64_t, c_bucketNum>;
+
+    uint64_t count() const;
+    uint64_t sum() const { return m_sum.load(std::memory_order_relaxed); }
+    // the count of the values not greater than _bound, including the other values in the bucket of
+    // _bound, so it's at most one sub-bucket (1/8 of _bound) too high but never too low
+    uint64_t countLE(uint64_t _bound) const;
+    // the upper bound of the bucket of the quantile, _quantile in [0, 1]
+    uint64_t quantile(double _quantile) const;
+    // a consistent copy of the bucket counts for exporting
+    Buckets snapshot() const;
+
+    static size_t bucketIndex(uint64_t _value);
+    // the values in the bucket are in [lowerBound, upperBound]
+    static uint64_t bucketLowerBound(size_t _index);
+    static uint64_t bucketUpperBound(size_t _index);
+
+private:
+    std::array<std::atomic_uint64_t, c_bucketNum> m_buckets{};
+    std::atomic_uint64_t m_sum = 0;
+};
+
+// record the time from the construction to the destruction into the histogram
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(Histogram& _histogram)
+      : m_histogram(_histogram), m_start(std::chrono::steady_clock::now())
+    {}
+    ~ScopedTimer()
+    {
+        m_histogram.observe(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - m_start)
+                                .count());
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Histogram& m_histogram;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+// MetricsRegistry owns all the metrics of the process. The metrics are never removed, so the
+// callers should look them up once and keep the reference.
+class MetricsRegistry
+{
+public:
+    static MetricsRegistry& instance()
+    {
+        static MetricsRegistry registry;
+        return registry;
+    }
+
+    // _labels: the labels in the Prometheus format, e.g. type="prepare"
+    Counter& counter(
+        std::string const& _name, std::string const& _help, std::string const& _labels = "");
+    Gauge& gauge(
+        std::string const& _name, std::string const& _help, std::string const& _labels = "");
+    // the histograms are exported in seconds, the name should end with _seconds
+    Histogram& histogram(
+        std::string const& _name, std::string const& _help, std::string const& _labels = "");
+
+    // all the metrics in the Prometheus text exposition format
+    std::string prometheusText() const;
+
+private:
+    using Metric = std::variant<std::unique_ptr<Counter>, std::unique_ptr<Gauge>,
+        std::unique_ptr<Histogram>>;
+    struct Family
+    {
+        std::string type;
+        std::string help;
+        std::map<std::string, Metric> metrics;
+    };
+
+    template <class T>
+    T& getOrCreate(std::string const& _name, std::string const& _help, std::string const& _labels);
+
+    mutable std::mutex x_families;
+    std::map<std::string, Family> m_families;
+};
+}  // namespace bcos::metrics
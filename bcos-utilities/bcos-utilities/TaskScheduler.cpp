@@ -0,0 +1,261 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief: the process-wide work-stealing scheduler shared by the modules
+ *
+ * @file TaskScheduler.cpp
+ */
+#include "TaskScheduler.h"
+#include "Timer.h"
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <chrono>
+#include <thread>
+
+using namespace bcos;
+
+#define SCHEDULER_LOG(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE("TaskScheduler")
+
+namespace
+{
+uint64_t steadyTimeUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+}  // namespace
+
+tbb::task_arena::priority TaskScheduler::priority(TaskClass _taskClass)
+{
+    // tbb only has three priorities: the execution of the proposals goes after the consensus
+    // messages but before the blocks and txs from the peers, the executive flows are the tasks of
+    // the same execution. rpc shares the lowest priority with sync, since both serve the
+    // requests from the outside that can wait
+    switch (_taskClass)
+    {
+    case TaskClass::CONSENSUS:
+        return tbb::task_arena::priority::high;
+    case TaskClass::EXECUTION:
+    case TaskClass::EXECUTIVE_FLOW:
+        return tbb::task_arena::priority::normal;
+    default:
+        return tbb::task_arena::priority::low;
+    }
+}
+
+std::string_view bcos::taskClassName(TaskClass _taskClass)
+{
+    switch (_taskClass)
+    {
+    case TaskClass::CONSENSUS:
+        return "consensus";
+    case TaskClass::EXECUTION:
+        return "execution";
+    case TaskClass::EXECUTIVE_FLOW:
+        return "executiveFlow";
+    case TaskClass::SYNC:
+        return "sync";
+    case TaskClass::RPC:
+        return "rpc";
+    default:
+        return "unknown";
+    }
+}
+
+TaskScheduler::AffinityObserver::AffinityObserver(
+    tbb::task_arena& _arena, std::vector<int> const& _cpus, std::atomic_size_t& _nextCpu)
+  : tbb::task_scheduler_observer(_arena), m_cpus(_cpus), m_nextCpu(_nextCpu)
+{
+    observe(true);
+}
+
+void TaskScheduler::AffinityObserver::on_scheduler_entry(bool)
+{
+    // the workers move between the arenas, only pin them the first time
+    thread_local bool pinned = false;
+    if (pinned)
+    {
+        return;
+    }
+    pinned = true;
+#if defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(m_cpus[m_nextCpu++ % m_cpus.size()], &cpuSet);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+#endif
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    stopReport();
+    m_observers.clear();
+}
+
+void TaskScheduler::init(size_t _threadNum, std::vector<int> _cpus)
+{
+    bool inited = true;
+    std::call_once(m_initFlag, [this, &inited, _threadNum, &_cpus]() {
+        inited = false;
+        doInit(_threadNum, std::move(_cpus));
+    });
+    if (inited)
+    {
+        SCHEDULER_LOG(WARNING) << LOG_DESC("TaskScheduler has already been initialized")
+                               << LOG_KV("threads", m_threadNum);
+    }
+}
+
+void TaskScheduler::doInit(size_t _threadNum, std::vector<int> _cpus)
+{
+    m_threadNum = _threadNum > 0 ? _threadNum : std::thread::hardware_concurrency();
+    m_cpus = std::move(_cpus);
+    for (size_t i = 0; i < m_arenas.size(); ++i)
+    {
+        // limit the concurrency of every arena rather than the process-wide tbb parallelism, so
+        // the tbb::parallel_for of the other modules keeps all the cpus
+        m_arenas[i] =
+            std::make_unique<tbb::task_arena>((int)m_threadNum, 0, priority((TaskClass)i));
+        m_arenas[i]->initialize();
+        if (!m_cpus.empty())
+        {
+            m_observers.emplace_back(
+                std::make_unique<AffinityObserver>(*m_arenas[i], m_cpus, m_nextCpu));
+        }
+    }
+    SCHEDULER_LOG(INFO) << LOG_DESC("init TaskScheduler") << LOG_KV("threads", m_threadNum)
+                        << LOG_KV("affinityCpus", m_cpus.size());
+}
+
+void TaskScheduler::enqueue(TaskClass _taskClass, std::function<void()> _task)
+{
+    std::call_once(m_initFlag, [this]() { doInit(0, {}); });
+    auto& stat = m_stats[(size_t)_taskClass];
+    ++stat.pending;
+    m_arenas[(size_t)_taskClass]->enqueue(
+        [&stat, task = std::move(_task), enqueueTime = steadyTimeUs(), _taskClass]() {
+            auto startTime = steadyTimeUs();
+            auto waitTime = startTime - enqueueTime;
+            --stat.pending;
+            auto maxWaitTime = stat.maxWaitTime.load();
+            while (waitTime > maxWaitTime &&
+                   !stat.maxWaitTime.compare_exchange_weak(maxWaitTime, waitTime))
+            {
+            }
+            stat.totalWaitTime += waitTime;
+            try
+            {
+                task();
+            }
+            catch (std::exception const& e)
+            {
+                SCHEDULER_LOG(ERROR) << LOG_DESC("task exception")
+                                     << LOG_KV("class", taskClassName(_taskClass))
+                                     << LOG_KV("error", boost::diagnostic_information(e));
+            }
+            catch (...)
+            {
+                SCHEDULER_LOG(ERROR) << LOG_DESC("task unknown exception")
+                                     << LOG_KV("class", taskClassName(_taskClass));
+            }
+            stat.totalExecTime += steadyTimeUs() - startTime;
+            ++stat.executed;
+        });
+}
+
+TaskScheduler::Stat TaskScheduler::stat(TaskClass _taskClass) const
+{
+    auto const& stat = m_stats[(size_t)_taskClass];
+    return Stat{stat.pending.load(), stat.executed.load(), stat.totalWaitTime.load(),
+        stat.maxWaitTime.load(), stat.totalExecTime.load()};
+}
+
+void TaskScheduler::startReport(uint64_t _interval)
+{
+    std::lock_guard<std::mutex> lock(x_reportTimer);
+    if (m_reportTimer)
+    {
+        return;
+    }
+    m_reportTimer = std::make_shared<Timer>(_interval, "schedulerReport");
+    m_reportTimer->registerTimeoutHandler([this]() {
+        report();
+        std::lock_guard<std::mutex> lock(x_reportTimer);
+        if (m_reportTimer)
+        {
+            m_reportTimer->restart();
+        }
+    });
+    m_reportTimer->start();
+}
+
+void TaskScheduler::stopReport()
+{
+    std::shared_ptr<Timer> reportTimer;
+    {
+        std::lock_guard<std::mutex> lock(x_reportTimer);
+        reportTimer.swap(m_reportTimer);
+    }
+    if (reportTimer)
+    {
+        reportTimer->destroy();
+    }
+}
+
+void TaskScheduler::report() const
+{
+    for (size_t i = 0; i < m_stats.size(); ++i)
+    {
+        auto stat = this->stat((TaskClass)i);
+        SCHEDULER_LOG(INFO) << LOG_BADGE("METRIC") << LOG_DESC("TaskScheduler stat")
+                            << LOG_KV("class", taskClassName((TaskClass)i))
+                            << LOG_KV("pending", stat.pending) << LOG_KV("executed", stat.executed)
+                            << LOG_KV("avgWaitUs",
+                                   stat.executed > 0 ? stat.totalWaitTime / stat.executed : 0)
+                            << LOG_KV("maxWaitUs", stat.maxWaitTime)
+                            << LOG_KV("avgExecUs",
+                                   stat.executed > 0 ? stat.totalExecTime / stat.executed : 0);
+    }
+}
+
+std::vector<int> TaskScheduler::parseCpuList(std::string const& _cpus)
+{
+    std::vector<int> cpus;
+    std::vector<std::string> ranges;
+    boost::split(ranges, _cpus, boost::is_any_of(","), boost::token_compress_on);
+    for (auto& range : ranges)
+    {
+        boost::trim(range);
+        if (range.empty())
+        {
+            continue;
+        }
+        auto pos = range.find('-');
+        auto begin = boost::lexical_cast<int>(boost::trim_copy(range.substr(0, pos)));
+        auto end = pos == std::string::npos ?
+                       begin :
+                       boost::lexical_cast<int>(boost::trim_copy(range.substr(pos + 1)));
+        if (begin < 0 || end < begin)
+        {
+            BOOST_THROW_EXCEPTION(std::invalid_argument("invalid cpu range: " + range));
+        }
+        for (auto cpu = begin; cpu <= end; ++cpu)
+        {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
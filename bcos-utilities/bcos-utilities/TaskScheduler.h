@@ -0,0 +1,139 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief: the process-wide work-stealing scheduler shared by the modules
+ *
+ * @file TaskScheduler.h
+ */
+
+#pragma once
+#include "Common.h"
+#include <tbb/task_arena.h>
+#include <tbb/task_scheduler_observer.h>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+namespace bcos
+{
+class Timer;
+
+// the class of the task, in the order of the priority
+enum class TaskClass : int
+{
+    CONSENSUS = 0,
+    EXECUTION = 1,
+    // the executive flows of the contracts, one pool per flow, kept apart from the other execution
+    // tasks so that the flows of a block don't queue up the requests of the executor
+    EXECUTIVE_FLOW = 2,
+    SYNC = 3,
+    // reserved, the front, gateway and websocket pools still run on their own io threads
+    RPC = 4,
+    COUNT = 5,
+};
+std::string_view taskClassName(TaskClass _taskClass);
+
+// TaskScheduler runs the tasks of all the modules on one pool of TBB worker threads. Every class
+// has its own task arena: the workers steal the tasks inside the arena, and are assigned to the
+// arenas of higher priority first (consensus > execution > sync, rpc), so the node no longer runs
+// one thread pool of hardware_concurrency threads per module.
+class TaskScheduler
+{
+public:
+    struct Stat
+    {
+        // the tasks enqueued but not started
+        int64_t pending = 0;
+        uint64_t executed = 0;
+        // in microseconds
+        uint64_t totalWaitTime = 0;
+        uint64_t maxWaitTime = 0;
+        uint64_t totalExecTime = 0;
+    };
+
+    constexpr static uint64_t c_reportInterval = 60000;
+
+    static TaskScheduler& instance()
+    {
+        static TaskScheduler scheduler;
+        return scheduler;
+    }
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler(TaskScheduler&&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(TaskScheduler&&) = delete;
+    ~TaskScheduler();
+
+    // Note: must be called before the first task is enqueued, otherwise the scheduler is
+    // initialized with hardware_concurrency threads and no cpu affinity
+    // _threadNum: 0 means hardware_concurrency
+    // _cpus: pin the worker threads to these cpus in turn, empty means no affinity
+    void init(size_t _threadNum, std::vector<int> _cpus = {});
+
+    void enqueue(TaskClass _taskClass, std::function<void()> _task);
+
+    Stat stat(TaskClass _taskClass) const;
+    static tbb::task_arena::priority priority(TaskClass _taskClass);
+    size_t threadNum() const { return m_threadNum; }
+
+    // log the stat of every class periodically
+    void startReport(uint64_t _interval = c_reportInterval);
+    void stopReport();
+    void report() const;
+
+    // parse the cpu list in format of "0-3,6,8"
+    static std::vector<int> parseCpuList(std::string const& _cpus);
+
+private:
+    struct ClassStat
+    {
+        std::atomic_int64_t pending = 0;
+        std::atomic_uint64_t executed = 0;
+        std::atomic_uint64_t totalWaitTime = 0;
+        std::atomic_uint64_t maxWaitTime = 0;
+        std::atomic_uint64_t totalExecTime = 0;
+    };
+
+    class AffinityObserver : public tbb::task_scheduler_observer
+    {
+    public:
+        AffinityObserver(tbb::task_arena& _arena, std::vector<int> const& _cpus,
+            std::atomic_size_t& _nextCpu);
+        ~AffinityObserver() override { observe(false); }
+        void on_scheduler_entry(bool _isWorker) override;
+
+    private:
+        std::vector<int> const& m_cpus;
+        std::atomic_size_t& m_nextCpu;
+    };
+
+    TaskScheduler() = default;
+    void doInit(size_t _threadNum, std::vector<int> _cpus);
+
+    std::once_flag m_initFlag;
+    size_t m_threadNum = 0;
+    std::vector<int> m_cpus;
+    std::atomic_size_t m_nextCpu = 0;
+
+    std::array<std::unique_ptr<tbb::task_arena>, (size_t)TaskClass::COUNT> m_arenas;
+    std::vector<std::unique_ptr<AffinityObserver>> m_observers;
+    std::array<ClassStat, (size_t)TaskClass::COUNT> m_stats;
+
+    std::mutex x_reportTimer;
+    std::shared_ptr<Timer> m_reportTimer;
+};
+}  // namespace bcos
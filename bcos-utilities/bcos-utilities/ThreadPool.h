@@ -22,10 +22,15 @@
 
 #pragma once
 #include "Common.h"
+#include "TaskScheduler.h"
 #include <boost/asio.hpp>
 #include <boost/thread/thread.hpp>
+#include <condition_variable>
 #include <iosfwd>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
 
 namespace bcos
 {
@@ -46,6 +51,16 @@ public:
             });
         }
     }
+
+    // run the tasks on the shared TaskScheduler instead of the dedicated threads
+    ThreadPool(const std::string& threadName, TaskClass _taskClass)
+      : m_work(_ioService),
+        m_taskClass(_taskClass),
+        m_scheduledTasks(std::make_shared<ScheduledTasks>())
+    {
+        _threadName = threadName;
+    }
+
     void stop()
     {
         _ioService.stop();
@@ -53,6 +68,18 @@ public:
         {
             _workers.join_all();
         }
+        if (m_scheduledTasks)
+        {
+            // drop the pending tasks and wait for the running ones, since the tasks may use the
+            // owner of the pool
+            std::unique_lock lock(m_scheduledTasks->mutex);
+            m_scheduledTasks->stopped = true;
+            if (ScheduledTasks::current != m_scheduledTasks.get())
+            {
+                m_scheduledTasks->finished.wait(
+                    lock, [this]() { return m_scheduledTasks->running == 0; });
+            }
+        }
     }
 
     ~ThreadPool() { stop(); }
@@ -61,15 +88,69 @@ public:
     template <class F>
     void enqueue(F f)
     {
-        _ioService.post(f);
+        if (!m_taskClass)
+        {
+            _ioService.post(f);
+            return;
+        }
+        TaskScheduler::instance().enqueue(*m_taskClass, [tasks = m_scheduledTasks, f]() {
+            {
+                std::lock_guard lock(tasks->mutex);
+                if (tasks->stopped)
+                {
+                    return;
+                }
+                ++tasks->running;
+            }
+            ScheduledTasks::RunningTask runningTask(tasks.get());
+            f();
+        });
     }
 
 private:
+    struct ScheduledTasks
+    {
+        std::mutex mutex;
+        std::condition_variable finished;
+        bool stopped = false;
+        int64_t running = 0;
+        // the tasks of the pool running on this thread
+        static inline thread_local ScheduledTasks* current = nullptr;
+
+        // notify stop() when the last running task returns or throws
+        class RunningTask
+        {
+        public:
+            explicit RunningTask(ScheduledTasks* _tasks) : m_tasks(_tasks), m_prev(current)
+            {
+                current = _tasks;
+            }
+            ~RunningTask()
+            {
+                current = m_prev;
+                std::lock_guard lock(m_tasks->mutex);
+                if (--m_tasks->running == 0)
+                {
+                    m_tasks->finished.notify_all();
+                }
+            }
+            RunningTask(RunningTask const&) = delete;
+            RunningTask& operator=(RunningTask const&) = delete;
+
+        private:
+            ScheduledTasks* m_tasks;
+            ScheduledTasks* m_prev;
+        };
+    };
+
     std::string _threadName;
     boost::thread_group _workers;
     boost::asio::io_service _ioService;
     // m_work ensures that io_service's run() function will not exit while work is underway
     boost::asio::io_service::work m_work;
+
+    std::optional<TaskClass> m_taskClass;
+    std::shared_ptr<ScheduledTasks> m_scheduledTasks;
 };
 
 }  // namespace bcos
@@ -0,0 +1,183 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief: the per-block execution trace, exported in the Chrome trace event format
+ *
+ * @file Tracer.cpp
+ */
+#include "Tracer.h"
+#include <pthread.h>
+#include <algorithm>
+#include <sstream>
+
+using namespace bcos;
+using namespace bcos::trace;
+
+namespace
+{
+std::string escapeJson(std::string const& _value)
+{
+    std::string out;
+    out.reserve(_value.size());
+    for (auto c : _value)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out.push_back('\\');
+        }
+        if ((unsigned char)c >= 0x20)
+        {
+            out.push_back(c);
+        }
+    }
+    return out;
+}
+}  // namespace
+
+void Tracer::enable(size_t _capacity)
+{
+    std::call_once(m_allocated, [this, _capacity]() {
+        size_t capacity = 1024;
+        while (capacity < _capacity)
+        {
+            capacity <<= 1;
+        }
+        m_slotsHolder = std::make_unique<Slot[]>(capacity);
+        m_mask = capacity - 1;
+        m_slots.store(m_slotsHolder.get(), std::memory_order_release);
+    });
+    m_enabled.store(true, std::memory_order_relaxed);
+}
+
+uint32_t Tracer::threadID()
+{
+    thread_local uint32_t id = 0;
+    if (id == 0)
+    {
+        id = m_threadCount.fetch_add(1, std::memory_order_relaxed) + 1;
+        char name[64] = {0};
+        pthread_getname_np(pthread_self(), name, sizeof(name));
+        std::lock_guard<std::mutex> lock(x_threadNames);
+        m_threadNames[id] = name;
+    }
+    return id;
+}
+
+void Tracer::record(char const* _category, char const* _name, int64_t _blockNumber,
+    uint64_t _start, uint64_t _duration, int64_t _arg)
+{
+    auto* slots = m_slots.load(std::memory_order_acquire);
+    if (!slots)
+    {
+        return;
+    }
+    auto index = m_next.fetch_add(1, std::memory_order_relaxed);
+    auto& slot = slots[index & m_mask];
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.category.store(_category, std::memory_order_relaxed);
+    slot.name.store(_name, std::memory_order_relaxed);
+    slot.blockNumber.store(_blockNumber, std::memory_order_relaxed);
+    slot.arg.store(_arg, std::memory_order_relaxed);
+    slot.start.store(_start, std::memory_order_relaxed);
+    slot.duration.store(_duration, std::memory_order_relaxed);
+    slot.threadID.store(threadID(), std::memory_order_relaxed);
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+}
+
+std::vector<Span> Tracer::spans(int64_t _blockNumber) const
+{
+    std::vector<Span> spans;
+    auto* slots = m_slots.load(std::memory_order_acquire);
+    if (!slots)
+    {
+        return spans;
+    }
+    for (size_t i = 0; i <= m_mask; ++i)
+    {
+        auto const& slot = slots[i];
+        auto sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence == 0 || (sequence & 1) ||
+            slot.blockNumber.load(std::memory_order_relaxed) != _blockNumber)
+        {
+            continue;
+        }
+        Span span{slot.category.load(std::memory_order_relaxed),
+            slot.name.load(std::memory_order_relaxed), _blockNumber,
+            slot.arg.load(std::memory_order_relaxed), slot.start.load(std::memory_order_relaxed),
+            slot.duration.load(std::memory_order_relaxed),
+            slot.threadID.load(std::memory_order_relaxed)};
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // overwritten while reading
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+        {
+            continue;
+        }
+        spans.push_back(span);
+    }
+    std::sort(spans.begin(), spans.end(),
+        [](Span const& _lhs, Span const& _rhs) { return _lhs.start < _rhs.start; });
+    return spans;
+}
+
+std::map<uint32_t, std::string> Tracer::threadNames() const
+{
+    std::lock_guard<std::mutex> lock(x_threadNames);
+    return m_threadNames;
+}
+
+std::string Tracer::chromeTrace(int64_t _blockNumber) const
+{
+    auto blockSpans = spans(_blockNumber);
+    auto names = threadNames();
+
+    std::ostringstream out;
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    auto separator = [&out, &first]() {
+        if (!first)
+        {
+            out << ",";
+        }
+        first = false;
+    };
+    // name the threads of the spans
+    std::map<uint32_t, std::string> threads;
+    for (auto const& span : blockSpans)
+    {
+        threads.emplace(span.threadID, names[span.threadID]);
+    }
+    for (auto const& [threadID, name] : threads)
+    {
+        separator();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadID
+            << ",\"args\":{\"name\":\"" << escapeJson(name) << "\"}}";
+    }
+    for (auto const& span : blockSpans)
+    {
+        separator();
+        out << "{\"name\":\"" << span.name << "\",\"cat\":\"" << span.category
+            << "\",\"ph\":\"X\",\"ts\":" << span.start << ",\"dur\":" << span.duration
+            << ",\"pid\":1,\"tid\":" << span.threadID << ",\"args\":{\"blockNumber\":"
+            << span.blockNumber;
+        if (span.arg >= 0)
+        {
+            out << ",\"arg\":" << span.arg;
+        }
+        out << "}}";
+    }
+    out << "],\"displayTimeUnit\":\"ms\"}";
+    return out.str();
+}
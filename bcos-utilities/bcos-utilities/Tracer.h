@@ -0,0 +1,168 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief: the per-block execution trace, exported in the Chrome trace event format
+ *
+ * @file Tracer.h
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace bcos::trace
+{
+// the categories of the spans
+constexpr static char const* c_consensus = "consensus";
+constexpr static char const* c_txpool = "txpool";
+constexpr static char const* c_scheduler = "scheduler";
+constexpr static char const* c_executor = "executor";
+constexpr static char const* c_storage = "storage";
+constexpr static char const* c_ledger = "ledger";
+
+// the category and the name must be string literals, only their pointers are recorded
+struct Span
+{
+    char const* category;
+    char const* name;
+    int64_t blockNumber;
+    // the optional argument, e.g. the txs count, -1 if not set
+    int64_t arg;
+    uint64_t start;  // microseconds since epoch
+    uint64_t duration;
+    uint32_t threadID;
+};
+
+inline uint64_t nowMicroseconds()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+/// Tracer records the spans of all the threads into a fixed ring, the oldest spans are
+/// overwritten. The writers never block: every slot is a seqlock, the readers skip the slots being
+/// written. When disabled, recording a span costs a relaxed load.
+class Tracer
+{
+public:
+    constexpr static size_t c_defaultCapacity = 1024 * 1024;
+
+    static Tracer& instance()
+    {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    // the ring is allocated by the first enable, the later calls keep its capacity
+    void enable(size_t _capacity = c_defaultCapacity);
+    void disable() { m_enabled.store(false, std::memory_order_relaxed); }
+    bool enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+    size_t capacity() const { return m_slots.load(std::memory_order_acquire) ? m_mask + 1 : 0; }
+
+    void record(char const* _category, char const* _name, int64_t _blockNumber, uint64_t _start,
+        uint64_t _duration, int64_t _arg = -1);
+
+    // the spans of the block still in the ring, ordered by the start time
+    std::vector<Span> spans(int64_t _blockNumber) const;
+    std::map<uint32_t, std::string> threadNames() const;
+
+    // the spans of the block in the Chrome trace event format, can be loaded by
+    // chrome://tracing or https://ui.perfetto.dev
+    std::string chromeTrace(int64_t _blockNumber) const;
+
+private:
+    struct Slot
+    {
+        // odd while being written, 2 * (index + 1) after the span of index is written
+        std::atomic_uint64_t sequence = 0;
+        std::atomic<char const*> category = nullptr;
+        std::atomic<char const*> name = nullptr;
+        std::atomic_int64_t blockNumber = 0;
+        std::atomic_int64_t arg = 0;
+        std::atomic_uint64_t start = 0;
+        std::atomic_uint64_t duration = 0;
+        std::atomic_uint32_t threadID = 0;
+    };
+
+    uint32_t threadID();
+
+    std::atomic_bool m_enabled = false;
+    std::once_flag m_allocated;
+    std::unique_ptr<Slot[]> m_slotsHolder;
+    // published after the ring is allocated
+    std::atomic<Slot*> m_slots = nullptr;
+    size_t m_mask = 0;
+    std::atomic_uint64_t m_next = 0;
+
+    std::atomic_uint32_t m_threadCount = 0;
+    mutable std::mutex x_threadNames;
+    std::map<uint32_t, std::string> m_threadNames;
+};
+
+// the start of a span across the callbacks, 0 if the tracer is disabled
+inline uint64_t spanStart()
+{
+    return Tracer::instance().enabled() ? nowMicroseconds() : 0;
+}
+
+inline void spanEnd(char const* _category, char const* _name, int64_t _blockNumber,
+    uint64_t _start, int64_t _arg = -1)
+{
+    if (_start != 0)
+    {
+        Tracer::instance().record(
+            _category, _name, _blockNumber, _start, nowMicroseconds() - _start, _arg);
+    }
+}
+
+// record the span of the scope
+class ScopedSpan
+{
+public:
+    ScopedSpan(char const* _category, char const* _name, int64_t _blockNumber, int64_t _arg = -1)
+      : m_category(_category),
+        m_name(_name),
+        m_blockNumber(_blockNumber),
+        m_arg(_arg),
+        m_start(spanStart())
+    {}
+    ~ScopedSpan() { spanEnd(m_category, m_name, m_blockNumber, m_start, m_arg); }
+
+    ScopedSpan(ScopedSpan const&) = delete;
+    ScopedSpan& operator=(ScopedSpan const&) = delete;
+
+private:
+    char const* m_category;
+    char const* m_name;
+    int64_t m_blockNumber;
+    int64_t m_arg;
+    uint64_t m_start;
+};
+}  // namespace bcos::trace
+
+#define BCOS_TRACE_CONCAT_IMPL(A, B) A##B
+#define BCOS_TRACE_CONCAT(A, B) BCOS_TRACE_CONCAT_IMPL(A, B)
+// trace the scope, BLOCK is only evaluated when the tracer is enabled, e.g.
+// BCOS_TRACE_SPAN(bcos::trace::c_storage, "getRow", blockNumber())
+#define BCOS_TRACE_SPAN(CATEGORY, NAME, BLOCK)                                     \
+    bcos::trace::ScopedSpan BCOS_TRACE_CONCAT(traceSpan, __LINE__)(CATEGORY, NAME, \
+        bcos::trace::Tracer::instance().enabled() ? (int64_t)(BLOCK) : -1)
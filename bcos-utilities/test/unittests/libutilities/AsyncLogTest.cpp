@@ -0,0 +1,162 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief Unit tests for the AsyncLogger
+ *
+ * @file AsyncLogTest.cpp
+ */
+
+#include "bcos-utilities/AsyncLog.h"
+#include "bcos-utilities/testutils/TestPromptFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <future>
+#include <thread>
+using namespace bcos;
+
+namespace bcos
+{
+namespace test
+{
+namespace
+{
+struct Captured
+{
+    LogLevel level;
+    std::chrono::system_clock::time_point timestamp;
+    std::string message;
+};
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(AsyncLogTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(format)
+{
+    auto encode = [](auto const&... _args) {
+        std::vector<uint8_t> args((asynclog::encodedSize(_args) + ... + 0));
+        auto* out = args.data();
+        (asynclog::encode(out, _args), ...);
+        return args;
+    };
+    std::string hash = "0x1234";
+    auto args = encode(asynclog::normalize(-5), asynclog::normalize((uint32_t)7),
+        asynclog::normalize(1.5), asynclog::normalize(true), asynclog::normalize(hash),
+        asynclog::normalize("str"), asynclog::normalize('c'));
+    std::string message;
+    AsyncLogger::format(message, "[TEST][desc],a={},b={},c={},d={},hash={},e={},f={}",
+        args.data(), args.data() + args.size());
+    BOOST_CHECK_EQUAL(message, "[TEST][desc],a=-5,b=7,c=1.5,d=1,hash=0x1234,e=str,f=c");
+
+    // the missing and the extra arguments
+    message.clear();
+    AsyncLogger::format(message, "a={},b={}", args.data(), args.data() + 9);
+    BOOST_CHECK_EQUAL(message, "a=-5,b={}");
+    message.clear();
+    AsyncLogger::format(message, "a", args.data(), args.data() + 9);
+    BOOST_CHECK_EQUAL(message, "a -5");
+}
+
+BOOST_AUTO_TEST_CASE(multiThreadLog)
+{
+    std::vector<Captured> captured;
+    auto& logger = AsyncLogger::instance();
+    logger.start(AsyncLogPolicy::BLOCK, 4096,
+        [&captured](LogLevel _level, std::chrono::system_clock::time_point _timestamp,
+            std::string_view _message) {
+            captured.push_back({_level, _timestamp, std::string(_message)});
+        });
+    BOOST_CHECK(logger.running());
+
+    int threadNum = 4;
+    int count = 2000;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadNum; ++i)
+    {
+        threads.emplace_back([i, count]() {
+            for (int j = 0; j < count; ++j)
+            {
+                BCOS_ASYNC_LOG(INFO, "[TEST]thread={},index={}", i, j);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    logger.stop();
+    BOOST_CHECK(!logger.running());
+
+    BOOST_CHECK_EQUAL(captured.size(), threadNum * count);
+    std::vector<int> nextIndex(threadNum, 0);
+    for (size_t i = 0; i < captured.size(); ++i)
+    {
+        BOOST_CHECK(captured[i].level == LogLevel::INFO);
+        int thread = 0;
+        int index = 0;
+        BOOST_CHECK_EQUAL(
+            std::sscanf(captured[i].message.c_str(), "[TEST]thread=%d,index=%d", &thread, &index),
+            2);
+        // the records of a thread keep their order
+        BOOST_CHECK_EQUAL(index, nextIndex[thread]++);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(dropPolicy)
+{
+    std::vector<Captured> captured;
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    auto& logger = AsyncLogger::instance();
+    auto dropped = logger.dropped();
+    logger.start(AsyncLogPolicy::DROP, 1024,
+        [&captured, released](LogLevel _level, std::chrono::system_clock::time_point _timestamp,
+            std::string_view _message) {
+            // hold the backend until all the records are logged
+            released.wait();
+            captured.push_back({_level, _timestamp, std::string(_message)});
+        });
+    int count = 1000;
+    for (int i = 0; i < count; ++i)
+    {
+        BCOS_ASYNC_LOG(INFO, "[TEST]index={}", i);
+    }
+    BOOST_CHECK_GT(logger.dropped(), dropped);
+    release.set_value();
+    logger.stop();
+
+    auto droppedCount = logger.dropped() - dropped;
+    // the logged records and the drop reports
+    size_t logged = 0;
+    uint64_t reportedDropped = 0;
+    for (auto const& record : captured)
+    {
+        uint64_t reported = 0;
+        if (std::sscanf(record.message.c_str(),
+                "[AsyncLog]drop the logs for the buffer is full,dropped=%lu", &reported) == 1)
+        {
+            BOOST_CHECK(record.level == LogLevel::WARNING);
+            reportedDropped += reported;
+        }
+        else
+        {
+            ++logged;
+        }
+    }
+    BOOST_CHECK_EQUAL(reportedDropped, droppedCount);
+    BOOST_CHECK_EQUAL(logged + droppedCount, count);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -0,0 +1,149 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief Unit tests for the BoundedConcurrentQueue
+ *
+ * @file BoundedConcurrentQueueTest.cpp
+ */
+
+#include "bcos-utilities/BoundedConcurrentQueue.h"
+#include "bcos-utilities/testutils/TestPromptFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <thread>
+using namespace bcos;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(BoundedConcurrentQueueTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(pushAndPop)
+{
+    BoundedConcurrentQueue<std::shared_ptr<int>> queue(3);
+    BOOST_CHECK_EQUAL(queue.capacity(), 4);
+    BOOST_CHECK(queue.empty());
+    BOOST_CHECK(!queue.tryPop());
+    BOOST_CHECK(!queue.tryPop(10));
+
+    for (int i = 0; i < 4; ++i)
+    {
+        BOOST_CHECK(queue.tryPush(std::make_shared<int>(i)));
+    }
+    // full
+    BOOST_CHECK(!queue.tryPush(std::make_shared<int>(4)));
+    BOOST_CHECK_EQUAL(queue.size(), 4);
+
+    BOOST_CHECK_EQUAL(*queue.pop(), 0);
+    BOOST_CHECK_EQUAL(**queue.tryPop(10), 1);
+    std::vector<std::shared_ptr<int>> elems;
+    BOOST_CHECK_EQUAL(queue.popBatch(elems, 10), 2);
+    BOOST_CHECK_EQUAL(*elems[0], 2);
+    BOOST_CHECK_EQUAL(*elems[1], 3);
+    BOOST_CHECK(queue.empty());
+}
+
+BOOST_AUTO_TEST_CASE(backPressure)
+{
+    BoundedConcurrentQueue<int> queue(2);
+    queue.push(0);
+    queue.push(1);
+    std::atomic_bool pushed = false;
+    std::thread producer([&]() {
+        std::vector<int> batch{2, 3, 4};
+        queue.pushBatch(batch.begin(), batch.end());
+        pushed = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    BOOST_CHECK(!pushed);
+
+    std::vector<int> elems;
+    while (elems.size() < 5)
+    {
+        queue.popBatch(elems, 2);
+    }
+    producer.join();
+    BOOST_CHECK(pushed);
+    BOOST_CHECK(elems == std::vector<int>({0, 1, 2, 3, 4}));
+}
+
+BOOST_AUTO_TEST_CASE(pushWithTimeout)
+{
+    BoundedConcurrentQueue<int> queue(2);
+    BOOST_CHECK(queue.tryPush(0, 10));
+    BOOST_CHECK(queue.tryPush(1, 10));
+    // full and nobody pops
+    auto start = std::chrono::steady_clock::now();
+    BOOST_CHECK(!queue.tryPush(2, 20));
+    BOOST_CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+    BOOST_CHECK_EQUAL(queue.size(), 2);
+
+    // resumed when the consumer drains the queue
+    std::thread consumer([&queue]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.pop();
+    });
+    BOOST_CHECK(queue.tryPush(2, 5000));
+    consumer.join();
+    BOOST_CHECK_EQUAL(*queue.tryPop(), 1);
+    BOOST_CHECK_EQUAL(*queue.tryPop(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(multiProducerMultiConsumer)
+{
+    BoundedConcurrentQueue<int64_t> queue(64);
+    int producerNum = 4;
+    int consumerNum = 4;
+    int64_t count = 10000;
+    std::atomic_int64_t sum = 0;
+    std::atomic_int64_t popped = 0;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < producerNum; ++i)
+    {
+        threads.emplace_back([&queue, count]() {
+            for (int64_t j = 1; j <= count; ++j)
+            {
+                queue.push(j);
+            }
+        });
+    }
+    for (int i = 0; i < consumerNum; ++i)
+    {
+        threads.emplace_back([&]() {
+            while (popped < producerNum * count)
+            {
+                auto elem = queue.tryPop(10);
+                if (elem)
+                {
+                    sum += *elem;
+                    ++popped;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    BOOST_CHECK_EQUAL(popped, producerNum * count);
+    BOOST_CHECK_EQUAL(sum, producerNum * count * (count + 1) / 2);
+    BOOST_CHECK(queue.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
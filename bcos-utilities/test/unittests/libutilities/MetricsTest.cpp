@@ -0,0 +1,147 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief Unit tests for the metrics
+ *
+ * @file MetricsTest.cpp
+ */
+
+#include "bcos-utilities/Metrics.h"
+#include "bcos-utilities/testutils/TestPromptFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <thread>
+#include <vector>
+using namespace bcos;
+using namespace bcos::metrics;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(MetricsTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(counterAndGauge)
+{
+    Counter counter;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i)
+    {
+        threads.emplace_back([&counter]() {
+            for (int j = 0; j < 10000; ++j)
+            {
+                counter.inc();
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    counter.inc(5);
+    BOOST_CHECK_EQUAL(counter.value(), 80005);
+
+    Gauge gauge;
+    gauge.set(10);
+    gauge.add(-3);
+    BOOST_CHECK_EQUAL(gauge.value(), 7);
+}
+
+BOOST_AUTO_TEST_CASE(histogramBuckets)
+{
+    // the buckets are continuous and the values fall into their own bucket
+    for (size_t i = 0; i + 1 < Histogram::c_bucketNum; ++i)
+    {
+        BOOST_CHECK_EQUAL(Histogram::bucketUpperBound(i) + 1, Histogram::bucketLowerBound(i + 1));
+    }
+    for (uint64_t value : {0UL, 7UL, 8UL, 15UL, 16UL, 1000UL, 123456789UL, UINT64_MAX})
+    {
+        auto index = Histogram::bucketIndex(value);
+        BOOST_CHECK_LE(Histogram::bucketLowerBound(index), value);
+        BOOST_CHECK_GE(Histogram::bucketUpperBound(index), value);
+    }
+    BOOST_CHECK_EQUAL(Histogram::bucketIndex(UINT64_MAX), Histogram::c_bucketNum - 1);
+
+    Histogram histogram;
+    BOOST_CHECK_EQUAL(histogram.quantile(0.99), 0);
+    for (uint64_t i = 1; i <= 10000; ++i)
+    {
+        histogram.observe(i);
+    }
+    BOOST_CHECK_EQUAL(histogram.count(), 10000);
+    BOOST_CHECK_EQUAL(histogram.sum(), 10000 * 10001 / 2);
+    BOOST_CHECK_EQUAL(histogram.countLE(7), 7);
+    // the relative error is bounded by the sub-buckets
+    for (double quantile : {0.5, 0.9, 0.99})
+    {
+        auto expected = quantile * 10000;
+        auto value = (double)histogram.quantile(quantile);
+        BOOST_CHECK_GE(value, expected);
+        BOOST_CHECK_LE(value, expected * 1.125);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(prometheusText)
+{
+    MetricsRegistry registry;
+    auto& counter = registry.counter("test_requests_total", "The requests", "type=\"a\"");
+    counter.inc(3);
+    BOOST_CHECK_EQUAL(&registry.counter("test_requests_total", "", "type=\"a\""), &counter);
+    registry.gauge("test_pending", "The pending requests").set(2);
+    auto& histogram = registry.histogram("test_latency_seconds", "The latency");
+    histogram.observe(5);
+    histogram.observe(2000);
+    histogram.observe(20000000);
+    BOOST_CHECK_THROW(registry.gauge("test_requests_total", ""), std::invalid_argument);
+
+    auto text = registry.prometheusText();
+    BOOST_CHECK(text.find("# TYPE test_requests_total counter\n") != std::string::npos);
+    BOOST_CHECK(text.find("test_requests_total{type=\"a\"} 3\n") != std::string::npos);
+    BOOST_CHECK(text.find("# HELP test_pending The pending requests\n") != std::string::npos);
+    BOOST_CHECK(text.find("test_pending 2\n") != std::string::npos);
+    BOOST_CHECK(text.find("# TYPE test_latency_seconds histogram\n") != std::string::npos);
+    BOOST_CHECK(text.find("test_latency_seconds_bucket{le=\"1e-05\"} 1\n") != std::string::npos);
+    BOOST_CHECK(text.find("test_latency_seconds_bucket{le=\"0.005\"} 2\n") != std::string::npos);
+    BOOST_CHECK(text.find("test_latency_seconds_bucket{le=\"10\"} 2\n") != std::string::npos);
+    BOOST_CHECK(text.find("test_latency_seconds_bucket{le=\"+Inf\"} 3\n") != std::string::npos);
+    BOOST_CHECK(text.find("test_latency_seconds_count 3\n") != std::string::npos);
+    BOOST_CHECK(text.find("test_latency_seconds_sum 20.002\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(prometheusTextBelowBounds)
+{
+    MetricsRegistry registry;
+    auto& histogram = registry.histogram("test_latency_seconds", "The latency");
+    // every value is just below an exported bound, in the same bucket as the bound
+    for (uint64_t value : {99UL, 4999UL, 999999UL})
+    {
+        BOOST_CHECK_EQUAL(Histogram::bucketIndex(value), Histogram::bucketIndex(value + 1));
+        histogram.observe(value);
+    }
+    BOOST_CHECK_EQUAL(histogram.countLE(99), 1);
+    BOOST_CHECK_EQUAL(histogram.countLE(100), 1);
+    BOOST_CHECK_EQUAL(histogram.countLE(5000), 2);
+
+    auto text = registry.prometheusText();
+    BOOST_CHECK(text.find("test_latency_seconds_bucket{le=\"5e-05\"} 0\n") != std::string::npos);
+    BOOST_CHECK(text.find("test_latency_seconds_bucket{le=\"0.0001\"} 1\n") != std::string::npos);
+    BOOST_CHECK(text.find("test_latency_seconds_bucket{le=\"0.001\"} 1\n") != std::string::npos);
+    BOOST_CHECK(text.find("test_latency_seconds_bucket{le=\"0.005\"} 2\n") != std::string::npos);
+    BOOST_CHECK(text.find("test_latency_seconds_bucket{le=\"1\"} 3\n") != std::string::npos);
+    BOOST_CHECK(text.find("test_latency_seconds_bucket{le=\"+Inf\"} 3\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
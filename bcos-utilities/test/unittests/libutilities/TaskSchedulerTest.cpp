@@ -0,0 +1,137 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief Unit tests for the TaskScheduler
+ *
+ * @file TaskSchedulerTest.cpp
+ */
+
+#include "bcos-utilities/TaskScheduler.h"
+#include "bcos-utilities/ThreadPool.h"
+#include "bcos-utilities/testutils/TestPromptFixture.h"
+#include <boost/lexical_cast.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <future>
+#include <thread>
+using namespace bcos;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(TaskSchedulerTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(enqueueByClass)
+{
+    auto& scheduler = TaskScheduler::instance();
+    auto executed = scheduler.stat(TaskClass::SYNC).executed;
+    size_t count = 100;
+    std::atomic_size_t finished = 0;
+    std::promise<void> allFinished;
+    for (size_t i = 0; i < count; ++i)
+    {
+        scheduler.enqueue(TaskClass::SYNC, [&finished, &allFinished, count]() {
+            if (++finished == count)
+            {
+                allFinished.set_value();
+            }
+        });
+    }
+    allFinished.get_future().get();
+    // the stat is updated after the task returns
+    while (scheduler.stat(TaskClass::SYNC).executed < executed + count)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    auto stat = scheduler.stat(TaskClass::SYNC);
+    BOOST_CHECK_EQUAL(stat.pending, 0);
+    BOOST_CHECK_GE(stat.totalWaitTime, stat.maxWaitTime);
+    BOOST_CHECK_EQUAL(scheduler.stat(TaskClass::RPC).executed, 0);
+    BOOST_CHECK_GT(scheduler.threadNum(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(priority)
+{
+    BOOST_CHECK(TaskScheduler::priority(TaskClass::CONSENSUS) >
+                TaskScheduler::priority(TaskClass::EXECUTION));
+    BOOST_CHECK(TaskScheduler::priority(TaskClass::EXECUTION) ==
+                TaskScheduler::priority(TaskClass::EXECUTIVE_FLOW));
+    BOOST_CHECK(
+        TaskScheduler::priority(TaskClass::EXECUTION) > TaskScheduler::priority(TaskClass::SYNC));
+    BOOST_CHECK(TaskScheduler::priority(TaskClass::SYNC) ==
+                TaskScheduler::priority(TaskClass::RPC));
+}
+
+BOOST_AUTO_TEST_CASE(scheduledThreadPool)
+{
+    auto pool = std::make_shared<ThreadPool>("test", TaskClass::EXECUTION);
+    std::atomic_bool started = false;
+    std::atomic_bool running = false;
+    std::atomic_size_t executed = 0;
+    pool->enqueue([&]() {
+        running = true;
+        started = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        running = false;
+        ++executed;
+    });
+    while (!started)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    for (int i = 0; i < 10; ++i)
+    {
+        pool->enqueue([&executed]() { ++executed; });
+    }
+    // stop waits for the running task
+    pool->stop();
+    BOOST_CHECK(!running);
+    auto executedAfterStop = executed.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    BOOST_CHECK_EQUAL(executed, executedAfterStop);
+}
+
+BOOST_AUTO_TEST_CASE(throwingTask)
+{
+    auto pool = std::make_shared<ThreadPool>("test", TaskClass::EXECUTIVE_FLOW);
+    std::promise<void> thrown;
+    pool->enqueue([&thrown]() {
+        thrown.set_value();
+        throw 1;
+    });
+    pool->enqueue([]() { throw std::runtime_error("task error"); });
+    thrown.get_future().get();
+    // the tasks throwing anything leave the pool, stop doesn't wait for them
+    pool->stop();
+
+    std::promise<void> executed;
+    TaskScheduler::instance().enqueue(
+        TaskClass::EXECUTIVE_FLOW, [&executed]() { executed.set_value(); });
+    executed.get_future().get();
+}
+
+BOOST_AUTO_TEST_CASE(parseCpuList)
+{
+    BOOST_CHECK(TaskScheduler::parseCpuList("").empty());
+    BOOST_CHECK(TaskScheduler::parseCpuList("0-3, 6,8") == std::vector<int>({0, 1, 2, 3, 6, 8}));
+    BOOST_CHECK(TaskScheduler::parseCpuList("5") == std::vector<int>({5}));
+    BOOST_CHECK_THROW(TaskScheduler::parseCpuList("3-1"), std::invalid_argument);
+    BOOST_CHECK_THROW(TaskScheduler::parseCpuList("a"), boost::bad_lexical_cast);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -0,0 +1,101 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief Unit tests for the Tracer
+ *
+ * @file TracerTest.cpp
+ */
+
+#include "bcos-utilities/Tracer.h"
+#include "bcos-utilities/testutils/TestPromptFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <thread>
+#include <vector>
+using namespace bcos;
+using namespace bcos::trace;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(TracerTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(recordSpans)
+{
+    auto& tracer = Tracer::instance();
+    // nothing is recorded before enabled
+    {
+        BCOS_TRACE_SPAN(c_executor, "disabled", 1);
+    }
+    BOOST_CHECK(!tracer.enabled());
+    BOOST_CHECK_EQUAL(tracer.capacity(), 0);
+    BOOST_CHECK(tracer.spans(1).empty());
+
+    tracer.enable(1000);
+    BOOST_CHECK_EQUAL(tracer.capacity(), 1024);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([]() {
+            for (int64_t block = 1; block <= 10; ++block)
+            {
+                BCOS_TRACE_SPAN(c_scheduler, "executeBlock", block);
+                auto start = spanStart();
+                spanEnd(c_storage, "commit", block, start, 100);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    auto spans = tracer.spans(3);
+    BOOST_CHECK_EQUAL(spans.size(), 8);
+    for (size_t i = 0; i < spans.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(spans[i].blockNumber, 3);
+        BOOST_CHECK(spans[i].threadID > 0);
+        if (i > 0)
+        {
+            BOOST_CHECK_LE(spans[i - 1].start, spans[i].start);
+        }
+    }
+
+    auto trace = tracer.chromeTrace(3);
+    BOOST_CHECK(trace.find("{\"traceEvents\":[") == 0);
+    BOOST_CHECK(trace.find("\"ph\":\"M\"") != std::string::npos);
+    BOOST_CHECK(trace.find("\"name\":\"executeBlock\",\"cat\":\"scheduler\",\"ph\":\"X\"") !=
+                std::string::npos);
+    BOOST_CHECK(trace.find("\"args\":{\"blockNumber\":3,\"arg\":100}") != std::string::npos);
+    BOOST_CHECK(tracer.chromeTrace(11).find("\"traceEvents\":[]") != std::string::npos);
+
+    // the oldest spans are overwritten
+    for (int i = 0; i < 1024; ++i)
+    {
+        tracer.record(c_consensus, "prePrepare", 100, i + 1, 1);
+    }
+    BOOST_CHECK(tracer.spans(3).empty());
+    BOOST_CHECK_EQUAL(tracer.spans(100).size(), 1024);
+
+    tracer.disable();
+    {
+        BCOS_TRACE_SPAN(c_executor, "disabled", 200);
+    }
+    BOOST_CHECK(tracer.spans(200).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
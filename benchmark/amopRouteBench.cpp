@@ -0,0 +1,116 @@
+#include <bcos-gateway/libamop/TopicIndex.h>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+
+using namespace bcos::amop;
+
+struct BenchParams
+{
+    int clients;
+    int topics;
+    int topicsPerClient;
+    int64_t count;
+};
+
+// route count messages to random topics, every client subscribes topicsPerClient random topics
+template <class Route>
+void run(std::string_view name, BenchParams const& params, Route&& route)
+{
+    std::mt19937 random(params.count);
+    std::uniform_int_distribution<int> topicDistribution(0, params.topics - 1);
+    uint64_t routed = 0;
+    auto timePoint = std::chrono::high_resolution_clock::now();
+    for (int64_t i = 0; i < params.count; ++i)
+    {
+        routed += route("topic" + std::to_string(topicDistribution(random)));
+    }
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - timePoint)
+                        .count();
+    std::cout << name << " clients: " << params.clients << ", topics: " << params.topics
+              << ", subscriptions: " << params.clients * params.topicsPerClient << ", "
+              << (double)duration / params.count << "us/msg, " << routed / params.count
+              << " subscribers/msg" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description options("AMOP topic routing benchmark");
+
+    // clang-format off
+    options.add_options()
+        ("clients,c", boost::program_options::value<int>()->default_value(0), "Subscribed clients, 0 means 10 to 1000")
+        ("topics,t", boost::program_options::value<int>()->default_value(5000), "Topics")
+        ("subscriptions,s", boost::program_options::value<int>()->default_value(20), "Topics subscribed by a client")
+        ("count,n", boost::program_options::value<int64_t>()->default_value(100000), "Messages to route")
+        ("help,h", "Print the usage")
+        ;
+    // clang-format on
+    boost::program_options::variables_map vm;
+    boost::program_options::store(
+        boost::program_options::parse_command_line(argc, argv, options), vm);
+    if (vm.count("help"))
+    {
+        options.print(std::cout);
+        return 0;
+    }
+
+    std::vector<int> clients{vm["clients"].as<int>()};
+    if (clients.front() <= 0)
+    {
+        clients = {10, 100, 1000};
+    }
+    for (auto clientNum : clients)
+    {
+        BenchParams params{clientNum, vm["topics"].as<int>(), vm["subscriptions"].as<int>(),
+            vm["count"].as<int64_t>()};
+
+        std::mt19937 random(clientNum);
+        std::uniform_int_distribution<int> topicDistribution(0, params.topics - 1);
+        std::unordered_map<std::string, TopicItems> client2TopicItems;
+        TopicIndex topicIndex;
+        for (int i = 0; i < params.clients; ++i)
+        {
+            auto client = "client" + std::to_string(i);
+            TopicItems topicItems;
+            for (int j = 0; j < params.topicsPerClient; ++j)
+            {
+                topicItems.insert(TopicItem("topic" + std::to_string(topicDistribution(random))));
+            }
+            topicIndex.update(client, TopicItems(), topicItems);
+            client2TopicItems[client] = std::move(topicItems);
+        }
+
+        // scan the topics of every client
+        run("Scan", params, [&client2TopicItems](std::string const& _topic) -> uint64_t {
+            std::vector<std::string> routedClients;
+            for (auto const& [client, topicItems] : client2TopicItems)
+            {
+                auto it = std::find_if(topicItems.begin(), topicItems.end(),
+                    [&_topic](TopicItem const& _item) { return _item.topicName() == _topic; });
+                if (it != topicItems.end())
+                {
+                    routedClients.push_back(client);
+                }
+            }
+            return routedClients.size();
+        });
+
+        // look up the inverted index snapshot
+        run("TopicIndex", params, [&topicIndex](std::string const& _topic) -> uint64_t {
+            std::vector<std::string> routedClients;
+            auto subscribers = topicIndex.subscribers(_topic);
+            if (subscribers)
+            {
+                routedClients.insert(routedClients.end(), subscribers->begin(), subscribers->end());
+            }
+            return routedClients.size();
+        });
+    }
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include <bcos-framework/gateway/GatewayTypeDef.h>
+#include <bcos-gateway/libp2p/P2PMessageV2.h>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::gateway;
+
+struct BenchParams
+{
+    int peers;
+    size_t payloadSize;
+    int rounds;
+};
+
+P2PMessageV2::Ptr buildMessage(size_t _payloadSize)
+{
+    auto message = std::make_shared<P2PMessageV2>();
+    message->setVersion((uint16_t)bcos::protocol::ProtocolVersion::V1);
+    message->setPacketType(GatewayMessageType::BroadcastMessage);
+    message->setSeq(1);
+    std::string srcNodeID(128, 'a');
+    message->options()->setGroupID("group0");
+    message->options()->setSrcNodeID(std::make_shared<bytes>(srcNodeID.begin(), srcNodeID.end()));
+    message->setPayload(std::make_shared<bytes>(_payloadSize, 'b'));
+    return message;
+}
+
+// every round broadcasts a new message to all the peers, the encoded frames are dropped after the
+// round like the sessions do after writing them
+template <class Encode>
+void run(std::string_view name, BenchParams const& params, Encode&& encode)
+{
+    std::vector<std::string> peers;
+    for (int i = 0; i < params.peers; ++i)
+    {
+        peers.emplace_back(std::string(127, 'c') + std::to_string(i % 10));
+    }
+    uint64_t encodedBytes = 0;
+    auto timePoint = std::chrono::high_resolution_clock::now();
+    for (int round = 0; round < params.rounds; ++round)
+    {
+        auto message = buildMessage(params.payloadSize);
+        for (auto const& peer : peers)
+        {
+            message->setSrcP2PNodeID(peers.front());
+            message->setDstP2PNodeID(peer);
+            encodedBytes += encode(*message);
+        }
+    }
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - timePoint)
+                        .count();
+    auto perBroadcast = (double)duration / params.rounds;
+    std::cout << name << " peers: " << params.peers << ", payload: " << params.payloadSize
+              << " bytes, " << perBroadcast << "us/broadcast, " << perBroadcast / params.peers
+              << "us/peer, " << encodedBytes / params.rounds << " bytes written/broadcast"
+              << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description options("P2P broadcast encoding benchmark");
+
+    // clang-format off
+    options.add_options()
+        ("peers,p", boost::program_options::value<int>()->default_value(0), "Peers to broadcast to, 0 means 1 to 64")
+        ("payload,s", boost::program_options::value<size_t>()->default_value(4 * 1024 * 1024), "Payload size in bytes")
+        ("rounds,n", boost::program_options::value<int>()->default_value(20), "Broadcasts per peer count")
+        ("help,h", "Print the usage")
+        ;
+    // clang-format on
+    boost::program_options::variables_map vm;
+    boost::program_options::store(
+        boost::program_options::parse_command_line(argc, argv, options), vm);
+    if (vm.count("help"))
+    {
+        options.print(std::cout);
+        return 0;
+    }
+
+    std::vector<int> peers{vm["peers"].as<int>()};
+    if (peers.front() <= 0)
+    {
+        peers = {1, 4, 8, 16, 32, 64};
+    }
+    for (auto peerNum : peers)
+    {
+        BenchParams params{peerNum, vm["payload"].as<size_t>(), vm["rounds"].as<int>()};
+
+        // encode the whole frame for every peer
+        run("EncodePerPeer", params, [](P2PMessage& message) -> uint64_t {
+            bytes buffer;
+            message.encode(buffer);
+            return buffer.size();
+        });
+
+        // encode the header for every peer and share the body
+        run("SharedBody", params, [](P2PMessage& message) -> uint64_t {
+            EncodedMessage encodedMsg;
+            message.encode(encodedMsg);
+            return encodedMsg.size();
+        });
+    }
+
+    return 0;
+}
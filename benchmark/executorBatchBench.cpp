@@ -0,0 +1,310 @@
+#include <bcos-tars-protocol/protocol/ExecutionMessageImpl.h>
+#include <bcos-tars-protocol/protocol/ExecutorBatchCodec.h>
+#include <bcos-tars-protocol/tars/ExecutionMessage.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <tup/Tars.h>
+
+using namespace bcostars;
+using namespace bcostars::protocol;
+
+struct BenchParams
+{
+    int contracts;
+    int txs;
+    int rounds;
+    int blocks;
+    size_t dataSize;
+};
+
+// the loopback connection between the scheduler and the executor, every frame is prefixed by the
+// length, an empty frame stops the executor
+class Loopback
+{
+public:
+    Loopback()
+    {
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, m_fds) != 0)
+        {
+            throw std::runtime_error("socketpair failed");
+        }
+    }
+    ~Loopback()
+    {
+        close(m_fds[0]);
+        close(m_fds[1]);
+    }
+
+    int schedulerFd() const { return m_fds[0]; }
+    int executorFd() const { return m_fds[1]; }
+
+    static void write(int _fd, std::vector<tars::Char> const& _frame)
+    {
+        uint32_t size = _frame.size();
+        writeAll(_fd, &size, sizeof(size));
+        writeAll(_fd, _frame.data(), _frame.size());
+    }
+
+    static void read(int _fd, std::vector<tars::Char>& _frame)
+    {
+        uint32_t size = 0;
+        readAll(_fd, &size, sizeof(size));
+        _frame.resize(size);
+        readAll(_fd, _frame.data(), size);
+    }
+
+private:
+    static void writeAll(int _fd, void const* _data, size_t _size)
+    {
+        auto data = (char const*)_data;
+        while (_size > 0)
+        {
+            auto written = ::write(_fd, data, _size);
+            if (written <= 0)
+            {
+                throw std::runtime_error("write failed");
+            }
+            data += written;
+            _size -= written;
+        }
+    }
+
+    static void readAll(int _fd, void* _data, size_t _size)
+    {
+        auto data = (char*)_data;
+        while (_size > 0)
+        {
+            auto readSize = ::read(_fd, data, _size);
+            if (readSize <= 0)
+            {
+                throw std::runtime_error("read failed");
+            }
+            data += readSize;
+            _size -= readSize;
+        }
+    }
+
+    int m_fds[2];
+};
+
+std::vector<bcos::protocol::ExecutionMessage::UniquePtr> buildMessages(
+    BenchParams const& params, int contract)
+{
+    std::vector<bcos::protocol::ExecutionMessage::UniquePtr> messages;
+    for (int i = 0; i < params.txs; ++i)
+    {
+        auto message = std::make_unique<ExecutionMessageImpl>();
+        message->setType(bcos::protocol::ExecutionMessage::MESSAGE);
+        message->setContextID(i);
+        message->setSeq(contract);
+        message->setFrom(std::string(40, 'f'));
+        message->setTo("contract" + std::to_string(contract));
+        message->setGasAvailable(3000000);
+        message->setData(bcos::bytes(params.dataSize, 'd'));
+        message->setKeyLocks({std::string(64, 'k'), std::string(64, 'l')});
+        messages.emplace_back(std::move(message));
+    }
+    return messages;
+}
+
+// every block runs rounds of DMC, the scheduler sends the messages of every contract to the
+// executor in each round, and waits for all the responses before the next round
+template <class Scheduler, class Executor>
+void run(std::string_view name, BenchParams const& params, Scheduler&& scheduler,
+    Executor&& executor)
+{
+    Loopback loopback;
+    // the executor reads the requests and writes the responses in different threads, so the
+    // pipelined requests never block on the responses not read yet
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<std::vector<tars::Char>> responses;
+    std::thread executorThread([&loopback, &executor, &mutex, &condition, &responses]() {
+        std::vector<tars::Char> request;
+        while (true)
+        {
+            Loopback::read(loopback.executorFd(), request);
+            auto response = request.empty() ? request : executor(request);
+            std::lock_guard lock(mutex);
+            responses.emplace_back(std::move(response));
+            condition.notify_one();
+            if (request.empty())
+            {
+                return;
+            }
+        }
+    });
+    std::thread responseThread([&loopback, &mutex, &condition, &responses]() {
+        while (true)
+        {
+            std::unique_lock lock(mutex);
+            condition.wait(lock, [&responses]() { return !responses.empty(); });
+            auto response = std::move(responses.front());
+            responses.pop_front();
+            lock.unlock();
+            if (response.empty())
+            {
+                return;
+            }
+            Loopback::write(loopback.executorFd(), response);
+        }
+    });
+
+    uint64_t duration = 0;
+    uint64_t rpcs = 0;
+    for (int block = 0; block < params.blocks; ++block)
+    {
+        std::vector<std::vector<bcos::protocol::ExecutionMessage::UniquePtr>> contracts;
+        for (int contract = 0; contract < params.contracts; ++contract)
+        {
+            contracts.emplace_back(buildMessages(params, contract));
+        }
+        auto timePoint = std::chrono::high_resolution_clock::now();
+        for (int round = 0; round < params.rounds; ++round)
+        {
+            rpcs += scheduler(loopback.schedulerFd(), contracts);
+        }
+        duration += std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::high_resolution_clock::now() - timePoint)
+                        .count();
+    }
+    Loopback::write(loopback.schedulerFd(), std::vector<tars::Char>());
+    executorThread.join();
+    responseThread.join();
+
+    std::cout << name << " contracts: " << params.contracts << ", txs/contract: " << params.txs
+              << ", rounds: " << params.rounds << ", " << (double)duration / params.blocks
+              << "us/block, " << rpcs / params.blocks << " rpcs/block" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description options("Scheduler to executor protocol benchmark");
+
+    // clang-format off
+    options.add_options()
+        ("contracts,c", boost::program_options::value<int>()->default_value(0), "Contracts on the executor, 0 means 1 to 64")
+        ("txs,t", boost::program_options::value<int>()->default_value(20), "Messages per contract per round")
+        ("rounds,r", boost::program_options::value<int>()->default_value(4), "DMC rounds per block")
+        ("blocks,b", boost::program_options::value<int>()->default_value(50), "Blocks")
+        ("data,d", boost::program_options::value<size_t>()->default_value(256), "Input data size of the message")
+        ("help,h", "Print the usage")
+        ;
+    // clang-format on
+    boost::program_options::variables_map vm;
+    boost::program_options::store(
+        boost::program_options::parse_command_line(argc, argv, options), vm);
+    if (vm.count("help"))
+    {
+        options.print(std::cout);
+        return 0;
+    }
+
+    std::vector<int> contracts{vm["contracts"].as<int>()};
+    if (contracts.front() <= 0)
+    {
+        contracts = {1, 4, 16, 64};
+    }
+    for (auto contractNum : contracts)
+    {
+        BenchParams params{contractNum, vm["txs"].as<int>(), vm["rounds"].as<int>(),
+            vm["blocks"].as<int>(), vm["data"].as<size_t>()};
+
+        // one tars call per contract per round: convert to vector<bcostars::ExecutionMessage>,
+        // tars-encode it, and convert back on both sides, the calls of a round are pipelined
+        run(
+            "TarsPerContract", params,
+            [](int _fd, auto& _contracts) -> uint64_t {
+                for (size_t i = 0; i < _contracts.size(); ++i)
+                {
+                    std::vector<bcostars::ExecutionMessage> tarsInputs;
+                    for (auto const& message : _contracts[i])
+                    {
+                        tarsInputs.emplace_back(((ExecutionMessageImpl&)*message).inner());
+                    }
+                    tars::TarsOutputStream<tars::BufferWriterVector> output;
+                    output.write("contract" + std::to_string(i), 1);
+                    output.write(tarsInputs, 2);
+                    Loopback::write(_fd, output.getByteBuffer());
+                }
+                std::vector<tars::Char> response;
+                for (auto& messages : _contracts)
+                {
+                    Loopback::read(_fd, response);
+                    tars::TarsInputStream<tars::BufferReader> input;
+                    input.setBuffer(response.data(), response.size());
+                    std::vector<bcostars::ExecutionMessage> tarsOutputs;
+                    input.read(tarsOutputs, 2, true);
+                    messages.clear();
+                    for (auto const& it : tarsOutputs)
+                    {
+                        messages.emplace_back(std::make_unique<ExecutionMessageImpl>(
+                            [m_message = it]() mutable { return &m_message; }));
+                    }
+                }
+                return _contracts.size();
+            },
+            [](std::vector<tars::Char> const& _request) {
+                tars::TarsInputStream<tars::BufferReader> input;
+                input.setBuffer(_request.data(), _request.size());
+                std::string contractAddress;
+                std::vector<bcostars::ExecutionMessage> tarsInputs;
+                input.read(contractAddress, 1, true);
+                input.read(tarsInputs, 2, true);
+                std::vector<bcos::protocol::ExecutionMessage::UniquePtr> messages;
+                for (auto const& it : tarsInputs)
+                {
+                    messages.emplace_back(std::make_unique<ExecutionMessageImpl>(
+                        [m_message = it]() mutable { return &m_message; }));
+                }
+                std::vector<bcostars::ExecutionMessage> tarsOutputs;
+                for (auto const& message : messages)
+                {
+                    tarsOutputs.emplace_back(((ExecutionMessageImpl&)*message).inner());
+                }
+                tars::TarsOutputStream<tars::BufferWriterVector> output;
+                output.write(tarsOutputs, 2);
+                return output.getByteBuffer();
+            });
+
+        // one executeBatch per round, the messages are framed by ExecutorBatchCodec
+        run(
+            "BatchPerRound", params,
+            [](int _fd, auto& _contracts) -> uint64_t {
+                ExecutorBatchCodec::Frame frame;
+                for (size_t i = 0; i < _contracts.size(); ++i)
+                {
+                    ExecutorBatchCodec::encodeRequest(frame, ExecutorBatchType::DMC_EXECUTE,
+                        "contract" + std::to_string(i), _contracts[i]);
+                }
+                Loopback::write(_fd, frame);
+                Loopback::read(_fd, frame);
+                auto responses =
+                    ExecutorBatchCodec::decodeResponses(ExecutorBatchCodec::toBytesRef(frame));
+                for (size_t i = 0; i < _contracts.size(); ++i)
+                {
+                    _contracts[i] = std::move(responses[i].messages);
+                }
+                return 1;
+            },
+            [](std::vector<tars::Char> const& _request) {
+                auto requests =
+                    ExecutorBatchCodec::decodeRequests(ExecutorBatchCodec::toBytesRef(_request));
+                ExecutorBatchCodec::Frame frame;
+                for (auto const& request : requests)
+                {
+                    ExecutorBatchCodec::encodeResponse(frame, nullptr, request.messages);
+                }
+                return frame;
+            });
+    }
+
+    return 0;
+}
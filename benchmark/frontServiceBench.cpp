@@ -0,0 +1,199 @@
+#include <bcos-crypto/signature/key/KeyFactoryImpl.h>
+#include <bcos-framework/gateway/GatewayInterface.h>
+#include <bcos-front/FrontService.h>
+#include <bcos-front/FrontServiceFactory.h>
+#include <boost/program_options.hpp>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <map>
+
+using namespace bcos;
+using namespace bcos::front;
+
+struct BenchParams
+{
+    size_t payloadSize;
+    int64_t count;
+    uint32_t threads;
+};
+
+// deliver the messages between the front services in the same process, as the gateway of the Air
+// binary does: the message received is held in a buffer of its own
+class LoopbackGateway : public gateway::GatewayInterface
+{
+public:
+    explicit LoopbackGateway(bool _shared) : m_shared(_shared) {}
+
+    void addFrontService(FrontService::Ptr _frontService)
+    {
+        m_frontServices[_frontService->nodeID()->data()] = _frontService;
+    }
+
+    void start() override {}
+    void stop() override {}
+    void asyncGetPeers(std::function<void(
+            Error::Ptr, bcos::gateway::GatewayInfo::Ptr, bcos::gateway::GatewayInfosPtr)>) override
+    {}
+    void asyncGetGroupNodeInfo(const std::string&, GetGroupNodeInfoFunc) override {}
+
+    void asyncSendMessageByNodeID(const std::string& _groupID, int,
+        bcos::crypto::NodeIDPtr _srcNodeID, bcos::crypto::NodeIDPtr _dstNodeID,
+        bytesConstRef _payload, bcos::gateway::ErrorRespFunc _errorRespFunc) override
+    {
+        auto const& frontService = m_frontServices.at(_dstNodeID->data());
+        auto message = std::make_shared<bytes>(_payload.begin(), _payload.end());
+        if (m_shared)
+        {
+            frontService->onReceiveSharedMessage(_groupID, _srcNodeID, message, _errorRespFunc);
+        }
+        else
+        {
+            frontService->onReceiveMessage(_groupID, _srcNodeID,
+                bytesConstRef(message->data(), message->size()), _errorRespFunc);
+        }
+    }
+
+    void asyncSendMessageByNodeIDs(const std::string&, int, bcos::crypto::NodeIDPtr,
+        const bcos::crypto::NodeIDs&, bytesConstRef) override
+    {}
+    void asyncSendBroadcastMessage(
+        uint16_t, const std::string&, int, bcos::crypto::NodeIDPtr, bytesConstRef) override
+    {}
+    void asyncNotifyGroupInfo(
+        bcos::group::GroupInfo::Ptr, std::function<void(Error::Ptr&&)>) override
+    {}
+    void asyncSendMessageByTopic(const std::string&, bcos::bytesConstRef,
+        std::function<void(bcos::Error::Ptr&&, int16_t, bytesPointer)>) override
+    {}
+    void asyncSendBroadcastMessageByTopic(const std::string&, bcos::bytesConstRef) override {}
+    void asyncSubscribeTopic(
+        std::string const&, std::string const&, std::function<void(Error::Ptr&&)>) override
+    {}
+    void asyncRemoveTopic(std::string const&, std::vector<std::string> const&,
+        std::function<void(Error::Ptr&&)>) override
+    {}
+
+private:
+    bool m_shared;
+    std::map<bytes, FrontService::Ptr> m_frontServices;
+};
+
+FrontService::Ptr buildFrontService(std::shared_ptr<LoopbackGateway> _gateway,
+    ThreadPool::Ptr _threadPool, std::string const& _nodeID)
+{
+    auto keyFactory = std::make_shared<bcos::crypto::KeyFactoryImpl>();
+    auto nodeID = keyFactory->createKey(bytesConstRef((byte*)_nodeID.data(), _nodeID.size()));
+    auto frontServiceFactory = std::make_shared<FrontServiceFactory>();
+    frontServiceFactory->setThreadPool(_threadPool);
+    frontServiceFactory->setGatewayInterface(_gateway);
+    auto frontService = frontServiceFactory->buildFrontService("group0", nodeID);
+    _gateway->addFrontService(frontService);
+    return frontService;
+}
+
+// the sender sends count messages to the receiver, the receiver responds every message if
+// _withResponse
+void run(std::string_view name, BenchParams const& params, bool _shared, bool _withResponse)
+{
+    constexpr static int moduleID = bcos::protocol::ModuleID::BlockSync;
+    auto gateway = std::make_shared<LoopbackGateway>(_shared);
+    auto threadPool = std::make_shared<ThreadPool>("frontBench", params.threads);
+    auto sender = buildFrontService(gateway, threadPool, "sender");
+    auto receiver = buildFrontService(gateway, threadPool, "receiver");
+
+    std::atomic<int64_t> finished = 0;
+    std::promise<void> promise;
+    auto onFinished = [&finished, &promise, &params]() {
+        if (++finished == params.count)
+        {
+            promise.set_value();
+        }
+    };
+    std::weak_ptr<FrontService> weakReceiver = receiver;
+    receiver->registerModuleMessageDispatcher(moduleID,
+        [&onFinished, _withResponse, weakReceiver](
+            bcos::crypto::NodeIDPtr _nodeID, const std::string& _id, bytesConstRef _data) {
+            if (!_withResponse)
+            {
+                onFinished();
+                return;
+            }
+            if (auto receiver = weakReceiver.lock())
+            {
+                receiver->asyncSendResponse(_id, moduleID, _nodeID, _data, nullptr);
+            }
+        });
+    sender->start();
+    receiver->start();
+
+    bytes payload(params.payloadSize, 'x');
+    CallbackFunc callback;
+    if (_withResponse)
+    {
+        callback = [&onFinished](Error::Ptr, bcos::crypto::NodeIDPtr, bytesConstRef,
+                       const std::string&, ResponseFunc) { onFinished(); };
+    }
+    auto timePoint = std::chrono::high_resolution_clock::now();
+    for (int64_t i = 0; i < params.count; ++i)
+    {
+        sender->asyncSendMessageByNodeID(
+            moduleID, receiver->nodeID(), ref(payload), _withResponse ? 10000 : 0, callback);
+    }
+    promise.get_future().get();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - timePoint)
+                        .count();
+    duration = std::max<int64_t>(duration, 1);
+    std::cout << name << " payload: " << params.payloadSize << " bytes, "
+              << (double)params.count * 1000000 / duration << " msgs/s" << std::endl;
+
+    sender->stop();
+    receiver->stop();
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description options("FrontService dispatch benchmark");
+
+    // clang-format off
+    options.add_options()
+        ("payload,p", boost::program_options::value<size_t>()->default_value(0), "Payload size of the message, 0 means 100 bytes and 1MB")
+        ("count,c", boost::program_options::value<int64_t>()->default_value(0), "Messages to send, 0 means 1M for 100 bytes and 1K for 1MB")
+        ("threads,t", boost::program_options::value<uint32_t>()->default_value(8), "Threads of the front service")
+        ("help,h", "Print the usage")
+        ;
+    // clang-format on
+    boost::program_options::variables_map vm;
+    boost::program_options::store(
+        boost::program_options::parse_command_line(argc, argv, options), vm);
+    if (vm.count("help"))
+    {
+        options.print(std::cout);
+        return 0;
+    }
+
+    std::vector<size_t> payloadSizes{vm["payload"].as<size_t>()};
+    if (payloadSizes.front() == 0)
+    {
+        payloadSizes = {100, 1024 * 1024};
+    }
+    for (auto payloadSize : payloadSizes)
+    {
+        auto count = vm["count"].as<int64_t>();
+        if (count == 0)
+        {
+            count = (payloadSize > 64 * 1024) ? 1000 : 1000000;
+        }
+        BenchParams params{payloadSize, count, vm["threads"].as<uint32_t>()};
+        // onReceiveMessage copies the message for the thread pool
+        run("Copy", params, false, false);
+        // onReceiveSharedMessage passes the payload to the module in the buffer received
+        run("Shared", params, true, false);
+        run("CopyRequestResponse", params, false, true);
+        run("SharedRequestResponse", params, true, true);
+    }
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include <bcos-table/src/KeyPageCodec.h>
+#include <bcos-table/src/KeyPageStorage.h>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+using namespace bcos::storage;
+
+struct BenchParams
+{
+    int pageSize;
+    int keySize;
+    int valueSize;
+    int rounds;
+};
+
+// the keys share a long prefix, like the storage keys of a contract
+KeyPageStorage::Page makePage(BenchParams const& params, std::vector<std::string>& keys)
+{
+    std::mt19937 random(0);
+    KeyPageStorage::Page page;
+    for (int i = 0; (int)page.size() < params.pageSize; ++i)
+    {
+        auto suffix = std::to_string(i * 7);
+        auto key = std::string(std::max(params.keySize - (int)suffix.size(), 0), 'k') + suffix;
+        std::string value(params.valueSize, 0);
+        for (auto& c : value)
+        {
+            c = (char)(random() % 16);
+        }
+        Entry entry;
+        entry.setField(0, std::move(value));
+        entry.setStatus(Entry::Status::MODIFIED);
+        page.setEntry(key, std::move(entry));
+        keys.push_back(std::move(key));
+    }
+    return page;
+}
+
+template <class Operation>
+void run(std::string_view name, int rounds, Operation&& operation)
+{
+    auto timePoint = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < rounds; ++i)
+    {
+        operation(i);
+    }
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::now() - timePoint)
+                        .count();
+    std::cout << name << ": " << duration / rounds / 1000.0 << "us/op" << std::endl;
+}
+
+void bench(std::string_view format, KeyPageFormat pageFormat, bool compress,
+    KeyPageStorage::Page const& page, std::vector<std::string> const& keys,
+    BenchParams const& params)
+{
+    KeyPageCodec::setFormat(pageFormat, compress);
+    Entry encoded;
+    page.encode(encoded);
+    std::cout << "== " << format << ", encoded size: " << encoded.size() << std::endl;
+
+    run("encode", params.rounds, [&page](int) {
+        Entry entry;
+        page.encode(entry);
+    });
+    auto value = encoded.get();
+    auto pageKey = keys.back();
+    run("decode", params.rounds,
+        [&value, &pageKey](int) { KeyPageStorage::Page decoded(value, pageKey); });
+    run("decode and lookup", params.rounds, [&value, &pageKey, &keys](int i) {
+        KeyPageStorage::Page decoded(value, pageKey);
+        decoded.getEntry(keys[i % keys.size()]);
+    });
+    if (pageFormat == KeyPageFormat::BINARY)
+    {
+        run("lookup without decode", params.rounds, [&value, &keys](int i) {
+            KeyPageReader reader(value);
+            reader.find(keys[i % keys.size()]);
+        });
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description options("Key page codec benchmark");
+
+    // clang-format off
+    options.add_options()
+        ("page,p", boost::program_options::value<int>()->default_value(10240), "Page size in bytes")
+        ("key,k", boost::program_options::value<int>()->default_value(32), "Key size")
+        ("value,v", boost::program_options::value<int>()->default_value(64), "Value size")
+        ("rounds,r", boost::program_options::value<int>()->default_value(10000), "Rounds per operation")
+        ("help,h", "Print the usage")
+        ;
+    // clang-format on
+    boost::program_options::variables_map vm;
+    boost::program_options::store(
+        boost::program_options::parse_command_line(argc, argv, options), vm);
+    if (vm.count("help"))
+    {
+        options.print(std::cout);
+        return 0;
+    }
+
+    BenchParams params{vm["page"].as<int>(), vm["key"].as<int>(), vm["value"].as<int>(),
+        vm["rounds"].as<int>()};
+    boost::log::core::get()->set_logging_enabled(false);
+    std::vector<std::string> keys;
+    auto page = makePage(params, keys);
+    std::cout << "page entries: " << keys.size() << ", page size: " << page.size() << std::endl;
+
+    bench("legacy", KeyPageFormat::LEGACY, false, page, keys, params);
+    bench("binary", KeyPageFormat::BINARY, false, page, keys, params);
+    bench("binary with zstd", KeyPageFormat::BINARY, true, page, keys, params);
+    return 0;
+}
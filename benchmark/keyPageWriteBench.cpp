@@ -0,0 +1,140 @@
+#include <bcos-table/src/KeyPageStorage.h>
+#include <bcos-table/src/StateStorage.h>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+using namespace bcos::storage;
+
+constexpr static std::string_view HOT_TABLE = "t_balance";
+constexpr static std::string_view APPEND_TABLE = "t_log";
+
+struct BenchParams
+{
+    int blocks;
+    int txCount;
+    int hotKeys;
+    // the percent of the txs updating the hot table, the others append to the log table
+    int hotPercent;
+    int pageSize;
+};
+
+struct WriteStats
+{
+    // the bytes of the rows set by the txs
+    uint64_t logicalBytes = 0;
+    // the bytes of the pages written to the backend
+    uint64_t writtenBytes = 0;
+};
+
+// every block is executed on a new KeyPageStorage and committed to the backend
+WriteStats run(std::string_view name, BenchParams const& params, bool adaptive)
+{
+    KeyPageStorage::setAdaptivePageSize(false);
+    auto backend = std::make_shared<StateStorage>(nullptr);
+    WriteStats stats;
+    std::mt19937 random(0);
+    std::uniform_int_distribution<int> hotDistribution(0, params.hotKeys - 1);
+    std::uniform_int_distribution<int> percent(0, 99);
+    int64_t logIndex = 0;
+    auto commit = [&backend](KeyPageStorage& storage, uint64_t* writtenBytes) {
+        storage.parallelTraverse(true,
+            [&backend, writtenBytes](auto const& table, auto const& key, auto const& entry) {
+                if (writtenBytes)
+                {
+                    *writtenBytes += key.size() + entry.size();
+                }
+                backend->asyncSetRow(table, key, entry, [](auto&&) {});
+                return true;
+            });
+    };
+
+    // the balances exist before the benchmark
+    auto genesis = std::make_shared<KeyPageStorage>(backend, params.pageSize);
+    genesis->createTable(std::string(HOT_TABLE), "value");
+    genesis->createTable(std::string(APPEND_TABLE), "value");
+    auto balances = genesis->openTable(HOT_TABLE);
+    for (int i = 0; i < params.hotKeys; ++i)
+    {
+        auto entry = balances->newEntry();
+        entry.setField(0, "0");
+        balances->setRow("balance_" + std::to_string(i), std::move(entry));
+    }
+    commit(*genesis, nullptr);
+    KeyPageStorage::setAdaptivePageSize(adaptive);
+
+    auto timePoint = std::chrono::high_resolution_clock::now();
+    for (int block = 0; block < params.blocks; ++block)
+    {
+        auto storage = std::make_shared<KeyPageStorage>(backend, params.pageSize);
+        auto hotTable = storage->openTable(HOT_TABLE);
+        auto appendTable = storage->openTable(APPEND_TABLE);
+        for (int i = 0; i < params.txCount; ++i)
+        {
+            std::string key;
+            std::string value;
+            std::optional<Table>* table = nullptr;
+            if (percent(random) < params.hotPercent)
+            {
+                key = "balance_" + std::to_string(hotDistribution(random));
+                auto balance = hotTable->getRow(key);
+                value = std::to_string(
+                    (balance ? std::stoll(std::string(balance->get())) : 0) + i + 1);
+                table = &hotTable;
+            }
+            else
+            {
+                auto index = std::to_string(logIndex++);
+                key = "log_" + std::string(12 - index.size(), '0') + index;
+                value = std::string(96, 'l');
+                table = &appendTable;
+            }
+            stats.logicalBytes += key.size() + value.size();
+            auto entry = (*table)->newEntry();
+            entry.setField(0, std::move(value));
+            (*table)->setRow(key, std::move(entry));
+        }
+        commit(*storage, &stats.writtenBytes);
+    }
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - timePoint)
+                        .count();
+    std::cout << name << ": " << params.blocks << " blocks in " << duration
+              << "ms, logical bytes: " << stats.logicalBytes
+              << ", written bytes: " << stats.writtenBytes << ", write amplification: "
+              << stats.writtenBytes / (double)stats.logicalBytes << std::endl;
+    return stats;
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description options(
+        "KeyPageStorage write amplification benchmark");
+
+    // clang-format off
+    options.add_options()
+        ("blocks,b", boost::program_options::value<int>()->default_value(50), "Block count")
+        ("count,c", boost::program_options::value<int>()->default_value(1000), "Transactions per block")
+        ("keys,k", boost::program_options::value<int>()->default_value(100000), "Hot key count")
+        ("hot", boost::program_options::value<int>()->default_value(80), "Percent of the hot updates")
+        ("page,p", boost::program_options::value<int>()->default_value(10240), "Page size in bytes")
+        ("help,h", "Print the usage")
+        ;
+    // clang-format on
+    boost::program_options::variables_map vm;
+    boost::program_options::store(
+        boost::program_options::parse_command_line(argc, argv, options), vm);
+    if (vm.count("help"))
+    {
+        options.print(std::cout);
+        return 0;
+    }
+
+    BenchParams params{vm["blocks"].as<int>(), vm["count"].as<int>(), vm["keys"].as<int>(),
+        vm["hot"].as<int>(), vm["page"].as<int>()};
+    boost::log::core::get()->set_logging_enabled(false);
+    run("fixed page size", params, false);
+    run("adaptive page size", params, true);
+    return 0;
+}
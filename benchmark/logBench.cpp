@@ -0,0 +1,104 @@
+#include <bcos-utilities/AsyncLog.h>
+#include <bcos-utilities/BoostLogInitializer.h>
+#include <bcos-utilities/Metrics.h>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+using namespace bcos;
+
+struct BenchParams
+{
+    int threads;
+    int64_t count;
+};
+
+// every thread logs count records, report the throughput and the latency of the callers
+template <class Log>
+void run(std::string_view name, BenchParams const& params, Log&& log)
+{
+    metrics::Histogram latency;
+    auto timePoint = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < params.threads; ++i)
+    {
+        threads.emplace_back([&params, &log, &latency, i]() {
+            for (int64_t j = 0; j < params.count; ++j)
+            {
+                metrics::ScopedTimer timer(latency);
+                log(i, j);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    auto callerDuration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - timePoint)
+                              .count();
+    auto total = params.threads * params.count;
+    std::cout << name << " threads: " << params.threads << ", " << total << " logs in "
+              << callerDuration << "ms, "
+              << (callerDuration > 0 ? total * 1000 / callerDuration : 0)
+              << " logs/s, caller latency p50: " << latency.quantile(0.5)
+              << "us, p99: " << latency.quantile(0.99) << "us, p999: " << latency.quantile(0.999)
+              << "us" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description options("Log benchmark");
+
+    // clang-format off
+    options.add_options()
+        ("threads,t", boost::program_options::value<int>()->default_value(4), "Logging threads")
+        ("count,n", boost::program_options::value<int64_t>()->default_value(200000), "Logs per thread")
+        ("path,p", boost::program_options::value<std::string>()->default_value("./logBench"), "Log path")
+        ("policy", boost::program_options::value<std::string>()->default_value("block"), "block or drop")
+        ("buffer", boost::program_options::value<size_t>()->default_value(1024), "Async buffer size of each thread in KB")
+        ("flush", boost::program_options::value<bool>()->default_value(false), "Flush every log")
+        ("help,h", "Print the usage")
+        ;
+    // clang-format on
+    boost::program_options::variables_map vm;
+    boost::program_options::store(
+        boost::program_options::parse_command_line(argc, argv, options), vm);
+    if (vm.count("help"))
+    {
+        options.print(std::cout);
+        return 0;
+    }
+
+    boost::property_tree::ptree pt;
+    pt.put("log.level", "info");
+    pt.put("log.log_path", vm["path"].as<std::string>());
+    pt.put("log.flush", vm["flush"].as<bool>());
+    pt.put("log.async_backend", true);
+    pt.put("log.async_full_policy", vm["policy"].as<std::string>());
+    pt.put("log.async_buffer_size", vm["buffer"].as<size_t>());
+    BoostLogInitializer logInitializer;
+    logInitializer.initLog(pt);
+
+    BenchParams params{vm["threads"].as<int>(), vm["count"].as<int64_t>()};
+    std::string hash = "0x3b6a27bc...";
+    run("BCOS_LOG", params, [&hash](int thread, int64_t index) {
+        BCOS_LOG(INFO) << LOG_BADGE("BENCH") << LOG_DESC("handle the message")
+                       << LOG_KV("thread", thread) << LOG_KV("index", index)
+                       << LOG_KV("hash", hash) << LOG_KV("sysProposal", false);
+    });
+    run("BCOS_ASYNC_LOG", params, [&hash](int thread, int64_t index) {
+        BCOS_ASYNC_LOG(INFO, "[BENCH]handle the message,thread={},index={},hash={},sysProposal={}",
+            thread, index, hash, false);
+    });
+
+    auto timePoint = std::chrono::steady_clock::now();
+    logInitializer.stopLogging();
+    std::cout << "flush the logs in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(
+                     std::chrono::steady_clock::now() - timePoint)
+                     .count()
+              << "ms, dropped: " << AsyncLogger::instance().dropped() << std::endl;
+    return 0;
+}
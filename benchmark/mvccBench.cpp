@@ -0,0 +1,144 @@
+#include <bcos-table/src/MVCCStorage.h>
+#include <bcos-table/src/StateStorage.h>
+#include <tbb/global_control.h>
+#include <tbb/parallel_for.h>
+#include <boost/functional/hash.hpp>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <random>
+
+using namespace bcos::storage;
+
+constexpr static std::string_view TABLE = "t_bench";
+
+struct BenchParams
+{
+    int txCount;
+    int hotKeys;
+    int reads;
+    int writes;
+    // the simulated execution cost of a transaction, in hash rounds
+    int work;
+};
+
+std::string keyOf(int i)
+{
+    return "key_" + std::to_string(i);
+}
+
+// every transaction reads and writes some random keys of the hot set
+template <class Execute>
+void run(std::string_view name, BenchParams const& params, Execute&& execute)
+{
+    auto timePoint = std::chrono::high_resolution_clock::now();
+    tbb::parallel_for(tbb::blocked_range<int>(0, params.txCount),
+        [&params, &execute](const tbb::blocked_range<int>& range) {
+            std::mt19937 random(range.begin());
+            std::uniform_int_distribution<int> distribution(0, params.hotKeys - 1);
+            for (auto txIndex = range.begin(); txIndex < range.end(); ++txIndex)
+            {
+                std::vector<int> reads(params.reads);
+                std::vector<int> writes(params.writes);
+                for (auto& key : reads)
+                {
+                    key = distribution(random);
+                }
+                for (auto& key : writes)
+                {
+                    key = distribution(random);
+                }
+                execute(txIndex, reads, writes);
+            }
+        });
+
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - timePoint)
+                        .count();
+    std::cout << name << ": " << params.txCount << " txs in " << duration << "ms, "
+              << (duration > 0 ? params.txCount * 1000 / duration : 0) << " tx/s" << std::endl;
+}
+
+void executeOn(StorageInterface& storage, int txIndex, std::vector<int> const& reads,
+    std::vector<int> const& writes, int work)
+{
+    size_t seed = txIndex;
+    for (auto key : reads)
+    {
+        storage.asyncGetRow(TABLE, keyOf(key), [&seed](auto&&, std::optional<Entry> entry) {
+            if (entry)
+            {
+                boost::hash_combine(seed, entry->getField(0));
+            }
+        });
+    }
+    for (int i = 0; i < work; ++i)
+    {
+        boost::hash_combine(seed, i);
+    }
+    for (auto key : writes)
+    {
+        Entry entry;
+        entry.importFields({std::to_string(seed)});
+        storage.asyncSetRow(TABLE, keyOf(key), std::move(entry), [](auto&&) {});
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description options("MVCC storage benchmark");
+
+    // clang-format off
+    options.add_options()
+        ("threads,t", boost::program_options::value<int>()->default_value((int)std::thread::hardware_concurrency()), "Worker threads")
+        ("count,c", boost::program_options::value<int>()->default_value(100000), "Transaction count")
+        ("keys,k", boost::program_options::value<int>()->default_value(100), "Hot key count")
+        ("reads,r", boost::program_options::value<int>()->default_value(4), "Reads per transaction")
+        ("writes,w", boost::program_options::value<int>()->default_value(2), "Writes per transaction")
+        ("work", boost::program_options::value<int>()->default_value(10000), "Execution cost per transaction")
+        ("help,h", "Print the usage")
+        ;
+    // clang-format on
+    boost::program_options::variables_map vm;
+    boost::program_options::store(
+        boost::program_options::parse_command_line(argc, argv, options), vm);
+    if (vm.count("help"))
+    {
+        options.print(std::cout);
+        return 0;
+    }
+
+    BenchParams params{vm["count"].as<int>(), vm["keys"].as<int>(), vm["reads"].as<int>(),
+        vm["writes"].as<int>(), vm["work"].as<int>()};
+    tbb::global_control control(
+        tbb::global_control::max_allowed_parallelism, vm["threads"].as<int>());
+
+    auto backend = std::make_shared<StateStorage>(nullptr);
+    for (int i = 0; i < params.hotKeys; ++i)
+    {
+        Entry entry;
+        entry.importFields({"init"});
+        backend->asyncSetRow(TABLE, keyOf(i), std::move(entry), [](auto&&) {});
+    }
+
+    // one shared state, the transactions touching the same keys are serialised
+    auto shared = std::make_shared<StateStorage>(backend);
+    std::mutex sharedMutex;
+    run("StateStorage[serialised]", params,
+        [&shared, &sharedMutex, &params](int txIndex, auto const& reads, auto const& writes) {
+            std::unique_lock lock(sharedMutex);
+            executeOn(*shared, txIndex, reads, writes, params.work);
+        });
+
+    // the transactions read the snapshot of their index and write their own versions
+    auto mvcc = std::make_shared<MVCCStorage>(backend);
+    run("MVCCStorage", params,
+        [&mvcc, &params](int txIndex, auto const& reads, auto const& writes) {
+            mvcc->setTxIndex(txIndex);
+            executeOn(*mvcc, txIndex, reads, writes, params.work);
+        });
+    std::cout << "MVCCStorage versions: " << mvcc->versionCount() << std::endl;
+
+    return 0;
+}
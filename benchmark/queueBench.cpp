@@ -0,0 +1,118 @@
+#include <bcos-utilities/BoundedConcurrentQueue.h>
+#include <bcos-utilities/ConcurrentQueue.h>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+using namespace bcos;
+
+using Message = std::shared_ptr<int64_t>;
+
+struct BenchParams
+{
+    int producers;
+    int consumers;
+    int64_t count;
+    size_t batch;
+};
+
+// every producer pushes count messages, the consumers pop them all
+template <class Push, class Pop>
+void run(std::string_view name, BenchParams const& params, Push&& push, Pop&& pop)
+{
+    auto total = params.producers * params.count;
+    std::atomic_int64_t popped = 0;
+    auto timePoint = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < params.producers; ++i)
+    {
+        threads.emplace_back([&params, &push]() {
+            for (int64_t j = 0; j < params.count; ++j)
+            {
+                push(std::make_shared<int64_t>(j));
+            }
+        });
+    }
+    for (int i = 0; i < params.consumers; ++i)
+    {
+        threads.emplace_back([&popped, &pop, total]() {
+            while (popped < total)
+            {
+                popped += pop();
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - timePoint)
+                        .count();
+    std::cout << name << " producers: " << params.producers << ", " << total << " msgs in "
+              << duration << "ms, " << (duration > 0 ? total * 1000 / duration : 0) << " msg/s"
+              << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description options("Concurrent queue benchmark");
+
+    // clang-format off
+    options.add_options()
+        ("producers,p", boost::program_options::value<int>()->default_value(0), "Producer threads, 0 means 1 to 32")
+        ("consumers,c", boost::program_options::value<int>()->default_value(1), "Consumer threads")
+        ("count,n", boost::program_options::value<int64_t>()->default_value(100000), "Messages per producer")
+        ("capacity", boost::program_options::value<size_t>()->default_value(65536), "Capacity of the bounded queue")
+        ("batch,b", boost::program_options::value<size_t>()->default_value(64), "Max size of popBatch")
+        ("help,h", "Print the usage")
+        ;
+    // clang-format on
+    boost::program_options::variables_map vm;
+    boost::program_options::store(
+        boost::program_options::parse_command_line(argc, argv, options), vm);
+    if (vm.count("help"))
+    {
+        options.print(std::cout);
+        return 0;
+    }
+
+    std::vector<int> producers{vm["producers"].as<int>()};
+    if (producers.front() <= 0)
+    {
+        producers = {1, 2, 4, 8, 16, 32};
+    }
+    auto capacity = vm["capacity"].as<size_t>();
+    for (auto producerNum : producers)
+    {
+        BenchParams params{producerNum, vm["consumers"].as<int>(), vm["count"].as<int64_t>(),
+            vm["batch"].as<size_t>()};
+
+        ConcurrentQueue<Message> queue;
+        run(
+            "ConcurrentQueue", params, [&queue](Message msg) { queue.push(std::move(msg)); },
+            [&queue]() -> int64_t { return queue.tryPop(5).first ? 1 : 0; });
+
+        BoundedConcurrentQueue<Message> boundedQueue(capacity);
+        run(
+            "BoundedConcurrentQueue", params,
+            [&boundedQueue](Message msg) { boundedQueue.push(std::move(msg)); },
+            [&boundedQueue]() -> int64_t { return boundedQueue.tryPop(5) ? 1 : 0; });
+
+        BoundedConcurrentQueue<Message> batchQueue(capacity);
+        run(
+            "BoundedConcurrentQueue[popBatch]", params,
+            [&batchQueue](Message msg) { batchQueue.push(std::move(msg)); },
+            [&batchQueue, &params]() -> int64_t {
+                thread_local std::vector<Message> msgs;
+                msgs.clear();
+                return (int64_t)batchQueue.tryPopBatch(msgs, params.batch, 5);
+            });
+    }
+
+    return 0;
+}
@@ -0,0 +1,166 @@
+#include <bcos-gateway/GatewayConfig.h>
+#include <bcos-gateway/libratelimit/BWRateLimiter.h>
+#include <bcos-gateway/libratelimit/RateLimiterManager.h>
+#include <boost/program_options.hpp>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::gateway;
+using namespace bcos::gateway::ratelimit;
+
+struct BenchParams
+{
+    int threads;
+    int64_t count;
+    int64_t permits;
+};
+
+// the token bucket guarded by a mutex, which the limiter used before
+class MutexRateLimiter : public BWRateLimiterInterface
+{
+public:
+    MutexRateLimiter(int64_t _maxQPS)
+      : m_maxQPS(_maxQPS),
+        m_permitsUpdateInterval(1000000000.0 / _maxQPS),
+        m_lastUpdateTime(now())
+    {}
+
+    void acquire(int64_t _requiredPermits) override { tryAcquire(_requiredPermits); }
+
+    bool tryAcquire(int64_t _requiredPermits) override
+    {
+        std::lock_guard lock(m_mutex);
+        auto currentTime = now();
+        auto increasedPermits =
+            (int64_t)((double)(currentTime - m_lastUpdateTime) / m_permitsUpdateInterval);
+        if (increasedPermits > 0)
+        {
+            m_storedPermits = std::min(m_maxQPS, m_storedPermits + increasedPermits);
+            m_lastUpdateTime = currentTime;
+        }
+        if (m_storedPermits < _requiredPermits)
+        {
+            return false;
+        }
+        m_storedPermits -= _requiredPermits;
+        return true;
+    }
+
+    void rollback(int64_t _requiredPermits) override
+    {
+        std::lock_guard lock(m_mutex);
+        m_storedPermits = std::min(m_maxQPS, m_storedPermits + _requiredPermits);
+    }
+
+private:
+    static int64_t now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    std::mutex m_mutex;
+    int64_t m_maxQPS;
+    double m_permitsUpdateInterval;
+    int64_t m_lastUpdateTime;
+    int64_t m_storedPermits = 0;
+};
+
+// every thread acquires count times, the limit is high enough that the acquisitions contend on the
+// bucket instead of failing at once
+template <class Acquire>
+void run(std::string_view name, BenchParams const& params, Acquire&& acquire)
+{
+    std::atomic<int64_t> acquired = 0;
+    std::vector<std::thread> threads;
+    auto timePoint = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < params.threads; ++i)
+    {
+        threads.emplace_back([&params, &acquire, &acquired]() {
+            int64_t threadAcquired = 0;
+            for (int64_t j = 0; j < params.count; ++j)
+            {
+                threadAcquired += acquire(params.permits) ? 1 : 0;
+            }
+            acquired += threadAcquired;
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - timePoint)
+                        .count();
+    auto total = params.threads * params.count;
+    std::cout << name << " threads: " << params.threads << ", "
+              << (double)total / std::max(duration, (int64_t)1) << " M acquire/s, "
+              << (double)duration * 1000 / total << "ns/acquire, " << acquired * 100 / total
+              << "% acquired" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description options("Outgoing bandwidth limiter benchmark");
+
+    // clang-format off
+    options.add_options()
+        ("threads,t", boost::program_options::value<int>()->default_value(0), "Threads acquiring the permits, 0 means 1 to 32")
+        ("count,n", boost::program_options::value<int64_t>()->default_value(200000), "Acquisitions per thread")
+        ("permits,p", boost::program_options::value<int64_t>()->default_value(1024), "Permits per acquisition, the message size")
+        ("limit,l", boost::program_options::value<int64_t>()->default_value(1024L * 1024 * 1024 * 8), "The limit of every level, permits per second")
+        ("help,h", "Print the usage")
+        ;
+    // clang-format on
+    boost::program_options::variables_map vm;
+    boost::program_options::store(
+        boost::program_options::parse_command_line(argc, argv, options), vm);
+    if (vm.count("help"))
+    {
+        options.print(std::cout);
+        return 0;
+    }
+
+    auto limit = vm["limit"].as<int64_t>();
+    std::vector<int> threads{vm["threads"].as<int>()};
+    if (threads.front() <= 0)
+    {
+        threads = {1, 2, 4, 8, 16, 32};
+    }
+    for (auto threadNum : threads)
+    {
+        BenchParams params{threadNum, vm["count"].as<int64_t>(), vm["permits"].as<int64_t>()};
+
+        MutexRateLimiter mutexRateLimiter(limit);
+        run("Mutex", params, [&mutexRateLimiter](int64_t _permits) {
+            return mutexRateLimiter.tryAcquire(_permits);
+        });
+
+        BWRateLimiter rateLimiter(limit);
+        run("CAS", params,
+            [&rateLimiter](int64_t _permits) { return rateLimiter.tryAcquire(_permits); });
+
+        // total -> group -> connection -> module in one pass
+        GatewayConfig::RateLimitConfig rateLimitConfig;
+        rateLimitConfig.totalOutgoingBwLimit = limit;
+        rateLimitConfig.connOutgoingBwLimit = limit;
+        rateLimitConfig.groupOutgoingBwLimit = limit;
+        rateLimitConfig.module2BwLimit[1000] = limit;
+        RateLimiterManager rateLimiterManager(rateLimitConfig);
+        rateLimiterManager.setRateLimiterFactory(std::make_shared<BWRateLimiterFactory>());
+        rateLimiterManager.registerRateLimiter(RateLimiterManager::TOTAL_OUTGOING_KEY,
+            std::make_shared<BWRateLimiter>(limit));
+        run("Hierarchical", params, [&rateLimiterManager](int64_t _permits) {
+            return rateLimiterManager.tryAcquire("192.108.0.1", "group0", 1000, _permits) ==
+                   RateLimitLevel::None;
+        });
+    }
+
+    return 0;
+}
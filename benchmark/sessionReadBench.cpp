@@ -0,0 +1,150 @@
+#include <bcos-framework/gateway/GatewayTypeDef.h>
+#include <bcos-gateway/libnetwork/MessageReader.h>
+#include <bcos-gateway/libp2p/P2PMessageV2.h>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::gateway;
+
+struct BenchParams
+{
+    size_t payloadSize;
+    size_t totalSize;
+    size_t bufferSize;
+};
+
+// the frames of the messages received from a busy peer, back to back
+bytes buildStream(BenchParams const& params, size_t& _messages)
+{
+    auto message = std::make_shared<P2PMessageV2>();
+    message->setVersion((uint16_t)bcos::protocol::ProtocolVersion::V1);
+    message->setPacketType(GatewayMessageType::PeerToPeerMessage);
+    message->setSeq(1);
+    message->options()->setGroupID("group0");
+    message->options()->setSrcNodeID(std::make_shared<bytes>(128, 'a'));
+    message->options()->dstNodeIDs().push_back(std::make_shared<bytes>(128, 'c'));
+    message->setPayload(std::make_shared<bytes>(params.payloadSize, 'b'));
+    bytes frame;
+    message->encode(frame);
+
+    _messages = std::max<size_t>(params.totalSize / frame.size(), 1);
+    bytes stream;
+    stream.reserve(_messages * frame.size());
+    for (size_t i = 0; i < _messages; ++i)
+    {
+        stream.insert(stream.end(), frame.begin(), frame.end());
+    }
+    return stream;
+}
+
+// every read of the socket fills the buffer given to it, as a peer sending faster than the session
+// reads does
+template <class Reader>
+void run(std::string_view name, BenchParams const& params, Reader&& reader)
+{
+    size_t messages = 0;
+    auto stream = buildStream(params, messages);
+    size_t decoded = 0;
+    auto timePoint = std::chrono::high_resolution_clock::now();
+    reader(stream, decoded);
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - timePoint)
+                        .count();
+    duration = std::max<int64_t>(duration, 1);
+    if (decoded != messages)
+    {
+        std::cout << name << " decoded " << decoded << " of " << messages << " messages"
+                  << std::endl;
+    }
+    std::cout << name << " payload: " << params.payloadSize << " bytes, buffer: "
+              << params.bufferSize << " bytes, " << (double)messages * 1000000 / duration
+              << " msgs/s, " << (double)stream.size() / duration << " MB/s" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description options("Session read and decode benchmark");
+
+    // clang-format off
+    options.add_options()
+        ("payload,p", boost::program_options::value<size_t>()->default_value(0), "Payload size of the message, 0 means 100 bytes and 1MB")
+        ("total,t", boost::program_options::value<size_t>()->default_value(256 * 1024 * 1024), "Bytes received")
+        ("buffer,b", boost::program_options::value<size_t>()->default_value(4096), "Read buffer size of the session")
+        ("help,h", "Print the usage")
+        ;
+    // clang-format on
+    boost::program_options::variables_map vm;
+    boost::program_options::store(
+        boost::program_options::parse_command_line(argc, argv, options), vm);
+    if (vm.count("help"))
+    {
+        options.print(std::cout);
+        return 0;
+    }
+
+    std::vector<size_t> payloadSizes{vm["payload"].as<size_t>()};
+    if (payloadSizes.front() == 0)
+    {
+        payloadSizes = {100, 1024 * 1024};
+    }
+    auto factory = std::make_shared<P2PMessageFactoryV2>();
+    for (auto payloadSize : payloadSizes)
+    {
+        BenchParams params{payloadSize, vm["total"].as<size_t>(), vm["buffer"].as<size_t>()};
+
+        // append every read to the receive buffer, decode from the front and erase the message
+        run("AppendErase", params, [&params, &factory](bytes const& _stream, size_t& _decoded) {
+            bytes recvBuffer(params.bufferSize);
+            bytes data;
+            for (size_t offset = 0; offset < _stream.size();)
+            {
+                auto size = std::min(recvBuffer.size(), _stream.size() - offset);
+                std::memcpy(recvBuffer.data(), _stream.data() + offset, size);
+                offset += size;
+                data.insert(data.end(), recvBuffer.begin(), recvBuffer.begin() + size);
+                while (true)
+                {
+                    auto message = factory->buildMessage();
+                    ssize_t result = 0;
+                    try
+                    {
+                        result = message->decode(bytesConstRef(data.data(), data.size()));
+                    }
+                    catch (std::out_of_range const&)
+                    {
+                        // the header of P2PMessageV2 is not complete
+                    }
+                    if (result <= 0)
+                    {
+                        break;
+                    }
+                    ++_decoded;
+                    data.erase(data.begin(), data.begin() + result);
+                }
+            }
+        });
+
+        // decode in place from the read buffer, the large payloads are read into the message
+        run("MessageReader", params, [&params, &factory](bytes const& _stream, size_t& _decoded) {
+            MessageReader reader(factory, params.bufferSize);
+            for (size_t offset = 0; offset < _stream.size();)
+            {
+                auto buffer = reader.readBuffer();
+                auto size = std::min(buffer.size(), _stream.size() - offset);
+                std::memcpy(buffer.data(), _stream.data() + offset, size);
+                offset += size;
+                reader.onRead(size, [&_decoded](NetworkException const&, Message::Ptr) {
+                    ++_decoded;
+                });
+            }
+        });
+    }
+
+    return 0;
+}
@@ -0,0 +1,160 @@
+#include <bcos-boostssl/websocket/WsInitializer.h>
+#include <bcos-boostssl/websocket/WsService.h>
+#include <boost/program_options.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+
+constexpr static uint16_t BENCH_MSG_TYPE = 9999;
+
+struct BenchParams
+{
+    uint16_t port;
+    int64_t count;
+    int64_t window;
+    size_t msgSize;
+    int32_t timeout;
+    uint32_t threads;
+};
+
+std::shared_ptr<WsService> startService(std::string const& _name, WsConfig::Ptr _config)
+{
+    _config->setDisableSsl(true);
+    auto wsService = std::make_shared<WsService>(_name);
+    auto wsInitializer = std::make_shared<WsInitializer>();
+    wsInitializer->setConfig(_config);
+    wsInitializer->initWsService(wsService);
+    return wsService;
+}
+
+// the client keeps window requests in flight over one loopback websocket connection, the server
+// echoes every request as the response
+void run(std::string_view name, BenchParams const& params, uint32_t callbackSlabSize)
+{
+    auto serverConfig = std::make_shared<WsConfig>();
+    serverConfig->setModel(WsModel::Server);
+    serverConfig->setListenIP("127.0.0.1");
+    serverConfig->setListenPort(params.port);
+    serverConfig->setThreadPoolSize(params.threads);
+    auto server = startService("ws-bench-server", serverConfig);
+    server->registerMsgHandler(BENCH_MSG_TYPE,
+        [](std::shared_ptr<MessageFace> _msg, std::shared_ptr<WsSession> _session) {
+            _session->asyncSendMessage(_msg);
+        });
+    server->start();
+
+    auto clientConfig = std::make_shared<WsConfig>();
+    clientConfig->setModel(WsModel::Client);
+    auto peers = std::make_shared<EndPoints>();
+    peers->insert(NodeIPEndpoint("127.0.0.1", params.port));
+    clientConfig->setConnectPeers(peers);
+    clientConfig->setThreadPoolSize(params.threads);
+    clientConfig->setSendMsgTimeout(params.timeout);
+    clientConfig->setCallbackSlabSize(callbackSlabSize);
+    auto client = startService("ws-bench-client", clientConfig);
+    client->start();
+    while (client->sessions().empty())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    int64_t inflight = 0;
+    std::atomic<int64_t> failed = 0;
+    auto payload = std::make_shared<bytes>(params.msgSize, 'a');
+
+    auto timePoint = std::chrono::high_resolution_clock::now();
+    for (int64_t i = 0; i < params.count; ++i)
+    {
+        {
+            std::unique_lock lock(mutex);
+            condition.wait(lock, [&]() { return inflight < params.window; });
+            ++inflight;
+        }
+        auto msg = client->messageFactory()->buildMessage();
+        msg->setPacketType(BENCH_MSG_TYPE);
+        msg->setSeq(client->messageFactory()->newSeq());
+        msg->setPayload(payload);
+        client->asyncSendMessage(msg, Options(-1),
+            [&mutex, &condition, &inflight, &failed](Error::Ptr _error,
+                std::shared_ptr<MessageFace>, std::shared_ptr<WsSession>) {
+                if (_error && _error->errorCode() != 0)
+                {
+                    ++failed;
+                }
+                std::lock_guard lock(mutex);
+                --inflight;
+                condition.notify_one();
+            });
+    }
+    {
+        std::unique_lock lock(mutex);
+        condition.wait(lock, [&]() { return inflight == 0; });
+    }
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - timePoint)
+                        .count();
+
+    client->stop();
+    server->stop();
+
+    std::cout << name << " window: " << params.window << ", msgSize: " << params.msgSize << ", "
+              << (double)params.count * 1000000 / std::max(duration, (int64_t)1) << " req/s, "
+              << (double)duration / params.count << "us/req, " << failed << " failed"
+              << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description options("Websocket session request benchmark");
+
+    // clang-format off
+    options.add_options()
+        ("port,p", boost::program_options::value<uint16_t>()->default_value(20299), "The loopback port of the server")
+        ("count,n", boost::program_options::value<int64_t>()->default_value(200000), "Requests")
+        ("window,w", boost::program_options::value<int64_t>()->default_value(0), "Requests in flight, 0 means 1 to 4096")
+        ("size,s", boost::program_options::value<size_t>()->default_value(256), "Payload size of the request")
+        ("timeout,t", boost::program_options::value<int32_t>()->default_value(10000), "Request timeout(ms)")
+        ("threads", boost::program_options::value<uint32_t>()->default_value(8), "Thread pool size of the service")
+        ("slab", boost::program_options::value<uint32_t>()->default_value(65536), "Slots of the callback slab")
+        ("help,h", "Print the usage")
+        ;
+    // clang-format on
+    boost::program_options::variables_map vm;
+    boost::program_options::store(
+        boost::program_options::parse_command_line(argc, argv, options), vm);
+    if (vm.count("help"))
+    {
+        options.print(std::cout);
+        return 0;
+    }
+
+    std::vector<int64_t> windows{vm["window"].as<int64_t>()};
+    if (windows.front() <= 0)
+    {
+        windows = {1, 64, 1024, 4096};
+    }
+    auto port = vm["port"].as<uint16_t>();
+    for (auto window : windows)
+    {
+        BenchParams params{port, vm["count"].as<int64_t>(), window, vm["size"].as<size_t>(),
+            vm["timeout"].as<int32_t>(), vm["threads"].as<uint32_t>()};
+
+        // the uuid seq, the callback map and a deadline_timer per request
+        run("UuidSeqMap", params, 0);
+        // every run listens on its own port, the closed socket may be in TIME_WAIT
+        params.port = ++port;
+        run("IntegerSeqSlab", params, vm["slab"].as<uint32_t>());
+        params.port = ++port;
+    }
+
+    return 0;
+}
@@ -18,10 +18,13 @@
  * @date 2022-5-10
  */
 #include "ExecutorServiceServer.h"
+#include <bcos-framework/executor/ExecuteError.h>
 #include <bcos-tars-protocol/Common.h>
 #include <bcos-tars-protocol/ErrorConverter.h>
 #include <bcos-tars-protocol/protocol/BlockHeaderImpl.h>
 #include <bcos-tars-protocol/protocol/ExecutionMessageImpl.h>
+#include <bcos-tars-protocol/protocol/ExecutorBatchCodec.h>
+#include <atomic>
 
 using namespace bcostars;
 
@@ -171,6 +174,74 @@ bcostars::Error ExecutorServiceServer::dagExecuteTransactions(
     return bcostars::Error();
 }
 
+bcostars::Error ExecutorServiceServer::executeBatch(std::vector<tars::Char> const& _requests,
+    std::vector<tars::Char>&, tars::TarsCurrentPtr _current)
+{
+    struct BatchContext
+    {
+        std::vector<bcostars::protocol::ExecutorBatchRequest> requests;
+        std::vector<bcostars::protocol::ExecutorBatchResponse> responses;
+        std::atomic<size_t> remaining = 0;
+    };
+    auto context = std::make_shared<BatchContext>();
+    try
+    {
+        context->requests = bcostars::protocol::ExecutorBatchCodec::decodeRequests(
+            bcostars::protocol::ExecutorBatchCodec::toBytesRef(_requests));
+    }
+    catch (std::exception const& e)
+    {
+        bcostars::Error error;
+        error.errorCode = bcos::executor::ExecuteError::EXECUTE_ERROR;
+        error.errorMessage = e.what();
+        return error;
+    }
+    if (context->requests.empty())
+    {
+        return bcostars::Error();
+    }
+    _current->setResponse(false);
+    context->responses.resize(context->requests.size());
+    context->remaining = context->requests.size();
+    // the requests are executed concurrently as they were sent one by one, the responses are
+    // framed in the order of the requests once all of them are done
+    for (size_t i = 0; i < context->requests.size(); ++i)
+    {
+        auto callback = [_current, context, i](bcos::Error::UniquePtr _error,
+                            std::vector<bcos::protocol::ExecutionMessage::UniquePtr> _outputs) {
+            context->responses[i].error = std::move(_error);
+            context->responses[i].messages = std::move(_outputs);
+            if (context->remaining.fetch_sub(1) != 1)
+            {
+                return;
+            }
+            bcostars::protocol::ExecutorBatchCodec::Frame responses;
+            for (auto const& response : context->responses)
+            {
+                bcostars::protocol::ExecutorBatchCodec::encodeResponse(
+                    responses, response.error.get(), response.messages);
+            }
+            async_response_executeBatch(_current, bcostars::Error(), std::move(responses));
+        };
+        auto& request = context->requests[i];
+        switch (request.type)
+        {
+        case bcostars::protocol::ExecutorBatchType::DMC_EXECUTE:
+            m_executor->dmcExecuteTransactions(
+                request.contractAddress, request.messages, std::move(callback));
+            break;
+        case bcostars::protocol::ExecutorBatchType::EXECUTE:
+            m_executor->executeTransactions(
+                request.contractAddress, request.messages, std::move(callback));
+            break;
+        case bcostars::protocol::ExecutorBatchType::DAG_EXECUTE:
+            m_executor->dagExecuteTransactions(request.messages, std::move(callback));
+            break;
+        }
+    }
+    return bcostars::Error();
+}
+
 bcostars::Error ExecutorServiceServer::dmcCall(bcostars::ExecutionMessage const& _input,
     bcostars::ExecutionMessage& _output, tars::TarsCurrentPtr _current)
 {
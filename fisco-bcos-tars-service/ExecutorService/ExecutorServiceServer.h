@@ -55,6 +55,8 @@ public:
         std::vector<bcostars::ExecutionMessage>& _ouptputs, tars::TarsCurrentPtr _current) override;
     bcostars::Error dagExecuteTransactions(std::vector<bcostars::ExecutionMessage> const& _inputs,
         std::vector<bcostars::ExecutionMessage>& _ouptputs, tars::TarsCurrentPtr _current) override;
+    bcostars::Error executeBatch(std::vector<tars::Char> const& _requests,
+        std::vector<tars::Char>& _responses, tars::TarsCurrentPtr _current) override;
     bcostars::Error dmcCall(bcostars::ExecutionMessage const& _input,
         bcostars::ExecutionMessage& _output, tars::TarsCurrentPtr _current) override;
 
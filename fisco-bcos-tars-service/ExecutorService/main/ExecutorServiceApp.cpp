@@ -117,6 +117,8 @@ void ExecutorServiceApp::createAndInitExecutor()
         schedulerPrx, m_protocolInitializer->cryptoSuite());
 
     // create executor
+    StorageInitializer::setKeyPageOptions(m_nodeConfig->keyPageFormat(),
+        m_nodeConfig->keyPageCompression(), m_nodeConfig->keyPageAdaptive());
     auto storage = StorageInitializer::build(m_nodeConfig->pdAddrs(), getLogPath());
     std::shared_ptr<bcos::storage::LRUStateStorage> cache = nullptr;
     if (m_nodeConfig->enableLRUCacheStorage())
@@ -141,6 +143,7 @@ void ExecutorServiceApp::createAndInitExecutor()
         m_txpool, cache, storage, executionMessageFactory,
         m_protocolInitializer->cryptoSuite()->hashImpl(), m_nodeConfig->isWasm(),
         m_nodeConfig->isAuthCheck(), m_nodeConfig->keyPageSize(), "executor");
+    executorFactory->setCallThreadCount(m_nodeConfig->callThreadCount());
 
     m_executor = std::make_shared<bcos::executor::SwitchExecutorManager>(executorFactory);
 
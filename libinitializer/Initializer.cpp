@@ -33,6 +33,7 @@
 #include "bcos-crypto/hasher/OpenSSLHasher.h"
 #include "bcos-executor/src/executor/SwitchExecutorManager.h"
 #include "bcos-framework/storage/StorageInterface.h"
+#include "bcos-table/src/CacheWarmer.h"
 #include <bcos-crypto/interfaces/crypto/CommonType.h>
 #include <bcos-crypto/signature/key/KeyFactoryImpl.h>
 #include <bcos-framework/executor/NativeExecutionMessage.h>
@@ -44,6 +45,7 @@
 #include <bcos-framework/rpc/RPCInterface.h>
 #include <bcos-protocol/TransactionSubmitResultFactoryImpl.h>
 #include <bcos-protocol/TransactionSubmitResultImpl.h>
+#include <bcos-scheduler/src/CallEngine.h>
 #include <bcos-scheduler/src/ExecutorManager.h>
 #include <bcos-scheduler/src/SchedulerManager.h>
 #include <bcos-scheduler/src/TarsRemoteExecutorManager.h>
@@ -52,6 +54,8 @@
 #include <bcos-tars-protocol/protocol/ExecutionMessageImpl.h>
 #include <bcos-tool/LedgerConfigFetcher.h>
 #include <bcos-tool/NodeConfig.h>
+#include <bcos-utilities/TaskScheduler.h>
+#include <bcos-utilities/Tracer.h>
 #include <util/tc_clientsocket.h>
 #include <vector>
 
@@ -95,6 +99,15 @@ void Initializer::initConfig(std::string const& _configFilePath, std::string con
     m_nodeConfig = std::make_shared<NodeConfig>(std::make_shared<bcos::crypto::KeyFactoryImpl>());
     m_nodeConfig->loadConfig(_configFilePath);
     m_nodeConfig->loadGenesisConfig(_genesisFile);
+    // the modules create their thread pools on the shared scheduler, init it before them
+    TaskScheduler::instance().init(
+        m_nodeConfig->taskSchedulerThreadCount(), m_nodeConfig->taskSchedulerCpus());
+    if (m_nodeConfig->enableTrace())
+    {
+        trace::Tracer::instance().enable(m_nodeConfig->traceCapacity());
+    }
+    StorageInitializer::setKeyPageOptions(m_nodeConfig->keyPageFormat(),
+        m_nodeConfig->keyPageCompression(), m_nodeConfig->keyPageAdaptive());
 
     // init the protocol
     m_protocolInitializer = std::make_shared<ProtocolInitializer>();
@@ -198,6 +211,8 @@ void Initializer::init(bcos::protocol::NodeArchitectureType _nodeArchType,
         m_txpoolInitializer->txpool(), m_protocolInitializer->txResultFactory(),
         m_protocolInitializer->cryptoSuite()->hashImpl(), m_nodeConfig->isAuthCheck(),
         m_nodeConfig->isWasm(), m_nodeConfig->isSerialExecute());
+    factory->setCallEngine(std::make_shared<bcos::scheduler::CallEngine>(
+        m_nodeConfig->callLimit(), m_nodeConfig->callCacheSize()));
 
     int64_t schedulerSeq = 0;  // In Max node, this seq will be update after consensus module switch
                                // to a leader during startup
@@ -212,6 +227,14 @@ void Initializer::init(bcos::protocol::NodeArchitectureType _nodeArchType,
         cache->setMaxCapacity(m_nodeConfig->cacheSize());
         INITIALIZER_LOG(INFO) << "initNode: enableLRUCacheStorage, size: "
                               << m_nodeConfig->cacheSize();
+        if (m_nodeConfig->enableCacheWarmup() &&
+            _nodeArchType != bcos::protocol::NodeArchitectureType::MAX)
+        {
+            m_cacheWarmer = std::make_shared<bcos::storage::CacheWarmer>(cache,
+                storagePath + c_fileSeparator + c_hotKeysFileName,
+                m_nodeConfig->cacheWarmupKeys());
+            m_cacheWarmer->prefetch();
+        }
     }
     else
     {
@@ -239,6 +262,7 @@ void Initializer::init(bcos::protocol::NodeArchitectureType _nodeArchType,
             m_ledger, m_txpoolInitializer->txpool(), cache, storage, executionMessageFactory,
             m_protocolInitializer->cryptoSuite()->hashImpl(), m_nodeConfig->isWasm(),
             m_nodeConfig->isAuthCheck(), m_nodeConfig->keyPageSize(), executorName);
+        executorFactory->setCallThreadCount(m_nodeConfig->callThreadCount());
         auto parallelExecutor =
             std::make_shared<bcos::executor::SwitchExecutorManager>(executorFactory);
         executorManager->addExecutor(executorName, parallelExecutor);
@@ -396,6 +420,11 @@ void Initializer::start()
     {
         m_frontServiceInitializer->start();
     }
+    if (m_cacheWarmer)
+    {
+        m_cacheWarmer->start();
+    }
+    TaskScheduler::instance().startReport();
 }
 
 void Initializer::stop()
@@ -418,6 +447,13 @@ void Initializer::stop()
         {
             m_scheduler->stop();
         }
+        if (m_cacheWarmer)
+        {
+            m_cacheWarmer->stop();
+            m_cacheWarmer->dump();
+            m_cacheWarmer.reset();
+        }
+        TaskScheduler::instance().stopReport();
     }
     catch (std::exception const& e)
     {
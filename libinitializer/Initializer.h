@@ -40,6 +40,10 @@ namespace scheduler
 {
 class SchedulerInterface;
 }
+namespace storage
+{
+class CacheWarmer;
+}
 namespace initializer
 {
 class Initializer
@@ -95,7 +99,9 @@ private:
 #endif
     bcos::ledger::LedgerInterface::Ptr m_ledger;
     std::shared_ptr<bcos::scheduler::SchedulerInterface> m_scheduler;
+    std::shared_ptr<bcos::storage::CacheWarmer> m_cacheWarmer;
     std::string const c_consensusStorageDBName = "consensus_log";
+    std::string const c_hotKeysFileName = "hot_keys";
     std::string const c_fileSeparator = "/";
 };
 }  // namespace initializer
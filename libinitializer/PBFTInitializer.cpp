@@ -377,7 +377,9 @@ void PBFTInitializer::createSealer()
 {
     // create sealer
     auto sealerFactory = std::make_shared<SealerFactory>(
-        m_protocolInitializer->blockFactory(), m_txpool, m_nodeConfig->minSealTime());
+        m_protocolInitializer->blockFactory(), m_txpool, m_nodeConfig->minSealTime(),
+        m_nodeConfig->adaptiveSealing() ? SealingPolicy::Adaptive : SealingPolicy::Static,
+        m_nodeConfig->targetBlockLatency());
     m_sealer = sealerFactory->createSealer();
 }
 
@@ -393,6 +395,7 @@ void PBFTInitializer::createPBFT()
     m_pbft = pbftFactory->createPBFT();
     auto pbftConfig = m_pbft->pbftEngine()->pbftConfig();
     pbftConfig->setCheckPointTimeoutInterval(m_nodeConfig->checkPointTimeoutInterval());
+    pbftConfig->setSpeculativeExecution(m_nodeConfig->speculativeExecution());
 }
 
 void PBFTInitializer::createSync()
@@ -403,6 +406,7 @@ void PBFTInitializer::createSync()
         m_protocolInitializer->blockFactory(), m_protocolInitializer->txResultFactory(), m_ledger,
         m_txpool, m_frontService, m_scheduler, m_pbft);
     m_blockSync = blockSyncFactory->createBlockSync();
+    m_blockSync->config()->setVerifyDepth(m_nodeConfig->syncVerifyDepth());
 }
 
 std::shared_ptr<bcos::txpool::TxPoolInterface> PBFTInitializer::txpool()
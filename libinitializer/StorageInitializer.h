@@ -29,6 +29,7 @@
 #include <bcos-framework/security/DataEncryptInterface.h>
 #include <bcos-framework/storage/StorageInterface.h>
 #include <bcos-storage/RocksDBStorage.h>
+#include <bcos-table/src/KeyPageStorage.h>
 #include <bcos-storage/TiKVStorage.h>
 
 namespace bcos::initializer
@@ -85,5 +86,15 @@ public:
         return std::make_shared<bcos::storage::TiKVStorage>(cluster);
     }
 #endif
+
+    // the options of the key pages written by the executors, all the formats are readable
+    static void setKeyPageOptions(std::string const& _format, bool _compress, bool _adaptive)
+    {
+        bcos::storage::KeyPageCodec::setFormat(_format == "binary" ?
+                                                   bcos::storage::KeyPageFormat::BINARY :
+                                                   bcos::storage::KeyPageFormat::LEGACY,
+            _compress);
+        bcos::storage::KeyPageStorage::setAdaptivePageSize(_adaptive);
+    }
 };
 }  // namespace bcos::initializer
\ No newline at end of file
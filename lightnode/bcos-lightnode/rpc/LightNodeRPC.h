@@ -349,6 +349,13 @@ public:
         _respFunc(BCOS_ERROR_PTR(-1, "Unspported method!"), value);
     }
 
+    void getBlockTrace(std::string_view _groupID, std::string_view _nodeName,
+        int64_t _blockNumber, RespFunc _respFunc) override
+    {
+        Json::Value value;
+        _respFunc(BCOS_ERROR_PTR(-1, "Unspported method!"), value);
+    }
+
     void getGroupBlockNumber(RespFunc _respFunc) override
     {
         LIGHTNODE_LOG(INFO) << "RPC get group block number request";
@@ -1158,6 +1158,9 @@ generate_config_ini() {
     sm_ssl=false
     ; ssl connection switch, if disable the ssl connection, default: false
     ${disable_ssl_content}
+    ; serve the metrics in the Prometheus format on GET /metrics without authentication,
+    ; only enable it when the listen_ip is not reachable from the public network, default: false
+    ; enable_metrics=false
 
 [cert]
     ; directory the certificates located in
@@ -1200,12 +1203,35 @@ generate_common_ini() {
 [consensus]
     ; min block generation time(ms)
     min_seal_time=500
+    ; adaptive: size the blocks by the measured execution throughput to commit every block within
+    ; target_block_latency(ms), static: seal block_tx_count_limit txs or after min_seal_time
+    ;sealing_policy=static
+    ;target_block_latency=1000
+    ; execute the proposals while the prepare and commit messages are exchanged
+    ;speculative_execution=false
+
+[sync]
+    ; the downloaded blocks verified ahead of the execution, 0 means verifying the blocks one by
+    ; one before commit, the default is 8
+    ;verify_depth=8
 
 [storage]
     data_path=data
     enable_cache=true
+    ; dump the hot keys of the cache on stop and prefetch them on start
+    ;cache_warmup=false
+    ; the max hot keys to dump, default is 100000
+    ;cache_warmup_keys=100000
     ; The granularity of the storage page, in bytes, must not be less than 4096 Bytes, the default is 10240 Bytes (10KB)
     key_page_size=${key_page_size}
+    ; the format of the storage pages to write, legacy or binary, the default is legacy
+    ; the binary pages are smaller and faster to encode, but can't be read by the older versions
+    ;key_page_format=legacy
+    ; compress the binary pages with zstd, the default is false
+    ;key_page_compression=false
+    ; adapt the page size of every table to its workload: smaller pages for the frequently updated
+    ; tables, bigger pages for the append-only tables, the default is false
+    ;key_page_adaptive=false
 
 [txpool]
     ; size of the txpool, default is 15000
@@ -1224,6 +1250,18 @@ generate_common_ini() {
     level=info
     ; MB
     max_log_file_size=200
+    ; format and write the logs of the hot paths on a background thread
+    ; async_backend=false
+    ; KB, the buffer size of each thread
+    ; async_buffer_size=1024
+    ; block or drop the logs when the buffer is full
+    ; async_full_policy=block
+
+[trace]
+    ; record the execution spans of the blocks, dump the trace of a block by the getBlockTrace rpc
+    ; enable=false
+    ; the spans kept in memory, the oldest are overwritten
+    ; capacity=1048576
 
 [flow_control]
     ; the module that does not limit bandwidth
@@ -1253,6 +1291,10 @@ generate_common_ini() {
     ;   group_group0=2
     ;   group_group1=2
     ;   group_group2=2
+    ;
+    ; specify module to limit bandwidth, module_moduleName=n
+    ;   module_amop=2
+    ;   module_block_sync=5
 EOF
 }
 